@@ -6,30 +6,33 @@
 #include "graphics/FogMistEffect.h"
 #include "graphics/LightningEffect.h"
 #include "graphics/MapDisplay.h"
-#include <QDateTime>
+#include "graphics/SceneAnimationDriver.h"
 #include <QDebug>
 #include <QCoreApplication>
 #include <QFile>
 #include <QFileInfo>
 #include <QStandardPaths>
 
+namespace {
+// qFuzzyCompare is unusable around 0.0, which most atmosphere values can be
+bool differs(qreal a, qreal b)
+{
+    return !qFuzzyCompare(1.0 + a, 1.0 + b);
+}
+}
+
 AtmosphereManager::AtmosphereManager(QObject* parent)
     : QObject(parent)
     , m_mapDisplay(nullptr)
     , m_ambientPlayer(nullptr)
     , m_musicRemote(nullptr)
-    , m_transitionTimer(new QTimer(this))
+    , m_hasAppliedState(false)
     , m_transitionDuration(DEFAULT_TRANSITION_MS)
-    , m_transitionStartTime(0)
-    , m_transitionPausedTime(0)
+    , m_transitionElapsed(0.0)
     , m_isTransitioning(false)
     , m_isPaused(false)
     , m_easingCurve(QEasingCurve::InOutCubic)
 {
-    // Setup transition timer
-    m_transitionTimer->setInterval(TICK_INTERVAL_MS);
-    connect(m_transitionTimer, &QTimer::timeout, this, &AtmosphereManager::onTransitionTick);
-
     // Audio is out of scope per README §"What Crit VTT Does NOT Do".
     // m_ambientPlayer / m_musicRemote remain nullptr; AtmosphereToolboxWidget
     // hides the audio panel and setAudioSystems() null-guards both pointers.
@@ -39,20 +42,35 @@ AtmosphereManager::AtmosphereManager(QObject* parent)
     m_currentPresetName = "Peaceful Day";
 }
 
-AtmosphereManager::~AtmosphereManager()
+void AtmosphereManager::setMapDisplay(MapDisplay* display)
 {
-    if (m_transitionTimer->isActive()) {
-        m_transitionTimer->stop();
+    if (m_mapDisplay) {
+        disconnect(m_mapDisplay, nullptr, this, nullptr);
+        if (m_mapDisplay->getAnimationDriver()) {
+            disconnect(m_mapDisplay->getAnimationDriver(), nullptr, this, nullptr);
+        }
     }
-}
 
-void AtmosphereManager::setMapDisplay(MapDisplay* display)
-{
     m_mapDisplay = display;
+    m_hasAppliedState = false;
+
     if (m_mapDisplay) {
+        // Transitions share the clock that already drives every scene effect
+        if (SceneAnimationDriver* driver = m_mapDisplay->getAnimationDriver()) {
+            connect(driver, &SceneAnimationDriver::tick, this, &AtmosphereManager::onAnimationTick);
+        }
+
+        // Scene rebuilds delete the effects - next push has to be a full one
+        connect(m_mapDisplay, &MapDisplay::sceneInvalidated, this, [this]() {
+            m_hasAppliedState = false;
+        });
+        connect(m_mapDisplay, &MapDisplay::scenePopulated, this, [this]() {
+            m_hasAppliedState = false;
+        });
+
         // Apply current state to the new display
         // LightingOverlay is lazily created, so applyStateToOverlay will handle it
-        applyStateToOverlay(m_currentState);
+        applyStateToOverlay(m_currentState, true);
     }
 }
 
@@ -72,13 +90,7 @@ qreal AtmosphereManager::getTransitionProgress() const
         return 1.0;
     }
 
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    if (m_isPaused) {
-        currentTime = m_transitionPausedTime;
-    }
-
-    qint64 elapsed = currentTime - m_transitionStartTime;
-    return qBound(0.0, static_cast<qreal>(elapsed) / m_transitionDuration, 1.0);
+    return qBound(0.0, m_transitionElapsed / m_transitionDuration, 1.0);
 }
 
 void AtmosphereManager::applyPreset(const QString& presetName)
@@ -153,7 +165,6 @@ void AtmosphereManager::setTimeOfDay(int timeOfDay)
 void AtmosphereManager::cancelTransition()
 {
     if (m_isTransitioning) {
-        m_transitionTimer->stop();
         m_isTransitioning = false;
         m_isPaused = false;
 
@@ -165,59 +176,55 @@ void AtmosphereManager::cancelTransition()
 void AtmosphereManager::pauseTransition()
 {
     if (m_isTransitioning && !m_isPaused) {
+        // Ticks keep arriving but no longer advance m_transitionElapsed
         m_isPaused = true;
-        m_transitionPausedTime = QDateTime::currentMSecsSinceEpoch();
-        m_transitionTimer->stop();
     }
 }
 
 void AtmosphereManager::resumeTransition()
 {
     if (m_isTransitioning && m_isPaused) {
-        // Adjust start time to account for pause duration
-        qint64 pauseDuration = QDateTime::currentMSecsSinceEpoch() - m_transitionPausedTime;
-        m_transitionStartTime += pauseDuration;
-
         m_isPaused = false;
-        m_transitionTimer->start();
     }
 }
 
 void AtmosphereManager::startTransition(const AtmosphereState& targetState, const QString& presetName)
 {
-    // Cancel any existing transition
-    if (m_isTransitioning) {
-        m_transitionTimer->stop();
-    }
-
-    // Store transition parameters
+    // Store transition parameters (restarts from the current interpolated state)
     m_startState = m_currentState;
     m_targetState = targetState;
     m_targetPresetName = presetName;
 
-    // Start timing
-    m_transitionStartTime = QDateTime::currentMSecsSinceEpoch();
+    // Start timing - progress is advanced by onAnimationTick()
+    m_transitionElapsed = 0.0;
     m_isTransitioning = true;
     m_isPaused = false;
 
     emit transitionStarted(presetName);
 
-    // Start the transition timer
-    m_transitionTimer->start();
-
     qDebug() << "AtmosphereManager: Starting transition to" << presetName
              << "over" << m_transitionDuration << "ms";
+
+    // Without a display there is no animation clock and nothing to fade
+    if (!m_mapDisplay || !m_mapDisplay->getAnimationDriver()) {
+        finishTransition();
+    }
 }
 
-void AtmosphereManager::onTransitionTick()
+void AtmosphereManager::onAnimationTick(qreal dt)
 {
-    if (!m_isTransitioning) {
-        m_transitionTimer->stop();
+    if (!m_isTransitioning || m_isPaused) {
         return;
     }
 
+    m_transitionElapsed += dt * 1000.0;
+
     // Calculate progress with easing
     qreal rawProgress = getTransitionProgress();
+    if (rawProgress >= 1.0) {
+        finishTransition();
+        return;
+    }
     qreal easedProgress = m_easingCurve.valueForProgress(rawProgress);
 
     // Interpolate state
@@ -229,120 +236,186 @@ void AtmosphereManager::onTransitionTick()
     // Emit progress signal
     emit transitionProgress(rawProgress);
     emit stateChanged(m_currentState);
+}
 
-    // Check if complete
-    if (rawProgress >= 1.0) {
-        m_transitionTimer->stop();
-        m_isTransitioning = false;
-        m_currentState = m_targetState;  // Ensure exact final state
-        m_currentPresetName = m_targetPresetName;
+void AtmosphereManager::finishTransition()
+{
+    m_isTransitioning = false;
+    m_isPaused = false;
+    m_currentState = m_targetState;  // Ensure exact final state
+    m_currentPresetName = m_targetPresetName;
 
-        applyStateToOverlay(m_currentState);
+    applyStateToOverlay(m_currentState);
 
-        emit transitionCompleted(m_currentPresetName);
-        emit presetChanged(m_currentPresetName);
+    emit transitionProgress(1.0);
+    emit stateChanged(m_currentState);
+    emit transitionCompleted(m_currentPresetName);
+    emit presetChanged(m_currentPresetName);
 
-        qDebug() << "AtmosphereManager: Transition complete -" << m_currentPresetName;
-    }
+    qDebug() << "AtmosphereManager: Transition complete -" << m_currentPresetName;
 }
 
-void AtmosphereManager::applyStateToOverlay(const AtmosphereState& state)
+void AtmosphereManager::applyStateToOverlay(const AtmosphereState& state, bool force)
 {
     // Always get fresh pointer from MapDisplay (it lazily creates the overlay)
     if (!m_mapDisplay) {
         return;
     }
 
-    LightingOverlay* overlay = m_mapDisplay->getLightingOverlay();
-    if (!overlay) {
-        return;
-    }
+    // Diff against the last pushed state; a full push when nothing was pushed
+    // to the current scene yet. Setters invalidate caches and reschedule strikes,
+    // so unchanged fields are not re-sent every frame.
+    const bool full = force || !m_hasAppliedState;
+    const AtmosphereState& prev = m_appliedState;
 
-    // Apply lighting properties
-    overlay->setEnabled(true);
+    LightingOverlay* overlay = m_mapDisplay->getLightingOverlay();
+    if (overlay) {
+        // Apply lighting properties
+        if (full || !overlay->isEnabled()) {
+            overlay->setEnabled(true);
+        }
 
-    // Set time of day (this sets base lighting parameters)
-    TimeOfDay tod = static_cast<TimeOfDay>(qBound(0, state.timeOfDay, 3));
-    overlay->setTimeOfDay(tod);
+        // Set time of day (this sets base lighting parameters, so the
+        // overrides below are re-sent whenever it changes)
+        const bool timeChanged = full || state.timeOfDay != prev.timeOfDay;
+        if (timeChanged) {
+            TimeOfDay tod = static_cast<TimeOfDay>(qBound(0, state.timeOfDay, 3));
+            overlay->setTimeOfDay(tod);
+        }
 
-    // Override with custom values for smooth transitions
-    overlay->setLightingIntensity(state.lightingIntensity);
-    overlay->setLightingTint(state.lightingTint);
-    overlay->setAmbientLightLevel(state.ambientLevel);
-    overlay->setExposure(state.exposure);
+        // Override with custom values for smooth transitions
+        if (timeChanged || differs(state.lightingIntensity, prev.lightingIntensity)) {
+            overlay->setLightingIntensity(state.lightingIntensity);
+        }
+        if (timeChanged || state.lightingTint != prev.lightingTint) {
+            overlay->setLightingTint(state.lightingTint);
+        }
+        if (timeChanged || differs(state.ambientLevel, prev.ambientLevel)) {
+            overlay->setAmbientLightLevel(state.ambientLevel);
+        }
+        if (timeChanged || differs(state.exposure, prev.exposure)) {
+            overlay->setExposure(state.exposure);
+        }
+    }
 
     // Phase 2: Apply weather effects
     WeatherEffect* weather = m_mapDisplay->getWeatherEffect();
     if (weather) {
         WeatherType weatherType = static_cast<WeatherType>(qBound(0, state.weatherType, 3));
 
-        if (weatherType != WeatherType::None) {
-            weather->setWeatherType(weatherType);
-            weather->setIntensity(state.weatherIntensity);
-            weather->setWindStrength(state.windStrength);
-            weather->setEnabled(true);
-        } else {
-            weather->setEnabled(false);
+        if (full || state.weatherType != prev.weatherType) {
+            if (weatherType != WeatherType::None) {
+                weather->setWeatherType(weatherType);
+                weather->setIntensity(state.weatherIntensity);
+                weather->setWindStrength(state.windStrength);
+                weather->setEnabled(true);
+            } else {
+                weather->setEnabled(false);
+            }
+        } else if (weatherType != WeatherType::None) {
+            if (differs(state.weatherIntensity, prev.weatherIntensity)) {
+                weather->setIntensity(state.weatherIntensity);
+            }
+            if (differs(state.windStrength, prev.windStrength)) {
+                weather->setWindStrength(state.windStrength);
+            }
         }
     }
 
     // Phase 3: Apply fog/mist effects
     FogMistEffect* fogMist = m_mapDisplay->getFogMistEffect();
     if (fogMist) {
-        if (state.fogEnabled && state.fogDensity > 0.0) {
-            fogMist->setDensity(state.fogDensity);
-            fogMist->setHeight(state.fogHeight);
-            fogMist->setColor(state.fogColor);
-
-            // Auto-load fog texture if not already loaded
-            if (!fogMist->hasTexture()) {
-                // Try to load from resources/textures/fog/ (copied during build)
-                QString texturePath = QCoreApplication::applicationDirPath() +
-                                     "/../Resources/resources/textures/fog/texture_fog_01.png";
-                if (QFile::exists(texturePath)) {
-                    fogMist->loadFogTexture(texturePath);
-                    fogMist->setTextureScale(1.5);  // Slightly larger tiles
-                    fogMist->setTextureTwist(0.3);  // Subtle rotation
-                } else {
-                    qDebug() << "FogMistEffect: Texture not found at" << texturePath;
+        const bool fogOn = state.fogEnabled && state.fogDensity > 0.0;
+        const bool wasFogOn = prev.fogEnabled && prev.fogDensity > 0.0;
+
+        if (full || fogOn != wasFogOn) {
+            if (fogOn) {
+                fogMist->setDensity(state.fogDensity);
+                fogMist->setHeight(state.fogHeight);
+                fogMist->setColor(state.fogColor);
+
+                // Auto-load fog texture if not already loaded
+                if (!fogMist->hasTexture()) {
+                    // Try to load from resources/textures/fog/ (copied during build)
+                    QString texturePath = QCoreApplication::applicationDirPath() +
+                                         "/../Resources/resources/textures/fog/texture_fog_01.png";
+                    if (QFile::exists(texturePath)) {
+                        fogMist->loadFogTexture(texturePath);
+                        fogMist->setTextureScale(1.5);  // Slightly larger tiles
+                        fogMist->setTextureTwist(0.3);  // Subtle rotation
+                    } else {
+                        qDebug() << "FogMistEffect: Texture not found at" << texturePath;
+                    }
                 }
-            }
 
-            fogMist->setEnabled(true);
-        } else {
-            fogMist->setEnabled(false);
+                fogMist->setEnabled(true);
+            } else {
+                fogMist->setEnabled(false);
+            }
+        } else if (fogOn) {
+            if (differs(state.fogDensity, prev.fogDensity)) {
+                fogMist->setDensity(state.fogDensity);
+            }
+            if (differs(state.fogHeight, prev.fogHeight)) {
+                fogMist->setHeight(state.fogHeight);
+            }
+            if (state.fogColor != prev.fogColor) {
+                fogMist->setColor(state.fogColor);
+            }
         }
     }
 
     // Phase 4: Apply lightning effects
     LightningEffect* lightning = m_mapDisplay->getLightningEffect();
     if (lightning) {
-        if (state.lightningEnabled && state.lightningIntensity > 0.0) {
-            lightning->setIntensity(state.lightningIntensity);
-            lightning->setFrequency(state.lightningFrequency);
-            lightning->setEnabled(true);
-        } else {
-            lightning->setEnabled(false);
+        const bool lightningOn = state.lightningEnabled && state.lightningIntensity > 0.0;
+        const bool wasLightningOn = prev.lightningEnabled && prev.lightningIntensity > 0.0;
+
+        if (full || lightningOn != wasLightningOn) {
+            if (lightningOn) {
+                lightning->setIntensity(state.lightningIntensity);
+                lightning->setFrequency(state.lightningFrequency);
+                lightning->setEnabled(true);
+            } else {
+                lightning->setEnabled(false);
+            }
+        } else if (lightningOn) {
+            if (differs(state.lightningIntensity, prev.lightningIntensity)) {
+                lightning->setIntensity(state.lightningIntensity);
+            }
+            // setFrequency() reschedules the next strike - only when it moved
+            if (differs(state.lightningFrequency, prev.lightningFrequency)) {
+                lightning->setFrequency(state.lightningFrequency);
+            }
         }
     }
 
-    // Audio — crossfade ambient track on state change
+    // Audio — crossfade ambient track on track change
     if (m_ambientPlayer) {
-        if (!state.ambientTrack.isEmpty()) {
-            QString trackPath = resolveAmbientTrackPath(state.ambientTrack);
-            if (!trackPath.isEmpty()) {
-                m_ambientPlayer->crossfadeTo(trackPath, m_transitionDuration);
+        if (full || state.ambientTrack != prev.ambientTrack) {
+            if (!state.ambientTrack.isEmpty()) {
+                QString trackPath = resolveAmbientTrackPath(state.ambientTrack);
+                if (!trackPath.isEmpty()) {
+                    m_ambientPlayer->crossfadeTo(trackPath, m_transitionDuration);
+                }
+            } else {
+                m_ambientPlayer->stop(m_transitionDuration);
             }
+        }
+        if (!state.ambientTrack.isEmpty() &&
+            (full || differs(state.ambientVolume, prev.ambientVolume))) {
             m_ambientPlayer->setVolume(state.ambientVolume);
-        } else {
-            m_ambientPlayer->stop(m_transitionDuration);
         }
     }
 
-    // Music URL — open in system music app on state change
-    if (m_musicRemote && !state.musicURL.isEmpty()) {
+    // Music URL — open in system music app when it changes
+    if (m_musicRemote && !state.musicURL.isEmpty() &&
+        (full || state.musicURL != prev.musicURL)) {
         m_musicRemote->openMusicURL(state.musicURL);
     }
+
+    m_appliedState = state;
+    m_hasAppliedState = true;
 }
 
 QString AtmosphereManager::resolveAmbientTrackPath(const QString& track) const
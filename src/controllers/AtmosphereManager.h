@@ -2,7 +2,6 @@
 #define ATMOSPHEREMANAGER_H
 
 #include <QObject>
-#include <QTimer>
 #include <QEasingCurve>
 #include "AtmosphereState.h"
 #include "AtmospherePreset.h"
@@ -12,14 +11,16 @@ class MusicRemote;
 class MapDisplay;
 
 // Central orchestrator for atmosphere effects and transitions
-// Manages smooth transitions between atmospheric states
+// Manages smooth transitions between atmospheric states. Transitions advance on
+// the MapDisplay's SceneAnimationDriver tick: one interpolated AtmosphereState
+// per frame, and only the fields that changed are pushed to the effects.
 class AtmosphereManager : public QObject
 {
     Q_OBJECT
 
 public:
     explicit AtmosphereManager(QObject* parent = nullptr);
-    ~AtmosphereManager();
+    ~AtmosphereManager() override = default;
 
     // Connect to map display (and its lighting overlay)
     void setMapDisplay(MapDisplay* display);
@@ -84,11 +85,13 @@ signals:
     void presetChanged(const QString& presetName);
 
 private slots:
-    void onTransitionTick();
+    void onAnimationTick(qreal dt);
 
 private:
-    void applyStateToOverlay(const AtmosphereState& state);
+    // Push the fields of state that differ from the last pushed state
+    void applyStateToOverlay(const AtmosphereState& state, bool force = false);
     void startTransition(const AtmosphereState& targetState, const QString& presetName);
+    void finishTransition();
     QString resolveAmbientTrackPath(const QString& track) const;
 
     // Map display reference (we get LightingOverlay fresh each time via MapDisplay)
@@ -105,18 +108,17 @@ private:
     QString m_currentPresetName;
     QString m_targetPresetName;
 
-    // Transition control
-    QTimer* m_transitionTimer;
+    // Last state pushed to the effects (invalid after the scene is rebuilt)
+    AtmosphereState m_appliedState;
+    bool m_hasAppliedState;
+
+    // Transition control (driven by the scene animation tick)
     int m_transitionDuration;  // milliseconds
-    qint64 m_transitionStartTime;
-    qint64 m_transitionPausedTime;
+    qreal m_transitionElapsed;  // milliseconds, excludes paused time
     bool m_isTransitioning;
     bool m_isPaused;
     QEasingCurve m_easingCurve;
 
-    // Timer interval for 60 FPS updates
-    static constexpr int TICK_INTERVAL_MS = 16;
-
     // Default transition duration (3 seconds for dramatic effect)
     static constexpr int DEFAULT_TRANSITION_MS = 3000;
 };
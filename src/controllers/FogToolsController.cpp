@@ -40,7 +40,10 @@ FogToolsController::FogToolbarActions FogToolsController::createToolbarActions(Q
     // Force text display (overrides toolbar-wide icon-only mode)
     if (auto* btn = qobject_cast<QToolButton*>(toolbar->widgetForAction(actions.hideToggle))) {
         btn->setToolButtonStyle(Qt::ToolButtonTextOnly);
-        btn->setStyleSheet(DarkTheme::successButtonStyle());
+        DarkTheme::setVariant(btn, DarkTheme::Variant::Success);
+        QFont font = btn->font();
+        font.setBold(true);
+        btn->setFont(font);
     }
 
     // Brush tool
@@ -71,7 +74,7 @@ FogToolsController::FogToolbarActions FogToolsController::createToolbarActions(Q
 
     // Style Reset Fog as danger
     if (auto* btn = qobject_cast<QToolButton*>(toolbar->widgetForAction(actions.resetFog))) {
-        btn->setStyleSheet(DarkTheme::dangerButtonStyle());
+        DarkTheme::setVariant(btn, DarkTheme::Variant::Danger);
     }
 
     // Lock Fog
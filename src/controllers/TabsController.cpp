@@ -6,16 +6,28 @@
 #include "ui/widgets/ThumbnailCache.h"
 
 #include <QTabBar>
+#include <QSignalBlocker>
 #include <QFileInfo>
 #include <QBuffer>
 #include <QByteArray>
-#include <QApplication>
-#include <QThread>
-#include <QTimer>
-#include <QPointer>
 
 TabsController::TabsController(QObject* parent)
-    : QObject(parent) {}
+    : QObject(parent)
+    , m_mapLoader(new MapLoadPipeline(this))
+{
+    // Maps decode on the pipeline's worker; only session activation
+    // (SceneBuilder::buildScene) runs here on the GUI thread
+    connect(m_mapLoader, &MapLoadPipeline::progressChanged,
+            this, &TabsController::requestProgress);
+    connect(m_mapLoader, &MapLoadPipeline::previewReady,
+            this, &TabsController::onMapPreviewReady);
+    connect(m_mapLoader, &MapLoadPipeline::loadFinished,
+            this, &TabsController::onMapLoadFinished);
+    connect(m_mapLoader, &MapLoadPipeline::loadFailed,
+            this, &TabsController::onMapLoadFailed);
+    connect(m_mapLoader, &MapLoadPipeline::loadCancelled,
+            this, &TabsController::onMapLoadCancelled);
+}
 
 void TabsController::attach(QTabBar* tabBar, MapDisplay* display, int maxTabs)
 {
@@ -58,12 +70,15 @@ void TabsController::loadMapFile(const QString& path)
         return;
     }
 
+    // Already loading this file into a new tab
+    if (!m_pendingSession && m_mapLoader->isLoading() && m_mapLoader->currentFilePath() == path) {
+        return;
+    }
+
     // If already open, switch
-    for (int i = 0; i < m_sessions.size(); ++i) {
-        if (m_sessions[i]->filePath() == path) {
-            m_tabBar->setCurrentIndex(i);
-            return;
-        }
+    if (MapSession* open = m_sessionsByPath.value(path, nullptr)) {
+        m_tabBar->setCurrentIndex(m_sessions.indexOf(open));
+        return;
     }
 
     if (m_sessions.size() >= m_maxTabs) {
@@ -78,99 +93,256 @@ void TabsController::loadMapFile(const QString& path)
     createNewTab(path);
 }
 
+void TabsController::restoreSessions(const SessionManifest& manifest)
+{
+    if (!m_tabBar || !m_display || !m_sessions.isEmpty()) {
+        return;
+    }
+
+    {
+        // Adding the first tab would make it current and start its load
+        const QSignalBlocker blocker(m_tabBar);
+        for (const SessionManifest::Tab& tab : manifest.tabs) {
+            if (m_sessionsByPath.contains(tab.filePath) || m_sessions.size() >= m_maxTabs ||
+                !QFileInfo::exists(tab.filePath)) {
+                continue;
+            }
+
+            MapSession* session = new MapSession(tab.filePath);
+            session->restoreFromManifest(tab);
+            m_sessions.append(session);
+            m_sessionsByPath.insert(tab.filePath, session);
+            m_recentSessions.append(session);
+
+            // The thumbnail tooltip is filled in when the tab is first shown
+            const int tabIndex = m_tabBar->addTab(shortTitle(tab.filePath));
+            m_tabBar->setTabToolTip(tabIndex, tab.filePath);
+        }
+    }
+    if (m_sessions.isEmpty()) {
+        return;
+    }
+
+    DebugConsole::info(QString("Restored %1 tabs from the last session").arg(m_sessions.size()), "Tabs");
+    m_tabBar->show();
+    m_display->show();
+
+    // Missing maps shift the tabs after them; fall back to the first tab
+    const QString activePath = manifest.tabs.value(manifest.activeIndex).filePath;
+    const int activeIndex = qMax(0, m_sessions.indexOf(m_sessionsByPath.value(activePath, nullptr)));
+    {
+        const QSignalBlocker blocker(m_tabBar);
+        m_tabBar->setCurrentIndex(activeIndex);
+    }
+    switchToTab(activeIndex);
+}
+
+SessionManifest TabsController::captureManifest()
+{
+    SessionManifest manifest;
+    if (MapSession* current = getCurrentSession()) {
+        current->setZoomLevel(m_display->getZoomLevel());
+        current->setViewCenter(m_display->mapToScene(m_display->rect().center()));
+    }
+    for (const MapSession* session : std::as_const(m_sessions)) {
+        manifest.tabs.append(session->manifestEntry());
+    }
+    manifest.activeIndex = m_currentIndex;
+    return manifest;
+}
+
 void TabsController::createNewTab(const QString& filePath)
 {
     QFileInfo fi(filePath);
     const qint64 fileSize = fi.size();
+
+    // Replaces any load still in flight (newest request wins); a pending tab
+    // reload is dropped, so the tab bar goes back to the active tab
+    if (m_pendingSession) {
+        m_pendingSession = nullptr;
+        m_tabBar->setCurrentIndex(m_currentIndex);
+    }
+    m_mapLoader->load(filePath);
+
     if (fileSize > 1024 * 1024) {
         emit requestShowProgress(fi.fileName(), fileSize);
     }
+}
 
-    // Defer heavy load slightly to keep UI responsive (mirrors existing behavior)
-    // CRITICAL FIX: Capture weak pointer to prevent crash if window closes during load
-    QPointer<TabsController> weakThis(this);
-    QTimer::singleShot(10, this, [weakThis, filePath, fi]() {
-        // Check if controller still exists (window not closed)
-        if (!weakThis) {
-            return;  // Window was closed, abort
-        }
+void TabsController::onMapPreviewReady(const QString& filePath, const QImage& preview,
+                                       const QSize& mapSize, int gridSize)
+{
+    // Tab reloads keep showing the live tab until the switch completes;
+    // a restored tab has no live tab to keep, so it gets the preview too
+    if ((m_pendingSession && m_currentIndex >= 0) || !m_display) {
+        return;
+    }
 
-        // Additional safety check for member variables
-        if (!weakThis->m_tabBar || !weakThis->m_display) {
-            return;  // UI components destroyed, abort
-        }
+    // No reduced-size read for this format (VTT): fall back to the browser thumbnail
+    QImage image = preview;
+    if (image.isNull() && ThumbnailCache::instance().hasThumbnail(filePath)) {
+        image = ThumbnailCache::instance().getThumbnail(filePath).toImage();
+    }
+    if (image.isNull()) {
+        return;
+    }
 
-        MapSession* session = nullptr;
-        try {
-            session = new MapSession(filePath);
-            const bool ok = session->loadImage();
+    // The preview replaces the current tab's scene, so park that session now
+    if (!m_previewShown) {
+        saveAndDeactivateCurrent();
+        m_previewShown = true;
+    }
+    m_display->showMapPreview(image, mapSize, gridSize);
+    emit sceneChanged();
+}
 
-            // Check again after potentially long load operation
-            if (!weakThis || !weakThis->m_tabBar || !weakThis->m_display) {
-                delete session;
-                return;  // Window closed during load
-            }
+void TabsController::onMapLoadFinished(const MapLoadPipeline::Result& result)
+{
+    emit requestHideProgress();
 
-            emit weakThis->requestHideProgress();
+    if (!m_tabBar || !m_display) {
+        m_pendingSession = nullptr;
+        return;  // UI components destroyed, abort
+    }
 
-            if (!ok) {
-                delete session;
-                QString errorMsg = QStringLiteral("Failed to load map: %1").arg(fi.fileName());
-                ErrorHandler::instance().reportError(errorMsg, ErrorLevel::Error);
-                emit weakThis->requestStatus(errorMsg, 5000);
+    try {
+        if (MapSession* pending = m_pendingSession) {
+            // Reloading an existing tab whose image was released
+            const int index = m_sessions.indexOf(pending);
+            if (index < 0 || !pending->adoptLoadResult(result)) {
+                onMapLoadFailed(result.filePath, result.errorMessage);
                 return;
             }
-        } catch (const std::exception& e) {
-            if (session) delete session;
-            if (weakThis) {
-                emit weakThis->requestHideProgress();
-                QString errorMsg = QString("Error loading map: %1").arg(e.what());
-                ErrorHandler::instance().reportError(errorMsg, ErrorLevel::Error);
-                emit weakThis->requestStatus(errorMsg, 5000);
-            }
+            m_pendingSession = nullptr;
+            m_previewShown = false;  // Promoted in place like a new tab's
+            switchToTab(index);
             return;
         }
 
-        // Deactivate current session before adding new one
-        if (weakThis->m_currentIndex >= 0 && weakThis->m_currentIndex < weakThis->m_sessions.size()) {
-            MapSession* currentSession = weakThis->m_sessions[weakThis->m_currentIndex];
-            if (currentSession) {
-                currentSession->setZoomLevel(weakThis->m_display->getZoomLevel());
-                currentSession->setViewCenter(weakThis->m_display->mapToScene(weakThis->m_display->rect().center()));
-                currentSession->deactivateSession(weakThis->m_display);
-            }
+        MapSession* session = new MapSession(result.filePath);
+        if (!session->adoptLoadResult(result)) {
+            delete session;
+            onMapLoadFailed(result.filePath, result.errorMessage);
+            return;
         }
+        addLoadedSession(session);
+    } catch (const std::exception& e) {
+        m_pendingSession = nullptr;
+        restoreAfterPreview();
+        QString errorMsg = QString("Error loading map: %1").arg(e.what());
+        ErrorHandler::instance().reportError(errorMsg, ErrorLevel::Error);
+        emit requestStatus(errorMsg, 5000);
+    }
+}
+
+void TabsController::onMapLoadFailed(const QString& filePath, const QString& errorMessage)
+{
+    emit requestHideProgress();
+
+    // A failed reload leaves the previous tab active
+    if (m_pendingSession && m_tabBar) {
+        m_tabBar->setCurrentIndex(m_currentIndex);
+    }
+    m_pendingSession = nullptr;
+    restoreAfterPreview();
+
+    DebugConsole::error(QString("Map load failed: %1 (%2)").arg(filePath, errorMessage), "Tabs");
+    QString errorMsg = QStringLiteral("Failed to load map: %1").arg(QFileInfo(filePath).fileName());
+    ErrorHandler::instance().reportError(errorMsg, ErrorLevel::Error);
+    emit requestStatus(errorMsg, 5000);
+}
+
+void TabsController::onMapLoadCancelled(const QString& filePath)
+{
+    emit requestHideProgress();
+
+    // Cancelled reload: the tab bar already moved, put it back on the active tab
+    if (m_pendingSession && m_tabBar) {
+        m_tabBar->setCurrentIndex(m_currentIndex);
+    }
+    m_pendingSession = nullptr;
+    restoreAfterPreview();
+
+    emit requestStatus(QStringLiteral("Cancelled loading %1").arg(QFileInfo(filePath).fileName()), 3000);
+}
+
+void TabsController::cancelLoading()
+{
+    m_mapLoader->cancel();
+}
+
+void TabsController::addLoadedSession(MapSession* session)
+{
+    const QString filePath = session->filePath();
 
-        weakThis->m_sessions.append(session);
-        const int newIndex = weakThis->m_sessions.size() - 1;
+    // Deactivate current session before adding new one (already done if a
+    // preview went up; the preview scene is promoted in place on activation)
+    if (!m_previewShown) {
+        saveAndDeactivateCurrent();
+    }
+    m_previewShown = false;
+
+    m_sessions.append(session);
+    m_sessionsByPath.insert(filePath, session);
+    const int newIndex = m_sessions.size() - 1;
+
+    // CRITICAL FIX: Always activate the session explicitly
+    // We can't rely on setCurrentIndex triggering currentChanged because:
+    // 1. When we add the same widget (m_display) to a new tab, Qt may auto-select it
+    // 2. If Qt already made the new tab current, setCurrentIndex won't emit currentChanged
+    DebugConsole::info(QString("Activating session for tab %1").arg(newIndex), "Tabs");
+    m_currentIndex = newIndex;
+    session->activateSession(m_display);
+    touchSession(session);
+
+    // Add tab to the tab bar (just adds a label, MapDisplay is managed separately)
+    const int tabIndex = m_tabBar->addTab(shortTitle(filePath));
+    m_tabBar->show();
+    m_display->show();
 
-        // CRITICAL FIX: Always activate the session explicitly
-        // We can't rely on setCurrentIndex triggering currentChanged because:
-        // 1. When we add the same widget (m_display) to a new tab, Qt may auto-select it
-        // 2. If Qt already made the new tab current, setCurrentIndex won't emit currentChanged
-        DebugConsole::info(QString("Activating session for tab %1").arg(newIndex), "Tabs");
-        weakThis->m_currentIndex = newIndex;
-        session->activateSession(weakThis->m_display);
+    // Set tab tooltip with thumbnail preview
+    setTabTooltipWithThumbnail(tabIndex, filePath);
 
-        // Add tab to the tab bar (just adds a label, MapDisplay is managed separately)
-        const int tabIndex = weakThis->m_tabBar->addTab(weakThis->shortTitle(filePath));
-        weakThis->m_tabBar->show();
-        weakThis->m_display->show();
+    // Set current index (may not trigger signal if already current, but that's fine now)
+    m_tabBar->setCurrentIndex(tabIndex);
 
-        // Set tab tooltip with thumbnail preview
-        weakThis->setTabTooltipWithThumbnail(tabIndex, filePath);
+    // Emit signals to update UI (currentMapPathChanged, uiChanged, sceneChanged)
+    emit currentMapPathChanged(filePath);
+    emit uiChanged();
+    emit sceneChanged();
 
-        // Set current index (may not trigger signal if already current, but that's fine now)
-        weakThis->m_tabBar->setCurrentIndex(tabIndex);
+    emit requestAddRecent(filePath);
+    emit requestStatus(QStringLiteral("Loaded: %1").arg(QFileInfo(filePath).fileName()), 5000);
+
+    rebalanceSessions();
+}
+
+void TabsController::saveAndDeactivateCurrent()
+{
+    if (m_currentIndex >= 0 && m_currentIndex < m_sessions.size()) {
+        MapSession* currentSession = m_sessions[m_currentIndex];
+        if (currentSession) {
+            currentSession->setZoomLevel(m_display->getZoomLevel());
+            currentSession->setViewCenter(m_display->mapToScene(m_display->rect().center()));
+            currentSession->deactivateSession(m_display);
+        }
+    }
+}
 
-        // Emit signals to update UI (currentMapPathChanged, uiChanged, sceneChanged)
-        emit weakThis->currentMapPathChanged(filePath);
-        emit weakThis->uiChanged();
-        emit weakThis->sceneChanged();
+void TabsController::restoreAfterPreview()
+{
+    if (!m_previewShown) {
+        return;
+    }
+    m_previewShown = false;
 
-        emit weakThis->requestAddRecent(filePath);
-        emit weakThis->requestStatus(QStringLiteral("Loaded: %1").arg(fi.fileName()), 5000);
-    });
+    // The new tab never materialized - bring back the tab the preview covered
+    if (m_currentIndex >= 0 && m_currentIndex < m_sessions.size() && m_sessions[m_currentIndex]) {
+        m_sessions[m_currentIndex]->activateSession(m_display);
+    } else {
+        m_display->discardMapPreview();
+    }
+    emit sceneChanged();
 }
 
 void TabsController::onTabChanged(int index)
@@ -200,12 +372,46 @@ void TabsController::switchToTab(int index)
         );
         return;
     }
-    
+
+    // A new tab's preview is covering the current one - abandon that load
+    // first so the current session is live again before it is switched away
+    if (m_previewShown) {
+        m_mapLoader->cancel();
+    }
+
     // If switching to the same tab that's already active, do nothing
     if (index == m_currentIndex) {
+        // Clicking back to the active tab abandons a pending reload of another one
+        if (m_pendingSession) {
+            m_pendingSession = nullptr;
+            m_mapLoader->cancel();
+        }
+        return;
+    }
+
+    // Image was released (or changed on disk): decode in the background and
+    // finish the switch in onMapLoadFinished(). The current tab stays live meanwhile.
+    MapSession* target = m_sessions[index];
+    if (target && target->needsImageLoad()) {
+        if (m_pendingSession == target) {
+            return;  // Already loading
+        }
+        m_pendingSession = target;
+        m_mapLoader->load(target->filePath());
+
+        QFileInfo fi(target->filePath());
+        if (fi.size() > 1024 * 1024) {
+            emit requestShowProgress(fi.fileName(), fi.size());
+        }
         return;
     }
 
+    // A pending reload of another tab is superseded by this switch
+    if (m_pendingSession) {
+        m_pendingSession = nullptr;
+        m_mapLoader->cancel();
+    }
+
     try {
         // Save and deactivate previous session
         if (m_currentIndex >= 0 && m_currentIndex < m_sessions.size()) {
@@ -228,10 +434,18 @@ void TabsController::switchToTab(int index)
         }
 
         next->activateSession(m_display);
+        touchSession(next);
+
+        // Restored tabs start with a plain tooltip (see restoreSessions)
+        if (m_tabBar->tabToolTip(index) == next->filePath()) {
+            setTabTooltipWithThumbnail(index, next->filePath());
+        }
 
         emit currentMapPathChanged(next->filePath());
         emit uiChanged();
         emit sceneChanged();
+
+        rebalanceSessions();
     } catch (const std::exception& e) {
         ErrorHandler::instance().reportError(
             QString("Error switching tabs: %1").arg(e.what()),
@@ -245,9 +459,19 @@ void TabsController::closeTab(int index)
     if (!m_tabBar || !m_display) return;
     if (index < 0 || index >= m_sessions.size()) return;
 
+    if (m_previewShown) {
+        m_mapLoader->cancel();
+    }
+
     MapSession* session = m_sessions[index];
+    if (session == m_pendingSession) {
+        m_pendingSession = nullptr;
+        m_mapLoader->cancel();
+    }
     session->deactivateSession(m_display);
     m_sessions.removeAt(index);
+    m_sessionsByPath.remove(session->filePath());
+    m_recentSessions.removeOne(session);
     m_tabBar->removeTab(index);
     delete session;
 
@@ -267,6 +491,37 @@ void TabsController::closeTab(int index)
     }
 }
 
+void TabsController::touchSession(MapSession* session)
+{
+    m_recentSessions.removeOne(session);
+    m_recentSessions.prepend(session);
+}
+
+void TabsController::rebalanceSessions()
+{
+    // Rank 0 is the active session; a session being reloaded is left alone
+    int demoted = 0;
+    for (int rank = 1; rank < m_recentSessions.size(); ++rank) {
+        MapSession* session = m_recentSessions[rank];
+        if (session == m_pendingSession || session->isActive()) {
+            continue;
+        }
+
+        const MapSession::Tier target = rank <= HOT_SESSIONS ? MapSession::Tier::Hot
+            : rank <= HOT_SESSIONS + WARM_SESSIONS ? MapSession::Tier::Warm
+            : MapSession::Tier::Cold;
+        if (target > session->tier()) {
+            session->demote(target);
+            ++demoted;
+        }
+    }
+
+    if (demoted > 0) {
+        DebugConsole::performance(QString("Demoted %1 of %2 sessions (hot %3, warm %4)")
+            .arg(demoted).arg(m_sessions.size()).arg(HOT_SESSIONS).arg(WARM_SESSIONS), "Tabs");
+    }
+}
+
 QString TabsController::shortTitle(const QString& filePath) const
 {
     QFileInfo info(filePath);
@@ -315,6 +570,25 @@ void TabsController::setTabTooltipWithThumbnail(int tabIndex, const QString& fil
     m_tabBar->setTabToolTip(tabIndex, tooltipHtml);
 }
 
+QStringList TabsController::releasedNeighbourPaths() const
+{
+    QStringList paths;
+    for (int distance = 1; distance < m_sessions.size() && paths.size() < PREFETCH_NEIGHBOURS; ++distance) {
+        for (int index : { m_currentIndex + distance, m_currentIndex - distance }) {
+            if (index >= 0 && index < m_sessions.size() && m_sessions[index] &&
+                m_sessions[index] != m_pendingSession && m_sessions[index]->needsImageLoad()) {
+                paths.append(m_sessions[index]->filePath());
+            }
+        }
+    }
+    return paths;
+}
+
+bool TabsController::isOpen(const QString& filePath) const
+{
+    return m_sessionsByPath.contains(filePath);
+}
+
 MapSession* TabsController::getCurrentSession() const
 {
     if (m_currentIndex >= 0 && m_currentIndex < m_sessions.size()) {
@@ -2,8 +2,13 @@
 #define TABSCONTROLLER_H
 
 #include <QObject>
+#include <QHash>
 #include <QList>
 #include <QString>
+#include <QStringList>
+
+#include "utils/MapLoadPipeline.h"
+#include "utils/SessionManifest.h"
 
 class QTabBar;
 class MapDisplay;
@@ -14,15 +19,42 @@ class TabsController : public QObject {
 public:
     explicit TabsController(QObject* parent = nullptr);
 
-    void attach(QTabBar* tabBar, MapDisplay* display, int maxTabs = 10);
+    void attach(QTabBar* tabBar, MapDisplay* display, int maxTabs = DEFAULT_MAX_TABS);
     void loadMapFile(const QString& path);
 
+    // Session restore: every tab of the manifest comes back at once as a
+    // cold session, and only the active one is decoded. The others load on
+    // first activation or through the prefetcher (releasedNeighbourPaths).
+    void restoreSessions(const SessionManifest& manifest);
+    SessionManifest captureManifest();
+
     // Get current map session
     MapSession* getCurrentSession() const;
 
+    // Abandon the map load in flight (loading overlay cancel button)
+    void cancelLoading();
+
+    // Open tabs whose images were released, nearest to the current tab first
+    // (at most PREFETCH_NEIGHBOURS of them)
+    QStringList releasedNeighbourPaths() const;
+    bool isOpen(const QString& filePath) const;
+
+    int sessionCount() const { return m_sessions.size(); }
+    MapSession* sessionAt(int index) const { return m_sessions.value(index, nullptr); }
+
+    // Residency of inactive tabs, by how recently they were active: the
+    // HOT_SESSIONS most recent keep their pixels, the next WARM_SESSIONS are
+    // hibernated to the decoded map cache, the rest are cold (metadata only).
+    // Sessions are promoted on demand when switched to.
+    static constexpr int HOT_SESSIONS = 3;
+    static constexpr int WARM_SESSIONS = 12;
+    static constexpr int PREFETCH_NEIGHBOURS = 4;
+    static constexpr int DEFAULT_MAX_TABS = 500;
+
 signals:
     void requestShowProgress(const QString& fileName, qint64 fileSize);
     void requestHideProgress();
+    void requestProgress(int percentage, const QString& status);
     void requestStatus(const QString& message, int ms);
     void requestAddRecent(const QString& path);
     void currentMapPathChanged(const QString& path);
@@ -35,10 +67,21 @@ public slots:
     void setCurrentIndex(int index) { switchToTab(index); }
     void closeIndex(int index) { closeTab(index); }
 
+private slots:
+    void onMapPreviewReady(const QString& filePath, const QImage& preview, const QSize& mapSize, int gridSize);
+    void onMapLoadFinished(const MapLoadPipeline::Result& result);
+    void onMapLoadFailed(const QString& filePath, const QString& errorMessage);
+    void onMapLoadCancelled(const QString& filePath);
+
 private:
     void createNewTab(const QString& filePath);
+    void addLoadedSession(MapSession* session);
+    void saveAndDeactivateCurrent();
+    void restoreAfterPreview();
     void switchToTab(int index);
     void closeTab(int index);
+    void touchSession(MapSession* session);
+    void rebalanceSessions();
     QString shortTitle(const QString& filePath) const;
     void setTabTooltipWithThumbnail(int tabIndex, const QString& filePath);
 
@@ -46,7 +89,14 @@ private:
     MapDisplay* m_display {nullptr};
     QList<MapSession*> m_sessions;
     int m_currentIndex {-1};
-    int m_maxTabs {10};
+    int m_maxTabs {DEFAULT_MAX_TABS};
+    QHash<QString, MapSession*> m_sessionsByPath;
+    QList<MapSession*> m_recentSessions;  // Most recently active first
+
+    // Background decoding; the scene is built on the GUI thread once a load lands
+    MapLoadPipeline* m_mapLoader {nullptr};
+    MapSession* m_pendingSession {nullptr};  // Session waiting for its image, nullptr = new tab
+    bool m_previewShown {false};  // Display shows a new tab's preview; current session is deactivated
 };
 
 #endif // TABSCONTROLLER_H
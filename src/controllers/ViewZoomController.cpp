@@ -199,9 +199,8 @@ QSpinBox* ViewZoomController::createToolbarActions(QToolBar* toolbar)
 
     // Zoom spinner
     QLabel* zoomLabel = new QLabel("Zoom:", toolbar);
-    zoomLabel->setStyleSheet(QString("color: %1; font-size: %2px; font-weight: 500; padding: 0 4px;")
-        .arg(DarkTheme::hex(DarkTheme::TextPrimary))
-        .arg(DarkTheme::FontBase));
+    DarkTheme::setTextStyle(zoomLabel, DarkTheme::TextPrimary, DarkTheme::FontBase, QFont::Medium);
+    zoomLabel->setContentsMargins(DarkTheme::SpaceTight, 0, DarkTheme::SpaceTight, 0);
     toolbar->addWidget(zoomLabel);
 
     QSpinBox* zoomSpinner = new QSpinBox(toolbar);
@@ -212,7 +211,7 @@ QSpinBox* ViewZoomController::createToolbarActions(QToolBar* toolbar)
     zoomSpinner->setSingleStep(5);
     zoomSpinner->setFixedWidth(85);
     zoomSpinner->setToolTip("<b>Zoom Level</b><br>Adjust map zoom percentage<br>Range: 10-500%");
-    zoomSpinner->setStyleSheet(DarkTheme::spinBoxStyle());
+    DarkTheme::setTextStyle(zoomSpinner, DarkTheme::TextPrimary, DarkTheme::FontBase);
     toolbar->addWidget(zoomSpinner);
 
     return zoomSpinner;
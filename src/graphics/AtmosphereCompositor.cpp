@@ -0,0 +1,201 @@
+#include "AtmosphereCompositor.h"
+#include "graphics/ZLayers.h"
+#include "graphics/PointLightSystem.h"
+#include "graphics/FogMistEffect.h"
+#include "graphics/WeatherEffect.h"
+#include "graphics/LightningEffect.h"
+#include <QPainter>
+#include <QPaintDevice>
+#include <QWidget>
+
+AtmosphereCompositor::AtmosphereCompositor(QGraphicsItem* parent)
+    : QObject(nullptr)
+    , QGraphicsItem(parent)
+{
+    setZValue(ZLayer::AtmosphereComposite);
+}
+
+AtmosphereCompositor::~AtmosphereCompositor()
+{
+    // Adopted effects may already be gone (scene->clear() deletes items in
+    // arbitrary order), so they are intentionally not touched here
+}
+
+QRectF AtmosphereCompositor::boundingRect() const
+{
+    return m_sceneBounds;
+}
+
+void AtmosphereCompositor::setSceneBounds(const QRectF& bounds)
+{
+    if (m_sceneBounds != bounds) {
+        prepareGeometryChange();
+        m_sceneBounds = bounds;
+        m_viewBuffers.clear();
+        update();
+    }
+}
+
+void AtmosphereCompositor::setPointLightSystem(PointLightSystem* system)
+{
+    adoptItem(m_pointLightSystem, system);
+    m_pointLightSystem = system;
+}
+
+void AtmosphereCompositor::setFogMistEffect(FogMistEffect* effect)
+{
+    adoptItem(m_fogMistEffect, effect);
+    m_fogMistEffect = effect;
+}
+
+void AtmosphereCompositor::setWeatherEffect(WeatherEffect* effect)
+{
+    adoptItem(m_weatherEffect, effect);
+    m_weatherEffect = effect;
+}
+
+void AtmosphereCompositor::setLightningEffect(LightningEffect* effect)
+{
+    adoptItem(m_lightningEffect, effect);
+    m_lightningEffect = effect;
+}
+
+void AtmosphereCompositor::releaseEffects()
+{
+    setPointLightSystem(nullptr);
+    setFogMistEffect(nullptr);
+    setWeatherEffect(nullptr);
+    setLightningEffect(nullptr);
+    m_viewBuffers.clear();
+}
+
+void AtmosphereCompositor::adoptItem(QGraphicsItem* previous, QGraphicsItem* next)
+{
+    if (previous == next) {
+        return;
+    }
+
+    // ItemHasNoContents keeps the scene from calling paint() on the effect
+    if (previous) {
+        previous->setFlag(QGraphicsItem::ItemHasNoContents, false);
+        previous->update();
+    }
+    if (next) {
+        next->setFlag(QGraphicsItem::ItemHasNoContents, true);
+    }
+    update();
+}
+
+void AtmosphereCompositor::advanceAnimation(qreal /*dt*/)
+{
+    // New frame: every view re-renders its buffer on its next paint
+    ++m_frameSerial;
+
+    // Drop buffers of views that no longer paint (closed player window)
+    for (auto it = m_viewBuffers.begin(); it != m_viewBuffers.end();) {
+        if (m_frameSerial - it->frame > STALE_BUFFER_FRAMES) {
+            it = m_viewBuffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool AtmosphereCompositor::hasActiveBufferedEffects() const
+{
+    if (m_fogMistEffect && m_fogMistEffect->isEnabled() &&
+        m_fogMistEffect->getDensity() > 0.0 && m_fogMistEffect->getHeight() > 0.0) {
+        return true;
+    }
+    if (m_weatherEffect && m_weatherEffect->isEnabled() &&
+        m_weatherEffect->getWeatherType() != WeatherType::None &&
+        m_weatherEffect->getIntensity() > 0.0) {
+        return true;
+    }
+    if (m_lightningEffect && m_lightningEffect->isEnabled() && m_lightningEffect->isStriking()) {
+        return true;
+    }
+    return false;
+}
+
+void AtmosphereCompositor::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                                 QWidget* widget)
+{
+    // 1. Point lights (Z 35): additive blend needs the map as backdrop
+    if (m_pointLightSystem && m_pointLightSystem->isVisible() && m_pointLightSystem->isEnabled()) {
+        m_pointLightSystem->paint(painter, option, widget);
+    }
+
+    // 2. Mist (Z 40), weather (Z 50), lightning (Z 70) through one buffer
+    if (m_sceneBounds.isValid() && hasActiveBufferedEffects()) {
+        paintBufferedEffects(painter, option, widget);
+    }
+
+    // The lighting tint (Z 600) paints itself, above the tool previews
+}
+
+void AtmosphereCompositor::paintBufferedEffects(QPainter* painter,
+                                                const QStyleOptionGraphicsItem* option,
+                                                QWidget* widget)
+{
+    QPaintDevice* device = painter->device();
+    if (!device) {
+        return;
+    }
+
+    // Buffer covers the visible part of the effects at view resolution
+    const QTransform transform = painter->worldTransform();
+    const QRect deviceBounds(0, 0, device->width(), device->height());
+    const QRect deviceRect = transform.mapRect(m_sceneBounds).toAlignedRect() & deviceBounds;
+    if (deviceRect.isEmpty()) {
+        return;
+    }
+
+    // Partial repaints within the same frame (fog brush, tool previews) reuse the buffer.
+    // Offscreen renders (no widget) always re-render.
+    ViewBuffer& buffer = m_viewBuffers[widget];
+    if (!widget || buffer.frame != m_frameSerial ||
+        buffer.transform != transform || buffer.deviceRect != deviceRect) {
+        renderBuffer(buffer, transform, deviceRect, device->devicePixelRatio(),
+                     painter->renderHints(), option, widget);
+    }
+
+    painter->save();
+    painter->resetTransform();
+    painter->drawImage(deviceRect.topLeft(), buffer.image);
+    painter->restore();
+}
+
+void AtmosphereCompositor::renderBuffer(ViewBuffer& buffer, const QTransform& transform,
+                                        const QRect& deviceRect, qreal devicePixelRatio,
+                                        QPainter::RenderHints hints,
+                                        const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    const QSize pixelSize = deviceRect.size() * devicePixelRatio;
+    if (buffer.image.size() != pixelSize) {
+        buffer.image = QImage(pixelSize, QImage::Format_ARGB32_Premultiplied);
+    }
+    buffer.image.setDevicePixelRatio(devicePixelRatio);
+    buffer.image.fill(Qt::transparent);
+
+    QPainter bufferPainter(&buffer.image);
+    bufferPainter.setRenderHints(hints);
+    bufferPainter.setTransform(transform * QTransform::fromTranslate(-deviceRect.x(), -deviceRect.y()));
+
+    // Fixed order matches the old per-item Z values; each effect returns early when idle
+    if (m_fogMistEffect) {
+        m_fogMistEffect->paint(&bufferPainter, option, widget);
+    }
+    if (m_weatherEffect) {
+        m_weatherEffect->paint(&bufferPainter, option, widget);
+    }
+    if (m_lightningEffect) {
+        m_lightningEffect->paint(&bufferPainter, option, widget);
+    }
+
+    bufferPainter.end();
+
+    buffer.transform = transform;
+    buffer.deviceRect = deviceRect;
+    buffer.frame = m_frameSerial;
+}
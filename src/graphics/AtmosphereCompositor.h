@@ -0,0 +1,89 @@
+#ifndef ATMOSPHERECOMPOSITOR_H
+#define ATMOSPHERECOMPOSITOR_H
+
+#include <QGraphicsItem>
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QPainter>
+#include <QTransform>
+
+class PointLightSystem;
+class FogMistEffect;
+class WeatherEffect;
+class LightningEffect;
+
+// Single scene item that paints the atmosphere overlays between the beacons
+// and the tool previews (point lights, mist, weather, lightning) in a fixed
+// order. Adopted effects get ItemHasNoContents so the scene stops painting
+// them; the compositor calls their paint() itself, and only for active effects.
+//
+// Source-over effects (mist, weather, lightning) are rasterized into one
+// device-resolution buffer per view per animation frame and blitted once.
+// Point lights (additive) depend on the map underneath, so they are painted
+// directly before that blit. The lighting tint is not adopted: it stays its
+// own item at ZLayer::LightingOverlay, above the tool previews.
+// Z-value: 35 (takes the PointLights slot, below fog mist)
+class AtmosphereCompositor : public QObject, public QGraphicsItem
+{
+    Q_OBJECT
+    Q_INTERFACES(QGraphicsItem)
+
+public:
+    explicit AtmosphereCompositor(QGraphicsItem* parent = nullptr);
+    ~AtmosphereCompositor() override;
+
+    // QGraphicsItem interface
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+    // Scene bounds - area covered by the buffered effects
+    void setSceneBounds(const QRectF& bounds);
+    QRectF getSceneBounds() const { return m_sceneBounds; }
+
+    // Effects painted by the compositor (pass nullptr to release one)
+    void setPointLightSystem(PointLightSystem* system);
+    void setFogMistEffect(FogMistEffect* effect);
+    void setWeatherEffect(WeatherEffect* effect);
+    void setLightningEffect(LightningEffect* effect);
+
+    // Hand all adopted effects back to the scene
+    void releaseEffects();
+
+public slots:
+    void advanceAnimation(qreal dt);
+
+private:
+    struct ViewBuffer {
+        QImage image;
+        QRect deviceRect;      // Where the buffer lands on the view
+        QTransform transform;  // Item-to-device transform it was rendered with
+        quint64 frame = 0;
+    };
+
+    void adoptItem(QGraphicsItem* previous, QGraphicsItem* next);
+    bool hasActiveBufferedEffects() const;
+    void paintBufferedEffects(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                              QWidget* widget);
+    void renderBuffer(ViewBuffer& buffer, const QTransform& transform, const QRect& deviceRect,
+                      qreal devicePixelRatio, QPainter::RenderHints hints,
+                      const QStyleOptionGraphicsItem* option, QWidget* widget);
+
+    QRectF m_sceneBounds;
+
+    // Adopted effects (owned by the scene)
+    PointLightSystem* m_pointLightSystem = nullptr;
+    FogMistEffect* m_fogMistEffect = nullptr;
+    WeatherEffect* m_weatherEffect = nullptr;
+    LightningEffect* m_lightningEffect = nullptr;
+
+    // One buffer per view (the DM view and the player view share the scene)
+    QHash<const QWidget*, ViewBuffer> m_viewBuffers;
+    quint64 m_frameSerial = 1;
+
+    // Buffers of views that stopped painting are dropped after this many frames
+    static constexpr quint64 STALE_BUFFER_FRAMES = 60;
+};
+
+#endif // ATMOSPHERECOMPOSITOR_H
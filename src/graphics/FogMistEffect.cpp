@@ -1,10 +1,19 @@
 #include "FogMistEffect.h"
 #include "graphics/ZLayers.h"
+#include "graphics/ImageCache.h"
 #include <QPainter>
 #include <QDateTime>
 #include <QRandomGenerator>
 #include <QtMath>
 #include <QLinearGradient>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <algorithm>
 #include "utils/DebugConsole.h"
 
 FogMistEffect::FogMistEffect(QGraphicsItem* parent)
@@ -21,12 +30,11 @@ FogMistEffect::FogMistEffect(QGraphicsItem* parent)
     , m_hasTexture(false)
     , m_textureScale(1.0)
     , m_textureTwist(0.3)
-    , m_transitionTimer(new QTimer(this))
     , m_startDensity(0.0)
     , m_targetDensity(0.0)
     , m_startHeight(0.3)
     , m_targetHeight(0.3)
-    , m_transitionStartTime(0)
+    , m_transitionElapsed(0.0)
     , m_transitionDuration(1000)
     , m_isTransitioning(false)
 {
@@ -38,9 +46,6 @@ FogMistEffect::FogMistEffect(QGraphicsItem* parent)
     // Setup animation timer
     connect(m_animationTimer, &QTimer::timeout, this, &FogMistEffect::onAnimationTick);
 
-    // Setup transition timer
-    connect(m_transitionTimer, &QTimer::timeout, this, &FogMistEffect::onTransitionTick);
-
     // Initialize last animation time
     m_lastAnimationTime = QDateTime::currentMSecsSinceEpoch();
 }
@@ -50,9 +55,6 @@ FogMistEffect::~FogMistEffect()
     if (m_animationTimer->isActive()) {
         m_animationTimer->stop();
     }
-    if (m_transitionTimer->isActive()) {
-        m_transitionTimer->stop();
-    }
 }
 
 QRectF FogMistEffect::boundingRect() const
@@ -74,9 +76,12 @@ void FogMistEffect::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*o
         return;
     }
 
-    // Fast path: use pre-rendered frame from advanceAnimation()
+    // Fast path: upscale pre-rendered low-resolution frame from advanceAnimation()
     if (m_frameValid && !m_renderedFrame.isNull()) {
-        painter->drawPixmap(m_sceneBounds.topLeft(), m_renderedFrame);
+        painter->save();
+        painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+        painter->drawPixmap(m_sceneBounds, m_renderedFrame, QRectF(m_renderedFrame.rect()));
+        painter->restore();
         return;
     }
 
@@ -268,16 +273,15 @@ void FogMistEffect::transitionTo(qreal density, qreal height, const QColor& colo
     m_targetHeight = height;
     m_startColor = m_color;
     m_targetColor = color;
-    m_transitionDuration = durationMs;
-    m_transitionStartTime = QDateTime::currentMSecsSinceEpoch();
+    m_transitionDuration = qMax(1, durationMs);
+    m_transitionElapsed = 0.0;
     m_isTransitioning = true;
 
     // Enable if transitioning to non-zero density
     if (!m_enabled && density > 0.0) {
         setEnabled(true);
     }
-
-    m_transitionTimer->start(TRANSITION_INTERVAL_MS);
+    // Progress is advanced from advanceAnimation() on the shared scene tick
 }
 
 void FogMistEffect::renderFrame()
@@ -287,11 +291,12 @@ void FogMistEffect::renderFrame()
         return;
     }
 
-    QSize targetSize = m_sceneBounds.size().toSize();
-    if (targetSize.isEmpty()) {
-        m_frameValid = false;
-        return;
-    }
+    // Cap the frame's long edge - a 16k map would otherwise need a 16k pixmap
+    qreal longEdge = qMax(m_sceneBounds.width(), m_sceneBounds.height());
+    m_frameScale = qMin(1.0, MAX_FRAME_DIMENSION / longEdge);
+
+    QSize targetSize(qMax(1, qRound(m_sceneBounds.width() * m_frameScale)),
+                     qMax(1, qRound(m_sceneBounds.height() * m_frameScale)));
 
     if (m_renderedFrame.size() != targetSize) {
         m_renderedFrame = QPixmap(targetSize);
@@ -300,12 +305,12 @@ void FogMistEffect::renderFrame()
 
     QPainter painter(&m_renderedFrame);
     painter.setRenderHint(QPainter::Antialiasing, false);
-    painter.translate(-m_sceneBounds.topLeft());
 
-    // Reuse existing paint logic (call the original drawing code)
+    // Draw in frame pixel space: layout is relative to fogRect, absolute
+    // sizes are multiplied by m_frameScale
     painter.setPen(Qt::NoPen);
-    QRectF fogRect = m_sceneBounds;
-    qreal scale = m_sceneScale;
+    QRectF fogRect(QPointF(0, 0), QSizeF(targetSize));
+    qreal scale = m_sceneScale * m_frameScale;
     qreal baseCloudUnit = 100.0 * scale;
     int baseAlpha = static_cast<int>(qBound(0, static_cast<int>(180 * m_density * m_height), 255));
 
@@ -316,27 +321,34 @@ void FogMistEffect::renderFrame()
 
     // Layer 2: clouds (simplified — just draw the gradients)
     const int bigCloudCount = 4 + static_cast<int>(m_density * 2);
-    for (int i = 0; i < bigCloudCount; ++i) {
-        qreal phase = m_animationOffset * 0.005 + i * 1.618;
-        qreal driftX = qSin(phase) * fogRect.width() * 0.25;
-        qreal driftY = qCos(phase * 0.7) * fogRect.height() * 0.25;
-        qreal cloudX = fogRect.center().x() + driftX;
-        qreal cloudY = fogRect.center().y() + driftY;
-        qreal cloudRadius = baseCloudUnit * (12.0 + 4.0 * m_density);
-
-        QRadialGradient gradient(QPointF(cloudX, cloudY), cloudRadius);
+    const qreal cloudRadius = baseCloudUnit * (12.0 + 4.0 * m_density);
+    if (m_cloudBrushColor != m_color || m_cloudBrushAlpha != baseAlpha ||
+        !qFuzzyCompare(m_cloudBrushRadius, cloudRadius)) {
+        QRadialGradient gradient(QPointF(0, 0), cloudRadius);
         QColor cloudColor = m_color;
         cloudColor.setAlpha(baseAlpha / 2);
         gradient.setColorAt(0, cloudColor);
         cloudColor.setAlpha(0);
         gradient.setColorAt(1.0, cloudColor);
-        painter.setBrush(QBrush(gradient));
-        painter.drawEllipse(QPointF(cloudX, cloudY), cloudRadius, cloudRadius);
+        m_cloudBrush = QBrush(gradient);
+        m_cloudBrushColor = m_color;
+        m_cloudBrushAlpha = baseAlpha;
+        m_cloudBrushRadius = cloudRadius;
     }
+    painter.setBrush(m_cloudBrush);
+    for (int i = 0; i < bigCloudCount; ++i) {
+        qreal phase = m_animationOffset * 0.005 + i * 1.618;
+        qreal driftX = qSin(phase) * fogRect.width() * 0.25;
+        qreal driftY = qCos(phase * 0.7) * fogRect.height() * 0.25;
+        painter.setTransform(QTransform::fromTranslate(fogRect.center().x() + driftX,
+                                                       fogRect.center().y() + driftY));
+        painter.drawEllipse(QPointF(0, 0), cloudRadius, cloudRadius);
+    }
+    painter.resetTransform();
 
     // Layer 3: texture (if available and density warrants it)
     if (m_hasTexture && m_density >= 0.3) {
-        paintTextureLayer(&painter, fogRect, baseAlpha);
+        paintTextureLayer(&painter, fogRect, baseAlpha, m_frameScale);
     }
 
     painter.end();
@@ -345,6 +357,10 @@ void FogMistEffect::renderFrame()
 
 void FogMistEffect::advanceAnimation(qreal dt)
 {
+    if (m_isTransitioning) {
+        advanceTransition(dt);
+    }
+
     if (!m_enabled) {
         return;
     }
@@ -382,16 +398,10 @@ void FogMistEffect::onAnimationTick()
     update();
 }
 
-void FogMistEffect::onTransitionTick()
+void FogMistEffect::advanceTransition(qreal dt)
 {
-    if (!m_isTransitioning) {
-        m_transitionTimer->stop();
-        return;
-    }
-
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 elapsed = currentTime - m_transitionStartTime;
-    qreal progress = qBound(0.0, static_cast<qreal>(elapsed) / m_transitionDuration, 1.0);
+    m_transitionElapsed += dt;
+    qreal progress = qBound(0.0, m_transitionElapsed * 1000.0 / m_transitionDuration, 1.0);
 
     // Smooth easing (ease-in-out)
     qreal easedProgress = 0.5 - 0.5 * qCos(progress * M_PI);
@@ -409,7 +419,6 @@ void FogMistEffect::onTransitionTick()
 
     if (progress >= 1.0) {
         m_isTransitioning = false;
-        m_transitionTimer->stop();
         m_density = m_targetDensity;
         m_height = m_targetHeight;
         m_color = m_targetColor;
@@ -432,90 +441,177 @@ void FogMistEffect::onTransitionTick()
 
 void FogMistEffect::generateNoiseTexture()
 {
-    // Generate a smooth Perlin-like noise texture for organic fog movement
-    m_noiseTexture = QImage(NOISE_SIZE, NOISE_SIZE, QImage::Format_ARGB32);
-    m_noiseTexture.fill(Qt::transparent);
-
-    // Generate base noise with larger scale for smoother appearance
-    for (int y = 0; y < NOISE_SIZE; ++y) {
-        for (int x = 0; x < NOISE_SIZE; ++x) {
-            // Use multiple octaves for more natural noise
-            qreal noise = 0.0;
-            qreal amplitude = 1.0;
-            qreal frequency = 0.5;  // Start with lower frequency for larger features
-
-            for (int octave = 0; octave < 3; ++octave) {  // Fewer octaves = smoother
-                // Simple value noise (pseudo-random based on position)
-                int sampleX = static_cast<int>(x * frequency) % NOISE_SIZE;
-                int sampleY = static_cast<int>(y * frequency) % NOISE_SIZE;
-
-                // Use a seeded random value based on position
-                uint seed = static_cast<uint>(sampleX * 374761393 + sampleY * 668265263);
-                qreal value = (seed % 1000) / 1000.0;
-
-                noise += value * amplitude;
-                amplitude *= 0.5;
-                frequency *= 2.0;
-            }
+    // Process-wide copy: the texture only depends on compile-time parameters,
+    // so every FogMistEffect (DM view, player view) shares one instance
+    static QImage s_sharedNoise;
+    if (!s_sharedNoise.isNull()) {
+        m_noiseTexture = s_sharedNoise;
+        return;
+    }
 
-            // Normalize and apply to alpha channel
-            int alpha = static_cast<int>(qBound(0.0, noise * 0.6, 1.0) * 255);
-            m_noiseTexture.setPixelColor(x, y, QColor(255, 255, 255, alpha));
-        }
+    // Disk cache keyed by every parameter that affects the output
+    const QString cacheKey = QString("noise_v%1_s%2_o%3_f%4_b%5x%6")
+        .arg(NOISE_CACHE_VERSION)
+        .arg(NOISE_SIZE)
+        .arg(NOISE_OCTAVES)
+        .arg(NOISE_BASE_FREQUENCY, 0, 'f', 2)
+        .arg(NOISE_BLUR_PASSES)
+        .arg(NOISE_BLUR_RADIUS);
+    const QString cacheDir =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/mist";
+    const QString cachePath = cacheDir + "/" + cacheKey + ".png";
+
+    QImage cached;
+    if (QFile::exists(cachePath) && cached.load(cachePath) &&
+        cached.size() == QSize(NOISE_SIZE, NOISE_SIZE)) {
+        s_sharedNoise = cached.convertToFormat(QImage::Format_ARGB32);
+        m_noiseTexture = s_sharedNoise;
+        DebugConsole::info(
+            QString("FogMistEffect: Loaded cached noise texture %1").arg(cacheKey),
+            "Atmosphere");
+        return;
     }
 
-    // Apply multiple passes of Gaussian blur for very smooth noise
-    // This eliminates blockiness and creates smooth gradients
-    for (int pass = 0; pass < 3; ++pass) {
-        QImage blurred(NOISE_SIZE, NOISE_SIZE, QImage::Format_ARGB32);
-        blurred.fill(Qt::transparent);
+    QElapsedTimer timer;
+    timer.start();
 
-        // 5x5 Gaussian kernel approximation
-        const int radius = 2;
+    // Work on a raw alpha buffer instead of setPixelColor()/pixelColor()
+    const int size = NOISE_SIZE;
+    QVector<int> alpha(size * size);
+    QVector<int> scratch(size * size, 0);
 
-        for (int y = radius; y < NOISE_SIZE - radius; ++y) {
-            for (int x = radius; x < NOISE_SIZE - radius; ++x) {
-                int sum = 0;
-                int count = 0;
-
-                // Sample in a circular pattern with distance weighting
-                for (int dy = -radius; dy <= radius; ++dy) {
-                    for (int dx = -radius; dx <= radius; ++dx) {
-                        // Weight by distance from center (approximate Gaussian)
-                        int weight = (radius + 1) - qMax(qAbs(dx), qAbs(dy));
-                        sum += m_noiseTexture.pixelColor(x + dx, y + dy).alpha() * weight;
-                        count += weight;
-                    }
+    // Generate base noise (multiple octaves of value noise) in parallel row bands
+    auto generateRows = [&alpha, size](int rowBegin, int rowEnd) {
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            int* row = alpha.data() + y * size;
+            for (int x = 0; x < size; ++x) {
+                qreal noise = 0.0;
+                qreal amplitude = 1.0;
+                qreal frequency = NOISE_BASE_FREQUENCY;  // Lower frequency for larger features
+
+                for (int octave = 0; octave < NOISE_OCTAVES; ++octave) {
+                    // Simple value noise (pseudo-random based on position)
+                    int sampleX = static_cast<int>(x * frequency) % size;
+                    int sampleY = static_cast<int>(y * frequency) % size;
+
+                    uint seed = static_cast<uint>(sampleX * 374761393 + sampleY * 668265263);
+                    qreal value = (seed % 1000) / 1000.0;
+
+                    noise += value * amplitude;
+                    amplitude *= 0.5;
+                    frequency *= 2.0;
                 }
 
-                int avgAlpha = sum / count;
-                blurred.setPixelColor(x, y, QColor(255, 255, 255, avgAlpha));
+                row[x] = static_cast<int>(qBound(0.0, noise * 0.6, 1.0) * 255);
+            }
+        }
+    };
+
+    // Private pool: the global one carries pyramid builds and cache writes
+    // that can run for seconds, and this wait is on the GUI thread
+    const int bandCount = qBound(1, QThread::idealThreadCount(), 16);
+    const int bandHeight = (size + bandCount - 1) / bandCount;
+    QThreadPool pool;
+    pool.setMaxThreadCount(bandCount);
+    for (int band = 0; band < bandCount; ++band) {
+        int rowBegin = band * bandHeight;
+        int rowEnd = qMin(size, rowBegin + bandHeight);
+        if (rowBegin >= rowEnd) {
+            break;
+        }
+        pool.start([&generateRows, rowBegin, rowEnd]() {
+            generateRows(rowBegin, rowEnd);
+        });
+    }
+    pool.waitForDone();
+
+    // Separable tent blur (weights 1..r+1..1), horizontal then vertical on scanlines.
+    // O(r) per pixel instead of O(r^2); border pixels fade to transparent as before.
+    const int radius = NOISE_BLUR_RADIUS;
+    int kernel[2 * NOISE_BLUR_RADIUS + 1];
+    int kernelSum = 0;
+    for (int k = -radius; k <= radius; ++k) {
+        kernel[k + radius] = (radius + 1) - qAbs(k);
+        kernelSum += kernel[k + radius];
+    }
+
+    for (int pass = 0; pass < NOISE_BLUR_PASSES; ++pass) {
+        // Horizontal: alpha -> scratch
+        for (int y = 0; y < size; ++y) {
+            const int* src = alpha.constData() + y * size;
+            int* dst = scratch.data() + y * size;
+            for (int x = 0; x < radius; ++x) {
+                dst[x] = 0;
+                dst[size - 1 - x] = 0;
+            }
+            for (int x = radius; x < size - radius; ++x) {
+                int sum = 0;
+                for (int k = -radius; k <= radius; ++k) {
+                    sum += src[x + k] * kernel[k + radius];
+                }
+                dst[x] = sum / kernelSum;
             }
         }
 
-        m_noiseTexture = blurred;
+        // Vertical: scratch -> alpha, one output row at a time
+        for (int y = 0; y < radius; ++y) {
+            std::fill_n(alpha.data() + y * size, size, 0);
+            std::fill_n(alpha.data() + (size - 1 - y) * size, size, 0);
+        }
+        for (int y = radius; y < size - radius; ++y) {
+            int* dst = alpha.data() + y * size;
+            std::fill_n(dst, size, 0);
+            for (int k = -radius; k <= radius; ++k) {
+                const int* src = scratch.constData() + (y + k) * size;
+                const int weight = kernel[k + radius];
+                for (int x = 0; x < size; ++x) {
+                    dst[x] += src[x] * weight;
+                }
+            }
+            for (int x = 0; x < size; ++x) {
+                dst[x] /= kernelSum;
+            }
+        }
     }
 
     // Make the noise tileable by blending edges
-    const int blendSize = NOISE_SIZE / 8;
-    for (int y = 0; y < NOISE_SIZE; ++y) {
+    const int blendSize = size / 8;
+    for (int y = 0; y < size; ++y) {
+        int* row = alpha.data() + y * size;
         for (int x = 0; x < blendSize; ++x) {
             qreal blend = static_cast<qreal>(x) / blendSize;
-            int leftAlpha = m_noiseTexture.pixelColor(x, y).alpha();
-            int rightAlpha = m_noiseTexture.pixelColor(NOISE_SIZE - blendSize + x, y).alpha();
-            int blendedAlpha = static_cast<int>(leftAlpha * blend + rightAlpha * (1.0 - blend));
-            m_noiseTexture.setPixelColor(x, y, QColor(255, 255, 255, blendedAlpha));
+            row[x] = static_cast<int>(row[x] * blend + row[size - blendSize + x] * (1.0 - blend));
         }
     }
-    for (int x = 0; x < NOISE_SIZE; ++x) {
-        for (int y = 0; y < blendSize; ++y) {
-            qreal blend = static_cast<qreal>(y) / blendSize;
-            int topAlpha = m_noiseTexture.pixelColor(x, y).alpha();
-            int bottomAlpha = m_noiseTexture.pixelColor(x, NOISE_SIZE - blendSize + y).alpha();
-            int blendedAlpha = static_cast<int>(topAlpha * blend + bottomAlpha * (1.0 - blend));
-            m_noiseTexture.setPixelColor(x, y, QColor(255, 255, 255, blendedAlpha));
+    for (int y = 0; y < blendSize; ++y) {
+        qreal blend = static_cast<qreal>(y) / blendSize;
+        int* top = alpha.data() + y * size;
+        const int* bottom = alpha.constData() + (size - blendSize + y) * size;
+        for (int x = 0; x < size; ++x) {
+            top[x] = static_cast<int>(top[x] * blend + bottom[x] * (1.0 - blend));
         }
     }
+
+    // Write white pixels with the computed alpha straight into the scanlines
+    m_noiseTexture = QImage(size, size, QImage::Format_ARGB32);
+    for (int y = 0; y < size; ++y) {
+        QRgb* scanLine = reinterpret_cast<QRgb*>(m_noiseTexture.scanLine(y));
+        const int* row = alpha.constData() + y * size;
+        for (int x = 0; x < size; ++x) {
+            scanLine[x] = qRgba(255, 255, 255, row[x]);
+        }
+    }
+    s_sharedNoise = m_noiseTexture;
+
+    DebugConsole::info(
+        QString("FogMistEffect: Generated noise texture in %1 ms").arg(timer.elapsed()),
+        "Atmosphere");
+
+    if (QDir().mkpath(cacheDir) && !m_noiseTexture.save(cachePath, "PNG")) {
+        DebugConsole::warning(
+            QString("FogMistEffect: Failed to write noise cache %1").arg(cachePath),
+            "Atmosphere");
+    }
 }
 
 void FogMistEffect::updateFogGradient()
@@ -534,6 +630,7 @@ bool FogMistEffect::loadFogTexture(const QString& filePath)
     }
 
     m_fogTexture = texture;
+    m_texturePath = filePath;
     m_hasTexture = true;
     m_lastTintColor = QColor();  // Reset tint to force re-tint
 
@@ -551,6 +648,7 @@ bool FogMistEffect::loadFogTexture(const QString& filePath)
 void FogMistEffect::clearFogTexture()
 {
     m_fogTexture = QPixmap();
+    m_texturePath.clear();
     m_tintedTexture = QPixmap();
     m_hasTexture = false;
 
@@ -582,7 +680,8 @@ void FogMistEffect::setTextureTwist(qreal twist)
     update();
 }
 
-void FogMistEffect::paintTextureLayer(QPainter* painter, const QRectF& fogRect, int baseAlpha)
+void FogMistEffect::paintTextureLayer(QPainter* painter, const QRectF& fogRect, int baseAlpha,
+                                      qreal unitScale)
 {
     if (!m_hasTexture || m_fogTexture.isNull()) {
         return;
@@ -591,31 +690,46 @@ void FogMistEffect::paintTextureLayer(QPainter* painter, const QRectF& fogRect,
     // Re-tint texture if color changed (and invalidate scaled cache)
     bool textureChanged = false;
     if (m_lastTintColor != m_color) {
-        // Create tinted version of texture
-        QImage tintedImg = m_fogTexture.toImage().convertToFormat(QImage::Format_ARGB32);
-
-        for (int y = 0; y < tintedImg.height(); ++y) {
-            QRgb* scanLine = reinterpret_cast<QRgb*>(tintedImg.scanLine(y));
-            for (int x = 0; x < tintedImg.width(); ++x) {
-                QRgb pixel = scanLine[x];
-                int alpha = qAlpha(pixel);
-                if (alpha > 0) {
-                    // Blend original grayscale with tint color
-                    int gray = qGray(pixel);
-                    int r = (m_color.red() * gray) / 255;
-                    int g = (m_color.green() * gray) / 255;
-                    int b = (m_color.blue() * gray) / 255;
-                    scanLine[x] = qRgba(r, g, b, alpha);
+        // Tinted textures are shared: the player view, other tabs and colour
+        // transitions returning to a preset all reuse the same renders
+        ImageCacheKey key;
+        key.imagePath = QStringLiteral("mist-tint:") + m_texturePath;
+        key.targetSize = m_fogTexture.size();
+        key.variant = m_color.rgba();
+
+        ImageCache& cache = ImageCacheManager::instance();
+        m_tintedTexture = cache.getCachedPixmap(key);
+        if (m_tintedTexture.isNull()) {
+            // Create tinted version of texture
+            QImage tintedImg = m_fogTexture.toImage().convertToFormat(QImage::Format_ARGB32);
+
+            for (int y = 0; y < tintedImg.height(); ++y) {
+                QRgb* scanLine = reinterpret_cast<QRgb*>(tintedImg.scanLine(y));
+                for (int x = 0; x < tintedImg.width(); ++x) {
+                    QRgb pixel = scanLine[x];
+                    int alpha = qAlpha(pixel);
+                    if (alpha > 0) {
+                        // Blend original grayscale with tint color
+                        int gray = qGray(pixel);
+                        int r = (m_color.red() * gray) / 255;
+                        int g = (m_color.green() * gray) / 255;
+                        int b = (m_color.blue() * gray) / 255;
+                        scanLine[x] = qRgba(r, g, b, alpha);
+                    }
                 }
             }
-        }
 
-        m_tintedTexture = QPixmap::fromImage(tintedImg);
+            m_tintedTexture = QPixmap::fromImage(tintedImg);
+            // Colours passed through mid-transition are never seen again
+            if (!m_isTransitioning) {
+                cache.setCachedPixmap(key, m_tintedTexture);
+            }
+            DebugConsole::info(
+                QString("FogMistEffect: Tinted texture to color %1").arg(m_color.name()),
+                "Atmosphere");
+        }
         m_lastTintColor = m_color;
         textureChanged = true;  // Invalidate scaled texture cache
-        DebugConsole::info(
-            QString("FogMistEffect: Tinted texture to color %1").arg(m_color.name()),
-            "Atmosphere");
     }
 
     const QPixmap& texToUse = m_tintedTexture.isNull() ? m_fogTexture : m_tintedTexture;
@@ -660,8 +774,8 @@ void FogMistEffect::paintTextureLayer(QPainter* painter, const QRectF& fogRect,
 
         // Maintain aspect ratio
         qreal aspectRatio = static_cast<qreal>(texToUse.height()) / texToUse.width();
-        int tileWidth = static_cast<int>(tileSize);
-        int tileHeight = static_cast<int>(tileSize * aspectRatio);
+        int tileWidth = qMax(1, static_cast<int>(tileSize));
+        int tileHeight = qMax(1, static_cast<int>(tileSize * aspectRatio));
 
         // OPTIMIZATION: Cache scaled textures - only rescale if size changed or texture changed
         QSize targetSize(tileWidth, tileHeight);
@@ -675,9 +789,9 @@ void FogMistEffect::paintTextureLayer(QPainter* painter, const QRectF& fogRect,
             m_cachedTileSizes[layer] = targetSize;
         }
 
-        // Calculate scroll offset with layer-specific speeds
-        qreal scrollX = m_animationOffset * L.scrollSpeedX;
-        qreal scrollY = m_animationOffset * L.scrollSpeedY;
+        // Calculate scroll offset with layer-specific speeds (scene units -> fogRect units)
+        qreal scrollX = m_animationOffset * L.scrollSpeedX * unitScale;
+        qreal scrollY = m_animationOffset * L.scrollSpeedY * unitScale;
 
         // Add some sinusoidal undulation to the scroll for organic movement
         scrollX += qSin(m_animationOffset * 0.002 + L.phaseOffset) * fogRect.width() * 0.05;
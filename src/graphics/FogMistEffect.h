@@ -6,6 +6,7 @@
 #include <QColor>
 #include <QImage>
 #include <QPixmap>
+#include <QBrush>
 
 // Animated fog/mist overlay effect
 // Z-value: 40 (per CLAUDE.md: 40-99 reserved for atmosphere overlays)
@@ -65,12 +66,13 @@ signals:
 
 private slots:
     void onAnimationTick();
-    void onTransitionTick();
 
 private:
     void generateNoiseTexture();
     void updateFogGradient();
-    void paintTextureLayer(QPainter* painter, const QRectF& fogRect, int baseAlpha);
+    void advanceTransition(qreal dt);
+    void paintTextureLayer(QPainter* painter, const QRectF& fogRect, int baseAlpha,
+                           qreal unitScale = 1.0);
 
     // Fog state
     qreal m_density;        // 0.0 to 1.0
@@ -91,14 +93,31 @@ private:
     // Noise texture for organic fog movement
     QImage m_noiseTexture;
     static constexpr int NOISE_SIZE = 512;  // Larger for smoother appearance on big maps
+    static constexpr int NOISE_OCTAVES = 3;  // Fewer octaves = smoother
+    static constexpr double NOISE_BASE_FREQUENCY = 0.5;
+    static constexpr int NOISE_BLUR_PASSES = 3;
+    static constexpr int NOISE_BLUR_RADIUS = 2;
+    static constexpr int NOISE_CACHE_VERSION = 1;  // Bump when the generator changes
 
     // Pre-rendered fog frame (avoids expensive rendering in paint())
+    // Mist is low-frequency content, so the frame is rendered at a capped
+    // resolution and upscaled with smooth filtering in paint().
     QPixmap m_renderedFrame;
     bool m_frameValid = false;
+    qreal m_frameScale = 1.0;  // Frame pixels per scene unit (<= 1.0)
+    static constexpr int MAX_FRAME_DIMENSION = 1024;  // Long edge of m_renderedFrame
     void renderFrame();
 
+    // Cloud gradient centred on the origin; clouds are placed with the
+    // painter transform, so the brush only changes with colour, alpha or size
+    QBrush m_cloudBrush;
+    QColor m_cloudBrushColor;
+    int m_cloudBrushAlpha = -1;
+    qreal m_cloudBrushRadius = -1.0;
+
     // Custom fog texture (seamless tile)
     QPixmap m_fogTexture;
+    QString m_texturePath;    // Cache key for the tinted versions
     QPixmap m_tintedTexture;  // Pre-tinted version for faster rendering
     bool m_hasTexture;
     qreal m_textureScale;     // Scale factor for texture tiles
@@ -111,21 +130,19 @@ private:
     QPixmap m_scaledTextures[NUM_TEXTURE_LAYERS];
     QSize m_cachedTileSizes[NUM_TEXTURE_LAYERS];  // Track sizes to detect when rescale needed
 
-    // Transition support
-    QTimer* m_transitionTimer;
+    // Transition support (advanced by the SceneAnimationDriver tick)
     qreal m_startDensity;
     qreal m_targetDensity;
     qreal m_startHeight;
     qreal m_targetHeight;
     QColor m_startColor;
     QColor m_targetColor;
-    qint64 m_transitionStartTime;
+    qreal m_transitionElapsed;  // seconds
     int m_transitionDuration;
     bool m_isTransitioning;
 
     // Timer intervals - optimized for performance
     static constexpr int ANIMATION_INTERVAL_MS = 100;  // 10 FPS for fog animation (reduced for performance)
-    static constexpr int TRANSITION_INTERVAL_MS = 33;  // 30 FPS for smooth transitions
 
 };
 
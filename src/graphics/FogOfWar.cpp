@@ -1,4 +1,5 @@
 #include "graphics/FogOfWar.h"
+#include "utils/MemoryManager.h"
 #include <QPainter>
 #include <QBrush>
 #include <QDataStream>
@@ -27,10 +28,16 @@ FogOfWar::FogOfWar()
             performDeferredUpdate();
         }
     });
+
+    m_memoryConsumerId = MemoryManager::instance().registerConsumer(QStringLiteral("Fog history"),
+        [this]() { return historyMemory(); },
+        [this](qint64 bytesWanted) { return trimHistory(bytesWanted); });
 }
 
 FogOfWar::~FogOfWar()
 {
+    MemoryManager::instance().unregisterConsumer(m_memoryConsumerId);
+
     if (m_updateTimer) {
         QObject::disconnect(m_updateTimer, nullptr, nullptr, nullptr);
         m_updateTimer->stop();
@@ -410,6 +417,30 @@ bool FogOfWar::loadState(const QByteArray& data)
     return true;
 }
 
+FogSnapshot FogOfWar::snapshot() const
+{
+    return FogSnapshot::fromMask(m_fogMask, m_fogColor, m_fogOpacity);
+}
+
+bool FogOfWar::restoreSnapshot(const FogSnapshot& snapshot)
+{
+    QImage mask = snapshot.toMask();
+    if (mask.isNull()) {
+        return false;
+    }
+
+    m_mapSize = snapshot.size();
+    m_fogColor = snapshot.color();
+    m_fogOpacity = snapshot.opacity();
+    m_fogMask = std::move(mask);
+    invalidatePixmapCache();
+
+    prepareGeometryChange();
+    update();
+
+    return true;
+}
+
 void FogOfWar::beginStroke()
 {
     pushState();
@@ -438,6 +469,8 @@ void FogOfWar::pushState()
     // Clear redo stack when new action is performed
     m_redoStack.clear();
 
+    MemoryManager::instance().touchConsumer(m_memoryConsumerId);
+
     // Push current state to undo stack
     QImage copy = m_fogMask.copy();
     m_undoStack.push(copy);
@@ -508,6 +541,30 @@ void FogOfWar::clearHistory()
     m_historyBytes = 0;
 }
 
+qint64 FogOfWar::historyMemory() const
+{
+    qint64 redoBytes = 0;
+    for (const QImage& state : m_redoStack) {
+        redoBytes += state.sizeInBytes();
+    }
+    return qint64(m_historyBytes) + redoBytes;
+}
+
+qint64 FogOfWar::trimHistory(qint64 bytesWanted)
+{
+    qint64 freed = 0;
+    while (freed < bytesWanted && m_undoStack.size() > MIN_KEPT_HISTORY) {
+        const QImage oldest = m_undoStack.takeFirst();
+        const size_t bytes = static_cast<size_t>(oldest.width()) * oldest.height() * 4;
+        m_historyBytes -= bytes;
+        freed += qint64(bytes);
+    }
+    while (freed < bytesWanted && m_redoStack.size() > MIN_KEPT_HISTORY) {
+        freed += m_redoStack.takeFirst().sizeInBytes();
+    }
+    return freed;
+}
+
 void FogOfWar::saveCurrentState()
 {
     if (!m_fogMask.isNull()) {
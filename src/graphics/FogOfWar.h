@@ -8,6 +8,8 @@
 #include <QPixmap>
 #include <functional>
 
+#include "graphics/FogSnapshot.h"
+
 class QTimer;
 
 class FogOfWar : public QGraphicsItem
@@ -30,6 +32,10 @@ public:
     // Serialization methods for autosave
     QByteArray saveState() const;
     bool loadState(const QByteArray& data);
+
+    // In-memory form for inactive tabs: no PNG round trip either way
+    FogSnapshot snapshot() const;
+    bool restoreSnapshot(const FogSnapshot& snapshot);
     
     // Get current fog mask for external access
     const QImage& getFogMask() const { return m_fogMask; }
@@ -88,6 +94,13 @@ private:
 
     void saveCurrentState();
 
+    // MemoryManager accounting: history is given up oldest first, keeping
+    // the last few steps so a recent stroke can still be undone
+    qint64 historyMemory() const;
+    qint64 trimHistory(qint64 bytesWanted);
+    static const int MIN_KEPT_HISTORY = 2;
+    int m_memoryConsumerId = 0;
+
     // Update batching for performance
     QTimer* m_updateTimer;
     bool m_pendingUpdate;
@@ -0,0 +1,167 @@
+#include "graphics/FogSnapshot.h"
+#include <QDataStream>
+#include <QIODevice>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr quint32 SNAPSHOT_MAGIC = 0x464f4753;  // "FOGS"
+constexpr quint8 SNAPSHOT_VERSION = 1;
+
+bool isUniform(const uchar* bits, qsizetype bytesPerLine, const QRect& rect, QRgb& value)
+{
+    value = reinterpret_cast<const QRgb*>(bits + rect.y() * bytesPerLine)[rect.x()];
+    for (int y = rect.top(); y <= rect.bottom(); ++y) {
+        const QRgb* row = reinterpret_cast<const QRgb*>(bits + y * bytesPerLine) + rect.x();
+        if (std::any_of(row, row + rect.width(), [value](QRgb pixel) { return pixel != value; })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+QRect FogSnapshot::tileRect(int index) const
+{
+    const int column = index % columns();
+    const int row = index / columns();
+    return QRect(column * TILE_SIZE, row * TILE_SIZE, TILE_SIZE, TILE_SIZE) & QRect(QPoint(0, 0), m_size);
+}
+
+FogSnapshot FogSnapshot::fromMask(const QImage& mask, const QColor& color, qreal opacity)
+{
+    FogSnapshot snapshot;
+    if (mask.isNull()) {
+        return snapshot;
+    }
+
+    const QImage source = mask.format() == QImage::Format_ARGB32
+        ? mask : mask.convertToFormat(QImage::Format_ARGB32);
+    snapshot.m_size = source.size();
+    snapshot.m_color = color;
+    snapshot.m_opacity = opacity;
+
+    const int rows = (snapshot.m_size.height() + TILE_SIZE - 1) / TILE_SIZE;
+    const int count = snapshot.columns() * rows;
+    snapshot.m_tiles.resize(count);
+
+    const uchar* bits = source.constBits();
+    const qsizetype bytesPerLine = source.bytesPerLine();
+    QByteArray raw;  // Reused for every mixed tile
+    for (int index = 0; index < count; ++index) {
+        const QRect rect = snapshot.tileRect(index);
+        Tile& tile = snapshot.m_tiles[index];
+        if (isUniform(bits, bytesPerLine, rect, tile.uniform)) {
+            continue;
+        }
+
+        const qsizetype rowBytes = qsizetype(rect.width()) * sizeof(QRgb);
+        raw.resize(rowBytes * rect.height());
+        for (int y = 0; y < rect.height(); ++y) {
+            memcpy(raw.data() + y * rowBytes,
+                   bits + (rect.y() + y) * bytesPerLine + rect.x() * sizeof(QRgb), rowBytes);
+        }
+        tile.packed = qCompress(raw, 1);
+    }
+    return snapshot;
+}
+
+QImage FogSnapshot::toMask() const
+{
+    if (isNull()) {
+        return QImage();
+    }
+
+    QImage mask(m_size, QImage::Format_ARGB32);
+    if (mask.isNull()) {
+        return QImage();
+    }
+    uchar* bits = mask.bits();
+    const qsizetype bytesPerLine = mask.bytesPerLine();
+
+    for (int index = 0; index < m_tiles.size(); ++index) {
+        const QRect rect = tileRect(index);
+        const Tile& tile = m_tiles.at(index);
+        const qsizetype rowBytes = qsizetype(rect.width()) * sizeof(QRgb);
+
+        if (tile.packed.isEmpty()) {
+            for (int y = rect.top(); y <= rect.bottom(); ++y) {
+                QRgb* row = reinterpret_cast<QRgb*>(bits + y * bytesPerLine) + rect.x();
+                std::fill_n(row, rect.width(), tile.uniform);
+            }
+            continue;
+        }
+
+        const QByteArray raw = qUncompress(tile.packed);
+        if (raw.size() != rowBytes * rect.height()) {
+            return QImage();
+        }
+        for (int y = 0; y < rect.height(); ++y) {
+            memcpy(bits + (rect.y() + y) * bytesPerLine + rect.x() * sizeof(QRgb),
+                   raw.constData() + y * rowBytes, rowBytes);
+        }
+    }
+    return mask;
+}
+
+int FogSnapshot::mixedTiles() const
+{
+    return int(std::count_if(m_tiles.cbegin(), m_tiles.cend(),
+                             [](const Tile& tile) { return !tile.packed.isEmpty(); }));
+}
+
+qint64 FogSnapshot::sizeInBytes() const
+{
+    qint64 bytes = qint64(m_tiles.size()) * sizeof(Tile);
+    for (const Tile& tile : m_tiles) {
+        bytes += tile.packed.size();
+    }
+    return bytes;
+}
+
+QByteArray FogSnapshot::serialize() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << SNAPSHOT_MAGIC << SNAPSHOT_VERSION << m_size << m_color << m_opacity
+           << qint32(TILE_SIZE) << qint32(m_tiles.size());
+    for (const Tile& tile : m_tiles) {
+        stream << quint32(tile.uniform) << tile.packed;
+    }
+    return data;
+}
+
+FogSnapshot FogSnapshot::deserialize(const QByteArray& data)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint8 version = 0;
+    qint32 tileSize = 0;
+    qint32 count = 0;
+    FogSnapshot snapshot;
+    stream >> magic >> version >> snapshot.m_size >> snapshot.m_color >> snapshot.m_opacity
+           >> tileSize >> count;
+    if (stream.status() != QDataStream::Ok || magic != SNAPSHOT_MAGIC ||
+        version != SNAPSHOT_VERSION || tileSize != TILE_SIZE || snapshot.m_size.isEmpty()) {
+        return FogSnapshot();
+    }
+
+    const int rows = (snapshot.m_size.height() + TILE_SIZE - 1) / TILE_SIZE;
+    if (count != snapshot.columns() * rows) {
+        return FogSnapshot();
+    }
+
+    snapshot.m_tiles.resize(count);
+    for (Tile& tile : snapshot.m_tiles) {
+        quint32 uniform = 0;
+        stream >> uniform >> tile.packed;
+        tile.uniform = uniform;
+    }
+    return stream.status() == QDataStream::Ok ? snapshot : FogSnapshot();
+}
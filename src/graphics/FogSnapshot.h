@@ -0,0 +1,54 @@
+#ifndef FOGSNAPSHOT_H
+#define FOGSNAPSHOT_H
+
+#include <QByteArray>
+#include <QColor>
+#include <QImage>
+#include <QSize>
+#include <QVector>
+
+// Compact copy of a fog mask for inactive tabs, taken straight from the
+// live ARGB32 mask. The mask is cut into TILE_SIZE tiles; a tile of one
+// colour (all fogged, all revealed - nearly every tile of a real map) is
+// kept as that single pixel, the rest as zlib at its fastest level. No
+// image codec is involved in either direction.
+//
+// Snapshots are implicitly shared values, safe to copy to and serialize on
+// worker threads. FogOfWar::saveState() (PNG) stays the on-disk autosave
+// format; serialize() is only for the hibernation swap file.
+class FogSnapshot
+{
+public:
+    FogSnapshot() = default;
+
+    static FogSnapshot fromMask(const QImage& mask, const QColor& color, qreal opacity);
+    QImage toMask() const;
+
+    bool isNull() const { return m_size.isEmpty(); }
+    QSize size() const { return m_size; }
+    QColor color() const { return m_color; }
+    qreal opacity() const { return m_opacity; }
+    int mixedTiles() const;
+    qint64 sizeInBytes() const;
+
+    QByteArray serialize() const;
+    static FogSnapshot deserialize(const QByteArray& data);
+
+    static constexpr int TILE_SIZE = 128;
+
+private:
+    struct Tile {
+        QRgb uniform = 0;
+        QByteArray packed;  // Empty for a uniform tile
+    };
+
+    int columns() const { return (m_size.width() + TILE_SIZE - 1) / TILE_SIZE; }
+    QRect tileRect(int index) const;
+
+    QSize m_size;
+    QColor m_color;
+    qreal m_opacity = 1.0;
+    QVector<Tile> m_tiles;  // Row-major
+};
+
+#endif // FOGSNAPSHOT_H
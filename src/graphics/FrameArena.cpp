@@ -0,0 +1,105 @@
+#include "graphics/FrameArena.h"
+#include <cstdlib>
+
+#if defined(CRITVTT_COUNT_ALLOCATIONS) && defined(__GLIBC__)
+// Qt containers allocate with malloc directly, so counting operator new
+// would miss most of them; the executable's malloc interposes the C
+// library's for the whole process instead
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+}
+
+namespace {
+thread_local qint64 t_allocations = 0;
+}
+
+extern "C" void* malloc(size_t size)
+{
+    ++t_allocations;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+    ++t_allocations;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size)
+{
+    ++t_allocations;
+    return __libc_realloc(pointer, size);
+}
+
+qint64 FrameArena::threadAllocationCount()
+{
+    return t_allocations;
+}
+#else
+qint64 FrameArena::threadAllocationCount()
+{
+    return -1;
+}
+#endif
+
+FrameArena& FrameArena::instance()
+{
+    static FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::allocateBytes(qsizetype bytes, qsizetype alignment)
+{
+    if (bytes <= 0) {
+        return nullptr;
+    }
+
+    while (m_block < m_blocks.size()) {
+        Block& block = m_blocks[m_block];
+        const quintptr base = quintptr(block.data.get());
+        const quintptr aligned = (base + m_offset + alignment - 1) & ~quintptr(alignment - 1);
+        const qsizetype start = qsizetype(aligned - base);
+        if (start + bytes <= block.size) {
+            m_offset = start + bytes;
+            m_frameBytes += bytes;
+            return block.data.get() + start;
+        }
+        // Blocks from earlier frames are reused in order before growing
+        ++m_block;
+        m_offset = 0;
+    }
+
+    Block block;
+    block.size = qMax(BLOCK_SIZE, bytes + alignment);
+    block.data.reset(new char[block.size]);
+    m_stats.capacity += block.size;
+    ++m_stats.blockAllocations;
+    m_blocks.push_back(std::move(block));
+    m_block = m_blocks.size() - 1;
+    m_offset = 0;
+    return allocateBytes(bytes, alignment);
+}
+
+void FrameArena::reset()
+{
+    m_stats.lastFrameBytes = m_frameBytes;
+    m_stats.peakFrameBytes = qMax(m_stats.peakFrameBytes, m_frameBytes);
+    ++m_stats.frames;
+
+    const qint64 allocations = threadAllocationCount();
+    if (allocations >= 0 && m_allocationsAtReset >= 0) {
+        m_stats.lastFrameHeapAllocations = allocations - m_allocationsAtReset;
+    }
+    m_allocationsAtReset = allocations;
+
+    m_block = 0;
+    m_offset = 0;
+    m_frameBytes = 0;
+}
+
+FrameArena::Stats FrameArena::stats() const
+{
+    return m_stats;
+}
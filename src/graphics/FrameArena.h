@@ -0,0 +1,66 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <QtGlobal>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Bump allocator for per-frame paint temporaries (GUI thread only).
+//
+// SceneAnimationDriver resets it at the start of every tick, so storage
+// taken from it is valid until the next tick - long enough for the paint
+// that tick schedules. Blocks are kept across frames: once the arena has
+// grown to a frame's working set, allocating from it never touches the
+// heap. Only trivially destructible types; nothing is ever destroyed.
+class FrameArena
+{
+public:
+    static FrameArena& instance();
+
+    template <typename T>
+    T* allocate(qsizetype count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return static_cast<T*>(allocateBytes(count * qsizetype(sizeof(T)), alignof(T)));
+    }
+
+    // Start of a frame: everything handed out so far is released at once
+    void reset();
+
+    struct Stats {
+        quint64 frames = 0;
+        qint64 capacity = 0;             // Bytes held across frames
+        qint64 lastFrameBytes = 0;
+        qint64 peakFrameBytes = 0;
+        quint64 blockAllocations = 0;    // Times the arena had to grow
+        qint64 lastFrameHeapAllocations = -1;  // GUI thread, tick to tick; -1 without the counter
+    };
+    Stats stats() const;
+
+    // Heap allocations made by the calling thread so far. Counting replaces
+    // malloc and is a debug build option (CRITVTT_COUNT_ALLOCATIONS, glibc
+    // only); -1 when it is not compiled in.
+    static qint64 threadAllocationCount();
+
+    static constexpr qsizetype BLOCK_SIZE = 256 * 1024;
+
+private:
+    FrameArena() = default;
+
+    void* allocateBytes(qsizetype bytes, qsizetype alignment);
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        qsizetype size = 0;
+    };
+    std::vector<Block> m_blocks;
+    size_t m_block = 0;       // Block currently handed out from
+    qsizetype m_offset = 0;   // Within m_blocks[m_block]
+    qint64 m_frameBytes = 0;
+
+    Stats m_stats;
+    qint64 m_allocationsAtReset = -1;
+};
+
+#endif // FRAMEARENA_H
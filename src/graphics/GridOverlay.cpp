@@ -1,4 +1,5 @@
 #include "graphics/GridOverlay.h"
+#include "utils/MemoryManager.h"
 #include <QPainter>
 #include <QPen>
 #include <QApplication>
@@ -20,6 +21,24 @@ GridOverlay::GridOverlay()
 
     // Initialize cached pen
     rebuildPen();
+
+    // Rebuilt on the next paint, so only a hidden grid gives its pixmap up
+    m_memoryConsumerId = MemoryManager::instance().registerConsumer(QStringLiteral("Grid cache"),
+        [this]() { return m_cachedGrid.isNull() ? qint64(0) : qint64(m_cachedGrid.width()) * m_cachedGrid.height() * 4; },
+        [this](qint64) -> qint64 {
+            if (isVisible() || m_cachedGrid.isNull()) {
+                return 0;
+            }
+            const qint64 bytes = qint64(m_cachedGrid.width()) * m_cachedGrid.height() * 4;
+            m_cachedGrid = QPixmap();
+            m_cacheValid = false;
+            return bytes;
+        });
+}
+
+GridOverlay::~GridOverlay()
+{
+    MemoryManager::instance().unregisterConsumer(m_memoryConsumerId);
 }
 
 void GridOverlay::setMapSize(const QSize& size)
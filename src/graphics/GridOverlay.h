@@ -10,6 +10,7 @@ class GridOverlay : public QGraphicsItem
 {
 public:
     GridOverlay();
+    ~GridOverlay();
 
     void setMapSize(const QSize& size);
     void setGridSize(int size);
@@ -45,6 +46,7 @@ private:
 
     QPixmap m_cachedGrid;  // Pre-rendered grid pixmap
     bool m_cacheValid = false;  // Whether the cached pixmap is up to date
+    int m_memoryConsumerId = 0; // Map-sized pixmap, released while hidden
 
     // D&D measurement properties
     double m_feetPerSquare;     // Game distance per square (default: 5 feet)
@@ -1,13 +1,11 @@
 #include "graphics/ImageCache.h"
+#include "utils/MemoryManager.h"
 #include <QMutexLocker>
 
 ImageCache* ImageCacheManager::s_instance = nullptr;
 QMutex ImageCacheManager::s_instanceMutex;
 
 ImageCache::ImageCache()
-    : m_maxCacheSize(100 * 1024 * 1024) // 100MB default
-    , m_currentCacheSize(0)
-    , m_enabled(true)
 {
 }
 
@@ -16,103 +14,278 @@ ImageCache::~ImageCache()
     clear();
 }
 
+ImageCache::Shard& ImageCache::shardFor(const ImageCacheKey& key)
+{
+    // Fixed seed: the shard of a key must not depend on QHash's random seed
+    const size_t hash = qHash(key, size_t(0));
+    return m_shards[(hash ^ (hash >> 17)) % SHARD_COUNT];
+}
+
+ImageCache::Node* ImageCache::find(Shard& shard, const ImageCacheKey& key)
+{
+    Node* node = shard.nodes.value(key, nullptr);
+    if (!node) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    // Move to front of the recency list
+    if (node != shard.head) {
+        unlink(shard, node);
+        pushFront(shard, node);
+    }
+    node->lastUsed = m_useClock.fetch_add(1, std::memory_order_relaxed);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return node;
+}
+
 QPixmap ImageCache::getCachedPixmap(const ImageCacheKey& key)
 {
-    if (!m_enabled) {
+    if (!m_enabled.load()) {
         return QPixmap();
     }
 
-    QMutexLocker locker(&m_cacheMutex);
+    Shard& shard = shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    Node* node = find(shard, key);
+    return node ? node->pixmap : QPixmap();
+}
 
-    auto it = m_cache.find(key);
-    if (it != m_cache.end()) {
-        // Update last used time and move to front of LRU list
-        it->lastUsed = QDateTime::currentDateTime();
-        updateEntryUsage(key);
-        return it->pixmap;
+QImage ImageCache::getCachedImage(const ImageCacheKey& key)
+{
+    if (!m_enabled.load()) {
+        return QImage();
     }
 
-    return QPixmap(); // Not found
+    Shard& shard = shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+    Node* node = find(shard, key);
+    return node ? node->image : QImage();
 }
 
 void ImageCache::setCachedPixmap(const ImageCacheKey& key, const QPixmap& pixmap)
 {
-    if (!m_enabled || pixmap.isNull()) {
+    if (pixmap.isNull()) {
         return;
     }
+    insert(key, pixmap, QImage(), calculatePixmapSize(pixmap));
+}
 
-    QMutexLocker locker(&m_cacheMutex);
+void ImageCache::setCachedImage(const ImageCacheKey& key, const QImage& image)
+{
+    if (image.isNull()) {
+        return;
+    }
+    insert(key, QPixmap(), image, image.sizeInBytes());
+}
 
-    size_t pixmapSize = calculatePixmapSize(pixmap);
+void ImageCache::insert(const ImageCacheKey& key, const QPixmap& pixmap, const QImage& image,
+                        qint64 bytes)
+{
+    if (!m_enabled.load()) {
+        return;
+    }
 
-    // Check if adding this would exceed cache size
-    if (pixmapSize > m_maxCacheSize) {
-        // Pixmap too large for cache
+    // Too large for its shard - caching it would flush everything else
+    const qint64 shardBudget = m_maxCacheSize.load() / SHARD_COUNT;
+    if (bytes > shardBudget) {
         return;
     }
 
-    // Remove existing entry if it exists
-    auto existing = m_cache.find(key);
-    if (existing != m_cache.end()) {
-        m_currentCacheSize -= existing->memorySize;
-        m_lruOrder.removeAll(key);
-        m_cache.erase(existing);
+    Shard& shard = shardFor(key);
+    QMutexLocker locker(&shard.mutex);
+
+    Node* node = shard.nodes.value(key, nullptr);
+    if (node) {
+        // Replace in place
+        shard.bytes -= node->bytes;
+        unlink(shard, node);
+    } else {
+        node = new Node;
+        node->key = key;
+        shard.nodes.insert(key, node);
     }
+    node->pixmap = pixmap;
+    node->image = image;
+    node->bytes = bytes;
+    node->lastUsed = m_useClock.fetch_add(1, std::memory_order_relaxed);
+    pushFront(shard, node);
+    shard.bytes += bytes;
+    m_insertions.fetch_add(1, std::memory_order_relaxed);
 
-    // Evict entries until we have space
-    while (m_currentCacheSize + pixmapSize > m_maxCacheSize && !m_cache.isEmpty()) {
-        evictLRU();
+    while (shard.bytes > shardBudget && shard.tail != node) {
+        evictTail(shard);
     }
+}
 
-    // Add new entry
-    ImageCacheEntry entry;
-    entry.pixmap = pixmap;
-    entry.lastUsed = QDateTime::currentDateTime();
-    entry.memorySize = pixmapSize;
+void ImageCache::remove(const ImageCacheKey& key)
+{
+    Shard& shard = shardFor(key);
+    QMutexLocker locker(&shard.mutex);
 
-    m_cache[key] = entry;
-    m_lruOrder.prepend(key);
-    m_currentCacheSize += pixmapSize;
+    Node* node = shard.nodes.take(key);
+    if (node) {
+        shard.bytes -= node->bytes;
+        unlink(shard, node);
+        delete node;
+    }
 }
 
 void ImageCache::clear()
 {
-    QMutexLocker locker(&m_cacheMutex);
+    for (Shard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        clearShard(shard);
+    }
+}
 
-    m_cache.clear();
-    m_lruOrder.clear();
-    m_currentCacheSize = 0;
+void ImageCache::trimTo(qint64 bytes)
+{
+    // Hold every shard, always in index order; everything else locks one
+    for (Shard& shard : m_shards) {
+        shard.mutex.lock();
+    }
+
+    qint64 total = 0;
+    for (const Shard& shard : m_shards) {
+        total += shard.bytes;
+    }
+
+    // Each shard's tail is its least recently used entry, so the oldest
+    // tail is the least recently used entry overall
+    const qint64 target = qMax<qint64>(0, bytes);
+    while (total > target) {
+        Shard* oldest = nullptr;
+        for (Shard& shard : m_shards) {
+            if (shard.tail && (!oldest || shard.tail->lastUsed < oldest->tail->lastUsed)) {
+                oldest = &shard;
+            }
+        }
+        if (!oldest) {
+            break;
+        }
+        total -= oldest->tail->bytes;
+        evictTail(*oldest);
+    }
+
+    for (int i = SHARD_COUNT - 1; i >= 0; --i) {
+        m_shards[i].mutex.unlock();
+    }
 }
 
-void ImageCache::evictLRU()
+void ImageCache::setMaxCacheSize(qint64 maxSize)
 {
-    if (m_lruOrder.isEmpty()) {
-        return;
+    m_maxCacheSize.store(qMax<qint64>(0, maxSize));
+    trimTo(maxSize);
+}
+
+qint64 ImageCache::getCurrentCacheSize() const
+{
+    qint64 total = 0;
+    for (const Shard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        total += shard.bytes;
+    }
+    return total;
+}
+
+int ImageCache::getCacheEntryCount() const
+{
+    int total = 0;
+    for (const Shard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        total += shard.nodes.size();
+    }
+    return total;
+}
+
+ImageCache::Stats ImageCache::stats() const
+{
+    Stats result;
+    result.hits = m_hits.load(std::memory_order_relaxed);
+    result.misses = m_misses.load(std::memory_order_relaxed);
+    result.insertions = m_insertions.load(std::memory_order_relaxed);
+    result.evictions = m_evictions.load(std::memory_order_relaxed);
+    for (const Shard& shard : m_shards) {
+        QMutexLocker locker(&shard.mutex);
+        result.bytes += shard.bytes;
+        result.entries += shard.nodes.size();
+    }
+    return result;
+}
+
+void ImageCache::resetStats()
+{
+    m_hits.store(0);
+    m_misses.store(0);
+    m_insertions.store(0);
+    m_evictions.store(0);
+}
+
+void ImageCache::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled);
+    if (!enabled) {
+        clear();
     }
+}
 
-    // Remove least recently used entry
-    ImageCacheKey oldestKey = m_lruOrder.last();
-    auto it = m_cache.find(oldestKey);
+void ImageCache::unlink(Shard& shard, Node* node)
+{
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        shard.head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        shard.tail = node->prev;
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+}
 
-    if (it != m_cache.end()) {
-        m_currentCacheSize -= it->memorySize;
-        m_cache.erase(it);
+void ImageCache::pushFront(Shard& shard, Node* node)
+{
+    node->prev = nullptr;
+    node->next = shard.head;
+    if (shard.head) {
+        shard.head->prev = node;
     }
+    shard.head = node;
+    if (!shard.tail) {
+        shard.tail = node;
+    }
+}
 
-    m_lruOrder.removeLast();
+void ImageCache::evictTail(Shard& shard)
+{
+    Node* node = shard.tail;
+    if (!node) {
+        return;
+    }
+    unlink(shard, node);
+    shard.nodes.remove(node->key);
+    shard.bytes -= node->bytes;
+    delete node;
+    m_evictions.fetch_add(1, std::memory_order_relaxed);
 }
 
-void ImageCache::updateEntryUsage(const ImageCacheKey& key)
+void ImageCache::clearShard(Shard& shard)
 {
-    // Move key to front of LRU list
-    m_lruOrder.removeAll(key);
-    m_lruOrder.prepend(key);
+    for (Node* node : std::as_const(shard.nodes)) {
+        delete node;
+    }
+    shard.nodes.clear();
+    shard.head = nullptr;
+    shard.tail = nullptr;
+    shard.bytes = 0;
 }
 
-size_t ImageCache::calculatePixmapSize(const QPixmap& pixmap)
+qint64 ImageCache::calculatePixmapSize(const QPixmap& pixmap)
 {
-    // Estimate memory usage: width * height * bytes per pixel (4 for ARGB32)
-    return static_cast<size_t>(pixmap.width()) * pixmap.height() * 4;
+    return qint64(pixmap.width()) * pixmap.height() * qMax(1, pixmap.depth() / 8);
 }
 
 ImageCache& ImageCacheManager::instance()
@@ -121,7 +294,24 @@ ImageCache& ImageCacheManager::instance()
 
     if (!s_instance) {
         s_instance = new ImageCache();
+
+        MemoryManager& memory = MemoryManager::instance();
+        s_instance->setMaxCacheSize(qint64(memory.getMaxMemoryLimit() * BUDGET_FRACTION));
+
+        ImageCache* cache = s_instance;
+        QObject::connect(&memory, &MemoryManager::memoryLimitChanged, &memory, [cache](qint64 bytes) {
+            cache->setMaxCacheSize(qint64(bytes * BUDGET_FRACTION));
+        });
+
+        // Derived renders can all be recreated
+        memory.registerConsumer(QStringLiteral("Render cache"),
+            [cache]() { return cache->getCurrentCacheSize(); },
+            [cache](qint64 bytesWanted) {
+                const qint64 before = cache->getCurrentCacheSize();
+                cache->trimTo(before - bytesWanted);
+                return before - cache->getCurrentCacheSize();
+            });
     }
 
     return *s_instance;
-}
\ No newline at end of file
+}
@@ -2,94 +2,162 @@
 #define IMAGECACHE_H
 
 #include <QPixmap>
+#include <QImage>
 #include <QHash>
-#include <QList>
 #include <QMutex>
-#include <QDateTime>
+#include <QString>
+#include <atomic>
 
+// Identifies one derived render: a source (file path, or a synthetic tag
+// such as "light-sprite") plus the parameters it was rendered with.
+// Rotation and scale compare at 1/1000 precision so equal keys always hash
+// equally; variant carries anything else (tint colour, falloff, ...).
 struct ImageCacheKey
 {
     QString imagePath;
     QSize targetSize;
-    qreal rotation;
-    qreal scaleX;
-    qreal scaleY;
+    qreal rotation = 0.0;
+    qreal scaleX = 1.0;
+    qreal scaleY = 1.0;
+    quint64 variant = 0;
+
+    static qint64 quantize(qreal value) { return qRound64(value * 1000.0); }
 
     bool operator==(const ImageCacheKey& other) const {
         return imagePath == other.imagePath &&
                targetSize == other.targetSize &&
-               qFuzzyCompare(rotation, other.rotation) &&
-               qFuzzyCompare(scaleX, other.scaleX) &&
-               qFuzzyCompare(scaleY, other.scaleY);
+               quantize(rotation) == quantize(other.rotation) &&
+               quantize(scaleX) == quantize(other.scaleX) &&
+               quantize(scaleY) == quantize(other.scaleY) &&
+               variant == other.variant;
     }
 };
 
-inline uint qHash(const ImageCacheKey& key, uint seed = 0)
+inline size_t qHash(const ImageCacheKey& key, size_t seed = 0)
 {
-    return qHash(key.imagePath, seed) ^
-           qHash(key.targetSize.width(), seed) ^
-           qHash(key.targetSize.height(), seed) ^
-           qHash(static_cast<int>(key.rotation * 100), seed) ^
-           qHash(static_cast<int>(key.scaleX * 100), seed) ^
-           qHash(static_cast<int>(key.scaleY * 100), seed);
+    return qHashMulti(seed, key.imagePath, key.targetSize.width(), key.targetSize.height(),
+                      ImageCacheKey::quantize(key.rotation), ImageCacheKey::quantize(key.scaleX),
+                      ImageCacheKey::quantize(key.scaleY), key.variant);
 }
 
-struct ImageCacheEntry
-{
-    QPixmap pixmap;
-    QDateTime lastUsed;
-    size_t memorySize;
-};
-
+// Shared LRU cache for derived renders (tinted mist textures, light sprites,
+// thumbnails, scaled or rotated map variants).
+//
+// Keys are spread over SHARD_COUNT independently locked shards so worker
+// threads and the GUI thread rarely contend. Each shard is a hash of nodes
+// threaded on an intrusive recency list, so hits, inserts and evictions are
+// all O(1). The byte budget is split evenly between shards for inserts;
+// trimTo() evicts in global recency order, using a use stamp per entry.
+//
+// Entries hold either a QPixmap (GUI thread only) or a QImage (any thread).
 class ImageCache
 {
 public:
+    struct Stats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 insertions = 0;
+        quint64 evictions = 0;
+        qint64 bytes = 0;
+        int entries = 0;
+
+        qreal hitRate() const { return hits + misses > 0 ? qreal(hits) / (hits + misses) : 0.0; }
+    };
+
     ImageCache();
     ~ImageCache();
 
-    // Get cached pixmap or return null if not found
+    // Get cached render or return null if not found
     QPixmap getCachedPixmap(const ImageCacheKey& key);
+    QImage getCachedImage(const ImageCacheKey& key);
 
-    // Store pixmap in cache
+    // Store a render, evicting least recently used entries of its shard
     void setCachedPixmap(const ImageCacheKey& key, const QPixmap& pixmap);
+    void setCachedImage(const ImageCacheKey& key, const QImage& image);
+
+    void remove(const ImageCacheKey& key);
 
     // Clear all cached images
     void clear();
 
-    // Set maximum cache size in bytes (default: 100MB)
-    void setMaxCacheSize(size_t maxSize) { m_maxCacheSize = maxSize; }
-    size_t getMaxCacheSize() const { return m_maxCacheSize; }
+    // Evict least recently used entries, across shards, until at most bytes
+    // remain in total (memory pressure, budget changes)
+    void trimTo(qint64 bytes);
+
+    // Maximum cache size in bytes, split across shards
+    void setMaxCacheSize(qint64 maxSize);
+    qint64 getMaxCacheSize() const { return m_maxCacheSize.load(); }
+
+    // Current cache usage
+    qint64 getCurrentCacheSize() const;
+    int getCacheEntryCount() const;
 
-    // Get current cache usage
-    size_t getCurrentCacheSize() const { return m_currentCacheSize; }
-    int getCacheEntryCount() const { return m_cache.size(); }
+    Stats stats() const;
+    void resetStats();
 
     // Enable/disable cache (for testing/debugging)
-    void setEnabled(bool enabled) { m_enabled = enabled; if (!enabled) clear(); }
-    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled.load(); }
+
+    static constexpr int SHARD_COUNT = 8;
 
 private:
-    void evictLRU();
-    void updateEntryUsage(const ImageCacheKey& key);
-    size_t calculatePixmapSize(const QPixmap& pixmap);
-
-    QHash<ImageCacheKey, ImageCacheEntry> m_cache;
-    QList<ImageCacheKey> m_lruOrder;
-    size_t m_maxCacheSize;
-    size_t m_currentCacheSize;
-    bool m_enabled;
-    mutable QMutex m_cacheMutex;
+    struct Node {
+        ImageCacheKey key;
+        QPixmap pixmap;
+        QImage image;
+        qint64 bytes = 0;
+        quint64 lastUsed = 0;  // From m_useClock, orders entries across shards
+        Node* prev = nullptr;  // Towards most recently used
+        Node* next = nullptr;  // Towards least recently used
+    };
+
+    struct Shard {
+        mutable QMutex mutex;
+        QHash<ImageCacheKey, Node*> nodes;
+        Node* head = nullptr;  // Most recently used
+        Node* tail = nullptr;  // Least recently used
+        qint64 bytes = 0;
+    };
+
+    Shard& shardFor(const ImageCacheKey& key);
+    Node* find(Shard& shard, const ImageCacheKey& key);
+    void insert(const ImageCacheKey& key, const QPixmap& pixmap, const QImage& image, qint64 bytes);
+
+    static void unlink(Shard& shard, Node* node);
+    static void pushFront(Shard& shard, Node* node);
+    void evictTail(Shard& shard);
+    static void clearShard(Shard& shard);
+
+    static qint64 calculatePixmapSize(const QPixmap& pixmap);
+
+    Shard m_shards[SHARD_COUNT];
+    std::atomic<qint64> m_maxCacheSize{100 * 1024 * 1024};
+    std::atomic<bool> m_enabled{true};
+    std::atomic<quint64> m_useClock{0};
+
+    std::atomic<quint64> m_hits{0};
+    std::atomic<quint64> m_misses{0};
+    std::atomic<quint64> m_insertions{0};
+    std::atomic<quint64> m_evictions{0};
 };
 
-// Singleton instance for global access
+// Singleton instance for global access. The budget is BUDGET_FRACTION of
+// the MemoryManager limit and follows memoryLimitChanged. There is no
+// blanket trim on memoryPressureDetected: the cache is a registered
+// MemoryManager consumer, and under pressure it frees what the manager
+// asks for, least recently used first.
 class ImageCacheManager
 {
 public:
     static ImageCache& instance();
 
+    // Share of MemoryManager::getMaxMemoryLimit() given to derived renders (5%)
+    static constexpr double BUDGET_FRACTION = 0.05;
+
 private:
     static ImageCache* s_instance;
     static QMutex s_instanceMutex;
 };
 
-#endif // IMAGECACHE_H
\ No newline at end of file
+#endif // IMAGECACHE_H
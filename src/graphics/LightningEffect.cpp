@@ -18,12 +18,11 @@ LightningEffect::LightningEffect(QGraphicsItem* parent)
     , m_updateTimer(new QTimer(this))
     , m_strikeStartTime(0)
     , m_strikeTimer(new QTimer(this))
-    , m_transitionTimer(new QTimer(this))
     , m_startIntensity(0.0)
     , m_targetIntensity(0.0)
     , m_startFrequency(0.0)
     , m_targetFrequency(0.0)
-    , m_transitionStartTime(0)
+    , m_transitionElapsed(0.0)
     , m_transitionDuration(1000)
     , m_isTransitioning(false)
     , m_random(QRandomGenerator::global()->generate())
@@ -38,10 +37,6 @@ LightningEffect::LightningEffect(QGraphicsItem* parent)
     m_strikeTimer->setSingleShot(true);
     connect(m_strikeTimer, &QTimer::timeout, this, &LightningEffect::onStrikeTick);
 
-    // Setup transition timer
-    m_transitionTimer->setInterval(TRANSITION_INTERVAL_MS);
-    connect(m_transitionTimer, &QTimer::timeout, this, &LightningEffect::onTransitionTick);
-
     // Start invisible
     setVisible(false);
 }
@@ -54,9 +49,6 @@ LightningEffect::~LightningEffect()
     if (m_strikeTimer->isActive()) {
         m_strikeTimer->stop();
     }
-    if (m_transitionTimer->isActive()) {
-        m_transitionTimer->stop();
-    }
 }
 
 QRectF LightningEffect::boundingRect() const
@@ -161,25 +153,24 @@ void LightningEffect::triggerStrike()
 
 void LightningEffect::transitionTo(qreal intensity, qreal frequency, int durationMs)
 {
-    // Cancel any existing transition
-    if (m_isTransitioning) {
-        m_transitionTimer->stop();
-    }
-
+    // Restarts from the current values if a transition is already running
     m_startIntensity = m_intensity;
     m_targetIntensity = qBound(0.0, intensity, 1.0);
     m_startFrequency = m_frequency;
     m_targetFrequency = qBound(0.0, frequency, 1.0);
 
     m_transitionDuration = qMax(100, durationMs);
-    m_transitionStartTime = QDateTime::currentMSecsSinceEpoch();
+    m_transitionElapsed = 0.0;
     m_isTransitioning = true;
-
-    m_transitionTimer->start();
+    // Progress is advanced from advanceAnimation() on the shared scene tick
 }
 
 void LightningEffect::advanceAnimation(qreal dt)
 {
+    if (m_isTransitioning) {
+        advanceTransition(dt);
+    }
+
     if (!m_enabled) {
         return;
     }
@@ -305,16 +296,10 @@ void LightningEffect::onStrikeTick()
     }
 }
 
-void LightningEffect::onTransitionTick()
+void LightningEffect::advanceTransition(qreal dt)
 {
-    if (!m_isTransitioning) {
-        m_transitionTimer->stop();
-        return;
-    }
-
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 elapsed = currentTime - m_transitionStartTime;
-    qreal progress = qBound(0.0, static_cast<qreal>(elapsed) / m_transitionDuration, 1.0);
+    m_transitionElapsed += dt;
+    qreal progress = qBound(0.0, m_transitionElapsed * 1000.0 / m_transitionDuration, 1.0);
 
     // Linear interpolation
     m_intensity = m_startIntensity + (m_targetIntensity - m_startIntensity) * progress;
@@ -324,7 +309,6 @@ void LightningEffect::onTransitionTick()
         m_intensity = m_targetIntensity;
         m_frequency = m_targetFrequency;
         m_isTransitioning = false;
-        m_transitionTimer->stop();
         emit transitionCompleted();
     }
 
@@ -42,6 +42,7 @@ public:
 
     // Force a lightning strike (for testing or manual triggering)
     void triggerStrike();
+    bool isStriking() const { return m_isStriking; }
 
     // Transition support - smooth intensity changes
     void transitionTo(qreal intensity, qreal frequency, int durationMs = 1000);
@@ -56,11 +57,11 @@ signals:
 private slots:
     void onUpdateTick();
     void onStrikeTick();
-    void onTransitionTick();
 
 private:
     void startStrike();
     void scheduleNextStrike();
+    void advanceTransition(qreal dt);
     qreal calculateFlashOpacity() const;
 
     // Lightning state
@@ -85,13 +86,12 @@ private:
     // Strike scheduling timer
     QTimer* m_strikeTimer;
 
-    // Transition support
-    QTimer* m_transitionTimer;
+    // Transition support (advanced by the SceneAnimationDriver tick)
     qreal m_startIntensity;
     qreal m_targetIntensity;
     qreal m_startFrequency;
     qreal m_targetFrequency;
-    qint64 m_transitionStartTime;
+    qreal m_transitionElapsed;  // seconds
     int m_transitionDuration;
     bool m_isTransitioning;
 
@@ -103,7 +103,6 @@ private:
 
     // Timer intervals
     static constexpr int UPDATE_INTERVAL_MS = 16;       // ~60 FPS
-    static constexpr int TRANSITION_INTERVAL_MS = 16;   // 60 FPS for smooth transitions
 
 
     // Random generator for timing
@@ -14,18 +14,19 @@
 #include "graphics/LightningEffect.h"
 #include "graphics/PointLightSystem.h"
 #include "graphics/PointLight.h"
+#include "graphics/AtmosphereCompositor.h"
 #include "graphics/SceneAnimationDriver.h"
+#include "graphics/TiledMapItem.h"
 #include "graphics/ZLayers.h"
 #include "graphics/ZoomIndicator.h"
 #include "graphics/LoadingProgressWidget.h"
-#include "utils/ImageLoader.h"
 #include "utils/VTTLoader.h"
 #include "utils/DebugConsole.h"
 #include "utils/CustomCursors.h"
 #include "utils/FogToolMode.h"
 #include "utils/ToolType.h"
+#include "utils/SettingsManager.h"
 #include <QGraphicsScene>
-#include <QGraphicsPixmapItem>
 #include <QGraphicsRectItem>
 #include <QWheelEvent>
 #include <QMouseEvent>
@@ -40,13 +41,9 @@
 #include <QDateTime>
 #include <QApplication>
 #include <QThread>
-#include <QEventLoop>
 #include <cmath>
 #include <QtMath>
 
-// Define static flag for app readiness
-bool MapDisplay::s_appReadyForProgress = false;
-
 MapDisplay::MapDisplay(QWidget *parent)
     : QGraphicsView(parent)
     , m_scene(nullptr)
@@ -76,9 +73,10 @@ MapDisplay::MapDisplay(QWidget *parent)
     , m_zoomAccumulationTimer(nullptr)
     , m_zoomIndicator(nullptr)
     , m_loadingProgressWidget(nullptr)
-    , m_imageLoader(nullptr)
     , m_zoomControlsEnabled(true)
     , m_lightingOverlay(nullptr)
+    , m_atmosphereCompositor(nullptr)
+    , m_atmosphereCompositingEnabled(SettingsManager::instance().loadAtmosphereCompositing())
     , m_animationDriver(nullptr)
     , m_pointLightPlacementMode(false)
     , m_currentLightPreset(LightPreset::Torch)
@@ -124,6 +122,7 @@ MapDisplay::MapDisplay(QWidget *parent)
     m_fogMistEffect = nullptr;
     m_lightningEffect = nullptr;
     m_pointLightSystem = nullptr;
+    m_atmosphereCompositor = nullptr;
 
     m_smoothPanTimer = new QTimer(this);
     m_smoothPanTimer->setInterval(16);
@@ -149,13 +148,6 @@ MapDisplay::MapDisplay(QWidget *parent)
     // Create loading progress widget
     m_loadingProgressWidget = new LoadingProgressWidget(this);
 
-    // Create image loader
-    m_imageLoader = new ImageLoader(this);
-    connect(m_imageLoader, &ImageLoader::progressChanged,
-            m_loadingProgressWidget, &LoadingProgressWidget::setProgress);
-    connect(m_imageLoader, &ImageLoader::statusChanged,
-            m_loadingProgressWidget, &LoadingProgressWidget::setLoadingText);
-
     // Create fog brush preview circle
     m_fogBrushPreview = new QGraphicsEllipseItem();
     m_fogBrushPreview->setVisible(false);
@@ -218,6 +210,7 @@ MapDisplay::~MapDisplay()
         m_fogMistEffect = nullptr;
         m_lightningEffect = nullptr;
         m_pointLightSystem = nullptr;
+        m_atmosphereCompositor = nullptr;
         m_mapItem = nullptr;
         m_fogBrushPreview = nullptr;
         m_selectionRectIndicator = nullptr;
@@ -239,7 +232,7 @@ bool MapDisplay::loadImage(const QString& path)
 
         // Check if we got a valid image, even if other VTT data failed
         if (!vttData.mapImage.isNull()) {
-            m_currentMap = vttData.mapImage;
+            m_currentMap = MapBuffer(vttData.mapImage, path);
 
             // Store VTT grid information if available
             if (vttData.isValid) {
@@ -254,7 +247,7 @@ bool MapDisplay::loadImage(const QString& path)
         }
     } else {
         // Load regular image
-        m_currentMap.load(path);
+        m_currentMap = MapBuffer(QImage(path), path);
         m_vttGridSize = 0;  // Reset VTT grid size for non-VTT files
     }
 
@@ -283,7 +276,7 @@ bool MapDisplay::loadImage(const QString& path)
         notifyFogChanged(dirtyRegion);
     };
 
-    SceneContents contents = SceneBuilder::buildScene(m_scene, m_currentMap, config);
+    SceneContents contents = SceneBuilder::buildScene(m_scene, m_currentMap.image(), config);
     if (!contents.mapItem) {
         return false;
     }
@@ -293,61 +286,31 @@ bool MapDisplay::loadImage(const QString& path)
     return true;
 }
 
-bool MapDisplay::loadImageWithProgress(const QString& path)
+bool MapDisplay::loadImageFromCache(const MapBuffer& map, const VTTLoader::VTTData& vttData)
 {
-    // Show progress widget
-    m_loadingProgressWidget->showProgress();
-    m_loadingProgressWidget->setProgress(0);
-    m_loadingProgressWidget->setLoadingText("Preparing to load...");
-
-    // CRITICAL FIX: Avoid multiple VTT loading
-    // Load VTT data once and reuse it throughout the method
-    VTTLoader::VTTData vttData;
-    bool isVTTFile = VTTLoader::isVTTFile(path);
-
-    if (isVTTFile) {
-        m_loadingProgressWidget->setLoadingText("Loading VTT file...");
-        m_loadingProgressWidget->setProgress(25);
-
-        // Pass progress callback to VTTLoader
-        // CRITICAL: Only process events if app is ready (after first paint)
-        auto progressCallback = [this](int percentage, const QString& message) {
-            m_loadingProgressWidget->setProgress(percentage);
-            m_loadingProgressWidget->setLoadingText(message);
-
-            // Only call processEvents if the app has been painted at least once
-            // This prevents hangs when DD2VTT is loaded as the first file
-            if (s_appReadyForProgress) {
-                QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-            }
-        };
+    if (map.isNull()) {
+        DebugConsole::warning("loadImageFromCache() - Cached image is null", "Graphics");
+        return false;
+    }
 
-        vttData = VTTLoader::loadVTT(path, progressCallback);
-        if (vttData.mapImage.isNull()) {
-            m_loadingProgressWidget->hideProgress();
-            DebugConsole::error(QString("Failed to load VTT file: %1").arg(vttData.errorMessage), "Graphics");
-            return false;
-        }
+    DebugConsole::performance("Loading from cached image (fast path)", "Loading");
 
-        m_currentMap = vttData.mapImage;
-        m_vttGridSize = vttData.isValid ? vttData.pixelsPerGrid : 0;
+    if (promotePreview(map, vttData)) {
+        updateSharedScene();
+        m_loadingProgressWidget->hideProgress();
+        return true;
+    }
 
-        m_loadingProgressWidget->setProgress(50);
-        m_loadingProgressWidget->setLoadingText("Processing VTT data...");
-    } else {
-        // Use image loader for regular images
-        m_loadingProgressWidget->setProgress(25);
-        QImage loadedImage = m_imageLoader->loadImageWithProgress(path);
+    // Show progress briefly to provide user feedback
+    m_loadingProgressWidget->showProgress();
+    m_loadingProgressWidget->setProgress(25);
+    m_loadingProgressWidget->setLoadingText("Loading from cache...");
 
-        if (loadedImage.isNull()) {
-            m_loadingProgressWidget->hideProgress();
-            return false;
-        }
+    // Share the session's buffer - no copy of the pixels
+    m_currentMap = map;
 
-        m_currentMap = loadedImage;
-        m_vttGridSize = 0;
-        m_loadingProgressWidget->setProgress(50);
-    }
+    // Set VTT grid size from cached data
+    m_vttGridSize = vttData.isValid ? vttData.pixelsPerGrid : 0;
 
     // Save fog state before clearing
     QByteArray fogState;
@@ -360,6 +323,8 @@ bool MapDisplay::loadImageWithProgress(const QString& path)
         // Point lights persist across map loads (managed via getPointLightSystem())
     }
 
+    m_loadingProgressWidget->setProgress(50);
+
     // Build scene with all overlays
     SceneConfig config;
     config.gridEnabled = m_gridEnabled;
@@ -370,7 +335,7 @@ bool MapDisplay::loadImageWithProgress(const QString& path)
         notifyFogChanged(dirtyRegion);
     };
 
-    SceneContents contents = SceneBuilder::buildScene(m_scene, m_currentMap, config);
+    SceneContents contents = SceneBuilder::buildScene(m_scene, m_currentMap.image(), config);
     if (!contents.mapItem) {
         m_loadingProgressWidget->hideProgress();
         return false;
@@ -378,128 +343,141 @@ bool MapDisplay::loadImageWithProgress(const QString& path)
 
     applySceneContents(contents);
 
-    // Apply VTT lighting and parsed lights if available
-    // CRITICAL FIX: Use already loaded VTT data instead of loading again
-    if (isVTTFile && vttData.isValid) {
-        m_loadingProgressWidget->setProgress(75);
-        m_loadingProgressWidget->setLoadingText("Applying VTT features...");
+    m_loadingProgressWidget->setProgress(75);
 
-        applyVTTLighting(vttData.globalLight, vttData.darkness);
+    // Process VTT data if available
+    if (vttData.isValid) {
+        // Apply VTT lighting data
         setParsedLights(vttData.lights);
     }
 
-    // CRITICAL FIX: Ensure progress reaches 100% before hiding
-    m_loadingProgressWidget->setProgress(100);
-    m_loadingProgressWidget->setLoadingText("Loading complete");
+    m_loadingProgressWidget->setProgress(90);
 
-    // Hide progress widget after a brief moment to show completion
-    QPointer<MapDisplay> self = this;
-    QTimer::singleShot(200, this, [self]() {
-        if (self && self->m_loadingProgressWidget) self->m_loadingProgressWidget->hideProgress();
-    });
+    // Update shared displays
+    updateSharedScene();
+
+    m_loadingProgressWidget->setProgress(100);
+    m_loadingProgressWidget->hideProgress();
 
-    // Force update of the scene to ensure map item is properly rendered
+    // CRITICAL FIX: Ensure cached image visibility
+    // Force map item visibility and scene refresh
     if (m_mapItem) {
         m_mapItem->setVisible(true);
         m_mapItem->update();
     }
 
-    // Force scene update and view refresh
+    // Ensure scene is properly updated
     if (m_scene) {
         m_scene->update();
     }
     update();
 
+    DebugConsole::performance("Successfully loaded from cache", "Graphics");
     return true;
 }
 
-bool MapDisplay::loadImageFromCache(const QImage& cachedImage, const VTTLoader::VTTData& vttData)
+void MapDisplay::showMapPreview(const QImage& preview, const QSize& mapSize, int vttGridSize)
 {
-    if (cachedImage.isNull()) {
-        DebugConsole::warning("loadImageFromCache() - Cached image is null", "Graphics");
-        return false;
+    if (mapSize.isEmpty()) {
+        return;
     }
 
-    DebugConsole::performance("Loading from cached image (fast path)", "Loading");
-
-    // Show progress briefly to provide user feedback
-    m_loadingProgressWidget->showProgress();
-    m_loadingProgressWidget->setProgress(25);
-    m_loadingProgressWidget->setLoadingText("Loading from cache...");
-
-    // Use cached image
-    m_currentMap = cachedImage;
-
-    // Set VTT grid size from cached data
-    m_vttGridSize = vttData.isValid ? vttData.pixelsPerGrid : 0;
-
-    // Save fog state before clearing
-    QByteArray fogState;
-    if (m_fogOverlay) {
-        fogState = m_fogOverlay->saveState();
+    // A second preview for the same load only swaps the stand-in
+    if (m_showingPreview && m_mapItem && mapSize == m_previewMapSize) {
+        m_mapItem->setPreview(preview, mapSize);
+        return;
     }
 
+    m_currentMap = MapBuffer();
+    m_vttGridSize = vttGridSize;
+
     if (m_lightingOverlay) {
         m_lightingOverlay->setEnabled(false);
-        // Point lights persist across map loads (managed via getPointLightSystem())
     }
 
-    m_loadingProgressWidget->setProgress(50);
-
-    // Build scene with all overlays
+    // New map: no fog carried over, the session restores its own on activation
     SceneConfig config;
     config.gridEnabled = m_gridEnabled;
     config.fogEnabled = m_fogEnabled;
     config.vttGridSize = m_vttGridSize;
-    config.fogState = fogState;
+    config.previewMapSize = mapSize;
     config.fogChangeCallback = [this](const QRectF& dirtyRegion) {
         notifyFogChanged(dirtyRegion);
     };
 
-    SceneContents contents = SceneBuilder::buildScene(m_scene, m_currentMap, config);
+    SceneContents contents = SceneBuilder::buildScene(m_scene, preview, config);
     if (!contents.mapItem) {
-        m_loadingProgressWidget->hideProgress();
-        return false;
+        return;
     }
 
     applySceneContents(contents);
+    m_showingPreview = true;
+    m_previewMapSize = mapSize;
+    updateSharedScene();
 
-    m_loadingProgressWidget->setProgress(75);
+    DebugConsole::performance(QString("Showing %1x%2 preview for %3x%4 map")
+        .arg(preview.width()).arg(preview.height())
+        .arg(mapSize.width()).arg(mapSize.height()), "Loading");
+}
 
-    // Process VTT data if available
-    if (vttData.isValid) {
-        // Apply VTT lighting data
-        setParsedLights(vttData.lights);
+void MapDisplay::discardMapPreview()
+{
+    if (!m_showingPreview) {
+        return;
     }
 
-    m_loadingProgressWidget->setProgress(90);
+    m_showingPreview = false;
+    m_previewMapSize = QSize();
+    emit sceneInvalidated();
+
+    if (m_scene) {
+        m_scene->clear();
+    }
+    m_mapItem = nullptr;
+    m_gridOverlay = nullptr;
+    m_fogOverlay = nullptr;
+    m_fogBrushPreview = nullptr;
+    m_lightingOverlay = nullptr;
+    m_weatherEffect = nullptr;
+    m_fogMistEffect = nullptr;
+    m_lightningEffect = nullptr;
+    m_pointLightSystem = nullptr;
+    m_atmosphereCompositor = nullptr;
+    m_selectionRectIndicator = nullptr;
+    m_selectedPointLightIndicator = nullptr;
+    m_lightDebugItems.clear();
 
-    // Update shared displays
     updateSharedScene();
+}
 
-    m_loadingProgressWidget->setProgress(100);
-    m_loadingProgressWidget->hideProgress();
+bool MapDisplay::promotePreview(const MapBuffer& map, const VTTLoader::VTTData& vttData)
+{
+    if (!m_showingPreview || !m_mapItem || map.size() != m_previewMapSize) {
+        return false;
+    }
 
-    // CRITICAL FIX: Ensure cached image visibility
-    // Force map item visibility and scene refresh
-    if (m_mapItem) {
-        m_mapItem->setVisible(true);
-        m_mapItem->update();
+    // Same scene rect: overlays, zoom and scroll position all stay valid
+    m_showingPreview = false;
+    m_previewMapSize = QSize();
+    m_currentMap = map;
+    m_vttGridSize = vttData.isValid ? vttData.pixelsPerGrid : 0;
+    if (m_gridOverlay && m_vttGridSize > 0) {
+        m_gridOverlay->setGridSize(m_vttGridSize);
     }
 
-    // Ensure scene is properly updated
-    if (m_scene) {
-        m_scene->update();
+    m_mapItem->setImage(m_currentMap.image());
+    if (vttData.isValid) {
+        setParsedLights(vttData.lights);
     }
-    update();
 
-    DebugConsole::performance("Successfully loaded from cache", "Graphics");
+    DebugConsole::performance("Preview replaced by full-resolution map in place", "Loading");
+    emit scenePopulated();
     return true;
 }
 
-void MapDisplay::setCachedImage(const QImage& image)
+void MapDisplay::setCachedImage(const MapBuffer& map)
 {
-    m_currentMap = image;
+    m_currentMap = map;
 }
 
 void MapDisplay::setParsedLights(const QList<VTTLoader::LightSource>& lights)
@@ -621,42 +599,29 @@ void MapDisplay::shareScene(MapDisplay* sourceDisplay)
         return;
     }
 
-    if (m_zoomAnimation) {
-        m_zoomAnimation->stop();
-    }
-    if (m_smoothPanTimer) {
-        m_smoothPanTimer->stop();
-    }
-    if (m_zoomAccumulationTimer) {
-        m_zoomAccumulationTimer->stop();
-    }
-
-    m_isZoomAnimating = false;
+    stopViewAnimations();
 
     m_ownScene = false;
     m_scene = sourceDisplay->getScene();
+    if (!sourceDisplay->m_sceneFollowers.contains(this)) {
+        sourceDisplay->m_sceneFollowers.append(this);
+    }
 
     if (m_scene) {
         setScene(m_scene);
     }
 
-    if (sourceDisplay->m_mapItem) {
-        m_mapItem = sourceDisplay->m_mapItem;
-    }
+    // Items always come from the source's current scene - after a scene
+    // swap the previous ones belong to a parked (or deleted) scene
+    m_mapItem = sourceDisplay->m_mapItem;
 
     if (!sourceDisplay->m_currentMap.isNull()) {
         m_currentMap = sourceDisplay->m_currentMap;
     }
 
-    if (sourceDisplay->m_gridOverlay) {
-        m_gridOverlay = sourceDisplay->m_gridOverlay;
-    }
-    if (sourceDisplay->m_fogOverlay) {
-        m_fogOverlay = sourceDisplay->m_fogOverlay;
-    }
-    if (sourceDisplay->m_lightingOverlay) {
-        m_lightingOverlay = sourceDisplay->m_lightingOverlay;
-    }
+    m_gridOverlay = sourceDisplay->m_gridOverlay;
+    m_fogOverlay = sourceDisplay->m_fogOverlay;
+    m_lightingOverlay = sourceDisplay->m_lightingOverlay;
     m_gridEnabled = sourceDisplay->m_gridEnabled;
     m_fogEnabled = sourceDisplay->m_fogEnabled;
 
@@ -679,6 +644,212 @@ void MapDisplay::shareScene(MapDisplay* sourceDisplay)
     update();
 }
 
+std::unique_ptr<RetainedScene> MapDisplay::detachScene()
+{
+    // Only a fully loaded scene of our own is worth keeping
+    if (!m_ownScene || !m_scene || !m_mapItem || m_showingPreview || m_currentMap.isNull()) {
+        return nullptr;
+    }
+
+    stopViewAnimations();
+    if (m_selectionRectIndicator) {
+        m_scene->removeItem(m_selectionRectIndicator);
+        delete m_selectionRectIndicator;
+        m_selectionRectIndicator = nullptr;
+    }
+    m_isSelectingRectangle = false;
+    m_isDraggingLight = false;
+
+    emit sceneInvalidated();
+
+    // A parked scene must not keep animating its effects
+    setEffectsAnimating(false);
+
+    auto retained = std::make_unique<RetainedScene>();
+    retained->zoomFactor = m_zoomFactor;
+    retained->viewCenter = mapToScene(viewport()->rect().center());
+
+    m_scene->setParent(nullptr);
+    retained->scene.reset(m_scene);
+    retained->contents.mapItem = m_mapItem;
+    retained->contents.gridOverlay = m_gridOverlay;
+    retained->contents.fogOverlay = m_fogOverlay;
+    retained->contents.fogBrushPreview = m_fogBrushPreview;
+    retained->lightingOverlay = m_lightingOverlay;
+    retained->weatherEffect = m_weatherEffect;
+    retained->fogMistEffect = m_fogMistEffect;
+    retained->lightningEffect = m_lightningEffect;
+    retained->pointLightSystem = m_pointLightSystem;
+    retained->atmosphereCompositor = m_atmosphereCompositor;
+    retained->selectedPointLightIndicator = m_selectedPointLightIndicator;
+    retained->selectedPointLightId = m_selectedPointLightId;
+    retained->lightDebugItems = m_lightDebugItems;
+    retained->mapBuffer = m_currentMap;
+    retained->vttGridSize = m_vttGridSize;
+    retained->parsedLights = m_parsedLights;
+
+    m_mapItem = nullptr;
+    m_gridOverlay = nullptr;
+    m_fogOverlay = nullptr;
+    m_fogBrushPreview = nullptr;
+    m_lightingOverlay = nullptr;
+    m_weatherEffect = nullptr;
+    m_fogMistEffect = nullptr;
+    m_lightningEffect = nullptr;
+    m_pointLightSystem = nullptr;
+    m_atmosphereCompositor = nullptr;
+    m_selectedPointLightIndicator = nullptr;
+    m_selectedPointLightId = QUuid();
+    m_lightDebugItems.clear();
+    m_parsedLights.clear();
+    m_currentMap = MapBuffer();
+    m_vttGridSize = 0;
+
+    // Continue on an empty scene; the next map is built into it
+    m_scene = new QGraphicsScene(this);
+    setScene(m_scene);
+    if (m_animationDriver) {
+        m_animationDriver->setScene(m_scene);
+    }
+    reshareWithFollowers();
+
+    return retained;
+}
+
+bool MapDisplay::attachScene(std::unique_ptr<RetainedScene>& retained)
+{
+    if (!retained || !retained->scene || !m_ownScene) {
+        return false;
+    }
+
+    stopViewAnimations();
+    emit sceneInvalidated();
+    setEffectsAnimating(false);
+
+    // Whatever is on screen now (an empty scene, a preview, or the scene of
+    // a tab that was not retained) is replaced wholesale
+    QGraphicsScene* outgoing = m_scene;
+
+    m_scene = retained->scene.release();
+    m_scene->setParent(this);
+    m_mapItem = retained->contents.mapItem;
+    m_gridOverlay = retained->contents.gridOverlay;
+    m_fogOverlay = retained->contents.fogOverlay;
+    m_fogBrushPreview = retained->contents.fogBrushPreview;
+    m_lightingOverlay = retained->lightingOverlay;
+    m_weatherEffect = retained->weatherEffect;
+    m_fogMistEffect = retained->fogMistEffect;
+    m_lightningEffect = retained->lightningEffect;
+    m_pointLightSystem = retained->pointLightSystem;
+    m_atmosphereCompositor = retained->atmosphereCompositor;
+    m_selectedPointLightIndicator = retained->selectedPointLightIndicator;
+    m_selectedPointLightId = retained->selectedPointLightId;
+    m_lightDebugItems = retained->lightDebugItems;
+    m_currentMap = retained->mapBuffer;
+    m_vttGridSize = retained->vttGridSize;
+    m_parsedLights = retained->parsedLights;
+    m_showingPreview = false;
+    m_previewMapSize = QSize();
+    m_selectionRectIndicator = nullptr;
+    const qreal zoomFactor = retained->zoomFactor;
+    const QPointF viewCenter = retained->viewCenter;
+
+    // The overlays belong to the display again, not to the parked scene
+    retained->contents = SceneContents();
+    retained.reset();
+
+    setScene(m_scene);
+    if (m_animationDriver) {
+        m_animationDriver->setScene(m_scene);
+    }
+    setEffectsAnimating(true);
+
+    if (m_atmosphereCompositingEnabled != (m_atmosphereCompositor != nullptr)) {
+        // The compositing setting changed while this scene was parked
+        const bool enabled = m_atmosphereCompositingEnabled;
+        m_atmosphereCompositingEnabled = !enabled;
+        setAtmosphereCompositingEnabled(enabled);
+    }
+
+    resetTransform();
+    scale(zoomFactor, zoomFactor);
+    m_zoomFactor = zoomFactor;
+    m_targetZoomFactor = zoomFactor;
+    centerOn(viewCenter);
+
+    reshareWithFollowers();
+    delete outgoing;
+
+    updateGrid();
+    updateFog();
+    notifyFogChanged();
+    emit zoomChanged(m_zoomFactor);
+    emit scenePopulated();
+    return true;
+}
+
+void MapDisplay::reshareWithFollowers()
+{
+    m_sceneFollowers.removeIf([](const QPointer<MapDisplay>& follower) { return follower.isNull(); });
+    for (const QPointer<MapDisplay>& follower : std::as_const(m_sceneFollowers)) {
+        follower->shareScene(this);
+    }
+}
+
+void MapDisplay::stopViewAnimations()
+{
+    if (m_zoomAnimation) {
+        m_zoomAnimation->stop();
+    }
+    if (m_smoothPanTimer) {
+        m_smoothPanTimer->stop();
+    }
+    if (m_zoomAccumulationTimer) {
+        m_zoomAccumulationTimer->stop();
+    }
+
+    m_isZoomAnimating = false;
+}
+
+void MapDisplay::setEffectsAnimating(bool animating)
+{
+    if (!m_animationDriver) {
+        return;
+    }
+
+    if (!animating) {
+        const QList<QObject*> effects = { m_weatherEffect, m_fogMistEffect, m_lightningEffect,
+                                          m_pointLightSystem, m_atmosphereCompositor };
+        for (QObject* effect : effects) {
+            if (effect) {
+                disconnect(m_animationDriver, &SceneAnimationDriver::tick, effect, nullptr);
+            }
+        }
+        return;
+    }
+
+    if (m_weatherEffect) {
+        connect(m_animationDriver, &SceneAnimationDriver::tick,
+                m_weatherEffect, &WeatherEffect::advanceAnimation, Qt::UniqueConnection);
+    }
+    if (m_fogMistEffect) {
+        connect(m_animationDriver, &SceneAnimationDriver::tick,
+                m_fogMistEffect, &FogMistEffect::advanceAnimation, Qt::UniqueConnection);
+    }
+    if (m_lightningEffect) {
+        connect(m_animationDriver, &SceneAnimationDriver::tick,
+                m_lightningEffect, &LightningEffect::advanceAnimation, Qt::UniqueConnection);
+    }
+    if (m_pointLightSystem) {
+        connect(m_animationDriver, &SceneAnimationDriver::tick,
+                m_pointLightSystem, &PointLightSystem::advanceAnimation, Qt::UniqueConnection);
+    }
+    if (m_atmosphereCompositor) {
+        connect(m_animationDriver, &SceneAnimationDriver::tick,
+                m_atmosphereCompositor, &AtmosphereCompositor::advanceAnimation, Qt::UniqueConnection);
+    }
+}
+
 void MapDisplay::updateSharedScene()
 {
     if (!m_ownScene && m_scene) {
@@ -704,21 +875,18 @@ void MapDisplay::copyMapFrom(MapDisplay* sourceDisplay)
         return;
     }
 
-    QImage sourceImage = sourceDisplay->getCurrentMapImage();
-    if (sourceImage.isNull()) {
+    // Same buffer, same pixels - only the tile pyramid is per item
+    const MapBuffer& sourceMap = sourceDisplay->getCurrentMapBuffer();
+    if (sourceMap.isNull()) {
         return;
     }
 
-
-
-    m_currentMap = sourceImage;
+    m_currentMap = sourceMap;
 
     if (m_mapItem) {
-        m_mapItem->setPixmap(QPixmap::fromImage(m_currentMap));
+        m_mapItem->setImage(m_currentMap.image());
     } else {
-        m_mapItem = new QGraphicsPixmapItem(QPixmap::fromImage(m_currentMap));
-        m_mapItem->setTransformationMode(Qt::SmoothTransformation);
-        m_mapItem->setZValue(ZLayer::Map);
+        m_mapItem = new TiledMapItem(m_currentMap.image());
 
         if (m_scene) {
             m_scene->addItem(m_mapItem);
@@ -915,6 +1083,8 @@ int MapDisplay::getGridSize() const
 
 void MapDisplay::applySceneContents(const SceneContents& contents)
 {
+    m_showingPreview = false;
+    m_previewMapSize = QSize();
     m_mapItem = contents.mapItem;
     m_gridOverlay = contents.gridOverlay;
     m_fogOverlay = contents.fogOverlay;
@@ -926,6 +1096,7 @@ void MapDisplay::applySceneContents(const SceneContents& contents)
     m_fogMistEffect = nullptr;
     m_lightningEffect = nullptr;
     m_pointLightSystem = nullptr;
+    m_atmosphereCompositor = nullptr;
     m_selectionRectIndicator = nullptr;
     m_selectedPointLightIndicator = nullptr;
     m_lightDebugItems.clear();
@@ -989,7 +1160,8 @@ void MapDisplay::fitMapToView()
 
 void MapDisplay::setInitialZoom()
 {
-    if (!m_mapItem || m_currentMap.isNull()) {
+    // A preview has the final map size, so it is fitted like the real map
+    if (!m_mapItem) {
         return;
     }
 
@@ -1647,12 +1819,6 @@ void MapDisplay::finishZoomAccumulation()
 
 void MapDisplay::paintEvent(QPaintEvent *event)
 {
-    // Set the flag after first paint - this ensures app.exec() has started
-    if (!s_appReadyForProgress) {
-        s_appReadyForProgress = true;
-        DebugConsole::system("App is now ready for progress events", "Graphics");
-    }
-
     // Call base class paintEvent first
     QGraphicsView::paintEvent(event);
 
@@ -1731,6 +1897,24 @@ bool MapDisplay::loadFogState(const QByteArray& data)
     return m_fogOverlay->loadState(data);
 }
 
+FogSnapshot MapDisplay::saveFogSnapshot() const
+{
+    if (!m_fogOverlay) {
+        return FogSnapshot();
+    }
+
+    return m_fogOverlay->snapshot();
+}
+
+bool MapDisplay::loadFogSnapshot(const FogSnapshot& snapshot)
+{
+    if (!m_fogOverlay || snapshot.isNull()) {
+        return false;
+    }
+
+    return m_fogOverlay->restoreSnapshot(snapshot);
+}
+
 void MapDisplay::connectFogChanges(QObject* receiver, const char* slot)
 {
     if (receiver) {
@@ -1833,6 +2017,7 @@ LightingOverlay* MapDisplay::getLightingOverlay()
         m_lightingOverlay->setZValue(ZLayer::LightingOverlay);
         // Keep the default enabled state from LightingOverlay constructor
         // which is true - this ensures menu state matches actual state
+        // The compositor leaves it alone: the tint stays above the tool previews
     }
     return m_lightingOverlay;
 }
@@ -1853,6 +2038,9 @@ WeatherEffect* MapDisplay::getWeatherEffect()
             connect(m_animationDriver, &SceneAnimationDriver::tick,
                     m_weatherEffect, &WeatherEffect::advanceAnimation);
         }
+        if (m_atmosphereCompositingEnabled) {
+            getAtmosphereCompositor()->setWeatherEffect(m_weatherEffect);
+        }
     }
     return m_weatherEffect;
 }
@@ -1873,6 +2061,9 @@ FogMistEffect* MapDisplay::getFogMistEffect()
             connect(m_animationDriver, &SceneAnimationDriver::tick,
                     m_fogMistEffect, &FogMistEffect::advanceAnimation);
         }
+        if (m_atmosphereCompositingEnabled) {
+            getAtmosphereCompositor()->setFogMistEffect(m_fogMistEffect);
+        }
     }
     return m_fogMistEffect;
 }
@@ -1893,6 +2084,9 @@ LightningEffect* MapDisplay::getLightningEffect()
             connect(m_animationDriver, &SceneAnimationDriver::tick,
                     m_lightningEffect, &LightningEffect::advanceAnimation);
         }
+        if (m_atmosphereCompositingEnabled) {
+            getAtmosphereCompositor()->setLightningEffect(m_lightningEffect);
+        }
     }
     return m_lightningEffect;
 }
@@ -1913,10 +2107,58 @@ PointLightSystem* MapDisplay::getPointLightSystem()
             connect(m_animationDriver, &SceneAnimationDriver::tick,
                     m_pointLightSystem, &PointLightSystem::advanceAnimation);
         }
+        if (m_atmosphereCompositingEnabled) {
+            getAtmosphereCompositor()->setPointLightSystem(m_pointLightSystem);
+        }
     }
     return m_pointLightSystem;
 }
 
+// Atmosphere compositor implementation with lazy loading
+AtmosphereCompositor* MapDisplay::getAtmosphereCompositor()
+{
+    if (!m_atmosphereCompositor) {
+        m_atmosphereCompositor = new AtmosphereCompositor();
+        m_scene->addItem(m_atmosphereCompositor);
+        // Z-value already set in AtmosphereCompositor constructor (35.0)
+        if (m_mapItem) {
+            m_atmosphereCompositor->setSceneBounds(m_mapItem->boundingRect());
+        }
+        // Wire to unified animation driver (one buffer refresh per tick)
+        if (m_animationDriver) {
+            connect(m_animationDriver, &SceneAnimationDriver::tick,
+                    m_atmosphereCompositor, &AtmosphereCompositor::advanceAnimation);
+        }
+    }
+    return m_atmosphereCompositor;
+}
+
+void MapDisplay::setAtmosphereCompositingEnabled(bool enabled)
+{
+    if (m_atmosphereCompositingEnabled == enabled) {
+        return;
+    }
+    m_atmosphereCompositingEnabled = enabled;
+
+    if (enabled) {
+        // Adopt effects that already exist; new ones are adopted on creation
+        AtmosphereCompositor* compositor = getAtmosphereCompositor();
+        compositor->setPointLightSystem(m_pointLightSystem);
+        compositor->setFogMistEffect(m_fogMistEffect);
+        compositor->setWeatherEffect(m_weatherEffect);
+        compositor->setLightningEffect(m_lightningEffect);
+    } else if (m_atmosphereCompositor) {
+        m_atmosphereCompositor->releaseEffects();
+        m_scene->removeItem(m_atmosphereCompositor);
+        delete m_atmosphereCompositor;
+        m_atmosphereCompositor = nullptr;
+    }
+
+    if (m_scene) {
+        m_scene->update();
+    }
+}
+
 // Lighting system implementation
 void MapDisplay::setLightingEnabled(bool enabled)
 {
@@ -4,16 +4,20 @@
 #include <QGraphicsView>
 #include <QImage>
 #include <QUuid>
+#include <QPointer>
 #include <memory>
 #include "utils/VTTLoader.h"
 #include "utils/ToolType.h"
+#include "utils/MapBuffer.h"
 
 class QGraphicsScene;
-class QGraphicsPixmapItem;
+class TiledMapItem;
 class QGraphicsRectItem;
 struct SceneContents;
+struct RetainedScene;
 class GridOverlay;
 class FogOfWar;
+class FogSnapshot;
 class PingIndicator;
 class GMBeacon;
 class LightingOverlay;
@@ -21,10 +25,10 @@ class WeatherEffect;
 class FogMistEffect;
 class LightningEffect;
 class PointLightSystem;
+class AtmosphereCompositor;
 class MainWindow;
 class ZoomIndicator;
 class LoadingProgressWidget;
-class ImageLoader;
 class SceneAnimationDriver;
 
 // Forward declaration for fog tool mode
@@ -43,15 +47,31 @@ public:
 
     // Core functionality
     bool loadImage(const QString& path);
-    bool loadImageWithProgress(const QString& path);
-    bool loadImageFromCache(const QImage& cachedImage, const VTTLoader::VTTData& vttData);
-    void setCachedImage(const QImage& image);
+    bool loadImageFromCache(const MapBuffer& map, const VTTLoader::VTTData& vttData);
+
+    // Progressive display: lay out the scene for a map of mapSize around a
+    // low-resolution stand-in (may be null) while the full decode runs. The
+    // next load of a same-sized image swaps the pixels in place, keeping
+    // zoom and scroll position.
+    void showMapPreview(const QImage& preview, const QSize& mapSize, int vttGridSize);
+    void discardMapPreview();
+    bool isShowingPreview() const { return m_showingPreview; }
+    void setCachedImage(const MapBuffer& map);
     void shareScene(MapDisplay* sourceDisplay);
     void updateSharedScene();  // CRITICAL FIX: Update shared displays safely
 
+    // Per-tab scenes: hand the built scene (items, effects, zoom and scroll
+    // position) to the caller and continue on an empty one, or swap a
+    // previously detached scene back in without rebuilding anything.
+    // attachScene() takes ownership only when it succeeds. Displays sharing
+    // this one's scene follow both swaps.
+    std::unique_ptr<RetainedScene> detachScene();
+    bool attachScene(std::unique_ptr<RetainedScene>& retained);
+
     // NEW: Direct map copying instead of scene sharing
     void copyMapFrom(MapDisplay* sourceDisplay);
-    QImage getCurrentMapImage() const { return m_currentMap; }
+    QImage getCurrentMapImage() const { return m_currentMap.image(); }
+    const MapBuffer& getCurrentMapBuffer() const { return m_currentMap; }
 
     // Grid control
     void setGridEnabled(bool enabled);
@@ -93,6 +113,8 @@ public:
     // Fog of War state management
     QByteArray saveFogState() const;
     bool loadFogState(const QByteArray& data);
+    FogSnapshot saveFogSnapshot() const;
+    bool loadFogSnapshot(const FogSnapshot& snapshot);
     FogOfWar* getFogOverlay() const { return m_fogOverlay; }
     void connectFogChanges(QObject* receiver, const char* slot);
 
@@ -149,6 +171,13 @@ public:
     // Get point light system (creates lazily if needed)
     PointLightSystem* getPointLightSystem();
 
+    // Paint all atmosphere overlays through one AtmosphereCompositor item
+    void setAtmosphereCompositingEnabled(bool enabled);
+    bool isAtmosphereCompositingEnabled() const { return m_atmosphereCompositingEnabled; }
+
+    // Shared animation clock - effects and atmosphere transitions advance on its tick
+    SceneAnimationDriver* getAnimationDriver() const { return m_animationDriver; }
+
     // Unified fog tool mode system
     void setMainWindow(MainWindow* mainWindow) { m_mainWindow = mainWindow; }
     MainWindow* getMainWindow() const { return m_mainWindow; }
@@ -204,20 +233,27 @@ protected:
 
 private:
     void applySceneContents(const SceneContents& contents);
+    void stopViewAnimations();
+    void setEffectsAnimating(bool animating);
+    void reshareWithFollowers();
+    bool promotePreview(const MapBuffer& map, const VTTLoader::VTTData& vttData);
     void updateGrid();
     void updateFog();
     void setInitialZoom();
     void calculateReleaseVelocity();
 
     QGraphicsScene* m_scene;
-    QGraphicsPixmapItem* m_mapItem;
+    TiledMapItem* m_mapItem;
     GridOverlay* m_gridOverlay;
     FogOfWar* m_fogOverlay;
 
-    QImage m_currentMap;
+    MapBuffer m_currentMap;
+    bool m_showingPreview = false;  // Scene holds a stand-in, m_currentMap is null
+    QSize m_previewMapSize;
     bool m_gridEnabled;
     bool m_fogEnabled;
     bool m_ownScene;  // Whether this display owns its scene
+    QList<QPointer<MapDisplay>> m_sceneFollowers;  // Displays sharing our scene
     int m_vttGridSize;  // Grid size from VTT data (0 for non-VTT files)
     int m_fogBrushSize;  // Current fog brush size in pixels
     bool m_fogHideModeEnabled;  // Whether fog hide mode is active
@@ -264,7 +300,6 @@ private:
 
     // Loading progress indicator
     LoadingProgressWidget* m_loadingProgressWidget;
-    ImageLoader* m_imageLoader;
 
     // Zoom cursor tracking (to avoid lambda capture issues)
     QPointF m_zoomCursorPos;
@@ -290,6 +325,11 @@ private:
     // Point light system (QPainter-based radial gradients)
     PointLightSystem* m_pointLightSystem;
 
+    // Optional single-item compositor for the overlays above (created lazily)
+    AtmosphereCompositor* m_atmosphereCompositor;
+    bool m_atmosphereCompositingEnabled;
+    AtmosphereCompositor* getAtmosphereCompositor();
+
     // Unified animation driver for all atmosphere effects
     SceneAnimationDriver* m_animationDriver;
 
@@ -336,9 +376,6 @@ private:
     QList<class QGraphicsEllipseItem*> m_lightDebugItems;
     bool m_showParsedLights = false;
     void updateParsedLightOverlays();
-
-    // Static flag to track if app is ready for progress events
-    static bool s_appReadyForProgress;
 };
 
 #endif // MAPDISPLAY_H
@@ -1,5 +1,6 @@
 #include "PointLightSystem.h"
 #include "graphics/ZLayers.h"
+#include "graphics/ImageCache.h"
 #include <QPainter>
 #include <QRadialGradient>
 #include <QDateTime>
@@ -247,7 +248,7 @@ void PointLightSystem::paint(QPainter* painter, const QStyleOptionGraphicsItem*
         qreal flickerMod = 1.0;
         if (light.flickering) {
             // Use multiple sine waves for organic flicker
-            qreal phase = m_flickerPhase + light.id.toString().length() * 0.1;  // Offset per light
+            qreal phase = m_flickerPhase + (qHash(light.id) % 64) * 0.1;  // Offset per light
             flickerMod = 1.0 - light.flickerAmount * (
                 0.5 * qSin(phase * 2.3) +
                 0.3 * qSin(phase * 5.7) +
@@ -269,24 +270,48 @@ void PointLightSystem::paintLight(QPainter* painter, const PointLight& light, qr
         return;
     }
 
-    // Create radial gradient for this light
-    QRadialGradient gradient(light.position, light.radius);
+    const QPixmap sprite = lightSprite(light);
+
+    // Premultiplied sprite: opacity scales colour and alpha together, the
+    // same as building the gradient with an intensity-scaled alpha. Scale the
+    // inherited item/effect opacity rather than replacing it.
+    const qreal savedOpacity = painter->opacity();
+    painter->setOpacity(savedOpacity * qBound(0.0, effectiveIntensity, 1.0));
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+    const QRectF target(light.position.x() - light.radius, light.position.y() - light.radius,
+                        light.radius * 2, light.radius * 2);
+    painter->drawPixmap(target, sprite, QRectF(sprite.rect()));
+    painter->setOpacity(savedOpacity);
+}
 
-    // Calculate color with intensity
-    QColor centerColor = light.color;
-    int alpha = static_cast<int>(qBound(0.0, effectiveIntensity * 255, 255.0));
-    centerColor.setAlpha(alpha);
+QPixmap PointLightSystem::lightSprite(const PointLight& light)
+{
+    ImageCacheKey key;
+    key.imagePath = QStringLiteral("light-sprite");
+    key.targetSize = QSize(SPRITE_SIZE, SPRITE_SIZE);
+    key.variant = (quint64(ImageCacheKey::quantize(light.falloff)) << 32) | light.color.rgb();
+
+    ImageCache& cache = ImageCacheManager::instance();
+    QPixmap sprite = cache.getCachedPixmap(key);
+    if (!sprite.isNull()) {
+        return sprite;
+    }
+
+    const qreal radius = SPRITE_SIZE / 2.0;
+    const QPointF center(radius, radius);
+    QRadialGradient gradient(center, radius);
 
     // Create falloff stops based on falloff curve
     // falloff = 1.0 is linear, 2.0 is quadratic (faster dropoff)
+    QColor centerColor = light.color;
+    centerColor.setAlpha(255);
     gradient.setColorAt(0.0, centerColor);
 
     // Intermediate stops for smoother falloff
     for (qreal t = 0.2; t < 1.0; t += 0.2) {
         qreal falloffFactor = 1.0 - qPow(t, light.falloff);
-        int stopAlpha = static_cast<int>(alpha * falloffFactor);
         QColor stopColor = light.color;
-        stopColor.setAlpha(qMax(0, stopAlpha));
+        stopColor.setAlpha(qMax(0, static_cast<int>(255 * falloffFactor)));
         gradient.setColorAt(t, stopColor);
     }
 
@@ -295,8 +320,16 @@ void PointLightSystem::paintLight(QPainter* painter, const PointLight& light, qr
     edgeColor.setAlpha(0);
     gradient.setColorAt(1.0, edgeColor);
 
-    // Draw the light circle
-    painter->setPen(Qt::NoPen);
-    painter->setBrush(gradient);
-    painter->drawEllipse(light.position, light.radius, light.radius);
+    QImage image(SPRITE_SIZE, SPRITE_SIZE, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter spritePainter(&image);
+    spritePainter.setRenderHint(QPainter::Antialiasing, true);
+    spritePainter.setPen(Qt::NoPen);
+    spritePainter.setBrush(gradient);
+    spritePainter.drawEllipse(center, radius, radius);
+    spritePainter.end();
+
+    sprite = QPixmap::fromImage(image);
+    cache.setCachedPixmap(key, sprite);
+    return sprite;
 }
@@ -6,6 +6,7 @@
 #include <QTimer>
 #include <QList>
 #include <QHash>
+#include <QPixmap>
 #include "PointLight.h"
 
 class MapDisplay;
@@ -75,6 +76,11 @@ private slots:
 private:
     void paintLight(QPainter* painter, const PointLight& light, qreal flickerMod);
 
+    // Full-intensity falloff sprite for a light's colour and falloff, shared
+    // through the ImageCache; paintLight scales it and applies intensity
+    // as opacity instead of building a gradient every frame
+    static QPixmap lightSprite(const PointLight& light);
+
     // Light storage
     QHash<QUuid, PointLight> m_lights;
 
@@ -94,6 +100,8 @@ private:
     // Timer intervals
     static constexpr int FLICKER_INTERVAL_MS = 50;  // 20 FPS for flicker
 
+    static constexpr int SPRITE_SIZE = 256;  // Smooth falloff upscales cleanly
+
 };
 
 #endif // POINTLIGHTSYSTEM_H
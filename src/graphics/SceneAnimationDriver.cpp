@@ -1,4 +1,5 @@
 #include "graphics/SceneAnimationDriver.h"
+#include "graphics/FrameArena.h"
 #include <QGraphicsScene>
 
 SceneAnimationDriver::SceneAnimationDriver(QObject* parent)
@@ -51,6 +52,9 @@ void SceneAnimationDriver::onTimeout()
     qreal dt = m_elapsed.restart() / 1000.0;
     dt = qMin(dt, 0.1);  // Cap to prevent huge jumps after stalls
 
+    // New frame: paint temporaries of the previous one are no longer in use
+    FrameArena::instance().reset();
+
     emit tick(dt);
 
     // Single scene update for all animated items
@@ -2,10 +2,9 @@
 #include "graphics/GridOverlay.h"
 #include "graphics/FogOfWar.h"
 #include "graphics/ZLayers.h"
+#include "graphics/TiledMapItem.h"
 #include "utils/DebugConsole.h"
-#include <QGraphicsPixmapItem>
 #include <QGraphicsEllipseItem>
-#include <QPixmap>
 
 SceneContents SceneBuilder::buildScene(
     QGraphicsScene* scene,
@@ -14,7 +13,8 @@ SceneContents SceneBuilder::buildScene(
 {
     SceneContents contents;
 
-    if (!scene || mapImage.isNull()) {
+    const bool isPreview = config.previewMapSize.isValid();
+    if (!scene || (mapImage.isNull() && !isPreview)) {
         DebugConsole::error("SceneBuilder: null scene or image", "Rendering");
         return contents;
     }
@@ -22,19 +22,21 @@ SceneContents SceneBuilder::buildScene(
     // 1. Clear scene (deletes all items)
     scene->clear();
 
-    // 2. Create map pixmap item
-    QPixmap pixmap = QPixmap::fromImage(mapImage);
-    contents.mapItem = scene->addPixmap(pixmap);
-    if (!contents.mapItem) {
-        DebugConsole::error("SceneBuilder: failed to create map item", "Rendering");
-        return contents;
+    // 2. Create tiled map item (pyramid levels build in the background)
+    QSize mapSize = mapImage.size();
+    if (isPreview) {
+        contents.mapItem = new TiledMapItem(QImage());
+        contents.mapItem->setPreview(mapImage, config.previewMapSize);
+        mapSize = config.previewMapSize;
+    } else {
+        contents.mapItem = new TiledMapItem(mapImage);
     }
-    contents.mapItem->setZValue(ZLayer::Map);
-    scene->setSceneRect(pixmap.rect());
+    scene->addItem(contents.mapItem);
+    scene->setSceneRect(QRectF(QPointF(0, 0), mapSize));
 
     // 3. Create grid overlay
     contents.gridOverlay = new GridOverlay();
-    contents.gridOverlay->setMapSize(pixmap.size());
+    contents.gridOverlay->setMapSize(mapSize);
     if (config.vttGridSize > 0) {
         contents.gridOverlay->setGridSize(config.vttGridSize);
     }
@@ -45,7 +47,7 @@ SceneContents SceneBuilder::buildScene(
 
     // 4. Create fog overlay
     contents.fogOverlay = new FogOfWar();
-    contents.fogOverlay->setMapSize(pixmap.size());
+    contents.fogOverlay->setMapSize(mapSize);
     if (!config.fogState.isEmpty()) {
         contents.fogOverlay->loadState(config.fogState);
     }
@@ -63,8 +65,33 @@ SceneContents SceneBuilder::buildScene(
     contents.fogBrushPreview->setZValue(ZLayer::BrushPreview);
     scene->addItem(contents.fogBrushPreview);
 
-    DebugConsole::info(QString("SceneBuilder: scene built (%1x%2)")
-        .arg(pixmap.width()).arg(pixmap.height()), "Rendering");
+    DebugConsole::info(QString("SceneBuilder: %1 built (%2x%3)")
+        .arg(isPreview ? "preview scene" : "scene")
+        .arg(mapSize.width()).arg(mapSize.height()), "Rendering");
 
     return contents;
 }
+
+RetainedScene::~RetainedScene()
+{
+    // Disabled overlays were never added, so the scene would not delete them
+    if (contents.gridOverlay && !contents.gridOverlay->scene()) {
+        delete contents.gridOverlay;
+    }
+    if (contents.fogOverlay && !contents.fogOverlay->scene()) {
+        delete contents.fogOverlay;
+    }
+    scene.reset();
+}
+
+qint64 RetainedScene::memoryBytes() const
+{
+    qint64 bytes = 0;
+    if (contents.mapItem) {
+        bytes += contents.mapItem->pyramidBytes();
+    }
+    if (contents.fogOverlay) {
+        bytes += contents.fogOverlay->getFogMask().sizeInBytes();
+    }
+    return bytes;
+}
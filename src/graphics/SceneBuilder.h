@@ -4,28 +4,71 @@
 #include <QGraphicsScene>
 #include <QImage>
 #include <QByteArray>
+#include <QUuid>
 #include <functional>
+#include <memory>
+#include "utils/VTTLoader.h"
+#include "utils/MapBuffer.h"
 
-class QGraphicsPixmapItem;
+class TiledMapItem;
 class QGraphicsEllipseItem;
 class GridOverlay;
 class FogOfWar;
+class LightingOverlay;
+class WeatherEffect;
+class FogMistEffect;
+class LightningEffect;
+class PointLightSystem;
+class AtmosphereCompositor;
 
 struct SceneConfig {
     bool gridEnabled = true;
     bool fogEnabled = false;
     int vttGridSize = 0;
     QByteArray fogState;
+    // When valid, mapImage is a low-resolution stand-in for a map of this size
+    QSize previewMapSize;
     std::function<void(const QRectF&)> fogChangeCallback;
 };
 
 struct SceneContents {
-    QGraphicsPixmapItem* mapItem = nullptr;
+    TiledMapItem* mapItem = nullptr;
     GridOverlay* gridOverlay = nullptr;
     FogOfWar* fogOverlay = nullptr;
     QGraphicsEllipseItem* fogBrushPreview = nullptr;
 };
 
+// A fully built scene parked while its tab is inactive (see
+// MapDisplay::detachScene). Owns the scene, plus the grid and fog overlays
+// when they are disabled and so not part of it.
+struct RetainedScene {
+    ~RetainedScene();
+
+    // Memory the scene holds beyond the map image it shares with the
+    // session: pyramid levels and the fog mask
+    qint64 memoryBytes() const;
+
+    std::unique_ptr<QGraphicsScene> scene;
+    SceneContents contents;
+
+    // Lazily created effects, when they exist
+    LightingOverlay* lightingOverlay = nullptr;
+    WeatherEffect* weatherEffect = nullptr;
+    FogMistEffect* fogMistEffect = nullptr;
+    LightningEffect* lightningEffect = nullptr;
+    PointLightSystem* pointLightSystem = nullptr;
+    AtmosphereCompositor* atmosphereCompositor = nullptr;
+    QGraphicsEllipseItem* selectedPointLightIndicator = nullptr;
+    QUuid selectedPointLightId;
+    QList<QGraphicsEllipseItem*> lightDebugItems;
+
+    MapBuffer mapBuffer;
+    int vttGridSize = 0;
+    QList<VTTLoader::LightSource> parsedLights;
+    qreal zoomFactor = 1.0;
+    QPointF viewCenter;
+};
+
 class SceneBuilder {
 public:
     // Build all overlays in the given scene for the given map image.
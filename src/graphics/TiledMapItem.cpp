@@ -0,0 +1,379 @@
+#include "graphics/TiledMapItem.h"
+#include "graphics/ZLayers.h"
+#include "utils/DebugConsole.h"
+#include "utils/ImageLoader.h"
+#include "utils/MemoryManager.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QThreadPool>
+#include <QCoreApplication>
+#include <QPointer>
+#include <QElapsedTimer>
+#include <QCache>
+#include <QtMath>
+
+namespace {
+
+// Uploaded tiles of every TiledMapItem, keyed by (owner, tile). Tiles
+// re-upload on demand, so the budget may trim them; shrinking drops least
+// recently drawn tiles first, so the visible ones survive. GUI thread only.
+class SharedTileCache
+{
+public:
+    using Key = QPair<quint64, quint64>;
+
+    static SharedTileCache& instance()
+    {
+        // Never destroyed, like ImageCacheManager: pixmaps must not outlive the app
+        static SharedTileCache* cache = new SharedTileCache();
+        return *cache;
+    }
+
+    QCache<Key, QPixmap> tiles;
+
+    quint64 newOwner() { return ++m_lastOwner; }
+
+    // Drawn just now, so the map on screen is not the budget's first pick
+    void touch() { MemoryManager::instance().touchConsumer(m_consumerId); }
+
+    void removeOwner(quint64 owner)
+    {
+        const QList<Key> keys = tiles.keys();
+        for (const Key& key : keys) {
+            if (key.first == owner) {
+                tiles.remove(key);
+            }
+        }
+    }
+
+private:
+    SharedTileCache()
+    {
+        MemoryManager& memory = MemoryManager::instance();
+        tiles.setMaxCost(budgetKB(memory.getMaxMemoryLimit()));
+        QObject::connect(&memory, &MemoryManager::memoryLimitChanged, &memory, [this](qint64 bytes) {
+            tiles.setMaxCost(budgetKB(bytes));
+        });
+        m_consumerId = memory.registerConsumer(QStringLiteral("Map tiles"),
+            [this]() { return qint64(tiles.totalCost()) * 1024; },
+            [this](qint64 bytesWanted) {
+                const qint64 before = tiles.totalCost();
+                const qsizetype maxCost = tiles.maxCost();
+                tiles.setMaxCost(qMax<qint64>(0, before - bytesWanted / 1024));
+                tiles.setMaxCost(maxCost);
+                return (before - tiles.totalCost()) * 1024;
+            });
+    }
+
+    static qsizetype budgetKB(qint64 limitBytes)
+    {
+        return qsizetype(limitBytes * TiledMapItem::TILE_BUDGET_FRACTION / 1024);
+    }
+
+    int m_consumerId = 0;
+    quint64 m_lastOwner = 0;
+};
+
+} // namespace
+
+TiledMapItem::TiledMapItem(const QImage& image, QGraphicsItem* parent)
+    : QObject(nullptr)
+    , QGraphicsItem(parent)
+{
+    setZValue(ZLayer::Map);
+    // exposedRect is only filled in with this flag - paint() relies on it
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);
+
+    setImage(image);
+}
+
+TiledMapItem::~TiledMapItem()
+{
+    cancelPyramidBuild();
+    releaseTiles();
+}
+
+void TiledMapItem::releaseTiles()
+{
+    SharedTileCache& cache = SharedTileCache::instance();
+    if (m_tileOwner != 0) {
+        cache.removeOwner(m_tileOwner);
+    }
+    m_tileOwner = cache.newOwner();
+}
+
+QRectF TiledMapItem::boundingRect() const
+{
+    return QRectF(QPointF(0, 0), m_size);
+}
+
+qint64 TiledMapItem::pyramidBytes() const
+{
+    qint64 bytes = qint64(m_preview.width()) * m_preview.height() * 4;
+    for (int level = 1; level < m_levels.size(); ++level) {
+        if (!m_fileBacked.at(level)) {
+            bytes += m_levels.at(level).sizeInBytes();
+        }
+    }
+    return bytes;
+}
+
+void TiledMapItem::setImage(const QImage& image)
+{
+    cancelPyramidBuild();
+
+    if (image.size() != m_size) {
+        prepareGeometryChange();
+        m_size = image.size();
+        m_preview = QPixmap();
+    }
+    m_source = image;
+    m_levels.clear();
+    m_fileBacked.clear();
+    releaseTiles();
+    m_pyramidReady = false;
+
+    if (m_source.isNull()) {
+        m_preview = QPixmap();
+        return;
+    }
+
+    m_levels.append(m_source);
+    m_fileBacked.append(false);
+    startPyramidBuild();
+    update();
+}
+
+void TiledMapItem::setPreview(const QImage& preview, const QSize& mapSize)
+{
+    cancelPyramidBuild();
+
+    if (mapSize != m_size) {
+        prepareGeometryChange();
+        m_size = mapSize;
+    }
+    m_source = QImage();
+    m_levels.clear();
+    m_fileBacked.clear();
+    releaseTiles();
+    m_pyramidReady = false;
+    m_preview = QPixmap::fromImage(preview);
+    update();
+}
+
+void TiledMapItem::cancelPyramidBuild()
+{
+    if (m_cancelFlag) {
+        m_cancelFlag->store(true);
+        m_cancelFlag.reset();
+    }
+    ++m_generation;
+}
+
+void TiledMapItem::startPyramidBuild()
+{
+    // Already fits in one tile - level 0 is the whole pyramid
+    if (qMax(m_source.width(), m_source.height()) <= TILE_SIZE) {
+        m_pyramidReady = true;
+        m_preview = QPixmap();
+        return;
+    }
+
+    const quint64 generation = m_generation;
+    const QImage source = m_source;
+    auto cancelFlag = std::make_shared<std::atomic<bool>>(false);
+    m_cancelFlag = cancelFlag;
+
+    // The item can be deleted by scene->clear() while the build runs, so
+    // results go through the application object and a guard, never `this`
+    QPointer<TiledMapItem> guard(this);
+    auto post = [guard](auto&& apply) {
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [guard, apply]() {
+            if (guard) {
+                apply(guard.data());
+            }
+        }, Qt::QueuedConnection);
+    };
+
+    QThreadPool::globalInstance()->start([source, generation, cancelFlag, post]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        // Nearest-neighbour preview only touches the output pixels, so it is
+        // ready long before the first smooth level of a huge map
+        const QImage preview = source.scaled(PREVIEW_SIZE, PREVIEW_SIZE,
+                                             Qt::KeepAspectRatio, Qt::FastTransformation);
+        post([generation, preview](TiledMapItem* item) {
+            item->adoptPreview(generation, preview);
+        });
+
+        QImage current = source;
+        int level = 0;
+        while (qMax(current.width(), current.height()) > TILE_SIZE) {
+            if (cancelFlag->load(std::memory_order_relaxed)) {
+                return;
+            }
+            current = current.scaled(qMax(1, (current.width() + 1) / 2),
+                                     qMax(1, (current.height() + 1) / 2),
+                                     Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            // The next level is scaled from the mapping, so the heap copy goes now
+            bool fileBacked = false;
+            current = ImageLoader::toFileBacked(current, &fileBacked);
+            ++level;
+            post([generation, level, current, fileBacked](TiledMapItem* item) {
+                item->adoptLevel(generation, level, current, fileBacked);
+            });
+        }
+
+        DebugConsole::performance(
+            QString("TiledMapItem: %1 pyramid levels for %2x%3 built in %4 ms")
+                .arg(level + 1)
+                .arg(source.width())
+                .arg(source.height())
+                .arg(timer.elapsed()),
+            "Rendering");
+
+        post([generation](TiledMapItem* item) {
+            item->finishPyramid(generation);
+        });
+    });
+}
+
+void TiledMapItem::adoptPreview(quint64 generation, const QImage& preview)
+{
+    if (generation != m_generation || m_pyramidReady) {
+        return;
+    }
+    m_preview = QPixmap::fromImage(preview);
+    update();
+}
+
+void TiledMapItem::adoptLevel(quint64 generation, int level, const QImage& image, bool fileBacked)
+{
+    // Levels arrive in order on the GUI thread
+    if (generation != m_generation || level != m_levels.size()) {
+        return;
+    }
+    m_levels.append(image);
+    m_fileBacked.append(fileBacked);
+    update();
+}
+
+void TiledMapItem::finishPyramid(quint64 generation)
+{
+    if (generation != m_generation) {
+        return;
+    }
+    m_cancelFlag.reset();
+    m_pyramidReady = true;
+    m_preview = QPixmap();
+    update();
+    emit pyramidReady();
+}
+
+int TiledMapItem::levelForScale(qreal scale) const
+{
+    // Finest level that still has at least one texel per device pixel
+    if (scale >= 1.0 || scale <= 0.0) {
+        return 0;
+    }
+    return qFloor(std::log2(1.0 / scale));
+}
+
+quint64 TiledMapItem::tileKey(int level, int column, int row)
+{
+    return (quint64(level) << 48) | (quint64(row) << 24) | quint64(column);
+}
+
+QPixmap TiledMapItem::tilePixmap(int level, int column, int row)
+{
+    QCache<SharedTileCache::Key, QPixmap>& tiles = SharedTileCache::instance().tiles;
+    const SharedTileCache::Key key(m_tileOwner, tileKey(level, column, row));
+    if (QPixmap* cached = tiles.object(key)) {
+        return *cached;
+    }
+
+    const QImage& levelImage = m_levels.at(level);
+    const QRect tileRect = QRect(column * TILE_SIZE, row * TILE_SIZE, TILE_SIZE, TILE_SIZE)
+                               & levelImage.rect();
+    if (tileRect.isEmpty()) {
+        return QPixmap();
+    }
+
+    // View into the level's pixels - fromImage makes the only copy.
+    // Sub-byte formats can't be addressed that way and fall back to copy().
+    QPixmap* tile = nullptr;
+    if (levelImage.depth() >= 8) {
+        const int bytesPerPixel = levelImage.depth() / 8;
+        const QImage view(levelImage.constScanLine(tileRect.y()) + tileRect.x() * bytesPerPixel,
+                          tileRect.width(), tileRect.height(), levelImage.bytesPerLine(),
+                          levelImage.format());
+        tile = new QPixmap(QPixmap::fromImage(view));
+    } else {
+        tile = new QPixmap(QPixmap::fromImage(levelImage.copy(tileRect)));
+    }
+    const QPixmap result = *tile;
+
+    const int costKB = qMax(1, int(qint64(tileRect.width()) * tileRect.height() * 4 / 1024));
+    tiles.insert(key, tile, costKB);
+    return result;
+}
+
+void TiledMapItem::paintLevel(QPainter* painter, const QRectF& exposed, int level)
+{
+    const QImage& levelImage = m_levels.at(level);
+    const qreal scaleX = qreal(m_size.width()) / levelImage.width();
+    const qreal scaleY = qreal(m_size.height()) / levelImage.height();
+
+    const int firstColumn = qMax(0, qFloor(exposed.left() / scaleX / TILE_SIZE));
+    const int lastColumn = qMin((levelImage.width() - 1) / TILE_SIZE,
+                                qFloor(exposed.right() / scaleX / TILE_SIZE));
+    const int firstRow = qMax(0, qFloor(exposed.top() / scaleY / TILE_SIZE));
+    const int lastRow = qMin((levelImage.height() - 1) / TILE_SIZE,
+                             qFloor(exposed.bottom() / scaleY / TILE_SIZE));
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const QPixmap tile = tilePixmap(level, column, row);
+            if (tile.isNull()) {
+                continue;
+            }
+            const QRectF target(column * TILE_SIZE * scaleX, row * TILE_SIZE * scaleY,
+                                tile.width() * scaleX, tile.height() * scaleY);
+            painter->drawPixmap(target, tile, QRectF(tile.rect()));
+        }
+    }
+}
+
+void TiledMapItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                         QWidget* /*widget*/)
+{
+    if (m_levels.isEmpty()) {
+        // Preview only: full-resolution pixels are still decoding
+        if (!m_preview.isNull()) {
+            painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+            painter->drawPixmap(boundingRect(), m_preview, QRectF(m_preview.rect()));
+        }
+        return;
+    }
+
+    const QRectF exposed = option->exposedRect & boundingRect();
+    if (exposed.isEmpty()) {
+        return;
+    }
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+    SharedTileCache::instance().touch();
+
+    const qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    const int wanted = levelForScale(scale);
+
+    // Coarse level not built yet: far zoomed out, level 0 would page in the
+    // whole map, so stretch the preview until the pyramid catches up
+    if (wanted >= m_levels.size() && !m_pyramidReady && !m_preview.isNull() && wanted > 1) {
+        painter->drawPixmap(boundingRect(), m_preview, QRectF(m_preview.rect()));
+        return;
+    }
+
+    paintLevel(painter, exposed, qMin(wanted, m_levels.size() - 1));
+}
@@ -0,0 +1,95 @@
+#ifndef TILEDMAPITEM_H
+#define TILEDMAPITEM_H
+
+#include <QGraphicsItem>
+#include <QObject>
+#include <QImage>
+#include <QPixmap>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+// Map image drawn from a tiled multi-resolution pyramid.
+// Level 0 is the source image itself (shared, never copied); level N halves
+// level N-1 until the whole map fits in one tile. The coarser levels are
+// built once on a worker thread, with a cheap preview shown meanwhile.
+// Levels as large as ImageLoader::FILE_BACKED_MIN_BYTES are paged out to a
+// file-backed mapping as they are built (huge sources already arrive that
+// way from MapLoadPipeline), so heap use stays bounded whatever the map size.
+//
+// paint() picks the level matching the view scale and draws only the tiles
+// that intersect the exposed rect. Tiles become QPixmaps on first use and
+// live in one LRU cache shared by every item (retained hot-tab scenes,
+// the visible map) and sized from the MemoryManager budget, so there is no
+// full-size pixmap and zoomed-out panning of huge maps touches a handful of
+// small tiles.
+// Z-value: 0 (Map)
+class TiledMapItem : public QObject, public QGraphicsItem
+{
+    Q_OBJECT
+    Q_INTERFACES(QGraphicsItem)
+
+public:
+    enum { Type = UserType + 1 };
+
+    explicit TiledMapItem(const QImage& image, QGraphicsItem* parent = nullptr);
+    ~TiledMapItem() override;
+
+    // QGraphicsItem interface
+    int type() const override { return Type; }
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+               QWidget* widget = nullptr) override;
+
+    // Replace the map image (restarts the pyramid build). A preview of the
+    // same size stays on screen until the new levels arrive.
+    void setImage(const QImage& image);
+    QImage image() const { return m_source; }
+
+    // Stretch a low-resolution stand-in over mapSize until setImage()
+    void setPreview(const QImage& preview, const QSize& mapSize);
+    bool isPreview() const { return m_source.isNull() && !m_preview.isNull(); }
+
+    // Levels built so far, including level 0
+    int levelCount() const { return m_levels.size(); }
+    bool isPyramidReady() const { return m_pyramidReady; }
+
+    // Heap held by levels 1..N plus the preview; level 0 is the caller's
+    // image and file-backed levels are not counted
+    qint64 pyramidBytes() const;
+
+    static constexpr int TILE_SIZE = 512;
+    static constexpr int PREVIEW_SIZE = 1024;           // Stand-in while levels are building
+    static constexpr double TILE_BUDGET_FRACTION = 0.1; // Of the MemoryManager limit, all items
+
+signals:
+    void pyramidReady();
+
+private:
+    void startPyramidBuild();
+    void cancelPyramidBuild();
+    void adoptPreview(quint64 generation, const QImage& preview);
+    void adoptLevel(quint64 generation, int level, const QImage& image, bool fileBacked);
+    void finishPyramid(quint64 generation);
+
+    int levelForScale(qreal scale) const;
+    QPixmap tilePixmap(int level, int column, int row);
+    void paintLevel(QPainter* painter, const QRectF& exposed, int level);
+
+    static quint64 tileKey(int level, int column, int row);
+    void releaseTiles();
+
+    QImage m_source;
+    QSize m_size;              // Map size in scene units (preview or source)
+    QVector<QImage> m_levels;  // m_levels[0] shares m_source
+    QVector<bool> m_fileBacked;  // Per level, see ImageLoader::toFileBacked
+    QPixmap m_preview;
+    bool m_pyramidReady = false;
+
+    quint64 m_tileOwner = 0;  // Key prefix in the shared tile cache, renewed per image
+
+    quint64 m_generation = 0;  // Drops results of a superseded build
+    std::shared_ptr<std::atomic<bool>> m_cancelFlag;
+};
+
+#endif // TILEDMAPITEM_H
@@ -4,6 +4,10 @@
 #include <QDateTime>
 #include <QRandomGenerator>
 #include <QtMath>
+#include <QThreadPool>
+#include <QRunnable>
+#include <algorithm>
+#include "graphics/FrameArena.h"
 #include "utils/DebugConsole.h"
 
 WeatherEffect::WeatherEffect(QGraphicsItem* parent)
@@ -15,37 +19,48 @@ WeatherEffect::WeatherEffect(QGraphicsItem* parent)
     , m_sceneScale(1.0)
     , m_updateTimer(new QTimer(this))
     , m_lastUpdateTime(0)
-    , m_transitionTimer(new QTimer(this))
     , m_targetType(WeatherType::None)
     , m_startIntensity(0.0)
     , m_targetIntensity(0.0)
-    , m_transitionStartTime(0)
+    , m_transitionElapsed(0.0)
     , m_transitionDuration(1000)
     , m_isTransitioning(false)
 {
     setZValue(ZLayer::Weather);
 
-    // Reserve particle pool
+    // Reserve both particle buffers
     m_particles.reserve(MAX_PARTICLES);
+    m_simParticles.reserve(MAX_PARTICLES);
+
+    // One dedicated worker keeps particle integration off the GUI thread
+    m_simulationPool = new QThreadPool(this);
+    m_simulationPool->setMaxThreadCount(1);
+
+    // One task object reused for every step, so ticking allocates nothing.
+    // Front buffer is read-only while the step runs, so the worker may copy from it
+    m_simulationTask.reset(QRunnable::create([this]() {
+        m_simParticles.resize(m_particles.size());
+        std::copy(m_particles.cbegin(), m_particles.cend(), m_simParticles.begin());
+        updateParticles(m_simParticles, m_stepParams, m_stepDeltaTime);
+        m_simulationBusy.store(false, std::memory_order_release);
+    }));
+    m_simulationTask->setAutoDelete(false);
 
     // Setup update timer
     connect(m_updateTimer, &QTimer::timeout, this, &WeatherEffect::onUpdateTick);
 
-    // Setup transition timer
-    connect(m_transitionTimer, &QTimer::timeout, this, &WeatherEffect::onTransitionTick);
-
     // Initialize last update time
     m_lastUpdateTime = QDateTime::currentMSecsSinceEpoch();
 }
 
 WeatherEffect::~WeatherEffect()
 {
+    // Worker references our buffers - let the in-flight step finish first
+    m_simulationPool->waitForDone();
+
     if (m_updateTimer->isActive()) {
         m_updateTimer->stop();
     }
-    if (m_transitionTimer->isActive()) {
-        m_transitionTimer->stop();
-    }
 }
 
 QRectF WeatherEffect::boundingRect() const
@@ -103,6 +118,7 @@ void WeatherEffect::setIntensity(qreal intensity)
 
 void WeatherEffect::setWindStrength(qreal strength)
 {
+    // Picked up by the next simulation step via simulationParams()
     m_windStrength = qBound(-1.0, strength, 1.0);
 }
 
@@ -140,7 +156,9 @@ void WeatherEffect::setEnabled(bool enabled)
             // Timer no longer auto-started — SceneAnimationDriver calls advanceAnimation()
         } else {
             m_updateTimer->stop();
+            waitForSimulation();
             m_particles.clear();
+            m_simParticles.clear();
         }
 
         update();
@@ -156,8 +174,8 @@ void WeatherEffect::transitionTo(WeatherType type, qreal intensity, int duration
     m_targetType = type;
     m_startIntensity = m_intensity;
     m_targetIntensity = intensity;
-    m_transitionDuration = durationMs;
-    m_transitionStartTime = QDateTime::currentMSecsSinceEpoch();
+    m_transitionDuration = qMax(1, durationMs);
+    m_transitionElapsed = 0.0;
     m_isTransitioning = true;
 
     // If changing type, set it immediately but start at 0 intensity
@@ -171,21 +189,70 @@ void WeatherEffect::transitionTo(WeatherType type, qreal intensity, int duration
     if (!m_enabled && type != WeatherType::None) {
         setEnabled(true);
     }
-
-    m_transitionTimer->start(TRANSITION_INTERVAL_MS);
+    // Progress is advanced from advanceAnimation() on the shared scene tick
 }
 
 void WeatherEffect::advanceAnimation(qreal dt)
 {
+    if (m_isTransitioning) {
+        advanceTransition(dt);
+    }
+
     if (!m_enabled || m_weatherType == WeatherType::None) {
         return;
     }
 
     // dt is already capped by SceneAnimationDriver
-    updateParticles(dt);
+    m_pendingDeltaTime += dt;
+
+    // Worker still integrating the previous step: keep painting the current
+    // front buffer and fold this tick's time into the next step
+    if (m_simulationBusy.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // Publish the finished step - a pointer swap, paint() never waits on a lock
+    if (m_simulationResultPending) {
+        m_particles.swap(m_simParticles);
+        m_simulationResultPending = false;
+    }
+
+    startSimulationStep(qMin(m_pendingDeltaTime, 0.1));
+    m_pendingDeltaTime = 0.0;
     // Do NOT call update() — SceneAnimationDriver handles scene->update()
 }
 
+WeatherEffect::SimulationParams WeatherEffect::simulationParams() const
+{
+    return SimulationParams{ m_sceneBounds, m_sceneScale, m_windStrength, m_weatherType };
+}
+
+void WeatherEffect::startSimulationStep(qreal deltaTime)
+{
+    if (m_particles.isEmpty()) {
+        return;
+    }
+
+    // Only written while no step is in flight; the pool's queue hand-off
+    // publishes them to the worker
+    m_stepParams = simulationParams();
+    m_stepDeltaTime = deltaTime;
+    m_simulationBusy.store(true, std::memory_order_relaxed);
+    m_simulationResultPending = true;
+
+    m_simulationPool->start(m_simulationTask.get());
+}
+
+void WeatherEffect::waitForSimulation()
+{
+    // Barrier before the GUI thread rewrites the particle buffers; the
+    // in-flight result is based on stale state and is dropped
+    m_simulationPool->waitForDone();
+    m_simulationBusy.store(false, std::memory_order_relaxed);
+    m_simulationResultPending = false;
+    m_pendingDeltaTime = 0.0;
+}
+
 void WeatherEffect::onUpdateTick()
 {
     if (!m_enabled || m_weatherType == WeatherType::None) {
@@ -199,20 +266,16 @@ void WeatherEffect::onUpdateTick()
     // Cap delta time to prevent huge jumps
     deltaTime = qMin(deltaTime, 0.1);
 
-    updateParticles(deltaTime);
+    // Legacy fallback path integrates synchronously on the GUI thread
+    waitForSimulation();
+    updateParticles(m_particles, simulationParams(), deltaTime);
     update();  // Request repaint
 }
 
-void WeatherEffect::onTransitionTick()
+void WeatherEffect::advanceTransition(qreal dt)
 {
-    if (!m_isTransitioning) {
-        m_transitionTimer->stop();
-        return;
-    }
-
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    qint64 elapsed = currentTime - m_transitionStartTime;
-    qreal progress = qBound(0.0, static_cast<qreal>(elapsed) / m_transitionDuration, 1.0);
+    m_transitionElapsed += dt;
+    qreal progress = qBound(0.0, m_transitionElapsed * 1000.0 / m_transitionDuration, 1.0);
 
     // Smooth easing
     qreal easedProgress = 0.5 - 0.5 * qCos(progress * M_PI);
@@ -221,7 +284,6 @@ void WeatherEffect::onTransitionTick()
 
     if (progress >= 1.0) {
         m_isTransitioning = false;
-        m_transitionTimer->stop();
         m_intensity = m_targetIntensity;
 
         // Disable if transitioning to none or zero intensity
@@ -242,12 +304,16 @@ void WeatherEffect::onTransitionTick()
 
 void WeatherEffect::initializeParticles()
 {
+    waitForSimulation();
     m_particles.clear();
+    m_simParticles.clear();
 
     if (m_weatherType == WeatherType::None || !m_sceneBounds.isValid()) {
         return;
     }
 
+    const SimulationParams params = simulationParams();
+
     // Calculate particle count based on intensity and scene size
     qreal area = m_sceneBounds.width() * m_sceneBounds.height();
     qreal densityFactor = area / (1000.0 * 1000.0);  // Normalize to 1000x1000
@@ -258,7 +324,7 @@ void WeatherEffect::initializeParticles()
 
     // Initialize each particle
     for (int i = 0; i < particleCount; ++i) {
-        spawnParticle(m_particles[i]);
+        spawnParticle(m_particles[i], params);
         // Randomize initial position throughout the scene
         m_particles[i].position.setY(
             m_sceneBounds.top() +
@@ -267,46 +333,51 @@ void WeatherEffect::initializeParticles()
     }
 }
 
-void WeatherEffect::updateParticles(qreal deltaTime)
+// Runs on the simulation worker: reads only params, particles and constant settings
+void WeatherEffect::updateParticles(QVector<WeatherParticle>& particles,
+                                    const SimulationParams& params, qreal deltaTime) const
 {
-    if (!m_sceneBounds.isValid()) {
+    if (!params.sceneBounds.isValid()) {
         return;
     }
 
-    for (auto& particle : m_particles) {
+    const QRectF& bounds = params.sceneBounds;
+    const qreal sceneScale = params.sceneScale;
+
+    for (auto& particle : particles) {
         // Apply wind to velocity (scaled)
-        qreal windEffect = m_windStrength * 200.0 * m_sceneScale;
+        qreal windEffect = params.windStrength * 200.0 * sceneScale;
 
         // Update position
         particle.position += particle.velocity * deltaTime;
         particle.position.rx() += windEffect * deltaTime;
 
         // Add wobble for snow (scaled)
-        if (m_weatherType == WeatherType::Snow) {
-            qreal wobble = qSin(particle.lifetime * 3.0) * m_snowSettings.wobbleAmount * m_sceneScale;
+        if (params.weatherType == WeatherType::Snow) {
+            qreal wobble = qSin(particle.lifetime * 3.0) * m_snowSettings.wobbleAmount * sceneScale;
             particle.position.rx() += wobble * deltaTime;
             particle.lifetime += deltaTime;
         }
 
         // Check if particle is out of bounds (scaled margin)
-        qreal margin = 50.0 * m_sceneScale;
+        qreal margin = 50.0 * sceneScale;
         bool outOfBounds = false;
-        if (particle.position.y() > m_sceneBounds.bottom()) {
+        if (particle.position.y() > bounds.bottom()) {
             outOfBounds = true;
-        } else if (particle.position.x() < m_sceneBounds.left() - margin ||
-                   particle.position.x() > m_sceneBounds.right() + margin) {
+        } else if (particle.position.x() < bounds.left() - margin ||
+                   particle.position.x() > bounds.right() + margin) {
             outOfBounds = true;
         }
 
         if (outOfBounds) {
-            spawnParticle(particle);
+            spawnParticle(particle, params);
         }
     }
 }
 
-void WeatherEffect::spawnParticle(WeatherParticle& particle)
+void WeatherEffect::spawnParticle(WeatherParticle& particle, const SimulationParams& params) const
 {
-    if (!m_sceneBounds.isValid()) {
+    if (!params.sceneBounds.isValid()) {
         return;
     }
 
@@ -314,28 +385,28 @@ void WeatherEffect::spawnParticle(WeatherParticle& particle)
 
     // Spawn at top of scene with random X position
     particle.position.setX(
-        m_sceneBounds.left() + rng->generateDouble() * m_sceneBounds.width()
+        params.sceneBounds.left() + rng->generateDouble() * params.sceneBounds.width()
     );
-    particle.position.setY(m_sceneBounds.top() - 10 * m_sceneScale);
+    particle.position.setY(params.sceneBounds.top() - 10 * params.sceneScale);
 
-    switch (m_weatherType) {
+    switch (params.weatherType) {
         case WeatherType::Rain:
         case WeatherType::Storm: {
             // Scale speed and size based on scene scale
             qreal baseSpeed = m_rainSettings.minSpeed +
                          rng->generateDouble() * (m_rainSettings.maxSpeed - m_rainSettings.minSpeed);
-            qreal speed = baseSpeed * m_sceneScale;
+            qreal speed = baseSpeed * params.sceneScale;
 
             // Storm has more horizontal movement
-            qreal horizontalSpeed = (m_weatherType == WeatherType::Storm) ?
-                                   (rng->generateDouble() - 0.5) * 200.0 * m_sceneScale : 0.0;
+            qreal horizontalSpeed = (params.weatherType == WeatherType::Storm) ?
+                                   (rng->generateDouble() - 0.5) * 200.0 * params.sceneScale : 0.0;
 
             particle.velocity = QPointF(horizontalSpeed, speed);
 
             // Scale rain length
             qreal baseSize = m_rainSettings.minLength +
                            rng->generateDouble() * (m_rainSettings.maxLength - m_rainSettings.minLength);
-            particle.size = baseSize * m_sceneScale;
+            particle.size = baseSize * params.sceneScale;
             particle.opacity = 0.3 + rng->generateDouble() * 0.7;
             break;
         }
@@ -344,13 +415,13 @@ void WeatherEffect::spawnParticle(WeatherParticle& particle)
             // Scale speed based on scene scale
             qreal baseSpeed = m_snowSettings.minSpeed +
                          rng->generateDouble() * (m_snowSettings.maxSpeed - m_snowSettings.minSpeed);
-            qreal speed = baseSpeed * m_sceneScale;
+            qreal speed = baseSpeed * params.sceneScale;
             particle.velocity = QPointF(0, speed);
 
             // Scale snowflake size
             qreal baseSize = m_snowSettings.minSize +
                            rng->generateDouble() * (m_snowSettings.maxSize - m_snowSettings.minSize);
-            particle.size = baseSize * m_sceneScale;
+            particle.size = baseSize * params.sceneScale;
             particle.opacity = 0.5 + rng->generateDouble() * 0.5;
             particle.lifetime = rng->generateDouble() * 10.0;  // Random phase for wobble
             break;
@@ -365,45 +436,59 @@ void WeatherEffect::paintRain(QPainter* painter)
 {
     if (m_particles.isEmpty()) return;
 
-    QColor rainColor = m_rainSettings.color;
-    rainColor.setAlphaF(rainColor.alphaF() * m_intensity);
-
-    // Scale pen width based on scene scale
-    qreal scaledWidth = m_rainSettings.width * m_sceneScale;
+    // Pens only change with intensity and scene scale, not per frame
+    if (m_rainPenIntensity != m_intensity || m_rainPenScale != m_sceneScale) {
+        QColor rainColor = m_rainSettings.color;
+        rainColor.setAlphaF(rainColor.alphaF() * m_intensity);
+
+        // Scale pen width based on scene scale
+        const qreal scaledWidth = m_rainSettings.width * m_sceneScale;
+        for (int i = 0; i < RAIN_BUCKETS; ++i) {
+            qreal bucketOpacity = (i + 0.5) / RAIN_BUCKETS;  // Mid-point of bucket
+            QColor bucketColor = rainColor;
+            bucketColor.setAlphaF(rainColor.alphaF() * bucketOpacity);
+            m_rainPens[i] = QPen(bucketColor, scaledWidth, Qt::SolidLine, Qt::RoundCap);
+        }
+        m_rainPenIntensity = m_intensity;
+        m_rainPenScale = m_sceneScale;
+    }
 
     // OPTIMIZATION: Batch particles by opacity bucket to minimize QPen changes
-    // Use 10 buckets (0.0-0.1, 0.1-0.2, ... 0.9-1.0)
-    constexpr int NUM_BUCKETS = 10;
-    QVector<QLineF> buckets[NUM_BUCKETS];
+    // (0.0-0.1, 0.1-0.2, ... 0.9-1.0). Bucket arrays come from the frame
+    // arena, sized exactly by a counting pass.
+    auto bucketOf = [](const WeatherParticle& particle) {
+        return qBound(0, static_cast<int>(particle.opacity * RAIN_BUCKETS), RAIN_BUCKETS - 1);
+    };
+    int counts[RAIN_BUCKETS] = {};
+    for (const auto& particle : m_particles) {
+        ++counts[bucketOf(particle)];
+    }
 
-    // Pre-allocate bucket capacity
-    int avgPerBucket = m_particles.size() / NUM_BUCKETS + 1;
-    for (int i = 0; i < NUM_BUCKETS; ++i) {
-        buckets[i].reserve(avgPerBucket);
+    FrameArena& arena = FrameArena::instance();
+    QLineF* buckets[RAIN_BUCKETS];
+    int filled[RAIN_BUCKETS] = {};
+    for (int i = 0; i < RAIN_BUCKETS; ++i) {
+        buckets[i] = arena.allocate<QLineF>(counts[i]);
     }
 
     // Sort particles into opacity buckets and pre-compute lines
     for (const auto& particle : m_particles) {
-        int bucket = qBound(0, static_cast<int>(particle.opacity * NUM_BUCKETS), NUM_BUCKETS - 1);
+        const int bucket = bucketOf(particle);
 
         // Pre-compute line direction
         qreal len = std::sqrt(particle.velocity.x() * particle.velocity.x() +
                               particle.velocity.y() * particle.velocity.y());
         QPointF dir = (len > 0.001) ? (particle.velocity / len) * particle.size : QPointF(0, 1) * particle.size;
 
-        buckets[bucket].append(QLineF(particle.position, particle.position + dir));
+        buckets[bucket][filled[bucket]++] = QLineF(particle.position, particle.position + dir);
     }
 
     // Draw each bucket with a single pen
-    for (int i = 0; i < NUM_BUCKETS; ++i) {
-        if (buckets[i].isEmpty()) continue;
+    for (int i = 0; i < RAIN_BUCKETS; ++i) {
+        if (counts[i] == 0) continue;
 
-        qreal bucketOpacity = (i + 0.5) / NUM_BUCKETS;  // Mid-point of bucket
-        QColor bucketColor = rainColor;
-        bucketColor.setAlphaF(rainColor.alphaF() * bucketOpacity);
-
-        painter->setPen(QPen(bucketColor, scaledWidth, Qt::SolidLine, Qt::RoundCap));
-        painter->drawLines(buckets[i]);  // Batch draw all lines in bucket
+        painter->setPen(m_rainPens[i]);
+        painter->drawLines(buckets[i], counts[i]);  // Batch draw all lines in bucket
     }
 }
 
@@ -413,39 +498,51 @@ void WeatherEffect::paintSnow(QPainter* painter)
 
     painter->setPen(Qt::NoPen);
 
+    // Brushes only change with intensity, not per frame
+    if (m_snowBrushIntensity != m_intensity) {
+        const QColor snowColor = m_snowSettings.color;
+        for (int i = 0; i < SNOW_BUCKETS; ++i) {
+            qreal bucketOpacity = (i + 0.5) / SNOW_BUCKETS;  // Mid-point of bucket
+            QColor bucketColor = snowColor;
+            bucketColor.setAlphaF(snowColor.alphaF() * m_intensity * bucketOpacity);
+            m_snowBrushes[i] = QBrush(bucketColor);
+        }
+        m_snowBrushIntensity = m_intensity;
+    }
+
     // OPTIMIZATION: Batch particles into opacity buckets, draw all rects per bucket
     // in a single drawRects() call. ~5 draw calls instead of ~500 drawEllipse calls.
     // Antialiasing is disabled for snow (set in paint()) — squares look fine at this scale.
-    constexpr int NUM_BUCKETS = 5;
-
-    QVector<QRectF> buckets[NUM_BUCKETS];
+    auto bucketOf = [](const WeatherParticle& particle) {
+        return qBound(0, static_cast<int>(particle.opacity * SNOW_BUCKETS), SNOW_BUCKETS - 1);
+    };
+    int counts[SNOW_BUCKETS] = {};
+    for (const auto& particle : m_particles) {
+        ++counts[bucketOf(particle)];
+    }
 
-    // Pre-allocate bucket capacity
-    int avgPerBucket = m_particles.size() / NUM_BUCKETS + 1;
-    for (int i = 0; i < NUM_BUCKETS; ++i) {
-        buckets[i].reserve(avgPerBucket);
+    FrameArena& arena = FrameArena::instance();
+    QRectF* buckets[SNOW_BUCKETS];
+    int filled[SNOW_BUCKETS] = {};
+    for (int i = 0; i < SNOW_BUCKETS; ++i) {
+        buckets[i] = arena.allocate<QRectF>(counts[i]);
     }
 
     // Sort particles into opacity buckets, building QRectF directly
     for (const auto& particle : m_particles) {
-        int bucket = qBound(0, static_cast<int>(particle.opacity * NUM_BUCKETS), NUM_BUCKETS - 1);
-        buckets[bucket].append(QRectF(
+        const int bucket = bucketOf(particle);
+        buckets[bucket][filled[bucket]++] = QRectF(
             particle.position.x() - particle.size,
             particle.position.y() - particle.size,
             particle.size * 2.0,
-            particle.size * 2.0));
+            particle.size * 2.0);
     }
 
     // Draw each bucket with a single brush + single drawRects call
-    QColor snowColor = m_snowSettings.color;
-    for (int i = 0; i < NUM_BUCKETS; ++i) {
-        if (buckets[i].isEmpty()) continue;
-
-        qreal bucketOpacity = (i + 0.5) / NUM_BUCKETS;  // Mid-point of bucket
-        QColor bucketColor = snowColor;
-        bucketColor.setAlphaF(snowColor.alphaF() * m_intensity * bucketOpacity);
+    for (int i = 0; i < SNOW_BUCKETS; ++i) {
+        if (counts[i] == 0) continue;
 
-        painter->setBrush(bucketColor);
-        painter->drawRects(buckets[i].constData(), buckets[i].size());
+        painter->setBrush(m_snowBrushes[i]);
+        painter->drawRects(buckets[i], counts[i]);
     }
 }
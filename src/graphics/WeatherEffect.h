@@ -6,6 +6,13 @@
 #include <QVector>
 #include <QPointF>
 #include <QColor>
+#include <QPen>
+#include <QBrush>
+#include <atomic>
+#include <memory>
+
+class QRunnable;
+class QThreadPool;
 
 // Weather type enumeration
 enum class WeatherType {
@@ -69,12 +76,27 @@ signals:
 
 private slots:
     void onUpdateTick();
-    void onTransitionTick();
 
 private:
+    // Immutable snapshot of everything the simulation reads, so the worker
+    // never touches members the GUI thread may be changing
+    struct SimulationParams {
+        QRectF sceneBounds;
+        qreal sceneScale;
+        qreal windStrength;
+        WeatherType weatherType;
+    };
+    SimulationParams simulationParams() const;
+
     void initializeParticles();
-    void updateParticles(qreal deltaTime);
-    void spawnParticle(WeatherParticle& particle);
+    void advanceTransition(qreal dt);
+    void updateParticles(QVector<WeatherParticle>& particles, const SimulationParams& params,
+                         qreal deltaTime) const;
+    void spawnParticle(WeatherParticle& particle, const SimulationParams& params) const;
+
+    // Off-thread simulation
+    void startSimulationStep(qreal deltaTime);
+    void waitForSimulation();
     void paintRain(QPainter* painter);
     void paintSnow(QPainter* painter);
 
@@ -84,10 +106,22 @@ private:
     qreal m_windStrength;   // -1.0 to 1.0
     bool m_enabled;
 
-    // Particle pool
+    // Particle pool, double-buffered:
+    // m_particles is the front buffer - only read by paint(), only swapped on the GUI thread.
+    // m_simParticles is the back buffer - written by the worker while a step is in flight.
     QVector<WeatherParticle> m_particles;
+    QVector<WeatherParticle> m_simParticles;
     static constexpr int MAX_PARTICLES = 500;
 
+    // Worker (single thread) and hand-off state
+    QThreadPool* m_simulationPool;
+    std::unique_ptr<QRunnable> m_simulationTask;  // Reused every step, never auto-deleted
+    SimulationParams m_stepParams{};            // Inputs of the step in flight
+    qreal m_stepDeltaTime = 0.0;
+    std::atomic<bool> m_simulationBusy{false};  // Released by the worker when a step finishes
+    bool m_simulationResultPending = false;     // Back buffer holds a finished step to swap in
+    qreal m_pendingDeltaTime = 0.0;             // Time accumulated while the worker was busy
+
     // Scene bounds for particle spawning
     QRectF m_sceneBounds;
     qreal m_sceneScale;  // Scale factor based on scene size
@@ -96,12 +130,11 @@ private:
     QTimer* m_updateTimer;
     qint64 m_lastUpdateTime;
 
-    // Transition support
-    QTimer* m_transitionTimer;
+    // Transition support (advanced by the SceneAnimationDriver tick)
     WeatherType m_targetType;
     qreal m_startIntensity;
     qreal m_targetIntensity;
-    qint64 m_transitionStartTime;
+    qreal m_transitionElapsed;  // seconds
     int m_transitionDuration;
     bool m_isTransitioning;
 
@@ -124,9 +157,17 @@ private:
         qreal wobbleAmount = 30.0;  // Horizontal drift
     } m_snowSettings;
 
+    // Per-bucket pens/brushes, rebuilt only when what they depend on changes
+    static constexpr int RAIN_BUCKETS = 10;
+    static constexpr int SNOW_BUCKETS = 5;
+    QPen m_rainPens[RAIN_BUCKETS];
+    qreal m_rainPenIntensity = -1.0;
+    qreal m_rainPenScale = -1.0;
+    QBrush m_snowBrushes[SNOW_BUCKETS];
+    qreal m_snowBrushIntensity = -1.0;
+
     // Timer intervals
     static constexpr int UPDATE_INTERVAL_MS = 33;  // ~30 FPS
-    static constexpr int TRANSITION_INTERVAL_MS = 16;  // 60 FPS for smooth transitions
 
 };
 
@@ -10,6 +10,7 @@ namespace ZLayer {
     constexpr qreal Fog             = 20.0;
     constexpr qreal Beacons         = 30.0;
     constexpr qreal PointLights     = 35.0;
+    constexpr qreal AtmosphereComposite = 35.0;  // Optional compositor, replaces the 35-70 overlays
     constexpr qreal FogMist         = 40.0;
     constexpr qreal Weather         = 50.0;
     constexpr qreal Lightning       = 70.0;
@@ -13,10 +13,20 @@
 #include "ui/MainWindow.h"
 #include "ui/DarkTheme.h"
 #include "utils/DebugConsole.h"
+#include "utils/DecodedMapCacheCheck.h"
 #include "utils/LogHandler.h"
+#include "utils/ImageLoader.h"
+#include "utils/PixelFormatBenchmark.h"
+#include "utils/SessionStressBenchmark.h"
+#include "utils/EffectsBenchmark.h"
+#include "utils/SettingsManager.h"
+#include "utils/StartupProfiler.h"
+#include "utils/ThemeBenchmark.h"
 
 int main(int argc, char *argv[])
 {
+    StartupProfiler::start();
+
     // Initialize Qt resources (handled automatically by qt6_add_resources)
     // Ensure Qt can find platform/imageformat plugins even before QApplication constructs
     // Prefer Homebrew Qt plugin paths to avoid codesign issues with bundled plugins
@@ -70,6 +80,7 @@ int main(int argc, char *argv[])
 
     // Install file-based log handler (writes to AppData/logs/critvtt.log)
     LogHandler::install();
+    StartupProfiler::mark("application");
 
     // Verify critical plugin support
     // DebugConsole::system(QString("Qt plugin paths: %1").arg(QCoreApplication::libraryPaths().join(", ")), "System");
@@ -117,26 +128,11 @@ int main(int argc, char *argv[])
     if (!formats.contains("png")) {
         // DebugConsole::warning("PNG support missing - some features may not work properly", "System");
     }
+    StartupProfiler::mark("image formats");
 
-    // Apply hardcoded dark theme
-    QString fullStyleSheet = DarkTheme::getApplicationStyleSheet() +
-                             DarkTheme::getButtonStyleSheet() +
-                             DarkTheme::getMenuStyleSheet() +
-                             DarkTheme::getSliderStyleSheet() +
-                             DarkTheme::getTabStyleSheet() +
-                             DarkTheme::getScrollBarStyleSheet() +
-                             DarkTheme::getToolboxStyleSheet() +
-                             R"(
-        QToolTip {
-            background-color: #2d2d2d;
-            color: #E0E0E0;
-            border: 1px solid #4A90E2;
-            border-radius: 4px;
-            padding: 6px 10px;
-            font-size: 12px;
-        }
-    )";
-    app.setStyleSheet(fullStyleSheet);
+    // Dark theme drawn by a proxy style and palette; no application stylesheet
+    DarkTheme::apply(app);
+    StartupProfiler::mark("theme");
 
 
     // Set application metadata
@@ -171,6 +167,38 @@ int main(int argc, char *argv[])
         "Test mode: Load image, verify rendering, and exit with status code");
     parser.addOption(testRenderOption);
 
+    // Check the decoded map cache budget rules in a scratch directory and exit
+    QCommandLineOption testDecodedCacheOption("test-decoded-cache",
+        "Test mode: Verify decoded map cache eviction rules and exit with status code");
+    parser.addOption(testDecodedCacheOption);
+
+    // Print load/convert/upload/blit costs per storage format for a map and exit
+    QCommandLineOption benchmarkFormatsOption("benchmark-formats",
+        "Benchmark map pixel formats for the given map file and exit");
+    parser.addOption(benchmarkFormatsOption);
+
+    // Open a campaign's worth of generated maps as tabs, print RSS and switch latency and exit
+    QCommandLineOption benchmarkSessionsOption("benchmark-sessions",
+        QString("Benchmark memory and tab switching with %1 open maps and exit")
+            .arg(SessionStressBenchmark::DEFAULT_SESSIONS));
+    parser.addOption(benchmarkSessionsOption);
+
+    // Run the atmosphere overlays off screen, print frame time and per-frame allocations and exit
+    QCommandLineOption benchmarkEffectsOption("benchmark-effects",
+        "Benchmark per-frame cost of weather, mist and light effects and exit");
+    parser.addOption(benchmarkEffectsOption);
+
+    // Build the side docks off screen, print build and repaint cost with and without the former
+    // stylesheets and exit; fails unless the theme repaints every panel faster
+    QCommandLineOption benchmarkThemeOption("benchmark-theme",
+        "Benchmark side panel build and repaint cost under the theme and exit");
+    parser.addOption(benchmarkThemeOption);
+
+    // Start normally without reopening the last session, print the startup phases once idle and exit
+    QCommandLineOption benchmarkStartupOption("benchmark-startup",
+        "Print startup phase timings once the window is up and exit");
+    parser.addOption(benchmarkStartupOption);
+
     // Process the actual command line arguments
     parser.process(app);
 
@@ -181,16 +209,65 @@ int main(int argc, char *argv[])
         mapFile = args.first();
     }
 
-    // Apply premium theme application-wide
-    // Set global application style
+    if (parser.isSet(testDecodedCacheOption)) {
+        const DecodedMapCacheCheck::Report report = DecodedMapCacheCheck::run();
+        std::cout << report.toText().toStdString() << std::flush;
+        return report.ok() ? 0 : 1;
+    }
+
+    if (parser.isSet(benchmarkFormatsOption)) {
+        if (mapFile.isEmpty()) {
+            std::cerr << "--benchmark-formats needs a map file" << std::endl;
+            return 1;
+        }
+        ImageLoader::setPixelFormatPolicy(static_cast<ImageLoader::PixelFormatPolicy>(
+            qBound(0, SettingsManager::instance().loadPixelFormatPolicy(),
+                   int(ImageLoader::PixelFormatPolicy::Memory))));
+        const PixelFormatBenchmark::Report report = PixelFormatBenchmark::run(mapFile);
+        std::cout << report.toText().toStdString() << std::flush;
+        return report.errorMessage.isEmpty() ? 0 : 1;
+    }
+
+    if (parser.isSet(benchmarkSessionsOption)) {
+        const SessionStressBenchmark::Report report = SessionStressBenchmark::run();
+        std::cout << report.toText().toStdString() << std::flush;
+        return report.errorMessage.isEmpty() ? 0 : 1;
+    }
+
+    if (parser.isSet(benchmarkEffectsOption)) {
+        const EffectsBenchmark::Report report = EffectsBenchmark::run();
+        std::cout << report.toText().toStdString() << std::flush;
+        return report.errorMessage.isEmpty() ? 0 : 1;
+    }
+
+    if (parser.isSet(benchmarkThemeOption)) {
+        const ThemeBenchmark::Report report = ThemeBenchmark::run();
+        std::cout << report.toText().toStdString() << std::flush;
+        return report.themeIsFaster() ? 0 : 1;
+    }
 
     // Check if we're in test mode
     bool testMode = parser.isSet(testRenderOption);
+    const bool benchmarkStartup = parser.isSet(benchmarkStartupOption);
+    StartupProfiler::mark("settings and command line");
 
     // Create and show the main window
     MainWindow mainWindow;
     mainWindow.setWindowTitle("Crit VTT - DM Control");
     mainWindow.show();
+    StartupProfiler::mark("show");
+
+    if (benchmarkStartup) {
+        QObject::connect(&mainWindow, &MainWindow::startupCompleted, &app, [&app]() {
+            std::cout << StartupProfiler::toText().toStdString() << std::flush;
+            app.exit(StartupProfiler::interactiveMs() >= 0.0 ? 0 : 1);
+        });
+    }
+
+    // Last session's tabs first, so a map given on the command line opens on top
+    if (!testMode && !benchmarkStartup) {
+        mainWindow.restoreLastSession();
+    }
 
     // Load map file if provided
     if (!mapFile.isEmpty()) {
@@ -54,8 +54,8 @@ AtmosphereToolboxWidget::AtmosphereToolboxWidget(QWidget* parent)
     m_debounceTimer->setInterval(DEBOUNCE_MS);
     connect(m_debounceTimer, &QTimer::timeout, this, &AtmosphereToolboxWidget::applyCurrentState);
 
-    setupUI();
     applyDarkTheme();
+    setupUI();
     populatePresetCombo();
     connectSignals();
 }
@@ -126,7 +126,7 @@ void AtmosphereToolboxWidget::createPresetsSection()
     comboLayout->addWidget(m_presetCombo, 1);
 
     m_modifiedLabel = new QLabel();
-    m_modifiedLabel->setStyleSheet("color: #F39C12; font-size: 10px;");
+    DarkTheme::setTextStyle(m_modifiedLabel, DarkTheme::AccentWarning, 10);
     m_modifiedLabel->hide();
     comboLayout->addWidget(m_modifiedLabel);
 
@@ -157,7 +157,7 @@ void AtmosphereToolboxWidget::createPresetsSection()
     todLayout->setSpacing(4);
 
     QLabel* todLabel = new QLabel(tr("Time of Day:"));
-    todLabel->setStyleSheet("color: #A0A0A0; font-size: 11px;");
+    DarkTheme::setTextStyle(todLabel, DarkTheme::TextSecondary, DarkTheme::FontSmall);
     todLayout->addWidget(todLabel);
 
     QWidget* todButtons = new QWidget();
@@ -237,7 +237,7 @@ void AtmosphereToolboxWidget::createLightingSection()
 
     QLabel* tintLabel = new QLabel(tr("Tint"));
     tintLabel->setFixedWidth(70);
-    tintLabel->setStyleSheet("color: #A0A0A0; font-size: 11px;");
+    DarkTheme::setTextStyle(tintLabel, DarkTheme::TextSecondary, DarkTheme::FontSmall);
     tintLayout->addWidget(tintLabel);
 
     m_lightingTintButton = new ColorPickerButton(Qt::white);
@@ -249,7 +249,8 @@ void AtmosphereToolboxWidget::createLightingSection()
 
     // DM-only section label
     QLabel* dmOnlyLabel = new QLabel(tr("DM View Only:"));
-    dmOnlyLabel->setStyleSheet("color: #808080; font-size: 10px; margin-top: 8px;");
+    DarkTheme::setTextStyle(dmOnlyLabel, DarkTheme::TextMuted, 10);
+    dmOnlyLabel->setContentsMargins(0, 8, 0, 0);
     m_lightingSection->addWidget(dmOnlyLabel);
 
     // Brightness slider (DM only)
@@ -285,7 +286,7 @@ void AtmosphereToolboxWidget::createWeatherSection()
 
     QLabel* typeLabel = new QLabel(tr("Type"));
     typeLabel->setFixedWidth(70);
-    typeLabel->setStyleSheet("color: #A0A0A0; font-size: 11px;");
+    DarkTheme::setTextStyle(typeLabel, DarkTheme::TextSecondary, DarkTheme::FontSmall);
     typeLayout->addWidget(typeLabel);
 
     m_weatherTypeCombo = new QComboBox();
@@ -352,7 +353,7 @@ void AtmosphereToolboxWidget::createFogSection()
 
     QLabel* colorLabel = new QLabel(tr("Color"));
     colorLabel->setFixedWidth(70);
-    colorLabel->setStyleSheet("color: #A0A0A0; font-size: 11px;");
+    DarkTheme::setTextStyle(colorLabel, DarkTheme::TextSecondary, DarkTheme::FontSmall);
     colorLayout->addWidget(colorLabel);
 
     m_fogColorButton = new ColorPickerButton(QColor(180, 180, 200, 128));
@@ -420,11 +421,11 @@ void AtmosphereToolboxWidget::createAudioSection()
 
     // --- Ambient Sound subsection ---
     QLabel* ambientHeader = new QLabel(tr("Ambient Sound"));
-    ambientHeader->setStyleSheet("font-weight: bold; color: #E0E0E0;");
+    DarkTheme::setTextStyle(ambientHeader, DarkTheme::TextPrimary, 0, QFont::Bold);
     m_audioSection->addWidget(ambientHeader);
 
     m_ambientTrackLabel = new QLabel(tr("No track loaded"));
-    m_ambientTrackLabel->setStyleSheet("color: #808080; font-style: italic;");
+    DarkTheme::setTextStyle(m_ambientTrackLabel, DarkTheme::TextMuted, 0, QFont::Normal, true);
     m_ambientTrackLabel->setWordWrap(true);
     m_audioSection->addWidget(m_ambientTrackLabel);
 
@@ -450,21 +451,24 @@ void AtmosphereToolboxWidget::createAudioSection()
     // --- Separator ---
     QFrame* separator = new QFrame();
     separator->setFrameShape(QFrame::HLine);
-    separator->setStyleSheet("color: #3A3A3A;");
+    separator->setFrameShadow(QFrame::Plain);
+    QPalette separatorPalette = separator->palette();
+    separatorPalette.setColor(QPalette::WindowText, DarkTheme::BorderColor);
+    separator->setPalette(separatorPalette);
     m_audioSection->addWidget(separator);
 
     // --- Music Remote subsection ---
     QLabel* musicHeader = new QLabel(tr("Music Remote"));
-    musicHeader->setStyleSheet("font-weight: bold; color: #E0E0E0;");
+    DarkTheme::setTextStyle(musicHeader, DarkTheme::TextPrimary, 0, QFont::Bold);
     m_audioSection->addWidget(musicHeader);
 
     m_nowPlayingLabel = new QLabel(tr("No music playing"));
-    m_nowPlayingLabel->setStyleSheet("color: #808080;");
+    DarkTheme::setTextStyle(m_nowPlayingLabel, DarkTheme::TextMuted);
     m_nowPlayingLabel->setWordWrap(true);
     m_audioSection->addWidget(m_nowPlayingLabel);
 
     m_nowPlayingArtist = new QLabel("");
-    m_nowPlayingArtist->setStyleSheet("color: #808080;");
+    DarkTheme::setTextStyle(m_nowPlayingArtist, DarkTheme::TextMuted);
     m_audioSection->addWidget(m_nowPlayingArtist);
 
     // Transport controls
@@ -477,7 +481,7 @@ void AtmosphereToolboxWidget::createAudioSection()
     m_musicNextButton = new QPushButton(QString::fromUtf8("\xe2\x8f\xad"));
     for (auto* btn : {m_musicPrevButton, m_musicPlayPauseButton, m_musicNextButton}) {
         btn->setFixedSize(36, 36);
-        btn->setStyleSheet("QPushButton { font-size: 16px; }");
+        DarkTheme::setTextStyle(btn, DarkTheme::TextPrimary, 16);
     }
     transportLayout->addStretch();
     transportLayout->addWidget(m_musicPrevButton);
@@ -505,14 +509,14 @@ QWidget* AtmosphereToolboxWidget::createSliderRow(const QString& labelText, QSli
 
     QLabel* label = new QLabel(labelText);
     label->setFixedWidth(70);
-    label->setStyleSheet("color: #A0A0A0; font-size: 11px;");
+    DarkTheme::setTextStyle(label, DarkTheme::TextSecondary, DarkTheme::FontSmall);
     layout->addWidget(label);
 
     layout->addWidget(slider, 1);
 
     valueLabel->setFixedWidth(40);
     valueLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-    valueLabel->setStyleSheet("color: #E0E0E0; font-size: 11px;");
+    DarkTheme::setTextStyle(valueLabel, DarkTheme::TextPrimary, DarkTheme::FontSmall);
     layout->addWidget(valueLabel);
 
     return row;
@@ -520,109 +524,11 @@ QWidget* AtmosphereToolboxWidget::createSliderRow(const QString& labelText, QSli
 
 void AtmosphereToolboxWidget::applyDarkTheme()
 {
-    setStyleSheet(QString(R"(
-        QDockWidget {
-            background-color: %1;
-            color: %2;
-            font-size: 12px;
-        }
-        QDockWidget::title {
-            background-color: %3;
-            padding: 6px;
-            font-weight: bold;
-        }
-        QScrollArea {
-            background-color: transparent;
-            border: none;
-        }
-        QComboBox {
-            background-color: %4;
-            border: 1px solid %5;
-            border-radius: 4px;
-            padding: 4px 8px;
-            color: %2;
-            min-height: 24px;
-        }
-        QComboBox:hover {
-            border-color: %6;
-        }
-        QComboBox::drop-down {
-            border: none;
-            width: 20px;
-        }
-        QComboBox QAbstractItemView {
-            background-color: %3;
-            border: 1px solid %5;
-            selection-background-color: %6;
-        }
-        QPushButton {
-            background-color: %4;
-            border: 1px solid %5;
-            border-radius: 4px;
-            padding: 4px 12px;
-            color: %2;
-            min-height: 24px;
-        }
-        QPushButton:hover {
-            background-color: %7;
-            border-color: %6;
-        }
-        QPushButton:pressed {
-            background-color: %6;
-        }
-        QPushButton:checked {
-            background-color: %6;
-            border-color: %6;
-        }
-        QPushButton:disabled {
-            background-color: %4;
-            color: %8;
-        }
-        QSlider::groove:horizontal {
-            background: %4;
-            height: 6px;
-            border-radius: 3px;
-        }
-        QSlider::handle:horizontal {
-            background: %6;
-            width: 14px;
-            margin: -4px 0;
-            border-radius: 7px;
-        }
-        QSlider::handle:horizontal:hover {
-            background: #5BA3F5;
-        }
-        QSlider::sub-page:horizontal {
-            background: %6;
-            border-radius: 3px;
-        }
-        QCheckBox {
-            color: %2;
-            spacing: 8px;
-        }
-        QCheckBox::indicator {
-            width: 16px;
-            height: 16px;
-            border: 1px solid %5;
-            border-radius: 3px;
-            background: %4;
-        }
-        QCheckBox::indicator:checked {
-            background: %6;
-            border-color: %6;
-        }
-        QCheckBox::indicator:hover {
-            border-color: %6;
-        }
-    )")
-    .arg(DarkTheme::BgPrimary.name())      // %1
-    .arg(DarkTheme::TextPrimary.name())    // %2
-    .arg(DarkTheme::BgSecondary.name())    // %3
-    .arg(DarkTheme::BgTertiary.name())     // %4
-    .arg(DarkTheme::BorderColor.name())    // %5
-    .arg(DarkTheme::AccentPrimary.name())  // %6
-    .arg("#3A3A3A")                         // %7 hover
-    .arg(DarkTheme::TextDisabled.name())); // %8
+    // Controls are drawn by DarkTheme::Style; the panel only sets its denser
+    // font, before setupUI so every child inherits it
+    QFont panelFont = font();
+    panelFont.setPixelSize(DarkTheme::FontBase);
+    setFont(panelFont);
 }
 
 void AtmosphereToolboxWidget::populatePresetCombo()
@@ -1044,11 +950,11 @@ void AtmosphereToolboxWidget::setAudioSystems(AmbientPlayer* ambient, MusicRemot
         connect(m_ambientPlayer, &AmbientPlayer::trackChanged, this, [this](const QString& track) {
             if (track.isEmpty()) {
                 m_ambientTrackLabel->setText(tr("No track loaded"));
-                m_ambientTrackLabel->setStyleSheet("color: #808080; font-style: italic;");
+                DarkTheme::setTextStyle(m_ambientTrackLabel, DarkTheme::TextMuted, 0, QFont::Normal, true);
                 m_ambientStopButton->setEnabled(false);
             } else {
                 m_ambientTrackLabel->setText(QFileInfo(track).fileName());
-                m_ambientTrackLabel->setStyleSheet("color: #4A90E2;");
+                DarkTheme::setTextStyle(m_ambientTrackLabel, DarkTheme::AccentPrimary);
                 m_ambientStopButton->setEnabled(true);
             }
         });
@@ -1120,11 +1026,11 @@ void AtmosphereToolboxWidget::onNowPlayingChanged()
     auto np = m_musicRemote->getNowPlaying();
     if (np.title.isEmpty()) {
         m_nowPlayingLabel->setText(tr("No music playing"));
-        m_nowPlayingLabel->setStyleSheet("color: #808080;");
+        DarkTheme::setTextStyle(m_nowPlayingLabel, DarkTheme::TextMuted);
         m_nowPlayingArtist->setText("");
     } else {
         m_nowPlayingLabel->setText(np.title);
-        m_nowPlayingLabel->setStyleSheet("color: #E0E0E0;");
+        DarkTheme::setTextStyle(m_nowPlayingLabel, DarkTheme::TextPrimary);
         m_nowPlayingArtist->setText(np.artist);
     }
 }
@@ -1,550 +1,792 @@
 #include "ui/DarkTheme.h"
+#include <QAbstractItemView>
+#include <QAbstractSpinBox>
+#include <QApplication>
+#include <QFontMetrics>
+#include <QLabel>
+#include <QPainter>
+#include <QStyleFactory>
+#include <QStyleOption>
+#include <QTabBar>
+#include <QToolBar>
+#include <QToolTip>
 
 namespace DarkTheme {
 
-QString getApplicationStyleSheet()
-{
-    return R"(
-        QWidget {
-            background-color: #1a1a1a;
-            color: #E0E0E0;
-            font-size: 14px;
-        }
+namespace {
 
-        QMainWindow {
-            background-color: #1a1a1a;
-        }
+constexpr char VARIANT_PROPERTY[] = "darkThemeVariant";
 
-        QDockWidget {
-            background-color: #242424;
-            border: 1px solid #3A3A3A;
-            border-radius: 4px;
-        }
+const QColor HoverBackground{"#3A3A3A"};
+const QColor HoverBorder{"#5BA3F5"};
+const QColor MenuBackground{"#2a2a2a"};
+const QColor StatusBarBorder{"#2a2a2a"};
+const QColor ScrollHandleHover{"#4A4A4A"};
+const QColor SliderHandleHover{"#3A7BC8"};
+const QColor DangerText{"#ff6b6b"};
+const QColor SuccessText{"#6bffb8"};
 
-        QDockWidget::title {
-            background-color: #2d2d2d;
-            padding: 8px;
-            border-bottom: 1px solid #3A3A3A;
-        }
+constexpr int SWATCH_RADIUS = 3;
+constexpr int CONTROL_HEIGHT = 32;
+constexpr int TOOL_BUTTON_SIZE = 50;
+constexpr int PRIMARY_BUTTON_WIDTH = 122;
 
-        QToolBar {
-            background-color: #242424;
-            border: none;
-            spacing: 4px;
-            padding: 4px;
-        }
+QColor alpha(const QColor& color, qreal opacity)
+{
+    QColor result(color);
+    result.setAlphaF(opacity);
+    return result;
+}
 
-        QStatusBar {
-            background-color: #242424;
-            border-top: 1px solid #3A3A3A;
-        }
+struct PanelColors {
+    QBrush fill;
+    QColor border;
+    QColor text;
+};
 
-        QGraphicsView {
-            background-color: #1a1a1a;
-            border: 1px solid #3A3A3A;
-        }
-    )";
+void drawPanel(QPainter* painter, const QRect& rect, const PanelColors& colors, int radius)
+{
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    const bool outlined = colors.border.isValid() && colors.border.alpha() > 0;
+    painter->setPen(outlined ? QPen(colors.border, 1) : QPen(Qt::NoPen));
+    painter->setBrush(colors.fill);
+    painter->drawRoundedRect(QRectF(rect).adjusted(0.5, 0.5, -0.5, -0.5), radius, radius);
+    painter->restore();
 }
 
-QString getMainWindowStyleSheet()
+QLinearGradient verticalGradient(const QRect& rect, const QColor& top, const QColor& bottom)
 {
-    return getApplicationStyleSheet() + R"(
-        /* Empty state styling */
-        QLabel#emptyStateLabel {
-            color: #808080;
-            font-size: 24px;
-            font-weight: 300;
-            background-color: transparent;
-        }
-    )";
+    QLinearGradient gradient(rect.topLeft(), rect.bottomLeft());
+    gradient.setColorAt(0.0, top);
+    gradient.setColorAt(1.0, bottom);
+    return gradient;
 }
 
-QString getToolboxStyleSheet()
+void drawArrow(QPainter* painter, const QRect& rect, bool up, const QColor& color)
 {
-    return R"(
-        QGroupBox {
-            background-color: #242424;
-            border: 1px solid #3A3A3A;
-            border-radius: 4px;
-            margin-top: 12px;
-            padding-top: 8px;
-        }
-
-        QGroupBox::title {
-            subcontrol-origin: margin;
-            left: 8px;
-            padding: 0 4px 0 4px;
-            color: #A0A0A0;
-            font-size: 12px;
-            font-weight: bold;
-        }
-
-        QLabel {
-            color: #E0E0E0;
-            background-color: transparent;
-        }
-
-        QLabel:disabled {
-            color: #808080;
-        }
-    )";
+    const QPointF c = QRectF(rect).center();
+    const qreal tip = up ? -2.0 : 2.0;
+    const QPointF arrow[3] = {
+        { c.x() - 4.0, c.y() - tip }, { c.x() + 4.0, c.y() - tip }, { c.x(), c.y() + tip }
+    };
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(color);
+    painter->drawPolygon(arrow, 3);
+    painter->restore();
 }
 
-QString getButtonStyleSheet()
+bool inToolBar(const QWidget* widget)
 {
-    return R"(
-        QPushButton {
-            background-color: #242424;
-            color: #E0E0E0;
-            border: 1px solid #3A3A3A;
-            border-radius: 4px;
-            padding: 6px 12px;
-            min-height: 24px;
-        }
-
-        QPushButton:hover {
-            background-color: #3A3A3A;
-            border-color: #5BA3F5;
-        }
-
-        QPushButton:pressed {
-            background-color: #1a1a1a;
-        }
-
-        QPushButton:checked {
-            background-color: #4A90E2;
-            color: white;
-            border-color: #4A90E2;
-        }
-
-        QPushButton:disabled {
-            background-color: #1a1a1a;
-            color: #808080;
-            border-color: #2d2d2d;
-        }
-
-        QPushButton#primaryButton {
-            background-color: #4A90E2;
-            color: white;
-            border-color: #4A90E2;
-            font-weight: bold;
-        }
-
-        QPushButton#primaryButton:hover {
-            background-color: #5BA3F5;
-        }
-
-        QPushButton#dangerButton {
-            background-color: #E74C3C;
-            color: white;
-            border-color: #E74C3C;
-        }
-
-        QPushButton#dangerButton:hover {
-            background-color: #FF5C4C;
-        }
-
-        QToolButton {
-            background-color: transparent;
-            border: 1px solid transparent;
-            border-radius: 4px;
-            padding: 4px;
-        }
-
-        QToolButton:hover {
-            background-color: #3A3A3A;
-            border-color: #5BA3F5;
-        }
-
-        QToolButton:pressed {
-            background-color: #1a1a1a;
-        }
-
-        QToolButton:checked {
-            background-color: #4A90E2;
-            color: white;
-        }
-    )";
+    return widget && qobject_cast<const QToolBar*>(widget->parentWidget());
 }
 
-QString getMenuStyleSheet()
+// Toolbar buttons and any tool button given a variant
+PanelColors toolButtonColors(Variant look, const QRect& rect, QStyle::State state)
 {
-    return R"(
-        QMenuBar {
-            background-color: #242424;
-            border-bottom: 1px solid #3A3A3A;
-        }
-
-        QMenuBar::item {
-            background-color: transparent;
-            color: #E0E0E0;
-            padding: 4px 8px;
-        }
-
-        QMenuBar::item:selected {
-            background-color: #2d2d2d;
-        }
-
-        QMenu {
-            background-color: #242424;
-            border: 1px solid #3A3A3A;
-            border-radius: 4px;
-            padding: 4px 0;
-        }
-
-        QMenu::item {
-            background-color: transparent;
-            color: #E0E0E0;
-            padding: 6px 20px;
-        }
-
-        QMenu::item:selected {
-            background-color: #4A90E2;
-            color: white;
-        }
-
-        QMenu::item:disabled {
-            color: #808080;
-        }
-
-        QMenu::separator {
-            height: 1px;
-            background-color: #3A3A3A;
-            margin: 4px 10px;
-        }
-    )";
+    const bool enabled = state & QStyle::State_Enabled;
+    const bool hover = enabled && (state & QStyle::State_MouseOver);
+    const bool pressed = enabled && (state & QStyle::State_Sunken);
+    const bool checked = state & QStyle::State_On;
+
+    if (!enabled) {
+        return { alpha(TextPrimary, 0.02), alpha(TextPrimary, 0.05), alpha(TextPrimary, 0.3) };
+    }
+
+    switch (look) {
+    case Variant::Primary:
+        if (checked) {
+            return { verticalGradient(rect, QColor("#4e7abe"), QColor("#456aae")), QColor("#6AB0FF"), Qt::white };
+        }
+        if (hover) {
+            return { verticalGradient(rect, QColor("#3e6aae"), QColor("#355a9e")), QColor("#5AA0F2"), Qt::white };
+        }
+        return { verticalGradient(rect, QColor("#2e5a9e"), QColor("#254a8e")), AccentPrimary, Qt::white };
+    case Variant::Danger:
+        if (hover || pressed || checked) {
+            return { alpha(AccentDanger, 0.3), alpha(AccentDanger, 0.5), DangerText };
+        }
+        return { alpha(AccentDanger, 0.15), alpha(AccentDanger, 0.3), DangerText };
+    case Variant::Success:
+        if (hover || pressed || checked) {
+            return { alpha(AccentSuccess, 0.4), alpha(AccentSuccess, 0.6), SuccessText };
+        }
+        return { alpha(AccentSuccess, 0.3), alpha(AccentSuccess, 0.5), SuccessText };
+    default:
+        break;
+    }
+
+    if (checked) {
+        return { alpha(AccentPrimary, 0.3), AccentPrimary, Qt::white };
+    }
+    if (pressed) {
+        return { alpha(AccentPrimary, 0.25), alpha(AccentPrimary, 0.3), TextPrimary };
+    }
+    if (hover) {
+        return { alpha(AccentPrimary, 0.15), alpha(AccentPrimary, 0.3), TextPrimary };
+    }
+    return { alpha(TextPrimary, 0.05), alpha(TextPrimary, 0.1), TextPrimary };
 }
 
-QString getSliderStyleSheet()
+// Push buttons and the closed state of combo boxes
+PanelColors pushButtonColors(Variant look, const QStyleOption* option)
 {
-    return R"(
-        QSlider {
-            background-color: transparent;
-        }
-
-        QSlider::groove:horizontal {
-            background-color: #3A3A3A;
-            height: 4px;
-            border-radius: 2px;
-        }
-
-        QSlider::handle:horizontal {
-            background-color: #4A90E2;
-            width: 16px;
-            height: 16px;
-            margin: -6px 0;
-            border-radius: 8px;
-        }
-
-        QSlider::handle:horizontal:hover {
-            background-color: #3A7BC8;
-        }
-
-        QSlider::sub-page:horizontal {
-            background-color: #4A90E2;
-            border-radius: 2px;
-        }
+    const QStyle::State state = option->state;
+    const bool enabled = state & QStyle::State_Enabled;
+    const bool hover = enabled && (state & QStyle::State_MouseOver);
+    const bool pressed = enabled && (state & QStyle::State_Sunken);
+    const bool checked = state & QStyle::State_On;
+
+    if (look == Variant::Swatch) {
+        const QColor border = !enabled ? BgTertiary : (hover || pressed) ? AccentPrimary : BorderColor;
+        return { option->palette.color(QPalette::Active, QPalette::Button), border, TextPrimary };
+    }
+    if (!enabled) {
+        return { BgPrimary, BgTertiary, TextMuted };
+    }
+
+    switch (look) {
+    case Variant::Primary:
+        return { hover ? HoverBorder : AccentPrimary, AccentPrimary, Qt::white };
+    case Variant::Danger:
+        return { hover ? QColor("#FF5C4C") : AccentDanger, AccentDanger, Qt::white };
+    case Variant::Success:
+        return { hover ? AccentSuccess.lighter(115) : AccentSuccess, AccentSuccess, Qt::white };
+    default:
+        break;
+    }
+
+    if (checked) {
+        return { AccentPrimary, AccentPrimary, Qt::white };
+    }
+    if (pressed) {
+        return { BgPrimary, HoverBorder, TextPrimary };
+    }
+    if (hover) {
+        return { HoverBackground, HoverBorder, TextPrimary };
+    }
+    return { BgSecondary, BorderColor, TextPrimary };
+}
 
-        QSpinBox, QDoubleSpinBox {
-            background-color: #242424;
-            color: #E0E0E0;
-            border: 1px solid #3A3A3A;
-            border-radius: 4px;
-            padding: 4px;
-        }
+} // namespace
 
-        QSpinBox:hover, QDoubleSpinBox:hover {
-            border-color: #4A90E2;
-        }
+void apply(QApplication& app)
+{
+    app.setStyle(new Style);
+    app.setPalette(palette());
 
-        QSpinBox::up-button, QDoubleSpinBox::up-button,
-        QSpinBox::down-button, QDoubleSpinBox::down-button {
-            background-color: #2d2d2d;
-            border: none;
-            width: 16px;
-        }
+    QFont font = app.font();
+    font.setPixelSize(FontMedium);
+    app.setFont(font);
 
-        QSpinBox::up-button:hover, QDoubleSpinBox::up-button:hover,
-        QSpinBox::down-button:hover, QDoubleSpinBox::down-button:hover {
-            background-color: #3A3A3A;
-        }
-    )";
+    QFont tipFont = font;
+    tipFont.setPixelSize(FontBase);
+    QToolTip::setFont(tipFont);
+    QToolTip::setPalette(palette());
 }
 
-QString getTabStyleSheet()
+QPalette palette()
 {
-    return R"(
-        QTabWidget::pane {
-            background-color: #1a1a1a;
-            border: 1px solid #3A3A3A;
-            border-radius: 4px;
-        }
-
-        QTabBar::tab {
-            background-color: #242424;
-            color: #A0A0A0;
-            padding: 8px 16px;
-            margin-right: 2px;
-            border: 1px solid #3A3A3A;
-            border-bottom: none;
-            border-top-left-radius: 4px;
-            border-top-right-radius: 4px;
-        }
-
-        QTabBar::tab:selected {
-            background-color: #1a1a1a;
-            color: #E0E0E0;
-            border-color: #4A90E2;
-        }
-
-        QTabBar::tab:hover:!selected {
-            background-color: #2d2d2d;
-        }
-    )";
+    QPalette result;
+    result.setColor(QPalette::Window, BgPrimary);
+    result.setColor(QPalette::WindowText, TextPrimary);
+    result.setColor(QPalette::Base, BgSecondary);
+    result.setColor(QPalette::AlternateBase, BgTertiary);
+    result.setColor(QPalette::Text, TextPrimary);
+    result.setColor(QPalette::PlaceholderText, TextMuted);
+    result.setColor(QPalette::Button, BgSecondary);
+    result.setColor(QPalette::ButtonText, TextPrimary);
+    result.setColor(QPalette::BrightText, Qt::white);
+    result.setColor(QPalette::Light, HoverBackground);
+    result.setColor(QPalette::Midlight, BorderColor);
+    result.setColor(QPalette::Mid, BgTertiary);
+    result.setColor(QPalette::Dark, BgPrimary);
+    result.setColor(QPalette::Shadow, Qt::black);
+    result.setColor(QPalette::Highlight, AccentPrimary);
+    result.setColor(QPalette::HighlightedText, Qt::white);
+    result.setColor(QPalette::Link, AccentPrimary);
+    result.setColor(QPalette::ToolTipBase, BgTertiary);
+    result.setColor(QPalette::ToolTipText, TextPrimary);
+
+    result.setColor(QPalette::Disabled, QPalette::WindowText, TextMuted);
+    result.setColor(QPalette::Disabled, QPalette::Text, TextMuted);
+    result.setColor(QPalette::Disabled, QPalette::ButtonText, TextMuted);
+    result.setColor(QPalette::Disabled, QPalette::Base, BgPrimary);
+    result.setColor(QPalette::Disabled, QPalette::Button, BgPrimary);
+    return result;
 }
 
-QString getScrollBarStyleSheet()
+void setVariant(QWidget* widget, Variant look)
 {
-    return R"(
-        QScrollBar:vertical {
-            background-color: #1a1a1a;
-            width: 12px;
-            border: none;
-        }
-
-        QScrollBar::handle:vertical {
-            background-color: #3A3A3A;
-            border-radius: 6px;
-            min-height: 20px;
-        }
-
-        QScrollBar::handle:vertical:hover {
-            background-color: #4A4A4A;
-        }
-
-        QScrollBar::add-line:vertical, QScrollBar::sub-line:vertical {
-            border: none;
-            background: none;
-            height: 0;
-        }
+    if (variant(widget) == look) {
+        return;
+    }
+    widget->setProperty(VARIANT_PROPERTY, int(look));
+    widget->updateGeometry();  // Primary buttons are wider
+    widget->update();
+}
 
-        QScrollBar:horizontal {
-            background-color: #1a1a1a;
-            height: 12px;
-            border: none;
-        }
+Variant variant(const QWidget* widget)
+{
+    return widget ? Variant(widget->property(VARIANT_PROPERTY).toInt()) : Variant::Normal;
+}
 
-        QScrollBar::handle:horizontal {
-            background-color: #3A3A3A;
-            border-radius: 6px;
-            min-width: 20px;
-        }
+void setTextStyle(QWidget* widget, const QColor& color, int pixelSize, QFont::Weight weight, bool italic)
+{
+    QPalette colors = widget->palette();
+    for (QPalette::ColorGroup group : { QPalette::Active, QPalette::Inactive }) {
+        colors.setColor(group, QPalette::WindowText, color);
+        colors.setColor(group, QPalette::ButtonText, color);
+        colors.setColor(group, QPalette::Text, color);
+    }
+    widget->setPalette(colors);
+
+    QFont font = widget->font();
+    if (pixelSize > 0) {
+        font.setPixelSize(pixelSize);
+    }
+    font.setWeight(weight);
+    font.setItalic(italic);
+    widget->setFont(font);
+}
 
-        QScrollBar::handle:horizontal:hover {
-            background-color: #4A4A4A;
-        }
+void setChipStyle(QLabel* label, const QColor& color, const QColor& background)
+{
+    QPalette colors = label->palette();
+    colors.setColor(QPalette::WindowText, color);
+    colors.setColor(QPalette::Window, background);
+    label->setPalette(colors);
+    label->setAutoFillBackground(true);
+    label->setContentsMargins(6, 2, 6, 2);
+}
 
-        QScrollBar::add-line:horizontal, QScrollBar::sub-line:horizontal {
-            border: none;
-            background: none;
-            width: 0;
-        }
+// --- Style ---
 
-        QComboBox {
-            background-color: #242424;
-            color: #E0E0E0;
-            border: 1px solid #3A3A3A;
-            border-radius: 4px;
-            padding: 4px 8px;
-            min-height: 24px;
-        }
+Style::Style()
+    : QProxyStyle(QStyleFactory::create(QStringLiteral("Fusion")))
+{
+}
 
-        QComboBox:hover {
-            border-color: #4A90E2;
-        }
+QPalette Style::standardPalette() const
+{
+    return palette();
+}
 
-        QComboBox::drop-down {
-            border: none;
-            width: 20px;
-        }
+void Style::polish(QWidget* widget)
+{
+    QProxyStyle::polish(widget);
+
+    // Fusion already tracks hover on buttons, sliders, spin and combo boxes
+    if (qobject_cast<QTabBar*>(widget)) {
+        widget->setAttribute(Qt::WA_Hover);
+    } else if (auto* view = qobject_cast<QAbstractItemView*>(widget)) {
+        view->viewport()->setAttribute(Qt::WA_Hover);
+    }
+}
 
-        QComboBox::down-arrow {
-            image: none;
-            border-left: 4px solid transparent;
-            border-right: 4px solid transparent;
-            border-top: 5px solid #E0E0E0;
-            width: 0;
-            height: 0;
-            margin-right: 4px;
-        }
+int Style::pixelMetric(PixelMetric metric, const QStyleOption* option, const QWidget* widget) const
+{
+    switch (metric) {
+    case PM_ToolBarFrameWidth:
+    case PM_MenuBarPanelWidth:
+        return 0;
+    case PM_ToolBarItemSpacing:
+    case PM_MenuBarVMargin:
+    case PM_MenuBarHMargin:
+    case PM_MenuHMargin:
+    case PM_MenuVMargin:
+        return SpaceTight;
+    case PM_ToolBarItemMargin:
+    case PM_DockWidgetTitleMargin:
+        return SpaceBase;
+    case PM_ToolBarSeparatorExtent:
+        return 1 + 2 * SpaceBase;
+    case PM_MenuPanelWidth:
+        return 1;
+    case PM_ToolTipLabelFrameWidth:
+        return 5;
+    case PM_ScrollBarExtent:
+        return 12;
+    case PM_ScrollBarSliderMin:
+        return 20;
+    case PM_SliderThickness:
+    case PM_SliderLength:
+    case PM_SliderControlThickness:
+    case PM_IndicatorWidth:
+    case PM_IndicatorHeight:
+        return 16;
+    default:
+        return QProxyStyle::pixelMetric(metric, option, widget);
+    }
+}
 
-        QComboBox QAbstractItemView {
-            background-color: #242424;
-            border: 1px solid #3A3A3A;
-            selection-background-color: #4A90E2;
-            selection-color: white;
-        }
+QSize Style::sizeFromContents(ContentsType type, const QStyleOption* option, const QSize& size,
+                              const QWidget* widget) const
+{
+    QSize result = QProxyStyle::sizeFromContents(type, option, size, widget);
+
+    switch (type) {
+    case CT_ToolButton: {
+        const Variant look = variant(widget);
+        if (look == Variant::Primary) {
+            return result.grownBy(QMargins(14, 4, 14, 4)).expandedTo(QSize(PRIMARY_BUTTON_WIDTH, TOOL_BUTTON_SIZE));
+        }
+        if (inToolBar(widget) || (look != Variant::Normal && look != Variant::Flat)) {
+            return result.grownBy(QMargins(4, 4, 4, 4)).expandedTo(QSize(TOOL_BUTTON_SIZE, TOOL_BUTTON_SIZE));
+        }
+        return result;
+    }
+    case CT_PushButton:
+        return variant(widget) == Variant::Swatch ? result : result.expandedTo(QSize(0, CONTROL_HEIGHT));
+    case CT_ComboBox:
+        return result.expandedTo(QSize(0, CONTROL_HEIGHT));
+    case CT_MenuBarItem:
+        return result.grownBy(QMargins(SpaceTight, 2, SpaceTight, 2));
+    case CT_MenuItem:
+        if (const auto* item = qstyleoption_cast<const QStyleOptionMenuItem*>(option);
+            item && item->menuItemType != QStyleOptionMenuItem::Separator) {
+            return result.grownBy(QMargins(SpaceTight, 2, SpaceTight, 2));
+        }
+        return result;
+    default:
+        return result;
+    }
+}
 
-        QLineEdit {
-            background-color: #242424;
-            color: #E0E0E0;
-            border: 1px solid #3A3A3A;
-            border-radius: 4px;
-            padding: 4px 8px;
-        }
+QRect Style::subControlRect(ComplexControl control, const QStyleOptionComplex* option,
+                            SubControl subControl, const QWidget* widget) const
+{
+    // Scroll bars are a bare groove and handle, without arrow buttons
+    const auto* bar = qstyleoption_cast<const QStyleOptionSlider*>(option);
+    if (control != CC_ScrollBar || !bar) {
+        return QProxyStyle::subControlRect(control, option, subControl, widget);
+    }
+
+    const QRect rect = bar->rect;
+    const bool horizontal = bar->orientation == Qt::Horizontal;
+    const int length = horizontal ? rect.width() : rect.height();
+    const int range = bar->maximum - bar->minimum;
+    int sliderLength = length;
+    if (range > 0) {
+        sliderLength = int(qint64(bar->pageStep) * length / (range + bar->pageStep));
+        sliderLength = qBound(qMin(length, pixelMetric(PM_ScrollBarSliderMin, bar, widget)), sliderLength, length);
+    }
+    const int sliderStart = sliderPositionFromValue(bar->minimum, bar->maximum, bar->sliderPosition,
+                                                    length - sliderLength, bar->upsideDown);
+
+    auto span = [&](int start, int extent) {
+        return horizontal ? QRect(rect.x() + start, rect.y(), extent, rect.height())
+                          : QRect(rect.x(), rect.y() + start, rect.width(), extent);
+    };
+
+    QRect result;
+    switch (subControl) {
+    case SC_ScrollBarGroove:
+        result = rect;
+        break;
+    case SC_ScrollBarSlider:
+        result = span(sliderStart, sliderLength);
+        break;
+    case SC_ScrollBarSubPage:
+        result = span(0, sliderStart);
+        break;
+    case SC_ScrollBarAddPage:
+        result = span(sliderStart + sliderLength, length - sliderStart - sliderLength);
+        break;
+    default:
+        return QRect();
+    }
+    return visualRect(bar->direction, rect, result);
+}
 
-        QLineEdit:focus {
-            border-color: #4A90E2;
-        }
+void Style::drawPrimitive(PrimitiveElement element, const QStyleOption* option, QPainter* painter,
+                          const QWidget* widget) const
+{
+    switch (element) {
+    case PE_PanelButtonCommand: {
+        const Variant look = variant(widget);
+        if (look != Variant::Flat) {
+            drawPanel(painter, option->rect, pushButtonColors(look, option),
+                      look == Variant::Swatch ? SWATCH_RADIUS : RadiusSmall);
+        }
+        return;
+    }
+    case PE_PanelLineEdit:
+        if (const auto* frame = qstyleoption_cast<const QStyleOptionFrame*>(option); frame && frame->lineWidth > 0) {
+            const bool enabled = option->state & State_Enabled;
+            const bool focus = enabled && (option->state & State_HasFocus);
+            drawPanel(painter, option->rect,
+                      { enabled ? BgSecondary : BgPrimary, focus ? AccentPrimary : BorderColor, {} },
+                      RadiusSmall);
+            return;
+        }
+        break;
+    case PE_FrameLineEdit:
+    case PE_FrameStatusBarItem:
+        return;
+    case PE_Frame: {
+        const bool itemView = qobject_cast<const QAbstractItemView*>(widget);
+        drawPanel(painter, option->rect,
+                  { itemView ? option->palette.base() : QBrush(Qt::NoBrush), BorderColor, {} }, RadiusSmall);
+        return;
+    }
+    case PE_FrameGroupBox:
+    case PE_FrameTabWidget:
+        drawPanel(painter, option->rect,
+                  { element == PE_FrameGroupBox ? BgSecondary : BgPrimary, BorderColor, {} }, RadiusSmall);
+        return;
+    case PE_PanelItemViewItem: {
+        const bool selected = option->state & State_Selected;
+        const bool hover = (option->state & State_Enabled) && (option->state & State_MouseOver);
+        if (selected || hover) {
+            drawPanel(painter, option->rect, { selected ? AccentPrimary : HoverBackground, {}, {} }, SWATCH_RADIUS);
+        } else if (const auto* item = qstyleoption_cast<const QStyleOptionViewItem*>(option);
+                   item && item->backgroundBrush.style() != Qt::NoBrush) {
+            painter->fillRect(option->rect, item->backgroundBrush);
+        }
+        return;
+    }
+    case PE_IndicatorCheckBox: {
+        const bool enabled = option->state & State_Enabled;
+        const bool on = option->state & (State_On | State_NoChange);
+        const bool hover = enabled && (option->state & State_MouseOver);
+        const QColor fill = on ? (enabled ? AccentPrimary : TextDisabled) : BgTertiary;
+        drawPanel(painter, option->rect, { fill, on ? fill : hover ? AccentPrimary : BorderColor, {} },
+                  SWATCH_RADIUS);
+        if (!on) {
+            return;
+        }
+
+        const QRectF box(option->rect);
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        painter->setPen(QPen(Qt::white, 2, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        if (option->state & State_NoChange) {
+            painter->drawLine(QPointF(box.left() + box.width() * 0.28, box.center().y()),
+                              QPointF(box.left() + box.width() * 0.72, box.center().y()));
+        } else {
+            const QPointF check[3] = {
+                { box.left() + box.width() * 0.25, box.top() + box.height() * 0.5 },
+                { box.left() + box.width() * 0.42, box.top() + box.height() * 0.68 },
+                { box.left() + box.width() * 0.75, box.top() + box.height() * 0.32 },
+            };
+            painter->drawPolyline(check, 3);
+        }
+        painter->restore();
+        return;
+    }
+    case PE_IndicatorToolBarSeparator: {
+        const QRect rect = option->rect;
+        painter->save();
+        painter->setPen(alpha(TextPrimary, 0.08));
+        if (option->state & State_Horizontal) {
+            const int x = rect.center().x();
+            painter->drawLine(x, rect.top() + SpaceTight, x, rect.bottom() - SpaceTight);
+        } else {
+            const int y = rect.center().y();
+            painter->drawLine(rect.left() + SpaceTight, y, rect.right() - SpaceTight, y);
+        }
+        painter->restore();
+        return;
+    }
+    case PE_PanelStatusBar:
+        painter->fillRect(option->rect, BgPrimary);
+        painter->fillRect(QRect(option->rect.topLeft(), QSize(option->rect.width(), 1)), StatusBarBorder);
+        return;
+    case PE_PanelMenu:
+        painter->fillRect(option->rect, MenuBackground);
+        return;
+    case PE_FrameMenu:
+        painter->save();
+        painter->setPen(BorderColor);
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRect(option->rect.adjusted(0, 0, -1, -1));
+        painter->restore();
+        return;
+    case PE_PanelTipLabel:
+        painter->save();
+        painter->setPen(AccentPrimary);
+        painter->setBrush(BgTertiary);
+        painter->drawRect(option->rect.adjusted(0, 0, -1, -1));
+        painter->restore();
+        return;
+    default:
+        break;
+    }
+    QProxyStyle::drawPrimitive(element, option, painter, widget);
+}
 
-        QLineEdit:disabled {
-            background-color: #1a1a1a;
-            color: #808080;
-        }
-    )";
+void Style::drawControl(ControlElement element, const QStyleOption* option, QPainter* painter,
+                        const QWidget* widget) const
+{
+    switch (element) {
+    case CE_PushButtonLabel:
+        if (const auto* button = qstyleoption_cast<const QStyleOptionButton*>(option)) {
+            const Variant look = variant(widget);
+            if (look == Variant::Normal || look == Variant::Flat) {
+                // Checked buttons are filled with the accent
+                if (button->state & State_On) {
+                    QStyleOptionButton label(*button);
+                    label.palette.setColor(QPalette::ButtonText, Qt::white);
+                    QProxyStyle::drawControl(element, &label, painter, widget);
+                    return;
+                }
+                break;
+            }
+            QStyleOptionButton label(*button);
+            label.palette.setColor(QPalette::ButtonText, pushButtonColors(look, option).text);
+            QProxyStyle::drawControl(element, &label, painter, widget);
+            return;
+        }
+        break;
+    case CE_ToolBar:
+        painter->fillRect(option->rect, BgPrimary);
+        return;
+    case CE_MenuBarEmptyArea:
+        painter->fillRect(option->rect, BgSecondary);
+        painter->fillRect(QRect(option->rect.left(), option->rect.bottom(), option->rect.width(), 1), BgPrimary);
+        return;
+    case CE_MenuBarItem:
+        if (const auto* item = qstyleoption_cast<const QStyleOptionMenuItem*>(option)) {
+            const bool enabled = option->state & State_Enabled;
+            painter->fillRect(option->rect, BgSecondary);
+            if (enabled && (option->state & (State_Selected | State_Sunken))) {
+                drawPanel(painter, option->rect.adjusted(2, 2, -2, -2),
+                          { alpha(AccentPrimary, 0.2), {}, {} }, RadiusSmall);
+            }
+            int alignment = Qt::AlignCenter | Qt::TextShowMnemonic | Qt::TextDontClip | Qt::TextSingleLine;
+            if (!proxy()->styleHint(SH_UnderlineShortcut, item, widget)) {
+                alignment |= Qt::TextHideMnemonic;
+            }
+            proxy()->drawItemText(painter, item->rect, alignment, item->palette, enabled, item->text,
+                                  QPalette::ButtonText);
+            return;
+        }
+        break;
+    case CE_MenuItem:
+        if (const auto* item = qstyleoption_cast<const QStyleOptionMenuItem*>(option)) {
+            QStyleOptionMenuItem tinted(*item);
+            tinted.palette.setColor(QPalette::Highlight, alpha(AccentPrimary, 0.25));
+            tinted.palette.setColor(QPalette::HighlightedText, TextPrimary);
+            QProxyStyle::drawControl(element, &tinted, painter, widget);
+            return;
+        }
+        break;
+    case CE_DockWidgetTitle:
+        if (const auto* dock = qstyleoption_cast<const QStyleOptionDockWidget*>(option);
+            dock && !dock->verticalTitleBar) {
+            painter->fillRect(dock->rect, BgTertiary);
+            painter->fillRect(QRect(dock->rect.left(), dock->rect.bottom(), dock->rect.width(), 1), BorderColor);
+            if (!dock->title.isEmpty()) {
+                const QRect textRect = proxy()->subElementRect(SE_DockWidgetTitleBarText, dock, widget);
+                QFont font = painter->font();
+                font.setBold(true);
+                painter->save();
+                painter->setFont(font);
+                const QString title = QFontMetrics(font).elidedText(dock->title, Qt::ElideRight, textRect.width());
+                proxy()->drawItemText(painter, textRect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextHideMnemonic,
+                                      dock->palette, dock->state & State_Enabled, title, QPalette::WindowText);
+                painter->restore();
+            }
+            return;
+        }
+        break;
+    case CE_TabBarTabShape:
+        if (const auto* tab = qstyleoption_cast<const QStyleOptionTab*>(option);
+            tab && tab->shape == QTabBar::RoundedNorth) {
+            const bool selected = tab->state & State_Selected;
+            const bool hover = (tab->state & State_Enabled) && (tab->state & State_MouseOver);
+            const QRect rect = tab->rect.adjusted(0, 0, -2, 0);
+
+            // Rounded on top only: the bottom corners fall outside the clip
+            painter->save();
+            painter->setClipRect(rect);
+            drawPanel(painter, rect.adjusted(0, 0, 0, RadiusSmall + 1),
+                      { selected ? BgPrimary : hover ? BgTertiary : BgSecondary,
+                        selected ? AccentPrimary : BorderColor, {} },
+                      RadiusSmall);
+            painter->restore();
+            return;
+        }
+        break;
+    case CE_TabBarTabLabel:
+        if (const auto* tab = qstyleoption_cast<const QStyleOptionTab*>(option)) {
+            QStyleOptionTab label(*tab);
+            label.palette.setColor(QPalette::WindowText,
+                                   (tab->state & State_Selected) ? TextPrimary : TextSecondary);
+            QProxyStyle::drawControl(element, &label, painter, widget);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    QProxyStyle::drawControl(element, option, painter, widget);
 }
 
-QString toolBarStyle()
+void Style::drawComplexControl(ComplexControl control, const QStyleOptionComplex* option,
+                               QPainter* painter, const QWidget* widget) const
 {
-    return QString(
-        "QToolBar {"
-        "  background: %1; border: none; spacing: %2px; padding: %3px;"
-        "}"
-        "QToolBar::separator {"
-        "  background: %4; width: 1px; margin: 4px 8px;"
-        "}"
-    ).arg(hex(BgPrimary),
-          QString::number(SpaceTight),
-          QString::number(SpaceBase),
-          rgba(TextPrimary, 0.08));
+    switch (control) {
+    case CC_ToolButton:
+        if (const auto* button = qstyleoption_cast<const QStyleOptionToolButton*>(option)) {
+            drawToolButton(button, painter, widget);
+            return;
+        }
+        break;
+    case CC_Slider:
+        if (const auto* slider = qstyleoption_cast<const QStyleOptionSlider*>(option)) {
+            drawSlider(slider, painter, widget);
+            return;
+        }
+        break;
+    case CC_ScrollBar:
+        if (const auto* bar = qstyleoption_cast<const QStyleOptionSlider*>(option)) {
+            drawScrollBar(bar, painter, widget);
+            return;
+        }
+        break;
+    case CC_SpinBox:
+        if (const auto* spin = qstyleoption_cast<const QStyleOptionSpinBox*>(option)) {
+            drawSpinBox(spin, painter, widget);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    QProxyStyle::drawComplexControl(control, option, painter, widget);
 }
 
-QString toolButtonStyle()
+void Style::drawToolButton(const QStyleOptionToolButton* option, QPainter* painter,
+                           const QWidget* widget) const
 {
-    return QString(
-        "QToolButton {"
-        "  background: %1; border: 1px solid %2; border-radius: %3px;"
-        "  padding: 8px; min-width: 32px; min-height: 32px;"
-        "  color: %4; font-size: %5px;"
-        "}"
-        "QToolButton:hover:enabled {"
-        "  background: %6; border-color: %7;"
-        "}"
-        "QToolButton:pressed:enabled {"
-        "  background: %8;"
-        "}"
-        "QToolButton:checked {"
-        "  background: %9; border-color: %10; color: white;"
-        "}"
-        "QToolButton:disabled {"
-        "  background: %11; border-color: %12; color: %13;"
-        "}"
-        "QToolButton:focus {"
-        "  outline: 2px solid %10; outline-offset: 2px;"
-        "}"
-    ).arg(rgba(TextPrimary, 0.05),    // 1: bg
-          rgba(TextPrimary, 0.1),      // 2: border
-          QString::number(RadiusBase), // 3: radius
-          hex(TextPrimary),            // 4: text
-          QString::number(FontBase),   // 5: font
-          rgba(AccentPrimary, 0.15),   // 6: hover bg
-          rgba(AccentPrimary, 0.3),    // 7: hover border
-          rgba(AccentPrimary, 0.25),   // 8: pressed bg
-          rgba(AccentPrimary, 0.3))    // 9: checked bg
-     .arg(hex(AccentPrimary),          // 10: checked border / focus
-          rgba(TextPrimary, 0.02),     // 11: disabled bg
-          rgba(TextPrimary, 0.05),     // 12: disabled border
-          rgba(TextPrimary, 0.3));     // 13: disabled text
+    const Variant look = variant(widget);
+    const bool enabled = option->state & State_Enabled;
+    QStyleOptionToolButton label(*option);
+
+    if (look == Variant::Flat) {
+        const bool hover = enabled && (option->state & State_MouseOver);
+        label.palette.setColor(QPalette::ButtonText, alpha(TextPrimary, hover ? 0.8 : 0.5));
+    } else if (inToolBar(widget) || look != Variant::Normal) {
+        const PanelColors colors = toolButtonColors(look, option->rect, option->state);
+        drawPanel(painter, option->rect, colors, RadiusBase);
+        label.palette.setColor(QPalette::ButtonText, colors.text);
+    } else {
+        // Loose tool buttons (view modes, tab scrollers) only show a panel on interaction
+        if (option->state & State_On) {
+            drawPanel(painter, option->rect, { AccentPrimary, AccentPrimary, {} }, RadiusSmall);
+            label.palette.setColor(QPalette::ButtonText, Qt::white);
+        } else if (enabled && (option->state & State_Sunken)) {
+            drawPanel(painter, option->rect, { BgPrimary, HoverBorder, {} }, RadiusSmall);
+        } else if (enabled && (option->state & State_MouseOver)) {
+            drawPanel(painter, option->rect, { HoverBackground, HoverBorder, {} }, RadiusSmall);
+        }
+    }
+
+    // Panel is done; the base style only lays out the icon, text and menu arrow
+    label.subControls &= ~SC_ToolButton;
+    label.state &= ~State_HasFocus;
+    QProxyStyle::drawComplexControl(CC_ToolButton, &label, painter, widget);
 }
 
-QString dangerButtonStyle()
+void Style::drawSlider(const QStyleOptionSlider* option, QPainter* painter, const QWidget* widget) const
 {
-    return QString(
-        "QToolButton {"
-        "  background: %1; border: 1px solid %2; border-radius: %3px;"
-        "  padding: 8px; min-width: 32px; min-height: 32px;"
-        "  color: %4; font-size: %5px;"
-        "}"
-        "QToolButton:hover:enabled {"
-        "  background: %6; border-color: %7;"
-        "}"
-        "QToolButton:disabled {"
-        "  background: %8; border-color: %9; color: %10;"
-        "}"
-    ).arg(rgba(AccentDanger, 0.15),    // 1: bg
-          rgba(AccentDanger, 0.3),     // 2: border
-          QString::number(RadiusBase), // 3: radius
-          "#ff6b6b",                   // 4: text (bright red)
-          QString::number(FontBase),   // 5: font
-          rgba(AccentDanger, 0.3),     // 6: hover bg
-          rgba(AccentDanger, 0.5),     // 7: hover border
-          rgba(TextPrimary, 0.02),     // 8: disabled bg
-          rgba(TextPrimary, 0.05),     // 9: disabled border
-          rgba(TextPrimary, 0.3));     // 10: disabled text
+    if (option->subControls & SC_SliderTickmarks) {
+        QStyleOptionSlider ticks(*option);
+        ticks.subControls = SC_SliderTickmarks;
+        QProxyStyle::drawComplexControl(CC_Slider, &ticks, painter, widget);
+    }
+
+    const bool enabled = option->state & State_Enabled;
+    const bool horizontal = option->orientation == Qt::Horizontal;
+    const QRectF handle = proxy()->subControlRect(CC_Slider, option, SC_SliderHandle, widget);
+    const QPointF center = handle.center();
+    const qreal inset = (horizontal ? handle.width() : handle.height()) / 2.0;
+    const QRectF rect(option->rect);
+
+    // 4px groove between the handle's extreme centres, filled up to the handle
+    QRectF groove, filled;
+    if (horizontal) {
+        groove = QRectF(rect.left() + inset, center.y() - 2.0, rect.width() - 2.0 * inset, 4.0);
+        filled = groove;
+        if (option->upsideDown) {
+            filled.setLeft(center.x());
+        } else {
+            filled.setRight(center.x());
+        }
+    } else {
+        groove = QRectF(center.x() - 2.0, rect.top() + inset, 4.0, rect.height() - 2.0 * inset);
+        filled = groove;
+        if (option->upsideDown) {
+            filled.setTop(center.y());
+        } else {
+            filled.setBottom(center.y());
+        }
+    }
+
+    const bool active = enabled && (option->activeSubControls & SC_SliderHandle)
+                        && (option->state & (State_MouseOver | State_Sunken));
+    const qreal radius = qMin(handle.width(), handle.height()) / 2.0;
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(BorderColor);
+    painter->drawRoundedRect(groove, 2.0, 2.0);
+    painter->setBrush(enabled ? AccentPrimary : TextDisabled);
+    painter->drawRoundedRect(filled, 2.0, 2.0);
+    painter->setBrush(!enabled ? TextDisabled : active ? SliderHandleHover : AccentPrimary);
+    painter->drawEllipse(center, radius, radius);
+    painter->restore();
 }
 
-QString successButtonStyle()
+void Style::drawScrollBar(const QStyleOptionSlider* option, QPainter* painter, const QWidget* widget) const
 {
-    return QString(
-        "QToolButton {"
-        "  background: %1; border: 1px solid %2; border-radius: %3px;"
-        "  padding: 8px; min-width: 32px; min-height: 32px;"
-        "  color: %4; font-size: %5px; font-weight: bold;"
-        "}"
-        "QToolButton:hover:enabled {"
-        "  background: %6; border-color: %7;"
-        "}"
-        "QToolButton:checked {"
-        "  background: %6; border-color: %7; color: %4;"
-        "}"
-        "QToolButton:disabled {"
-        "  background: %8; border-color: %9; color: %10;"
-        "}"
-    ).arg(rgba(AccentSuccess, 0.3),    // 1: bg
-          rgba(AccentSuccess, 0.5),    // 2: border
-          QString::number(RadiusBase), // 3: radius
-          "#6bffb8",                   // 4: text (bright green)
-          QString::number(FontBase),   // 5: font
-          rgba(AccentSuccess, 0.4),    // 6: hover/checked bg
-          rgba(AccentSuccess, 0.6),    // 7: hover/checked border
-          rgba(TextPrimary, 0.02),     // 8: disabled bg
-          rgba(TextPrimary, 0.05),     // 9: disabled border
-          rgba(TextPrimary, 0.3));     // 10: disabled text
+    painter->fillRect(option->rect, BgPrimary);
+
+    const QRect slider = proxy()->subControlRect(CC_ScrollBar, option, SC_ScrollBarSlider, widget);
+    if (!slider.isValid()) {
+        return;
+    }
+    const bool active = (option->activeSubControls & SC_ScrollBarSlider)
+                        && (option->state & (State_MouseOver | State_Sunken));
+    const int radius = qMin(slider.width(), slider.height()) / 2;
+    drawPanel(painter, slider, { active ? ScrollHandleHover : BorderColor, {}, {} }, radius);
 }
 
-QString spinBoxStyle()
+void Style::drawSpinBox(const QStyleOptionSpinBox* option, QPainter* painter, const QWidget* widget) const
 {
-    return QString(
-        "QSpinBox {"
-        "  background: %1; border: 1px solid %2; border-radius: %3px;"
-        "  padding: 4px 8px; color: %4; font-size: %5px;"
-        "  min-width: 60px; max-width: 85px;"
-        "}"
-        "QSpinBox:hover {"
-        "  background: %6; border-color: %7;"
-        "}"
-        "QSpinBox:focus {"
-        "  border-color: %8;"
-        "}"
-        "QSpinBox::up-button, QSpinBox::down-button {"
-        "  background: %1; border: 1px solid %2; width: 20px;"
-        "}"
-        "QSpinBox::up-button:hover, QSpinBox::down-button:hover {"
-        "  background: %6;"
-        "}"
-        "QSpinBox:disabled {"
-        "  background: %9; color: %10;"
-        "}"
-    ).arg(rgba(TextPrimary, 0.05),    // 1: bg
-          rgba(TextPrimary, 0.1),      // 2: border
-          QString::number(RadiusSmall),// 3: radius
-          hex(TextPrimary),            // 4: text
-          QString::number(FontBase),   // 5: font
-          rgba(TextPrimary, 0.08),     // 6: hover bg
-          rgba(AccentPrimary, 0.3),    // 7: hover border
-          hex(AccentPrimary),          // 8: focus border
-          hex(BgPrimary),              // 9: disabled bg
-          hex(TextDisabled));          // 10: disabled text
+    const bool enabled = option->state & State_Enabled;
+    const bool hover = enabled && (option->state & State_MouseOver);
+    const bool focus = enabled && (option->state & State_HasFocus);
+
+    if (option->frame) {
+        const QColor fill = !enabled ? alpha(TextPrimary, 0.02) : alpha(TextPrimary, hover ? 0.08 : 0.05);
+        const QColor border = focus ? AccentPrimary
+                              : hover ? alpha(AccentPrimary, 0.3)
+                              : alpha(TextPrimary, enabled ? 0.1 : 0.05);
+        drawPanel(painter, option->rect, { fill, border, {} }, RadiusSmall);
+    }
+
+    if (option->buttonSymbols == QAbstractSpinBox::NoButtons) {
+        return;
+    }
+    for (const SubControl button : { SC_SpinBoxUp, SC_SpinBoxDown }) {
+        if (!(option->subControls & button)) {
+            continue;
+        }
+        const QRect rect = proxy()->subControlRect(CC_SpinBox, option, button, widget);
+        const bool stepEnabled = enabled && option->stepEnabled.testFlag(button == SC_SpinBoxUp
+                                                ? QAbstractSpinBox::StepUpEnabled
+                                                : QAbstractSpinBox::StepDownEnabled);
+        if (stepEnabled && hover && option->activeSubControls.testFlag(button)) {
+            painter->fillRect(rect.adjusted(1, 1, -1, -1), alpha(AccentPrimary, 0.2));
+        }
+        drawArrow(painter, rect, button == SC_SpinBoxUp, stepEnabled ? TextPrimary : TextDisabled);
+    }
 }
 
-}
\ No newline at end of file
+} // namespace DarkTheme
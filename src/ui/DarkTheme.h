@@ -2,6 +2,15 @@
 
 #include <QString>
 #include <QColor>
+#include <QFont>
+#include <QPalette>
+#include <QProxyStyle>
+
+class QApplication;
+class QLabel;
+class QStyleOptionSlider;
+class QStyleOptionSpinBox;
+class QStyleOptionToolButton;
 
 namespace DarkTheme {
     // --- Color palette ---
@@ -15,6 +24,7 @@ namespace DarkTheme {
     inline const QColor TextPrimary{"#E0E0E0"};     // Main text
     inline const QColor TextSecondary{"#A0A0A0"};   // Secondary text
     inline const QColor TextDisabled{"#606060"};    // Disabled text
+    inline const QColor TextMuted{"#808080"};       // Hints, empty states
     inline const QColor BorderColor{"#3A3A3A"};     // Borders
     inline const QColor GridColor{"#4A90E233"};     // 20% opacity blue
 
@@ -34,27 +44,63 @@ namespace DarkTheme {
     constexpr int RadiusSmall = 4;
     constexpr int RadiusBase  = 6;
 
-    // --- Helpers ---
-    inline QString hex(const QColor& c) { return c.name(); }
-    inline QString rgba(const QColor& c, double opacity) {
-        return QString("rgba(%1,%2,%3,%4)")
-            .arg(c.red()).arg(c.green()).arg(c.blue()).arg(opacity);
-    }
-
-    // --- Component stylesheet factories ---
-    QString toolButtonStyle();       // Standard toolbar button
-    QString dangerButtonStyle();     // Destructive action (red tint)
-    QString successButtonStyle();    // Positive action (green tint)
-    QString spinBoxStyle();          // Number spinners
-    QString toolBarStyle();          // Toolbar container
-
-    // --- Existing factories ---
-    QString getApplicationStyleSheet();
-    QString getMainWindowStyleSheet();
-    QString getToolboxStyleSheet();
-    QString getButtonStyleSheet();
-    QString getMenuStyleSheet();
-    QString getSliderStyleSheet();
-    QString getTabStyleSheet();
-    QString getScrollBarStyleSheet();
-}
\ No newline at end of file
+    // --- Application style ---
+    // The look is drawn in code by Style (a QProxyStyle over Fusion) from
+    // palette(), instead of an application stylesheet. Any stylesheet puts
+    // every widget under QStyleSheetStyle, which re-resolves rules on each
+    // polish and paint; keep setStyleSheet for one-off overlays only.
+    void apply(QApplication& app);
+    QPalette palette();
+
+    // Button looks beyond the default, set per widget
+    enum class Variant {
+        Normal,
+        Primary,   // Prominent action (player view)
+        Danger,    // Destructive action (red tint)
+        Success,   // Positive action (green tint)
+        Flat,      // No panel, dimmed text (section expanders)
+        Swatch     // Filled with the widget's QPalette::Button (colour pickers)
+    };
+    void setVariant(QWidget* widget, Variant variant);
+    Variant variant(const QWidget* widget);
+
+    // Text colour and font for labels and buttons; pixelSize 0 keeps the size
+    void setTextStyle(QWidget* widget, const QColor& color, int pixelSize = 0,
+                      QFont::Weight weight = QFont::Normal, bool italic = false);
+    // Label on a filled background (status badges)
+    void setChipStyle(QLabel* label, const QColor& color, const QColor& background);
+
+    class Style : public QProxyStyle
+    {
+    public:
+        Style();
+
+        QPalette standardPalette() const override;
+        void polish(QWidget* widget) override;
+        using QProxyStyle::polish;
+
+        int pixelMetric(PixelMetric metric, const QStyleOption* option = nullptr,
+                        const QWidget* widget = nullptr) const override;
+        QSize sizeFromContents(ContentsType type, const QStyleOption* option,
+                               const QSize& size, const QWidget* widget) const override;
+        QRect subControlRect(ComplexControl control, const QStyleOptionComplex* option,
+                             SubControl subControl, const QWidget* widget = nullptr) const override;
+
+        void drawPrimitive(PrimitiveElement element, const QStyleOption* option,
+                           QPainter* painter, const QWidget* widget = nullptr) const override;
+        void drawControl(ControlElement element, const QStyleOption* option,
+                         QPainter* painter, const QWidget* widget = nullptr) const override;
+        void drawComplexControl(ComplexControl control, const QStyleOptionComplex* option,
+                                QPainter* painter, const QWidget* widget = nullptr) const override;
+
+    private:
+        void drawToolButton(const QStyleOptionToolButton* option, QPainter* painter,
+                            const QWidget* widget) const;
+        void drawSlider(const QStyleOptionSlider* option, QPainter* painter,
+                        const QWidget* widget) const;
+        void drawScrollBar(const QStyleOptionSlider* option, QPainter* painter,
+                           const QWidget* widget) const;
+        void drawSpinBox(const QStyleOptionSpinBox* option, QPainter* painter,
+                         const QWidget* widget) const;
+    };
+}
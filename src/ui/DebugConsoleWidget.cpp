@@ -1,4 +1,7 @@
 #include "DebugConsoleWidget.h"
+#include "graphics/ImageCache.h"
+#include "utils/MemoryManager.h"
+#include "utils/MapBuffer.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QTextEdit>
@@ -105,14 +108,24 @@ void DebugConsoleWidget::setupMetricsTab()
     m_loadTimeLabel = new QLabel("Last Load Time: --");
     m_averageLoadTimeLabel = new QLabel("Average Load Time: --");
     m_totalLoadsLabel = new QLabel("Total Loads: 0");
+    m_memoryBudgetLabel = new QLabel("Memory Budget: --");
+    m_mapBufferLabel = new QLabel("Map Buffers: --");
     
     perfLayout->addWidget(m_fpsLabel);
     perfLayout->addWidget(m_memoryLabel);
     perfLayout->addWidget(m_loadTimeLabel);
     perfLayout->addWidget(m_averageLoadTimeLabel);
     perfLayout->addWidget(m_totalLoadsLabel);
+    perfLayout->addWidget(m_memoryBudgetLabel);
+    perfLayout->addWidget(m_mapBufferLabel);
     
+    QGroupBox* renderCacheGroup = new QGroupBox("Render Cache");
+    QVBoxLayout* renderCacheLayout = new QVBoxLayout(renderCacheGroup);
+    m_renderCacheLabel = new QLabel("--");
+    renderCacheLayout->addWidget(m_renderCacheLabel);
+
     layout->addWidget(performanceGroup);
+    layout->addWidget(renderCacheGroup);
     layout->addStretch();
     
     m_tabWidget->addTab(m_metricsTab, "Performance");
@@ -290,6 +303,32 @@ void DebugConsoleWidget::updateMetricsDisplay()
         m_averageLoadTimeLabel->setText(QString("Average Load Time: %1ms").arg(qRound(metrics.averageLoadTime)));
         m_totalLoadsLabel->setText(QString("Total Loads: %1").arg(metrics.totalLoads));
     }
+
+    const MemoryManager& memory = MemoryManager::instance();
+    m_memoryBudgetLabel->setText(QString("Memory Budget: %1 / %2 (maps %3)")
+        .arg(formatBytes(memory.getCurrentMemoryUsage()))
+        .arg(formatBytes(memory.getMaxMemoryLimit()))
+        .arg(formatBytes(memory.getMapImageUsage())));
+
+    // Each loaded map should be exactly one allocation, however many holders
+    const MapBuffer::Audit audit = MapBuffer::audit();
+    m_mapBufferLabel->setText(QString("Map Buffers: %1 in %2 allocations (%3)%4")
+        .arg(audit.buffers)
+        .arg(audit.allocations)
+        .arg(formatBytes(audit.bytes))
+        .arg(audit.isClean() ? QString() : QString("\nDuplicated: %1").arg(audit.duplicated.join(", "))));
+
+    const ImageCache& cache = ImageCacheManager::instance();
+    const ImageCache::Stats stats = cache.stats();
+    m_renderCacheLabel->setText(QString("Entries: %1 (%2 / %3)\nHits: %4  Misses: %5  Hit rate: %6%\nInsertions: %7  Evictions: %8")
+        .arg(stats.entries)
+        .arg(formatBytes(stats.bytes))
+        .arg(formatBytes(cache.getMaxCacheSize()))
+        .arg(stats.hits)
+        .arg(stats.misses)
+        .arg(stats.hitRate() * 100.0, 0, 'f', 1)
+        .arg(stats.insertions)
+        .arg(stats.evictions));
 }
 
 void DebugConsoleWidget::refreshSystemInfo()
@@ -67,6 +67,9 @@ private:
     QLabel* m_loadTimeLabel;
     QLabel* m_averageLoadTimeLabel;
     QLabel* m_totalLoadsLabel;
+    QLabel* m_memoryBudgetLabel;
+    QLabel* m_mapBufferLabel;
+    QLabel* m_renderCacheLabel;
     
     QWidget* m_systemTab;
     QTreeWidget* m_systemInfoTree;
@@ -32,6 +32,11 @@
 #include "ui/widgets/MapBrowserWidget.h"
 #include "ui/AtmosphereToolboxWidget.h"
 #include "utils/MapSession.h"
+#include "utils/DecodedMapCache.h"
+#include "utils/MapPrefetcher.h"
+#include "utils/ImageLoader.h"
+#include "utils/MemoryManager.h"
+#include "utils/StartupProfiler.h"
 #include "graphics/ToolOverlayWidget.h"
 #include "graphics/LightingOverlay.h"
 #include "graphics/PointLightSystem.h"
@@ -81,6 +86,21 @@
 const int MainWindow::MaxRecentFiles;
 const int MainWindow::MAX_TABS;
 
+namespace {
+
+// Status bar indicators stay muted until their feature is in use
+void setStatusActive(QLabel* label, bool active)
+{
+    DarkTheme::setTextStyle(label, active ? DarkTheme::AccentPrimary : QColor("#666666"),
+                            DarkTheme::FontSmall, QFont::Medium);
+    QPalette palette = label->palette();
+    palette.setColor(QPalette::Window, QColor(74, 144, 226, 25));
+    label->setPalette(palette);
+    label->setAutoFillBackground(active);
+}
+
+} // namespace
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , m_mapDisplay(nullptr)
@@ -193,21 +213,32 @@ MainWindow::MainWindow(QWidget *parent)
     QRect savedGeometry = settings.loadWindowGeometry("MainWindow", defaultGeometry);
     setGeometry(savedGeometry);
 
+    // Loader threads use the decoded map cache; configure it while still single-threaded
+    DecodedMapCache::instance().setMaxSizeMB(settings.loadDecodedMapCacheSize());
+    MapPrefetcher::instance().setBudgetMB(settings.loadPrefetchBudget());
+    ImageLoader::setPixelFormatPolicy(static_cast<ImageLoader::PixelFormatPolicy>(
+        qBound(0, settings.loadPixelFormatPolicy(), int(ImageLoader::PixelFormatPolicy::Memory))));
+
+    // Every registered cache answers to one process-wide budget
+    MemoryManager& memory = MemoryManager::instance();
+    memory.setMaxMemoryLimit(qint64(qMax(0, settings.loadMemoryBudget())) * 1024 * 1024);
+    memory.startBudgetMonitor();
+    StartupProfiler::mark("settings and caches");
+
     // MEMORY OPTIMIZATION: Defer heavy UI initialization
     // Only create bare minimum UI components initially
     setupMinimalUI();  // Create only essential components
+    StartupProfiler::mark("map view");
 
-    // Defer creation of controllers and managers until needed
-    QPointer<MainWindow> self = this;
-    QTimer::singleShot(10, this, [self]() {
-        if (self) self->setupDeferredComponents();
-    });
+    // The first frame of the map view ends startup; docks and panels nobody
+    // has asked for yet are built after it (setupDeferredComponents)
+    m_mapDisplay->viewport()->installEventFilter(this);
 
     setupActions();
+    StartupProfiler::mark("actions");
 
     createMenus();
-
-    // MEMORY OPTIMIZATION: Defer toolbox and fog controller creation
+    StartupProfiler::mark("menus");
 
     // Setup fog tool mode system BEFORE creating toolbar (toolbar needs these actions)
     setupFogToolModeSystem();
@@ -215,8 +246,10 @@ MainWindow::MainWindow(QWidget *parent)
     createToolbar();
 
     createZoomToolbar();
+    StartupProfiler::mark("toolbars");
 
     setupStatusBar();
+    StartupProfiler::mark("status bar");
 
     // Initialize controllers that depend on UI components
     // Note: ToolManager and FogToolsController will be created after MapDisplay
@@ -259,6 +292,7 @@ MainWindow::MainWindow(QWidget *parent)
     // CRITICAL: Set focus policy so MainWindow can receive keyboard events
     // This is required for shortcuts to work without clicking inside first
     setFocusPolicy(Qt::StrongFocus);
+    StartupProfiler::mark("main window constructed");
 }
 
 MainWindow::~MainWindow()
@@ -309,6 +343,10 @@ void MainWindow::closeEvent(QCloseEvent *event)
     // Save window geometry
     SettingsManager::instance().saveWindowGeometry("MainWindow", geometry());
 
+    // Open tabs come back on the next launch
+    SettingsManager::instance().saveSessionManifest(
+        m_tabsController ? m_tabsController->captureManifest() : SessionManifest());
+
     // Accept the close event and quit the application
     event->accept();
     QApplication::quit();
@@ -392,6 +430,19 @@ void MainWindow::setupMinimalUI()
     m_dropOverlay->setObjectName("dropOverlay");
     m_dropOverlay->hide();
     m_dropOverlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+    // Radial glow with a dashed outline; the overlay's own stylesheet is set
+    // once here rather than on every drag
+    m_dropOverlay->setStyleSheet(
+        "QWidget {"
+        "    background: qradialgradient("
+        "        cx: 0.5, cy: 0.5, radius: 0.8,"
+        "        stop: 0 rgba(74, 158, 255, 0.15),"
+        "        stop: 0.5 rgba(74, 158, 255, 0.08),"
+        "        stop: 1 transparent"
+        "    );"
+        "    border: 2px dashed #4a9eff;"
+        "    border-radius: 12px;"
+        "}");
 
     // No opacity effects or animations - they cause crashes with shared scenes
     m_dropAnimation = nullptr;
@@ -400,17 +451,29 @@ void MainWindow::setupMinimalUI()
 
 void MainWindow::setupDeferredComponents()
 {
+    // Runs once the first frame is on screen. Docks that were not opened in
+    // the meantime are built one per event-loop pass, so input arriving now
+    // waits for at most one of them; opening one first builds it on demand.
+    QTimer::singleShot(0, this, [this]() {
+        ensureMapBrowser();
+        StartupProfiler::mark("idle: map browser");
+
+        QTimer::singleShot(0, this, [this]() {
+            ensureAtmosphereToolbox();
+            StartupProfiler::mark("idle: atmosphere panel");
+            emit startupCompleted();
+        });
+    });
+}
 
-    // These components can be created after initial window is shown
-    // They're not needed immediately for basic functionality
-
-    // Defer controller creation - create on first use
-    // m_gridController - create when grid is first toggled
-    // m_lightingController - create when lighting is first enabled
-    // m_viewZoomController - create when zoom is first used
-    // m_playerWindowController - create when player window is opened
-    // m_fogToolsController - create when fog is first enabled
-
+bool MainWindow::eventFilter(QObject* watched, QEvent* event)
+{
+    if (event->type() == QEvent::Paint && m_mapDisplay && watched == m_mapDisplay->viewport()) {
+        m_mapDisplay->viewport()->removeEventFilter(this);
+        StartupProfiler::markInteractive();
+        setupDeferredComponents();
+    }
+    return QMainWindow::eventFilter(watched, event);
 }
 
 void MainWindow::setupActions()
@@ -512,43 +575,7 @@ QAction* MainWindow::getOrCreateAction(const QString& actionId)
 
 void MainWindow::createMenus()
 {
-    // Simplified menu bar with only essential items
-    menuBar()->setStyleSheet(R"(
-        QMenuBar {
-            background: #242424;
-            border-bottom: 1px solid #1a1a1a;
-            padding: 4px;
-        }
-        QMenuBar::item {
-            padding: 6px 12px;
-            color: #E0E0E0;
-            background: transparent;
-            border-radius: 4px;
-            margin: 0 2px;
-        }
-        QMenuBar::item:selected {
-            background: rgba(74, 144, 226, 0.2);
-        }
-        QMenu {
-            background: #2a2a2a;
-            border: 1px solid #3a3a3a;
-            padding: 4px;
-        }
-        QMenu::item {
-            padding: 8px 24px;
-            color: #E0E0E0;
-            border-radius: 4px;
-            margin: 2px;
-        }
-        QMenu::item:selected {
-            background: rgba(74, 144, 226, 0.25);
-        }
-        QMenu::separator {
-            background: #3a3a3a;
-            height: 1px;
-            margin: 4px 8px;
-        }
-    )");
+    // Simplified menu bar with only essential items (drawn by DarkTheme::Style)
 
     // FILE MENU - Minimal
     m_fileMenu = menuBar()->addMenu("&File");
@@ -794,16 +821,7 @@ void MainWindow::createMenus()
 
     m_viewMenu->addSeparator();
 
-    // Map Browser dock widget
-    m_mapBrowserWidget = new MapBrowserWidget(this);
-    m_mapBrowserWidget->setRecentFilesController(m_recentFilesController);
-    addDockWidget(Qt::RightDockWidgetArea, m_mapBrowserWidget);
-    m_mapBrowserWidget->hide();  // Hidden by default
-
-    // Connect map selection to file loading
-    connect(m_mapBrowserWidget, &MapBrowserWidget::mapSelected,
-            this, &MainWindow::loadMapFile);
-
+    // Map Browser dock widget (built by ensureMapBrowser)
     m_mapBrowserAction = new QAction("Map &Browser", this);
     m_mapBrowserAction->setShortcut(QKeySequence("B"));
     m_mapBrowserAction->setCheckable(true);
@@ -811,19 +829,7 @@ void MainWindow::createMenus()
     connect(m_mapBrowserAction, &QAction::triggered, this, &MainWindow::toggleMapBrowser);
     m_viewMenu->addAction(m_mapBrowserAction);
 
-    // Atmosphere Toolbox dock widget
-    m_atmosphereToolbox = new AtmosphereToolboxWidget(this);
-    if (m_atmosphereController && m_atmosphereController->getAtmosphereManager()) {
-        m_atmosphereToolbox->setAtmosphereManager(m_atmosphereController->getAtmosphereManager());
-        auto* mgr = m_atmosphereController->getAtmosphereManager();
-        m_atmosphereToolbox->setAudioSystems(mgr->getAmbientPlayer(), mgr->getMusicRemote());
-    }
-    addDockWidget(Qt::RightDockWidgetArea, m_atmosphereToolbox);
-    m_atmosphereToolbox->hide();  // Hidden by default
-
-    // Tabify right-side panels so they share space when both open
-    tabifyDockWidget(m_mapBrowserWidget, m_atmosphereToolbox);
-
+    // Atmosphere Toolbox dock widget (built by ensureAtmosphereToolbox)
     m_atmosphereToolboxAction = new QAction("&Atmosphere Panel", this);
     m_atmosphereToolboxAction->setShortcut(QKeySequence("A"));
     m_atmosphereToolboxAction->setCheckable(true);
@@ -890,8 +896,10 @@ void MainWindow::createToolbar()
     m_mainToolBar->setMovable(false);
     m_mainToolBar->setToolButtonStyle(Qt::ToolButtonIconOnly);  // Icons only to save space
 
-    // Toolbar styling from DarkTheme
-    m_mainToolBar->setStyleSheet(DarkTheme::toolBarStyle() + DarkTheme::toolButtonStyle());
+    // Toolbar buttons get DarkTheme::Style's flat panels; labels use the small font
+    QFont toolBarFont = m_mainToolBar->font();
+    toolBarFont.setPixelSize(DarkTheme::FontBase);
+    m_mainToolBar->setFont(toolBarFont);
 
     // SECTION 1: File Operations
     // Load Map button with premium styling
@@ -990,31 +998,8 @@ void MainWindow::createToolbar()
 
     // Make player window button more prominent with animation
     if (auto* btn = qobject_cast<QToolButton*>(m_mainToolBar->widgetForAction(m_playerWindowToggleAction))) {
-        btn->setStyleSheet(R"(
-            QToolButton {
-                background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,
-                            stop: 0 #2e5a9e, stop: 1 #254a8e);
-                border: 1px solid #4A90E2;
-                border-radius: 6px;
-                padding: 10px 20px;
-                color: white;
-                font-size: 14px;
-                font-weight: 600;
-                min-width: 120px;
-            }
-            QToolButton:hover {
-                background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,
-                            stop: 0 #3e6aae, stop: 1 #355a9e);
-                border-color: #5AA0F2;
-            }
-            QToolButton:pressed {
-            }
-            QToolButton:checked {
-                background: qlineargradient(x1: 0, y1: 0, x2: 0, y2: 1,
-                            stop: 0 #4e7abe, stop: 1 #456aae);
-                border-color: #6AB0FF;
-            }
-        )");
+        DarkTheme::setVariant(btn, DarkTheme::Variant::Primary);
+        DarkTheme::setTextStyle(btn, Qt::white, DarkTheme::FontMedium, QFont::DemiBold);
 
         // NOTE: Pulse animation removed - Qt QSS doesn't support box-shadow
         // and the effect was non-functional. Keep button styling simple.
@@ -1041,7 +1026,8 @@ void MainWindow::createContextualControls()
 
     // === Brush Size Spinner (compact control) ===
     QLabel* brushLabel = new QLabel("Brush:", this);
-    brushLabel->setStyleSheet("color: #E0E0E0; font-size: 12px; font-weight: 500; padding: 0 4px;");
+    DarkTheme::setTextStyle(brushLabel, DarkTheme::TextPrimary, DarkTheme::FontBase, QFont::Medium);
+    brushLabel->setContentsMargins(DarkTheme::SpaceTight, 0, DarkTheme::SpaceTight, 0);
     m_mainToolBar->addWidget(brushLabel);
 
     m_fogBrushSizeSpinner = new QSpinBox(this);
@@ -1051,50 +1037,7 @@ void MainWindow::createContextualControls()
     m_fogBrushSizeSpinner->setSuffix("px");
     m_fogBrushSizeSpinner->setFixedWidth(85);  // Compact width
     m_fogBrushSizeSpinner->setToolTip("<b>Brush Size</b><br>Adjust fog reveal brush diameter<br>Range: 10-400px");
-    m_fogBrushSizeSpinner->setStyleSheet(R"(
-        QSpinBox {
-            background: rgba(255, 255, 255, 0.05);
-            border: 1px solid rgba(255, 255, 255, 0.1);
-            border-radius: 4px;
-            padding: 4px 8px;
-            color: #E0E0E0;
-            font-size: 12px;
-            font-weight: 500;
-        }
-        QSpinBox:hover {
-            background: rgba(255, 255, 255, 0.08);
-            border-color: rgba(74, 144, 226, 0.3);
-        }
-        QSpinBox:disabled {
-            background: rgba(255, 255, 255, 0.02);
-            color: #808080;
-            border-color: rgba(255, 255, 255, 0.05);
-        }
-        QSpinBox::up-button, QSpinBox::down-button {
-            background: rgba(255, 255, 255, 0.05);
-            border: 1px solid rgba(255, 255, 255, 0.1);
-            width: 16px;
-        }
-        QSpinBox::up-button:hover, QSpinBox::down-button:hover {
-            background: rgba(74, 144, 226, 0.2);
-        }
-        QSpinBox::up-arrow {
-            image: none;
-            border-left: 4px solid transparent;
-            border-right: 4px solid transparent;
-            border-bottom: 4px solid #E0E0E0;
-            width: 0;
-            height: 0;
-        }
-        QSpinBox::down-arrow {
-            image: none;
-            border-left: 4px solid transparent;
-            border-right: 4px solid transparent;
-            border-top: 4px solid #E0E0E0;
-            width: 0;
-            height: 0;
-        }
-    )");
+    DarkTheme::setTextStyle(m_fogBrushSizeSpinner, DarkTheme::TextPrimary, DarkTheme::FontBase, QFont::Medium);
     m_mainToolBar->addWidget(m_fogBrushSizeSpinner);
 
     // Use QPointer for safe lambda capture
@@ -1120,7 +1063,8 @@ void MainWindow::createContextualControls()
 
     // === Grid Size Spinner (compact control) ===
     QLabel* gridLabel = new QLabel("Grid:", this);
-    gridLabel->setStyleSheet("color: #E0E0E0; font-size: 12px; font-weight: 500; padding: 0 4px;");
+    DarkTheme::setTextStyle(gridLabel, DarkTheme::TextPrimary, DarkTheme::FontBase, QFont::Medium);
+    gridLabel->setContentsMargins(DarkTheme::SpaceTight, 0, DarkTheme::SpaceTight, 0);
     m_mainToolBar->addWidget(gridLabel);
 
     m_gridSizeSpinner = new QSpinBox(this);
@@ -1131,50 +1075,7 @@ void MainWindow::createContextualControls()
     m_gridSizeSpinner->setSingleStep(10);  // Per CLAUDE.md spec: 10px increments
     m_gridSizeSpinner->setFixedWidth(85);  // Match brush spinner width
     m_gridSizeSpinner->setToolTip("<b>Grid Size</b><br>Adjust grid cell size<br>Range: 20-500px");
-    m_gridSizeSpinner->setStyleSheet(R"(
-        QSpinBox {
-            background: rgba(255, 255, 255, 0.05);
-            border: 1px solid rgba(255, 255, 255, 0.1);
-            border-radius: 4px;
-            padding: 4px 8px;
-            color: #E0E0E0;
-            font-size: 12px;
-            font-weight: 500;
-        }
-        QSpinBox:hover {
-            background: rgba(255, 255, 255, 0.08);
-            border-color: rgba(74, 144, 226, 0.3);
-        }
-        QSpinBox:disabled {
-            background: rgba(255, 255, 255, 0.02);
-            color: #808080;
-            border-color: rgba(255, 255, 255, 0.05);
-        }
-        QSpinBox::up-button, QSpinBox::down-button {
-            background: rgba(255, 255, 255, 0.05);
-            border: 1px solid rgba(255, 255, 255, 0.1);
-            width: 16px;
-        }
-        QSpinBox::up-button:hover, QSpinBox::down-button:hover {
-            background: rgba(74, 144, 226, 0.2);
-        }
-        QSpinBox::up-arrow {
-            image: none;
-            border-left: 4px solid transparent;
-            border-right: 4px solid transparent;
-            border-bottom: 4px solid #E0E0E0;
-            width: 0;
-            height: 0;
-        }
-        QSpinBox::down-arrow {
-            image: none;
-            border-left: 4px solid transparent;
-            border-right: 4px solid transparent;
-            border-top: 4px solid #E0E0E0;
-            width: 0;
-            height: 0;
-        }
-    )");
+    DarkTheme::setTextStyle(m_gridSizeSpinner, DarkTheme::TextPrimary, DarkTheme::FontBase, QFont::Medium);
     m_mainToolBar->addWidget(m_gridSizeSpinner);
 
     // Use QPointer for safe lambda capture
@@ -1234,34 +1135,9 @@ void MainWindow::updateContextualToolbarControls()
     if (m_resetFogAction) {
         m_resetFogAction->setEnabled(m_mapDisplay && m_mapDisplay->isFogEnabled());
 
-        // Apply danger styling (always, since button always visible)
-        if (m_mainToolBar) {
-            if (auto* btn = qobject_cast<QToolButton*>(m_mainToolBar->widgetForAction(m_resetFogAction))) {
-                btn->setStyleSheet(R"(
-                    QToolButton {
-                        background: rgba(220, 53, 69, 0.15);
-                        border: 1px solid rgba(220, 53, 69, 0.3);
-                        border-radius: 6px;
-                        padding: 8px 16px;
-                        color: #ff6b6b;
-                        font-size: 13px;
-                        font-weight: 500;
-                    }
-                    QToolButton:hover:enabled {
-                        background: rgba(220, 53, 69, 0.25);
-                        border-color: rgba(220, 53, 69, 0.5);
-                        color: #ff8787;
-                    }
-                    QToolButton:pressed:enabled {
-                        background: rgba(220, 53, 69, 0.35);
-                    }
-                    QToolButton:disabled {
-                        background: rgba(220, 53, 69, 0.05);
-                        border-color: rgba(220, 53, 69, 0.1);
-                        color: rgba(255, 107, 107, 0.3);
-                    }
-                )");
-            }
+        // Danger look (always, since button always visible)
+        if (auto* btn = qobject_cast<QToolButton*>(m_mainToolBar->widgetForAction(m_resetFogAction))) {
+            DarkTheme::setVariant(btn, DarkTheme::Variant::Danger);
         }
     }
 }
@@ -1358,6 +1234,23 @@ void MainWindow::loadMap()
 }
 
 void MainWindow::loadMapFile(const QString& path)
+{
+    ensureTabsController();
+    m_tabsController->loadMapFile(path);
+}
+
+void MainWindow::restoreLastSession()
+{
+    const SessionManifest manifest = SettingsManager::instance().loadSessionManifest();
+    if (manifest.isEmpty()) {
+        return;
+    }
+
+    ensureTabsController();
+    m_tabsController->restoreSessions(manifest);
+}
+
+void MainWindow::ensureTabsController()
 {
     // MapDisplay and ToolManager are now created eagerly in setupMinimalUI
     // Only need to create TabsController if it doesn't exist yet
@@ -1375,6 +1268,12 @@ void MainWindow::loadMapFile(const QString& path)
                 });
         connect(m_tabsController, &TabsController::requestHideProgress,
                 this, &MainWindow::hideLoadProgress);
+        connect(m_tabsController, &TabsController::requestProgress,
+                this, [this](int percentage, const QString& status) {
+                    if (m_loadingOverlay && m_loadingOverlay->isLoading()) {
+                        m_loadingOverlay->updateProgress(percentage, status);
+                    }
+                });
         connect(m_tabsController, &TabsController::requestStatus,
                 this, [this](const QString& message, int timeout) {
                     if (auto* toast = ToastNotification::instance(this)) {
@@ -1407,15 +1306,13 @@ void MainWindow::loadMapFile(const QString& path)
                     if (!mapPath.isEmpty()) {
                         setWindowTitle(QString("Crit VTT — %1").arg(QFileInfo(mapPath).fileName()));
                     }
+
+                    updatePrefetchCandidates();
                 });
         // CRITICAL FIX: Connect requestAddRecent signal to add files to recent files menu
         connect(m_tabsController, &TabsController::requestAddRecent,
                 this, &MainWindow::addToRecentFiles, Qt::QueuedConnection);
     }
-
-    if (m_tabsController) {
-        m_tabsController->loadMapFile(path);
-    }
 }
 
 void MainWindow::togglePlayerWindow()
@@ -1650,6 +1547,9 @@ void MainWindow::openPreferences()
             m_mapDisplay->update();
             // Re-apply wheel zoom preference
             m_mapDisplay->setZoomControlsEnabled(SettingsManager::instance().loadWheelZoomEnabled());
+            // Adopts or releases the live effects; the player view shares the scene.
+            // Parked tab scenes catch up when they are restored.
+            m_mapDisplay->setAtmosphereCompositingEnabled(SettingsManager::instance().loadAtmosphereCompositing());
 
             // Sync with player window
             if (m_playerWindow) {
@@ -2007,7 +1907,10 @@ void MainWindow::showLoadProgress(const QString& fileName, qint64 fileSize)
     if (!m_loadingOverlay) {
         m_loadingOverlay = new LoadingOverlay(this);
         connect(m_loadingOverlay, &LoadingOverlay::cancelled, this, [this]() {
-            // Handle cancellation if needed
+            // Loads run on a worker, so the in-flight load can really be abandoned
+            if (m_tabsController) {
+                m_tabsController->cancelLoading();
+            }
             hideLoadProgress();
         });
     }
@@ -2136,19 +2039,6 @@ void MainWindow::animateDropFeedback(bool entering)
         m_dropOverlay->setGeometry(rect);
         m_dropOverlay->show();
         m_dropOverlay->raise();
-
-        // Premium drop feedback with subtle animation feel
-        m_dropOverlay->setStyleSheet(
-            "QWidget {"
-            "    background: qradialgradient("
-            "        cx: 0.5, cy: 0.5, radius: 0.8,"
-            "        stop: 0 rgba(74, 158, 255, 0.15),"
-            "        stop: 0.5 rgba(74, 158, 255, 0.08),"
-            "        stop: 1 transparent"
-            "    );"
-            "    border: 2px dashed #4a9eff;"
-            "    border-radius: 12px;"
-            "}");
     } else {
         // Simple hide without animation
         m_dropOverlay->hide();
@@ -2168,6 +2058,41 @@ void MainWindow::openRecentFile() {}
 
 void MainWindow::clearRecentFiles() {}
 
+void MainWindow::updatePrefetchCandidates()
+{
+    // Most likely next first: neighbouring tabs that were released from
+    // memory, the next map in the browse folder, then recent files
+    QStringList candidates;
+    QString currentPath;
+    if (m_tabsController) {
+        candidates << m_tabsController->releasedNeighbourPaths();
+        if (MapSession* session = m_tabsController->getCurrentSession()) {
+            currentPath = session->filePath();
+        }
+    }
+    auto isOpen = [this](const QString& path) {
+        return m_tabsController && m_tabsController->isOpen(path);
+    };
+
+    if (m_mapBrowserWidget && !currentPath.isEmpty()) {
+        const QStringList browseFiles = m_mapBrowserWidget->browseMapFiles();
+        const int index = browseFiles.indexOf(QFileInfo(currentPath).absoluteFilePath());
+        for (int i = index + 1; index >= 0 && i < browseFiles.size() && i <= index + 2; ++i) {
+            if (!isOpen(browseFiles.at(i))) {
+                candidates << browseFiles.at(i);
+            }
+        }
+    }
+
+    for (const QString& recent : SettingsManager::instance().loadRecentFiles()) {
+        if (!isOpen(recent) && QFileInfo::exists(recent)) {
+            candidates << recent;
+        }
+    }
+
+    MapPrefetcher::instance().setCandidates(candidates);
+}
+
 void MainWindow::updateRecentFilesMenu() { if (m_recentFilesController) m_recentFilesController->updateMenu(); }
 
 void MainWindow::addToRecentFiles(const QString& filePath) { if (m_recentFilesController) m_recentFilesController->addToRecent(filePath); }
@@ -2175,18 +2100,7 @@ void MainWindow::addToRecentFiles(const QString& filePath) { if (m_recentFilesCo
 void MainWindow::setupStatusBar()
 {
     // Ultra-minimal status bar with only essential info
-    statusBar()->setStyleSheet(R"(
-        QStatusBar {
-            background: #1a1a1a;
-            border-top: 1px solid #2a2a2a;
-            padding: 4px;
-            font-size: 12px;
-            color: #888;
-        }
-        QStatusBar::item {
-            border: none;
-        }
-    )");
+    DarkTheme::setTextStyle(statusBar(), QColor("#888888"), DarkTheme::FontBase);
 
     statusBar()->showMessage("Ready");
 
@@ -2196,21 +2110,6 @@ void MainWindow::setupStatusBar()
 
     // Minimal status container with only 3 indicators
     m_statusContainer = new QWidget(this);
-    m_statusContainer->setStyleSheet(R"(
-        QWidget { background: transparent; }
-        QLabel {
-            color: #666;
-            font-size: 11px;
-            font-weight: 500;
-            padding: 2px 8px;
-            margin: 0 2px;
-            border-radius: 3px;
-        }
-        QLabel[active="true"] {
-            color: #4A90E2;
-            background: rgba(74, 144, 226, 0.1);
-        }
-    )");
 
     QHBoxLayout* statusLayout = new QHBoxLayout(m_statusContainer);
     statusLayout->setContentsMargins(0, 0, 8, 0);
@@ -2230,34 +2129,24 @@ void MainWindow::setupStatusBar()
     m_rotationStatusLabel->setToolTip("DM rotation (click rotate button to change)");
     statusLayout->addWidget(m_rotationStatusLabel);
 
+    for (QLabel* indicator : { m_gridStatusLabel, m_zoomStatusLabel, m_rotationStatusLabel }) {
+        indicator->setContentsMargins(DarkTheme::SpaceBase, 2, DarkTheme::SpaceBase, 2);
+        setStatusActive(indicator, false);
+    }
+
     // Hidden privacy indicator (only shows when active)
     m_privacyStatusLabel = new QLabel("PRIVACY", m_statusContainer);
     m_privacyStatusLabel->setToolTip("Privacy mode active - Player screen protected");
-    m_privacyStatusLabel->setStyleSheet(R"(
-        QLabel {
-            color: #E74C3C;
-            background: rgba(231, 76, 60, 0.15);
-            font-weight: 600;
-            padding: 2px 10px;
-            border-radius: 3px;
-        }
-    )");
-    m_privacyStatusLabel->setStyleSheet(
-        "QLabel {"
-        "   color: #E74C3C;"
-        "   font-weight: bold;"
-        "   padding: 2px 6px;"
-        "   background: rgba(231, 76, 60, 0.1);"
-        "   border: 1px solid #E74C3C;"
-        "   border-radius: 3px;"
-        "}"
-    );
+    DarkTheme::setChipStyle(m_privacyStatusLabel, DarkTheme::AccentDanger, QColor(231, 76, 60, 25));
+    QFont privacyFont = m_privacyStatusLabel->font();
+    privacyFont.setBold(true);
+    m_privacyStatusLabel->setFont(privacyFont);
     m_privacyStatusLabel->hide(); // Hidden by default
     statusLayout->addWidget(m_privacyStatusLabel);
 
     // Player sync badge (hidden until Player Window visible)
     m_playerSyncBadge = new QLabel("Synced", m_statusContainer);
-    m_playerSyncBadge->setStyleSheet("QLabel { background: #2E7D32; color: white; padding: 2px 6px; border-radius: 6px; }");
+    DarkTheme::setChipStyle(m_playerSyncBadge, Qt::white, QColor("#2E7D32"));
     m_playerSyncBadge->setVisible(false);
     statusLayout->addWidget(m_playerSyncBadge);
 
@@ -2275,7 +2164,7 @@ void MainWindow::updateStatusIndicators()
 
     // Minimalist grid indicator with subtle state
     const bool gridEnabled = m_mapDisplay && m_mapDisplay->isGridEnabled();
-    m_gridStatusLabel->setProperty("active", gridEnabled);
+    setStatusActive(m_gridStatusLabel, gridEnabled);
     if (gridEnabled && m_mapDisplay->getGridOverlay()) {
         GridOverlay* grid = m_mapDisplay->getGridOverlay();
         m_gridStatusLabel->setToolTip(QString("Grid: %1px = %2ft")
@@ -2287,11 +2176,11 @@ void MainWindow::updateStatusIndicators()
 
     // Minimalist fog indicator
     const bool fogOn = m_mapDisplay && m_mapDisplay->isFogEnabled();
-    m_fogStatusLabel->setProperty("active", fogOn);
+    setStatusActive(m_fogStatusLabel, fogOn);
     m_fogStatusLabel->setToolTip(fogOn ? "Fog enabled" : "Fog disabled (Ctrl+F)");
 
     // Player view mode indicator
-    m_playerViewStatusLabel->setProperty("active", m_playerViewModeEnabled);
+    setStatusActive(m_playerViewStatusLabel, m_playerViewModeEnabled);
     m_playerViewStatusLabel->setToolTip(m_playerViewModeEnabled ? "Player view mode active" : "Player view mode (Ctrl+P)");
 
     // Clean zoom display
@@ -2300,39 +2189,32 @@ void MainWindow::updateStatusIndicators()
         zoomLevel = m_mapDisplay->transform().m11() * 100.0;
     }
     m_zoomStatusLabel->setText(QString("%1%").arg(qRound(zoomLevel)));
-    m_zoomStatusLabel->setProperty("active", zoomLevel != 100.0);
+    setStatusActive(m_zoomStatusLabel, zoomLevel != 100.0);
 
     // Rotation status - show DM and Player rotation if different
     if (m_rotationStatusLabel) {
+        bool diverged = false;
         if (m_syncRotationToPlayer) {
             // Synced: just show DM rotation
             m_rotationStatusLabel->setText(QString("Rot: %1°").arg(m_mapRotation));
             m_rotationStatusLabel->setToolTip("Rotation (synced to player)");
-            m_rotationStatusLabel->setStyleSheet("");  // Default style
         } else {
             // Independent: show both if different
             if (m_mapRotation != m_playerRotation) {
                 m_rotationStatusLabel->setText(QString("DM:%1° / P:%2°").arg(m_mapRotation).arg(m_playerRotation));
                 m_rotationStatusLabel->setToolTip("DM and Player rotations are independent");
-                m_rotationStatusLabel->setStyleSheet("QLabel { color: #FFA500; }");  // Orange to indicate difference
+                diverged = true;
             } else {
                 m_rotationStatusLabel->setText(QString("Rot: %1°").arg(m_mapRotation));
                 m_rotationStatusLabel->setToolTip("Rotation (sync disabled, but currently matching)");
-                m_rotationStatusLabel->setStyleSheet("");
             }
         }
-        m_rotationStatusLabel->setProperty("active", m_mapRotation != 0 || m_playerRotation != 0);
+        setStatusActive(m_rotationStatusLabel, m_mapRotation != 0 || m_playerRotation != 0);
+        if (diverged) {
+            // Orange to indicate difference
+            DarkTheme::setTextStyle(m_rotationStatusLabel, QColor("#FFA500"), DarkTheme::FontSmall, QFont::Medium);
+        }
     }
-
-    // Refresh styles with smooth transition
-    m_gridStatusLabel->style()->unpolish(m_gridStatusLabel);
-    m_gridStatusLabel->style()->polish(m_gridStatusLabel);
-    m_fogStatusLabel->style()->unpolish(m_fogStatusLabel);
-    m_fogStatusLabel->style()->polish(m_fogStatusLabel);
-    m_playerViewStatusLabel->style()->unpolish(m_playerViewStatusLabel);
-    m_playerViewStatusLabel->style()->polish(m_playerViewStatusLabel);
-    m_zoomStatusLabel->style()->unpolish(m_zoomStatusLabel);
-    m_zoomStatusLabel->style()->polish(m_zoomStatusLabel);
 }
 
 void MainWindow::updateZoomStatus()
@@ -2766,9 +2648,7 @@ void MainWindow::updateFogModeIndicator()
 
     // Color the toggle button: green for reveal, red for hide
     if (auto* btn = qobject_cast<QToolButton*>(m_mainToolBar->widgetForAction(m_fogHideToggleAction))) {
-        btn->setStyleSheet(hideMode
-            ? DarkTheme::dangerButtonStyle()
-            : DarkTheme::successButtonStyle());
+        DarkTheme::setVariant(btn, hideMode ? DarkTheme::Variant::Danger : DarkTheme::Variant::Success);
     }
 }
 
@@ -3355,12 +3235,59 @@ void MainWindow::toggleDebugConsole()
     }
 }
 
-void MainWindow::toggleMapBrowser()
+MapBrowserWidget* MainWindow::ensureMapBrowser()
 {
-    if (!m_mapBrowserWidget) {
-        return;
+    if (m_mapBrowserWidget) {
+        return m_mapBrowserWidget;
     }
 
+    m_mapBrowserWidget = new MapBrowserWidget(this);
+    m_mapBrowserWidget->setRecentFilesController(m_recentFilesController);
+    addDockWidget(Qt::RightDockWidgetArea, m_mapBrowserWidget);
+    m_mapBrowserWidget->hide();  // Hidden by default
+
+    // Connect map selection to file loading
+    connect(m_mapBrowserWidget, &MapBrowserWidget::browseFilesChanged,
+            this, &MainWindow::updatePrefetchCandidates);
+    connect(m_mapBrowserWidget, &MapBrowserWidget::mapSelected,
+            this, &MainWindow::loadMapFile);
+
+    // Tabify right-side panels so they share space when both open
+    if (m_atmosphereToolbox) {
+        tabifyDockWidget(m_atmosphereToolbox, m_mapBrowserWidget);
+    }
+
+    // The constructor already emitted browseFilesChanged, before the
+    // connection above; maps opened before this build need the candidates
+    updatePrefetchCandidates();
+    return m_mapBrowserWidget;
+}
+
+AtmosphereToolboxWidget* MainWindow::ensureAtmosphereToolbox()
+{
+    if (m_atmosphereToolbox) {
+        return m_atmosphereToolbox;
+    }
+
+    m_atmosphereToolbox = new AtmosphereToolboxWidget(this);
+    if (m_atmosphereController && m_atmosphereController->getAtmosphereManager()) {
+        m_atmosphereToolbox->setAtmosphereManager(m_atmosphereController->getAtmosphereManager());
+        auto* mgr = m_atmosphereController->getAtmosphereManager();
+        m_atmosphereToolbox->setAudioSystems(mgr->getAmbientPlayer(), mgr->getMusicRemote());
+    }
+    addDockWidget(Qt::RightDockWidgetArea, m_atmosphereToolbox);
+    m_atmosphereToolbox->hide();  // Hidden by default
+
+    if (m_mapBrowserWidget) {
+        tabifyDockWidget(m_mapBrowserWidget, m_atmosphereToolbox);
+    }
+    return m_atmosphereToolbox;
+}
+
+void MainWindow::toggleMapBrowser()
+{
+    ensureMapBrowser();
+
     if (m_mapBrowserWidget->isVisible()) {
         m_mapBrowserWidget->hide();
         if (m_mapBrowserAction) {
@@ -3377,9 +3304,7 @@ void MainWindow::toggleMapBrowser()
 
 void MainWindow::toggleAtmosphereToolbox()
 {
-    if (!m_atmosphereToolbox) {
-        return;
-    }
+    ensureAtmosphereToolbox();
 
     if (m_atmosphereToolbox->isVisible()) {
         m_atmosphereToolbox->hide();
@@ -56,6 +56,13 @@ public:
     // Public API for loading maps from command line
     void loadMapFromCommandLine(const QString& path) { loadMapFile(path); }
 
+    // Reopen the tabs that were open at the last quit
+    void restoreLastSession();
+
+signals:
+    // First frame is up and the idle-time docks are built (StartupProfiler)
+    void startupCompleted();
+
 public slots:
     void loadMap();
     void togglePlayerWindow();
@@ -165,6 +172,9 @@ protected:
     // Focus management - ensure window has focus when shown
     void showEvent(QShowEvent *event) override;
 
+    // Watches the map view for the first painted frame
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
 private slots:
     void handleLoadProgress(qint64 bytesRead, qint64 totalBytes);
     void animateDropFeedback(bool entering);
@@ -187,7 +197,9 @@ private slots:
 
 private:
     void setupMinimalUI();  // Create only essential components
-    void setupDeferredComponents();  // Create heavy components after startup
+    void setupDeferredComponents();  // Create heavy components after the first frame
+    MapBrowserWidget* ensureMapBrowser();
+    AtmosphereToolboxWidget* ensureAtmosphereToolbox();
     void createMenus();
     void setupActions();
     QAction* getOrCreateAction(const QString& actionId);
@@ -195,8 +207,10 @@ private:
     void createToolbar();
     void createZoomToolbar();
     void loadMapFile(const QString& path);
+    void ensureTabsController();
     void updateRecentFilesMenu();
     void addToRecentFiles(const QString& filePath);
+    void updatePrefetchCandidates();
     void autoOpenPlayerWindow();
     void positionPlayerWindow();
     void ensurePlayerWindowConnections();
@@ -234,7 +248,7 @@ private:
 
     // Tab system
     QTabBar* m_tabBar;
-    static const int MAX_TABS = 10;
+    static const int MAX_TABS = 500;
 
     QMenu* m_fileMenu;
     QMenu* m_recentFilesMenu;
@@ -1,5 +1,6 @@
 #include "ui/PlayerWindow.h"
 #include "graphics/MapDisplay.h"
+#include "graphics/TiledMapItem.h"
 #include "utils/SettingsManager.h"
 #include "utils/AnimationHelper.h"
 #include <QMenuBar>
@@ -17,7 +18,6 @@
 #include <QWindow>
 #include <QContextMenuEvent>
 #include <QMenu>
-#include <QGraphicsPixmapItem>
 #include <QKeyEvent>
 #include <QMouseEvent>
 #include <QLabel>
@@ -308,12 +308,12 @@ void PlayerWindow::checkForMonitorChange()
 void PlayerWindow::autoFitToScreen()
 {
     if (m_playerView && m_playerView->scene() && !m_playerView->scene()->items().isEmpty()) {
-        // Get the first pixmap item (the map)
+        // Get the map item
         QList<QGraphicsItem*> items = m_playerView->scene()->items();
-        QGraphicsPixmapItem* mapItem = nullptr;
+        TiledMapItem* mapItem = nullptr;
         for (QGraphicsItem* item : items) {
-            if (auto* pixmapItem = qgraphicsitem_cast<QGraphicsPixmapItem*>(item)) {
-                mapItem = pixmapItem;
+            if (auto* tiledItem = qgraphicsitem_cast<TiledMapItem*>(item)) {
+                mapItem = tiledItem;
                 break;
             }
         }
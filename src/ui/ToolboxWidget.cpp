@@ -1,4 +1,5 @@
 #include "ui/ToolboxWidget.h"
+#include "ui/DarkTheme.h"
 #include "utils/AnimationHelper.h"
 #include "graphics/GMBeacon.h"
 #include <QAction>
@@ -10,6 +11,7 @@
 #include <QSlider>
 #include <QLabel>
 #include <QButtonGroup>
+#include <QFrame>
 #include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
 #include <QTimer>
@@ -49,41 +51,27 @@ void ToolSection::setupUI()
     m_expandButton = new QToolButton(this);
     m_expandButton->setText(">");
     m_expandButton->setFixedSize(20, 20);
-    m_expandButton->setStyleSheet(
-        "QToolButton {"
-        "   background: transparent;"
-        "   border: none;"
-        "   color: rgba(255, 255, 255, 0.5);"
-        "   font-size: 12px;"
-        "   font-weight: normal;"
-        "}"
-        "QToolButton:hover {"
-        "   color: rgba(255, 255, 255, 0.8);"
-        "}"
-    );
+    DarkTheme::setVariant(m_expandButton, DarkTheme::Variant::Flat);
+    DarkTheme::setTextStyle(m_expandButton, DarkTheme::TextPrimary, DarkTheme::FontBase);
     connect(m_expandButton, &QToolButton::clicked, this, &ToolSection::toggleExpanded);
 
     m_titleLabel = new QLabel(m_title.toUpper(), this);  // Apply uppercase directly
-    m_titleLabel->setStyleSheet(
-        "QLabel {"
-        "   color: rgba(255, 255, 255, 0.5);"
-        "   font-weight: 600;"
-        "   font-size: 12px;"
-        "   letter-spacing: 1px;"
-        "   background: transparent;"
-        "}"
-    );
+    DarkTheme::setTextStyle(m_titleLabel, QColor(255, 255, 255, 128), DarkTheme::FontBase, QFont::DemiBold);
+    QFont titleFont = m_titleLabel->font();
+    titleFont.setLetterSpacing(QFont::AbsoluteSpacing, 1);
+    m_titleLabel->setFont(titleFont);
 
     m_headerLayout->addWidget(m_expandButton);
     m_headerLayout->addWidget(m_titleLabel);
     m_headerLayout->addStretch();
 
-    m_headerWidget->setStyleSheet(
-        "QWidget {"
-        "   background: transparent;"
-        "   border-bottom: 1px solid rgba(255, 255, 255, 0.1);"
-        "}"
-    );
+    // Hairline under the header
+    QFrame* headerRule = new QFrame(this);
+    headerRule->setFrameShape(QFrame::HLine);
+    headerRule->setFrameShadow(QFrame::Plain);
+    QPalette rulePalette = headerRule->palette();
+    rulePalette.setColor(QPalette::WindowText, QColor(255, 255, 255, 25));
+    headerRule->setPalette(rulePalette);
 
     m_contentWidget = new QWidget(this);
     m_contentLayout = new QVBoxLayout(m_contentWidget);
@@ -94,6 +82,7 @@ void ToolSection::setupUI()
     m_contentLayout->setSpacing(spacing);
 
     m_mainLayout->addWidget(m_headerWidget);
+    m_mainLayout->addWidget(headerRule);
     m_mainLayout->addWidget(m_contentWidget);
 
     m_collapseAnimation = new QPropertyAnimation(m_contentWidget, "maximumHeight", this);
@@ -1,4 +1,5 @@
 #include "LightEditDialog.h"
+#include "ui/DarkTheme.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -60,6 +61,7 @@ void LightEditDialog::setupUI()
     QHBoxLayout* colorLayout = new QHBoxLayout(colorGroup);
     m_colorButton = new QPushButton();
     m_colorButton->setFixedSize(60, 30);
+    DarkTheme::setVariant(m_colorButton, DarkTheme::Variant::Swatch);
     m_colorButton->setToolTip("Click to change light color");
     connect(m_colorButton, &QPushButton::clicked, this, &LightEditDialog::onColorButtonClicked);
     colorLayout->addWidget(new QLabel("Light Color:"));
@@ -226,10 +228,9 @@ void LightEditDialog::onFlickerAmountChanged(int value)
 
 void LightEditDialog::updateColorButton()
 {
-    QString style = QString(
-        "background-color: %1; border: 1px solid #555; border-radius: 4px;"
-    ).arg(m_currentColor.name());
-    m_colorButton->setStyleSheet(style);
+    QPalette swatch = m_colorButton->palette();
+    swatch.setColor(QPalette::Button, m_currentColor);
+    m_colorButton->setPalette(swatch);
 }
 
 void LightEditDialog::updateLabels()
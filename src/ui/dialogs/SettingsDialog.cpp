@@ -49,6 +49,7 @@ SettingsDialog::SettingsDialog(QWidget *parent)
     , m_smoothAnimationsCheck(nullptr)
     , m_updateFrequencySlider(nullptr)
     , m_updateFrequencyLabel(nullptr)
+    , m_atmosphereCompositingCheck(nullptr)
     , m_displayTab(nullptr)
     , m_gridOpacitySlider(nullptr)
     , m_gridOpacityLabel(nullptr)
@@ -265,8 +266,18 @@ void SettingsDialog::createPerformanceTab()
     updateSliderLayout->addWidget(m_updateFrequencyLabel);
     updateLayout->addRow("Target FPS:", updateSliderLayout);
 
+    // Rendering settings
+    QGroupBox* renderingGroup = new QGroupBox("Rendering");
+    QFormLayout* renderingLayout = new QFormLayout(renderingGroup);
+
+    m_atmosphereCompositingCheck = new QCheckBox("Composite atmosphere effects into one layer");
+    m_atmosphereCompositingCheck->setChecked(DEFAULT_ATMOSPHERE_COMPOSITING);
+    m_atmosphereCompositingCheck->setToolTip("Paints lights, mist, weather and lightning in a single pass. Applies immediately.");
+    renderingLayout->addRow("", m_atmosphereCompositingCheck);
+
     layout->addWidget(qualityGroup);
     layout->addWidget(updateGroup);
+    layout->addWidget(renderingGroup);
     layout->addStretch();
 
     m_tabWidget->addTab(m_performanceTab, "Performance");
@@ -372,6 +383,7 @@ void SettingsDialog::connectSignals()
     connect(m_gridColorButton, &QPushButton::clicked, this, &SettingsDialog::onGridColorClicked);
     connect(m_defaultFogBrushSlider, &QSlider::valueChanged, this, &SettingsDialog::onDefaultFogBrushSizeChanged);
     connect(m_wheelZoomCheck, &QCheckBox::toggled, this, [this](bool enabled){ m_settings.wheelZoomEnabled = enabled; });
+    connect(m_atmosphereCompositingCheck, &QCheckBox::toggled, this, [this](bool enabled){ m_settings.atmosphereCompositing = enabled; });
 
     // Button signals
     connect(m_okButton, &QPushButton::clicked, this, [this]() {
@@ -497,6 +509,7 @@ void SettingsDialog::resetToDefaults()
     m_animationQualityCombo->setCurrentIndex(DEFAULT_ANIMATION_QUALITY);
     m_smoothAnimationsCheck->setChecked(DEFAULT_SMOOTH_ANIMATIONS);
     m_updateFrequencySlider->setValue(DEFAULT_UPDATE_FREQUENCY);
+    m_atmosphereCompositingCheck->setChecked(DEFAULT_ATMOSPHERE_COMPOSITING);
 
     m_gridOpacitySlider->setValue(DEFAULT_GRID_OPACITY);
     m_gridColor = DEFAULT_GRID_COLOR;
@@ -515,6 +528,7 @@ void SettingsDialog::resetToDefaults()
     m_settings.animationQuality = DEFAULT_ANIMATION_QUALITY;
     m_settings.smoothAnimations = DEFAULT_SMOOTH_ANIMATIONS;
     m_settings.updateFrequency = DEFAULT_UPDATE_FREQUENCY;
+    m_settings.atmosphereCompositing = DEFAULT_ATMOSPHERE_COMPOSITING;
     m_settings.gridOpacity = DEFAULT_GRID_OPACITY;
     m_settings.gridColor = DEFAULT_GRID_COLOR;
     m_settings.defaultFogBrushSize = DEFAULT_FOG_BRUSH_SIZE;
@@ -540,6 +554,7 @@ void SettingsDialog::loadSettings()
     m_settings.animationQuality = settings.loadAnimationQuality();
     m_settings.smoothAnimations = settings.loadSmoothAnimations();
     m_settings.updateFrequency = settings.loadUpdateFrequency();
+    m_settings.atmosphereCompositing = settings.loadAtmosphereCompositing();
 
     // Load Display settings
     m_settings.gridOpacity = settings.loadGridOpacity();
@@ -561,6 +576,7 @@ void SettingsDialog::loadSettings()
     m_animationQualityCombo->setCurrentIndex(m_settings.animationQuality);
     m_smoothAnimationsCheck->setChecked(m_settings.smoothAnimations);
     m_updateFrequencySlider->setValue(m_settings.updateFrequency);
+    m_atmosphereCompositingCheck->setChecked(m_settings.atmosphereCompositing);
 
     m_gridOpacitySlider->setValue(m_settings.gridOpacity);
     m_gridColor = m_settings.gridColor;
@@ -588,6 +604,7 @@ void SettingsDialog::saveSettings()
     settings.saveAnimationQuality(m_settings.animationQuality);
     settings.saveSmoothAnimations(m_settings.smoothAnimations);
     settings.saveUpdateFrequency(m_settings.updateFrequency);
+    settings.saveAtmosphereCompositing(m_settings.atmosphereCompositing);
 
     // Save Display settings
     settings.saveGridOpacity(m_settings.gridOpacity);
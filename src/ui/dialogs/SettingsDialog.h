@@ -96,6 +96,7 @@ private:
     QCheckBox* m_smoothAnimationsCheck;
     QSlider* m_updateFrequencySlider;
     QLabel* m_updateFrequencyLabel;
+    QCheckBox* m_atmosphereCompositingCheck;
 
     // Display Settings
     QWidget* m_displayTab;
@@ -134,6 +135,7 @@ private:
         int animationQuality; // 0=low, 1=medium, 2=high
         bool smoothAnimations;
         int updateFrequency;
+        bool atmosphereCompositing;
 
         // Display
         int gridOpacity;
@@ -155,6 +157,7 @@ private:
     static const int DEFAULT_ANIMATION_QUALITY = 1; // medium
     static const bool DEFAULT_SMOOTH_ANIMATIONS = true;
     static const int DEFAULT_UPDATE_FREQUENCY = 60;
+    static const bool DEFAULT_ATMOSPHERE_COMPOSITING = false;
 
     static const int DEFAULT_GRID_OPACITY = 50;
     static const QColor DEFAULT_GRID_COLOR;
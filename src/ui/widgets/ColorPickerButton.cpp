@@ -1,4 +1,5 @@
 #include "ColorPickerButton.h"
+#include "ui/DarkTheme.h"
 #include <QColorDialog>
 
 ColorPickerButton::ColorPickerButton(QWidget* parent)
@@ -7,6 +8,7 @@ ColorPickerButton::ColorPickerButton(QWidget* parent)
 {
     setFixedSize(32, 24);
     setCursor(Qt::PointingHandCursor);
+    DarkTheme::setVariant(this, DarkTheme::Variant::Swatch);
     connect(this, &QPushButton::clicked, this, &ColorPickerButton::openColorDialog);
     updateButtonStyle();
 }
@@ -17,6 +19,7 @@ ColorPickerButton::ColorPickerButton(const QColor& initialColor, QWidget* parent
 {
     setFixedSize(32, 24);
     setCursor(Qt::PointingHandCursor);
+    DarkTheme::setVariant(this, DarkTheme::Variant::Swatch);
     connect(this, &QPushButton::clicked, this, &ColorPickerButton::openColorDialog);
     updateButtonStyle();
 }
@@ -48,28 +51,13 @@ void ColorPickerButton::openColorDialog()
 
 void ColorPickerButton::updateButtonStyle()
 {
-    // Create a style with the color swatch and dark theme border
-    QString colorHex = m_color.name(QColor::HexArgb);
-
-    // For display, use opaque version if alpha is very low
+    // DarkTheme::Style fills the swatch with the Button colour, always opaque
     QColor displayColor = m_color;
-    if (displayColor.alpha() < 50) {
-        displayColor.setAlpha(255);
-    }
+    displayColor.setAlpha(255);
 
-    setStyleSheet(QString(R"(
-        QPushButton {
-            background-color: %1;
-            border: 1px solid #3A3A3A;
-            border-radius: 3px;
-        }
-        QPushButton:hover {
-            border: 1px solid #4A90E2;
-        }
-        QPushButton:pressed {
-            border: 2px solid #4A90E2;
-        }
-    )").arg(displayColor.name()));
+    QPalette swatch = palette();
+    swatch.setColor(QPalette::Button, displayColor);
+    setPalette(swatch);
 
     // Set tooltip showing color info
     QString tooltip = QString("<b>Color</b><br>%1").arg(m_color.name(QColor::HexRgb).toUpper());
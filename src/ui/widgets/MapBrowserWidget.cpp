@@ -1,6 +1,7 @@
 #include "MapBrowserWidget.h"
 #include "ThumbnailCache.h"
 #include "controllers/RecentFilesController.h"
+#include "ui/DarkTheme.h"
 #include "utils/SettingsManager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -98,16 +99,12 @@ void MapBrowserWidget::setupUI()
     m_mainLayout->setContentsMargins(8, 8, 8, 8);
     m_mainLayout->setSpacing(8);
 
-    // Common list style
-    const QString listStyle =
-        "QListWidget { background: #252525; border: 1px solid #3A3A3A; border-radius: 4px; }"
-        "QListWidget::item { padding: 4px; border-radius: 3px; }"
-        "QListWidget::item:hover { background: #3A3A3A; }"
-        "QListWidget::item:selected { background: #4A90E2; }";
+    // Lists, line edits and buttons take their look from DarkTheme::Style
+    const QColor favoriteColor("#E2A94A");
 
     // === Recent Files Section ===
     m_recentLabel = new QLabel("RECENT FILES");
-    m_recentLabel->setStyleSheet("font-weight: bold; color: #808080; font-size: 11px;");
+    DarkTheme::setTextStyle(m_recentLabel, DarkTheme::TextMuted, DarkTheme::FontSmall, QFont::Bold);
     m_mainLayout->addWidget(m_recentLabel);
 
     m_recentList = new QListWidget();
@@ -115,7 +112,6 @@ void MapBrowserWidget::setupUI()
     m_recentList->setIconSize(QSize(48, 48));
     m_recentList->setSpacing(2);
     m_recentList->setMaximumHeight(150);
-    m_recentList->setStyleSheet(listStyle);
     m_recentList->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(m_recentList, &QListWidget::itemClicked,
             this, &MapBrowserWidget::onRecentItemClicked);
@@ -125,7 +121,7 @@ void MapBrowserWidget::setupUI()
 
     // === Favorites Section ===
     m_favoritesLabel = new QLabel("★ FAVORITES");
-    m_favoritesLabel->setStyleSheet("font-weight: bold; color: #E2A94A; font-size: 11px;");
+    DarkTheme::setTextStyle(m_favoritesLabel, favoriteColor, DarkTheme::FontSmall, QFont::Bold);
     m_mainLayout->addWidget(m_favoritesLabel);
 
     m_favoritesList = new QListWidget();
@@ -133,7 +129,6 @@ void MapBrowserWidget::setupUI()
     m_favoritesList->setIconSize(QSize(48, 48));
     m_favoritesList->setSpacing(2);
     m_favoritesList->setMaximumHeight(150);
-    m_favoritesList->setStyleSheet(listStyle);
     m_favoritesList->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(m_favoritesList, &QListWidget::itemClicked,
             this, &MapBrowserWidget::onFavoriteItemClicked);
@@ -150,16 +145,13 @@ void MapBrowserWidget::setupUI()
 
     // === Browse Folder Section ===
     m_browseLabel = new QLabel("BROWSE FOLDER");
-    m_browseLabel->setStyleSheet("font-weight: bold; color: #808080; font-size: 11px;");
+    DarkTheme::setTextStyle(m_browseLabel, DarkTheme::TextMuted, DarkTheme::FontSmall, QFont::Bold);
     m_mainLayout->addWidget(m_browseLabel);
 
     // Path display
     m_pathEdit = new QLineEdit();
     m_pathEdit->setReadOnly(true);
     m_pathEdit->setPlaceholderText("No folder selected");
-    m_pathEdit->setStyleSheet(
-        "QLineEdit { background: #252525; border: 1px solid #3A3A3A; border-radius: 3px; padding: 4px; }"
-    );
     m_mainLayout->addWidget(m_pathEdit);
 
     // Button bar: Up, Open, Star
@@ -171,9 +163,7 @@ void MapBrowserWidget::setupUI()
     m_parentButton = new QPushButton("↑");
     m_parentButton->setFixedWidth(32);
     m_parentButton->setToolTip("Go to parent folder");
-    m_parentButton->setStyleSheet(
-        "QPushButton { font-size: 14px; font-weight: bold; }"
-    );
+    DarkTheme::setTextStyle(m_parentButton, DarkTheme::TextPrimary, DarkTheme::FontMedium, QFont::Bold);
     connect(m_parentButton, &QPushButton::clicked,
             this, &MapBrowserWidget::onParentDirectoryClicked);
     pathLayout->addWidget(m_parentButton);
@@ -181,9 +171,7 @@ void MapBrowserWidget::setupUI()
     m_refreshButton = new QPushButton("⟳");
     m_refreshButton->setFixedWidth(32);
     m_refreshButton->setToolTip("Refresh folder contents");
-    m_refreshButton->setStyleSheet(
-        "QPushButton { font-size: 14px; font-weight: bold; }"
-    );
+    DarkTheme::setTextStyle(m_refreshButton, DarkTheme::TextPrimary, DarkTheme::FontMedium, QFont::Bold);
     connect(m_refreshButton, &QPushButton::clicked,
             this, &MapBrowserWidget::onRefreshClicked);
     pathLayout->addWidget(m_refreshButton);
@@ -196,11 +184,7 @@ void MapBrowserWidget::setupUI()
 
     m_favoriteButton = new QPushButton("★ Favorite");
     m_favoriteButton->setToolTip("Add selected map to favorites");
-    m_favoriteButton->setStyleSheet(
-        "QPushButton { color: #E2A94A; }"
-        "QPushButton:hover { background: #3A3A3A; }"
-        "QPushButton:disabled { color: #505050; }"
-    );
+    DarkTheme::setTextStyle(m_favoriteButton, favoriteColor);
     connect(m_favoriteButton, &QPushButton::clicked,
             this, &MapBrowserWidget::onAddToFavoritesClicked);
     pathLayout->addWidget(m_favoriteButton);
@@ -218,9 +202,6 @@ void MapBrowserWidget::setupUI()
     m_searchEdit = new QLineEdit();
     m_searchEdit->setPlaceholderText("Search maps (includes subfolders)...");
     m_searchEdit->setClearButtonEnabled(true);
-    m_searchEdit->setStyleSheet(
-        "QLineEdit { background: #252525; border: 1px solid #3A3A3A; border-radius: 3px; padding: 4px; }"
-    );
     connect(m_searchEdit, &QLineEdit::textChanged,
             this, &MapBrowserWidget::onSearchTextChanged);
     searchLayout->addWidget(m_searchEdit, 1);
@@ -251,7 +232,7 @@ void MapBrowserWidget::setupUI()
     m_viewModeButton = new QToolButton();
     m_viewModeButton->setText(m_gridView ? "☷" : "☰");
     m_viewModeButton->setToolTip(m_gridView ? "Switch to list view" : "Switch to grid view");
-    m_viewModeButton->setStyleSheet("QToolButton { font-size: 14px; padding: 4px 8px; }");
+    DarkTheme::setTextStyle(m_viewModeButton, DarkTheme::TextPrimary, DarkTheme::FontMedium);
     connect(m_viewModeButton, &QToolButton::clicked,
             this, &MapBrowserWidget::onViewModeToggled);
     controlsLayout->addWidget(m_viewModeButton);
@@ -261,7 +242,7 @@ void MapBrowserWidget::setupUI()
     m_bookmarkButton->setText("📁");
     m_bookmarkButton->setToolTip("Folder bookmarks");
     m_bookmarkButton->setPopupMode(QToolButton::InstantPopup);
-    m_bookmarkButton->setStyleSheet("QToolButton { font-size: 14px; padding: 4px 8px; }");
+    DarkTheme::setTextStyle(m_bookmarkButton, DarkTheme::TextPrimary, DarkTheme::FontMedium);
     connect(m_bookmarkButton, &QToolButton::clicked,
             this, &MapBrowserWidget::onBookmarksMenuRequested);
     controlsLayout->addWidget(m_bookmarkButton);
@@ -270,7 +251,7 @@ void MapBrowserWidget::setupUI()
 
     // File count label
     m_fileCountLabel = new QLabel("0 files");
-    m_fileCountLabel->setStyleSheet("color: #808080; font-size: 11px;");
+    DarkTheme::setTextStyle(m_fileCountLabel, DarkTheme::TextMuted, DarkTheme::FontSmall);
     controlsLayout->addWidget(m_fileCountLabel);
 
     m_mainLayout->addWidget(m_controlsWidget);
@@ -283,7 +264,6 @@ void MapBrowserWidget::setupUI()
     m_browseList->setSpacing(m_gridView ? 8 : 2);
     m_browseList->setResizeMode(QListView::Adjust);
     m_browseList->setWordWrap(true);
-    m_browseList->setStyleSheet(listStyle);
     m_browseList->setContextMenuPolicy(Qt::CustomContextMenu);
     m_browseList->setSelectionMode(QAbstractItemView::ExtendedSelection);  // Multi-select with Ctrl/Shift
     // Disable Qt's internal drag - we handle it ourselves with proper file URL mime data
@@ -455,6 +435,19 @@ void MapBrowserWidget::updateBrowseSection()
 
     // Update file count
     updateFileCount();
+
+    emit browseFilesChanged();
+}
+
+QStringList MapBrowserWidget::browseMapFiles() const
+{
+    QStringList files;
+    for (const BrowseItem& item : m_allBrowseItems) {
+        if (!item.isDirectory) {
+            files.append(item.filePath);
+        }
+    }
+    return files;
 }
 
 void MapBrowserWidget::filterBrowseList(const QString& filter)
@@ -1063,6 +1056,7 @@ void MapBrowserWidget::onSortChanged(int index)
     // Re-sort and refresh
     sortBrowseItems();
     filterBrowseList(m_currentFilter);
+    emit browseFilesChanged();
 }
 
 // ===== View Mode =====
@@ -33,8 +33,12 @@ public:
     // Get current browse directory
     QString browseDirectory() const { return m_browseDirectory; }
 
+    // Map files of the browse folder (and its subfolders) in display order
+    QStringList browseMapFiles() const;
+
 signals:
     void mapSelected(const QString& filePath);
+    void browseFilesChanged();
 
 public slots:
     void refreshRecentFiles();
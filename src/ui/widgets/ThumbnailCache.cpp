@@ -1,4 +1,5 @@
 #include "ThumbnailCache.h"
+#include "graphics/ImageCache.h"
 #include "utils/VTTLoader.h"
 #include <QStandardPaths>
 #include <QDir>
@@ -24,10 +25,6 @@ ThumbnailCache::ThumbnailCache()
     // Configure thread pool - limit concurrent thumbnail generation
     m_threadPool->setMaxThreadCount(2);
 
-    // Set memory cache size (estimate ~50KB per 128x128 RGBA thumbnail)
-    // 50MB / 50KB = ~1000 thumbnails
-    m_memoryCache.setMaxCost(m_memoryCacheSizeMB * 1024);
-
     // Create placeholder pixmap
     m_placeholderPixmap = QPixmap(m_thumbnailSize, m_thumbnailSize);
     m_placeholderPixmap.fill(QColor(0x2D, 0x2D, 0x2D));
@@ -74,17 +71,15 @@ QPixmap ThumbnailCache::getThumbnail(const QString& filePath)
     QMutexLocker locker(&m_mutex);
 
     // Check memory cache first
-    QPixmap* cached = m_memoryCache.object(filePath);
-    if (cached) {
-        return *cached;
+    QPixmap cached = memoryCached(filePath);
+    if (!cached.isNull()) {
+        return cached;
     }
 
     // Check disk cache
     QPixmap diskCached = loadFromDiskCache(filePath);
     if (!diskCached.isNull()) {
-        // Add to memory cache (estimate cost as KB)
-        int cost = (diskCached.width() * diskCached.height() * 4) / 1024;
-        m_memoryCache.insert(filePath, new QPixmap(diskCached), qMax(cost, 1));
+        storeInMemory(filePath, diskCached);
         return diskCached;
     }
 
@@ -102,7 +97,7 @@ bool ThumbnailCache::hasThumbnail(const QString& filePath) const
 {
     QMutexLocker locker(&const_cast<QMutex&>(m_mutex));
 
-    if (m_memoryCache.contains(filePath)) {
+    if (!memoryCached(filePath).isNull()) {
         return true;
     }
 
@@ -122,12 +117,42 @@ QPixmap ThumbnailCache::loadFromDiskCache(const QString& filePath)
     return QPixmap();
 }
 
-void ThumbnailCache::saveToDiskCache(const QString& filePath, const QPixmap& thumbnail)
+void ThumbnailCache::saveToDiskCache(const QString& filePath, const QImage& thumbnail)
 {
     QString cachePath = getCacheFilePath(filePath);
     thumbnail.save(cachePath, "PNG");
 }
 
+QPixmap ThumbnailCache::memoryCached(const QString& filePath) const
+{
+    ImageCacheKey key;
+    key.imagePath = filePath;
+    key.targetSize = QSize(m_thumbnailSize, m_thumbnailSize);
+    key.variant = m_memoryGeneration;
+    return ImageCacheManager::instance().getCachedPixmap(key);
+}
+
+void ThumbnailCache::storeInMemory(const QString& filePath, const QPixmap& thumbnail)
+{
+    ImageCacheKey key;
+    key.imagePath = filePath;
+    key.targetSize = QSize(m_thumbnailSize, m_thumbnailSize);
+    key.variant = m_memoryGeneration;
+    ImageCacheManager::instance().setCachedPixmap(key, thumbnail);
+}
+
+void ThumbnailCache::onThumbnailGenerated(const QString& filePath, const QImage& thumbnail)
+{
+    // Pixmaps are GUI-thread only, so the worker hands over a QImage
+    const QPixmap pixmap = QPixmap::fromImage(thumbnail);
+    {
+        QMutexLocker locker(&m_mutex);
+        storeInMemory(filePath, pixmap);
+        m_pendingRequests.remove(filePath);
+    }
+    emit thumbnailReady(filePath, pixmap);
+}
+
 void ThumbnailCache::requestThumbnailGeneration(const QString& filePath)
 {
     ThumbnailWorker* worker = new ThumbnailWorker(filePath, this);
@@ -136,8 +161,10 @@ void ThumbnailCache::requestThumbnailGeneration(const QString& filePath)
 
 void ThumbnailCache::clearMemoryCache()
 {
+    // Entries of the old generation are unreachable and age out of the
+    // shared cache like any other LRU victim
     QMutexLocker locker(&m_mutex);
-    m_memoryCache.clear();
+    ++m_memoryGeneration;
 }
 
 void ThumbnailCache::clearDiskCache()
@@ -162,11 +189,6 @@ void ThumbnailCache::setThumbnailSize(int size)
     m_thumbnailSize = qBound(64, size, 256);
 }
 
-void ThumbnailCache::setMemoryCacheSize(int sizeInMB)
-{
-    m_memoryCacheSizeMB = qBound(10, sizeInMB, 200);
-    m_memoryCache.setMaxCost(m_memoryCacheSizeMB * 1024);
-}
 
 // ThumbnailWorker implementation
 ThumbnailWorker::ThumbnailWorker(const QString& filePath, ThumbnailCache* cache)
@@ -231,8 +253,8 @@ void ThumbnailWorker::run()
     int size = targetSize;
     QImage scaled = image.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 
-    // Center in square pixmap with background
-    QPixmap thumbnail(size, size);
+    // Center in square image with background
+    QImage thumbnail(size, size, QImage::Format_RGB32);
     thumbnail.fill(QColor(0x2D, 0x2D, 0x2D));
     QPainter painter(&thumbnail);
     int x = (size - scaled.width()) / 2;
@@ -243,17 +265,10 @@ void ThumbnailWorker::run()
     // Save to disk cache
     m_cache->saveToDiskCache(m_filePath, thumbnail);
 
-    // Update memory cache
-    {
-        QMutexLocker locker(&m_cache->m_mutex);
-        int cost = (thumbnail.width() * thumbnail.height() * 4) / 1024;
-        m_cache->m_memoryCache.insert(m_filePath, new QPixmap(thumbnail), qMax(cost, 1));
-        m_cache->m_pendingRequests.remove(m_filePath);
-    }
-
-    // Signal completion on main thread
-    QMetaObject::invokeMethod(m_cache, "thumbnailReady",
-                              Qt::QueuedConnection,
-                              Q_ARG(QString, m_filePath),
-                              Q_ARG(QPixmap, thumbnail));
+    // Memory cache and signal on the main thread
+    ThumbnailCache* cache = m_cache;
+    const QString filePath = m_filePath;
+    QMetaObject::invokeMethod(cache, [cache, filePath, thumbnail]() {
+        cache->onThumbnailGenerated(filePath, thumbnail);
+    }, Qt::QueuedConnection);
 }
@@ -2,8 +2,8 @@
 #define THUMBNAILCACHE_H
 
 #include <QObject>
-#include <QCache>
 #include <QPixmap>
+#include <QImage>
 #include <QHash>
 #include <QMutex>
 #include <QRunnable>
@@ -11,7 +11,8 @@
 class QThreadPool;
 
 // Async thumbnail generation with memory and disk caching
-// Uses QThreadPool for background loading without blocking UI
+// Uses QThreadPool for background loading without blocking UI.
+// The memory tier lives in the shared ImageCache, under its budget.
 class ThumbnailCache : public QObject
 {
     Q_OBJECT
@@ -35,9 +36,6 @@ public:
     void setThumbnailSize(int size);
     int thumbnailSize() const { return m_thumbnailSize; }
 
-    void setMemoryCacheSize(int sizeInMB);
-    int memoryCacheSize() const { return m_memoryCacheSizeMB; }
-
 signals:
     void thumbnailReady(const QString& filePath, const QPixmap& thumbnail);
 
@@ -52,17 +50,20 @@ private:
     QString generateCacheKey(const QString& filePath) const;
 
     QPixmap loadFromDiskCache(const QString& filePath);
-    void saveToDiskCache(const QString& filePath, const QPixmap& thumbnail);
+    void saveToDiskCache(const QString& filePath, const QImage& thumbnail);
 
     void requestThumbnailGeneration(const QString& filePath);
+    void onThumbnailGenerated(const QString& filePath, const QImage& thumbnail);
+
+    QPixmap memoryCached(const QString& filePath) const;
+    void storeInMemory(const QString& filePath, const QPixmap& thumbnail);
 
-    QCache<QString, QPixmap> m_memoryCache;
     QHash<QString, bool> m_pendingRequests;
     QMutex m_mutex;
     QThreadPool* m_threadPool;
 
     int m_thumbnailSize = 128;
-    int m_memoryCacheSizeMB = 50;
+    quint64 m_memoryGeneration = 0;  // Bumped to orphan memory entries on clear
 
     QPixmap m_placeholderPixmap;
 
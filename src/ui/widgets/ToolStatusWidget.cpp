@@ -39,47 +39,31 @@ void ToolStatusWidget::setupUI()
     m_iconLabel = new QLabel(this);
     m_iconLabel->setFixedSize(24, 24);
     m_iconLabel->setAlignment(Qt::AlignCenter);
-    m_iconLabel->setStyleSheet(QString(
-        "QLabel {"
-        "    color: %1;"
-        "    font-size: 16px;"
-        "    font-weight: bold;"
-        "    background: transparent;"
-        "}"
-    ).arg(DarkTheme::AccentPrimary.name()));
+    DarkTheme::setTextStyle(m_iconLabel, DarkTheme::AccentPrimary, 16, QFont::Bold);
     
+    QPalette separatorPalette = palette();
+    separatorPalette.setColor(QPalette::WindowText, DarkTheme::BorderColor);
+
     QFrame* separator1 = new QFrame(this);
     separator1->setFrameShape(QFrame::VLine);
     separator1->setFixedSize(1, 20);
-    separator1->setStyleSheet(QString("QFrame { background-color: %1; }").arg(DarkTheme::BorderColor.name()));
+    separator1->setFrameShadow(QFrame::Plain);
+    separator1->setPalette(separatorPalette);
     
     m_nameLabel = new QLabel(this);
     m_nameLabel->setMinimumWidth(80);
     m_nameLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    m_nameLabel->setStyleSheet(QString(
-        "QLabel {"
-        "    color: %1;"
-        "    font-size: 13px;"
-        "    font-weight: 600;"
-        "    background: transparent;"
-        "}"
-    ).arg(DarkTheme::TextPrimary.name()));
+    DarkTheme::setTextStyle(m_nameLabel, DarkTheme::TextPrimary, 13, QFont::DemiBold);
     
     QFrame* separator2 = new QFrame(this);
     separator2->setFrameShape(QFrame::VLine);
     separator2->setFixedSize(1, 20);
-    separator2->setStyleSheet(QString("QFrame { background-color: %1; }").arg(DarkTheme::BorderColor.name()));
+    separator2->setFrameShadow(QFrame::Plain);
+    separator2->setPalette(separatorPalette);
     
     m_hintLabel = new QLabel(this);
     m_hintLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    m_hintLabel->setStyleSheet(QString(
-        "QLabel {"
-        "    color: %1;"
-        "    font-size: 12px;"
-        "    font-style: italic;"
-        "    background: transparent;"
-        "}"
-    ).arg(DarkTheme::TextSecondary.name()));
+    DarkTheme::setTextStyle(m_hintLabel, DarkTheme::TextSecondary, DarkTheme::FontBase, QFont::Normal, true);
     
     m_layout->addWidget(m_iconLabel);
     m_layout->addWidget(separator1);
@@ -0,0 +1,309 @@
+#include "utils/Base64Decoder.h"
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <array>
+
+namespace {
+
+// Lookup classes for non-alphabet bytes
+constexpr qint8 SKIP = -1;     // JSON whitespace
+constexpr qint8 ESCAPE = -2;   // Backslash of a JSON string escape
+constexpr qint8 PAD = -3;      // '=' (only valid at the very end)
+constexpr qint8 INVALID = -4;
+
+constexpr std::array<qint8, 256> makeDecodeTable()
+{
+    std::array<qint8, 256> table{};
+    for (int i = 0; i < 256; ++i) {
+        table[i] = INVALID;
+    }
+    const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    for (int i = 0; i < 64; ++i) {
+        table[static_cast<uchar>(alphabet[i])] = static_cast<qint8>(i);
+    }
+    table[' '] = SKIP;
+    table['\n'] = SKIP;
+    table['\r'] = SKIP;
+    table['\t'] = SKIP;
+    table['\\'] = ESCAPE;
+    table['='] = PAD;
+    return table;
+}
+
+constexpr std::array<qint8, 256> DECODE_TABLE = makeDecodeTable();
+
+enum ReadStatus { Sextet, End, Error };
+
+// Pulls alphabet values out of [p, end); escapes may peek one byte further
+struct SextetReader {
+    const uchar* base;   // Input start, for error offsets
+    const uchar* p;
+    const uchar* end;
+    qsizetype errorOffset = -1;
+    const char* errorString = nullptr;
+
+    ReadStatus next(int& value)
+    {
+        while (p < end) {
+            const qint8 v = DECODE_TABLE[*p];
+            if (v >= 0) {
+                ++p;
+                value = v;
+                return Sextet;
+            }
+            if (v == SKIP) {
+                ++p;
+                continue;
+            }
+            if (v == ESCAPE && p + 1 < end) {
+                const uchar escaped = p[1];
+                if (escaped == '/') {
+                    p += 2;
+                    value = 63;
+                    return Sextet;
+                }
+                if (escaped == 'n' || escaped == 'r' || escaped == 't') {
+                    p += 2;
+                    continue;
+                }
+            }
+            errorOffset = p - base;
+            errorString = v == PAD ? "padding character before end of data"
+                        : v == ESCAPE ? "invalid escape sequence"
+                        : "invalid base64 character";
+            return Error;
+        }
+        return End;
+    }
+
+    // Fast path: four plain alphabet bytes in a row
+    bool nextQuad(int& v0, int& v1, int& v2, int& v3)
+    {
+        if (end - p < 4) {
+            return false;
+        }
+        v0 = DECODE_TABLE[p[0]];
+        v1 = DECODE_TABLE[p[1]];
+        v2 = DECODE_TABLE[p[2]];
+        v3 = DECODE_TABLE[p[3]];
+        if ((v0 | v1 | v2 | v3) < 0) {
+            return false;
+        }
+        p += 4;
+        return true;
+    }
+};
+
+inline void writeQuad(char* out, int v0, int v1, int v2, int v3)
+{
+    out[0] = static_cast<char>((v0 << 2) | (v1 >> 4));
+    out[1] = static_cast<char>(((v1 & 0x0F) << 4) | (v2 >> 2));
+    out[2] = static_cast<char>(((v2 & 0x03) << 6) | v3);
+}
+
+// Collect up to four sextets through the slow path; returns how many were read
+int readGroup(SextetReader& reader, int values[4])
+{
+    int count = 0;
+    while (count < 4) {
+        const ReadStatus status = reader.next(values[count]);
+        if (status != Sextet) {
+            return status == Error ? -1 : count;
+        }
+        ++count;
+    }
+    return count;
+}
+
+// Trailing group of 2 or 3 sextets (already checked against the padding)
+qsizetype writeTail(char* out, const int values[4], int count)
+{
+    if (count >= 2) {
+        out[0] = static_cast<char>((values[0] << 2) | (values[1] >> 4));
+    }
+    if (count == 3) {
+        out[1] = static_cast<char>(((values[1] & 0x0F) << 4) | (values[2] >> 2));
+    }
+    return count - 1;
+}
+
+bool checkTail(int tailCount, int padding, qsizetype bodyEnd, Base64Decoder::Result& result)
+{
+    if (tailCount == 1 || (padding > 0 && (tailCount + padding) % 4 != 0)) {
+        result.errorOffset = bodyEnd;
+        result.errorString = tailCount == 1 ? QStringLiteral("truncated base64 data")
+                                            : QStringLiteral("incorrect base64 padding");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+Base64Decoder::Result Base64Decoder::decode(QByteArrayView input, int maxThreads)
+{
+    Result result;
+    const uchar* base = reinterpret_cast<const uchar*>(input.data());
+
+    // Trim up to two '=' and any whitespace (or escaped line breaks) around them
+    qsizetype bodyEnd = input.size();
+    int padding = 0;
+    for (;;) {
+        if (bodyEnd > 0 && DECODE_TABLE[base[bodyEnd - 1]] == SKIP) {
+            --bodyEnd;
+        } else if (bodyEnd > 1 && base[bodyEnd - 2] == '\\' &&
+                   (base[bodyEnd - 1] == 'n' || base[bodyEnd - 1] == 'r' || base[bodyEnd - 1] == 't')) {
+            bodyEnd -= 2;
+        } else if (bodyEnd > 0 && padding < 2 && base[bodyEnd - 1] == '=') {
+            --bodyEnd;
+            ++padding;
+        } else {
+            break;
+        }
+    }
+
+    if (maxThreads <= 0) {
+        maxThreads = QThread::idealThreadCount();
+    }
+    const int chunkCount = bodyEnd < PARALLEL_THRESHOLD ? 1
+        : int(qBound<qsizetype>(1, bodyEnd / MIN_CHUNK_SIZE, qMax(1, maxThreads)));
+
+    // Single pass: decode into an upper-bound buffer, then trim
+    if (chunkCount == 1) {
+        result.data = QByteArray(bodyEnd / 4 * 3 + 3, Qt::Uninitialized);
+        char* out = result.data.data();
+        SextetReader reader{base, base, base + bodyEnd};
+        int v[4];
+        int tailCount = 0;
+        for (;;) {
+            if (reader.nextQuad(v[0], v[1], v[2], v[3])) {
+                writeQuad(out, v[0], v[1], v[2], v[3]);
+                out += 3;
+                continue;
+            }
+            const int count = readGroup(reader, v);
+            if (count < 0) {
+                result.data.clear();
+                result.errorOffset = reader.errorOffset;
+                result.errorString = QString::fromLatin1(reader.errorString);
+                return result;
+            }
+            if (count < 4) {
+                tailCount = count;
+                break;
+            }
+            writeQuad(out, v[0], v[1], v[2], v[3]);
+            out += 3;
+        }
+        if (!checkTail(tailCount, padding, bodyEnd, result)) {
+            result.data.clear();
+            return result;
+        }
+        if (tailCount > 0) {
+            out += writeTail(out, v, tailCount);
+        }
+        result.data.truncate(out - result.data.constData());
+        return result;
+    }
+
+    // Chunk boundaries, never between a backslash and the byte it escapes
+    QVector<qsizetype> bounds(chunkCount + 1);
+    bounds[0] = 0;
+    bounds[chunkCount] = bodyEnd;
+    for (int i = 1; i < chunkCount; ++i) {
+        qsizetype boundary = qMax(bounds[i - 1], bodyEnd * i / chunkCount);
+        if (boundary > 0 && boundary < bodyEnd && base[boundary - 1] == '\\') {
+            ++boundary;
+        }
+        bounds[i] = boundary;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(chunkCount);
+
+    // Pass 1: validate and count sextets per chunk
+    QVector<qsizetype> counts(chunkCount, 0);
+    QVector<qsizetype> errorOffsets(chunkCount, -1);
+    QVector<const char*> errorStrings(chunkCount, nullptr);
+    for (int i = 0; i < chunkCount; ++i) {
+        pool.start([&, i]() {
+            // Boundaries never split an escape, so the chunk end bounds the reader
+            SextetReader reader{base, base + bounds[i], base + bounds[i + 1]};
+            qsizetype count = 0;
+            int value = 0;
+            for (;;) {
+                const ReadStatus status = reader.next(value);
+                if (status == Error) {
+                    errorOffsets[i] = reader.errorOffset;
+                    errorStrings[i] = reader.errorString;
+                    return;
+                }
+                if (status == End) {
+                    break;
+                }
+                ++count;
+            }
+            counts[i] = count;
+        });
+    }
+    pool.waitForDone();
+
+    // Chunks are in input order, so the first error found is the earliest
+    qsizetype total = 0;
+    QVector<qsizetype> starts(chunkCount + 1);
+    for (int i = 0; i < chunkCount; ++i) {
+        if (errorOffsets[i] >= 0) {
+            result.errorOffset = errorOffsets[i];
+            result.errorString = QString::fromLatin1(errorStrings[i]);
+            return result;
+        }
+        starts[i] = total;
+        total += counts[i];
+    }
+    starts[chunkCount] = total;
+
+    const int tailCount = int(total % 4);
+    if (!checkTail(tailCount, padding, bodyEnd, result)) {
+        return result;
+    }
+
+    const qsizetype fullGroups = total / 4;
+    result.data = QByteArray(fullGroups * 3 + (tailCount > 0 ? tailCount - 1 : 0), Qt::Uninitialized);
+    char* output = result.data.data();
+
+    // Pass 2: every chunk decodes the groups that start inside it, reading
+    // on into the next chunk (hence the body end) to finish its last group
+    for (int i = 0; i < chunkCount; ++i) {
+        pool.start([&, i]() {
+            SextetReader reader{base, base + bounds[i], base + bodyEnd};
+            int v[4];
+
+            // Leading sextets finish the previous chunk's last group
+            qsizetype index = starts[i];
+            while (index % 4 != 0 && index < starts[i + 1]) {
+                reader.next(v[0]);
+                ++index;
+            }
+
+            char* out = output + index / 4 * 3;
+            while (index < starts[i + 1]) {
+                if (index + 4 <= total) {
+                    if (!reader.nextQuad(v[0], v[1], v[2], v[3]) && readGroup(reader, v) != 4) {
+                        return;  // Unreachable: pass 1 validated the input
+                    }
+                    writeQuad(out, v[0], v[1], v[2], v[3]);
+                    out += 3;
+                    index += 4;
+                } else {
+                    const int count = readGroup(reader, v);
+                    writeTail(out, v, count);
+                    index += count;
+                }
+            }
+        });
+    }
+    pool.waitForDone();
+
+    return result;
+}
@@ -0,0 +1,39 @@
+#ifndef BASE64DECODER_H
+#define BASE64DECODER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+
+// Table-driven base64 decoder for embedded VTT images.
+// Validates, skips whitespace and JSON string escapes ("\/", "\n", "\r",
+// "\t") and decodes in a single lookup per input byte, so the input can be
+// the raw JSON string content straight from the mapped file.
+//
+// Large inputs are split into chunks decoded on a local thread pool: a
+// parallel counting pass gives every chunk its output offset, then each
+// chunk decodes straight into the shared output buffer. Errors report the
+// byte offset of the first offending character.
+class Base64Decoder
+{
+public:
+    struct Result {
+        QByteArray data;
+        qsizetype errorOffset = -1;  // Offset into the input, -1 = no error
+        QString errorString;
+
+        bool isValid() const { return errorOffset < 0; }
+    };
+
+    // Thread-safe. maxThreads <= 0 uses QThread::idealThreadCount().
+    static Result decode(QByteArrayView input, int maxThreads = 0);
+
+    // Inputs below this size are decoded on the calling thread
+    static constexpr qsizetype PARALLEL_THRESHOLD = 4 * 1024 * 1024;
+    static constexpr qsizetype MIN_CHUNK_SIZE = 1024 * 1024;
+
+private:
+    Base64Decoder() = default;
+};
+
+#endif // BASE64DECODER_H
@@ -2,6 +2,7 @@
 #include "ui/DebugConsoleWidget.h"
 #include <QMutexLocker>
 #include <QCoreApplication>
+#include <QThread>
 #include <QOpenGLContext>
 #include <QOpenGLFunctions>
 #include <QSysInfo>
@@ -114,11 +115,17 @@ void DebugConsole::updateMemoryUsage(qint64 bytes)
     emit console->metricsUpdated(console->m_metrics);
 }
 
+QList<DebugMessage> DebugConsole::getMessages() const
+{
+    QMutexLocker locker(&m_messagesMutex);
+    return m_messages;
+}
+
 void DebugConsole::setWidget(DebugConsoleWidget* widget)
 {
     m_widget = widget;
     if (m_widget) {
-        for (const DebugMessage& message : m_messages) {
+        for (const DebugMessage& message : getMessages()) {
             m_widget->addMessage(message);
         }
     }
@@ -126,8 +133,10 @@ void DebugConsole::setWidget(DebugConsoleWidget* widget)
 
 void DebugConsole::clearMessages()
 {
-    QMutexLocker locker(&m_messagesMutex);
-    m_messages.clear();
+    {
+        QMutexLocker locker(&m_messagesMutex);
+        m_messages.clear();
+    }
     if (m_widget) {
         m_widget->clearMessages();
     }
@@ -135,31 +144,44 @@ void DebugConsole::clearMessages()
 
 void DebugConsole::log(LogLevel level, const QString& message, const QString& category)
 {
-    // Lazy initialize system info on first use
-    if (!m_systemInfoCollected) {
-        m_systemInfoCollected = true;
-        collectSystemInfo();
-    }
-
     DebugMessage debugMessage;
     debugMessage.timestamp = QDateTime::currentDateTime().toString("hh:mm:ss.zzz");
     debugMessage.level = levelToString(level);
     debugMessage.message = message;
     debugMessage.category = category;
-    
-    QMutexLocker locker(&m_messagesMutex);
-    
-    if (m_messages.size() >= MAX_MESSAGES) {
-        m_messages.removeFirst();
+
+    {
+        QMutexLocker locker(&m_messagesMutex);
+        if (m_messages.size() >= MAX_MESSAGES) {
+            m_messages.removeFirst();
+        }
+        m_messages.append(debugMessage);
     }
-    
-    m_messages.append(debugMessage);
-    
+
+    // Loader, prefetch and hibernation workers log too; the widget and the
+    // system info belong to the GUI thread
+    QCoreApplication* app = QCoreApplication::instance();
+    if (!app || QThread::currentThread() == app->thread()) {
+        deliver(debugMessage);
+    } else {
+        QMetaObject::invokeMethod(app, [this, debugMessage]() { deliver(debugMessage); },
+                                  Qt::QueuedConnection);
+    }
+}
+
+void DebugConsole::deliver(const DebugMessage& message)
+{
+    // Lazy initialize system info on first use
+    if (!m_systemInfoCollected) {
+        m_systemInfoCollected = true;
+        collectSystemInfo();
+    }
+
     if (m_widget) {
-        m_widget->addMessage(debugMessage);
+        m_widget->addMessage(message);
     }
-    
-    emit messageAdded(debugMessage);
+
+    emit messageAdded(message);
 }
 
 QString DebugConsole::levelToString(LogLevel level) const
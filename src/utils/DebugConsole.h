@@ -70,7 +70,8 @@ public:
 
     void setWidget(DebugConsoleWidget* widget);
     
-    const QList<DebugMessage>& getMessages() const { return m_messages; }
+    // Snapshot; messages are appended from worker threads too
+    QList<DebugMessage> getMessages() const;
     const PerformanceMetrics& getMetrics() const { return m_metrics; }
     const SystemInfo& getSystemInfo() const { return m_systemInfo; }
 
@@ -92,6 +93,7 @@ private:
     DebugConsole& operator=(const DebugConsole&) = delete;
 
     void log(LogLevel level, const QString& message, const QString& category);
+    void deliver(const DebugMessage& message);
     QString levelToString(LogLevel level) const;
     void collectSystemInfo();
     void collectOpenGLInfo();
@@ -103,11 +105,11 @@ private:
     SystemInfo m_systemInfo;
     DebugConsoleWidget* m_widget;
     
-    QMutex m_messagesMutex;
+    mutable QMutex m_messagesMutex;  // Guards m_messages only
     QTimer* m_metricsTimer;
     QElapsedTimer m_fpsTimer;
     int m_frameCount;
-    bool m_systemInfoCollected = false;
+    bool m_systemInfoCollected = false;  // GUI thread only
 
     static const int MAX_MESSAGES = 1000;
     static const int METRICS_UPDATE_INTERVAL = 1000;
@@ -0,0 +1,329 @@
+#include "utils/DecodedMapCache.h"
+#include "utils/DebugConsole.h"
+#include "utils/MapBuffer.h"
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+constexpr char ENTRY_MAGIC[4] = { 'D', 'M', 'C', '1' };
+constexpr quint32 ENTRY_VERSION = 1;
+constexpr qint64 PIXEL_ALIGNMENT = 4096;  // Page-aligned so rows map lazily
+
+// Machine-local cache, so the header is written in native byte order
+struct EntryHeader {
+    char magic[4];
+    quint32 version;
+    qint64 sourceSize;
+    qint64 sourceModifiedMs;
+    qint32 width;
+    qint32 height;
+    qint32 format;
+    qint32 reserved;
+    qint64 bytesPerLine;
+    qint64 metadataSize;
+    qint64 pixelOffset;
+};
+
+QByteArray serializeMetadata(const VTTLoader::VTTData& data)
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << data.isValid << qint32(data.gridSquaresX) << qint32(data.gridSquaresY)
+           << qint32(data.pixelsPerGrid) << data.ambientLight << data.globalLight << data.darkness;
+
+    stream << qint32(data.lights.size());
+    for (const VTTLoader::LightSource& light : data.lights) {
+        stream << light.position << light.dimRadius << light.brightRadius << light.tintColor
+               << light.tintAlpha << light.intensity;
+    }
+
+    stream << qint32(data.walls.size());
+    for (const VTTLoader::WallSegment& wall : data.walls) {
+        stream << wall.line;
+    }
+
+    stream << qint32(data.portals.size());
+    for (const VTTLoader::PortalData& portal : data.portals) {
+        stream << portal.position << portal.bound1 << portal.bound2 << portal.rotation
+               << portal.closed << portal.freestanding;
+    }
+    return bytes;
+}
+
+bool deserializeMetadata(const QByteArray& bytes, VTTLoader::VTTData& data)
+{
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    qint32 gridX = 0, gridY = 0, pixelsPerGrid = 0, count = 0;
+    stream >> data.isValid >> gridX >> gridY >> pixelsPerGrid >> data.ambientLight
+           >> data.globalLight >> data.darkness;
+    data.gridSquaresX = gridX;
+    data.gridSquaresY = gridY;
+    data.pixelsPerGrid = pixelsPerGrid;
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        VTTLoader::LightSource light;
+        stream >> light.position >> light.dimRadius >> light.brightRadius >> light.tintColor
+               >> light.tintAlpha >> light.intensity;
+        data.lights.append(light);
+    }
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        VTTLoader::WallSegment wall;
+        stream >> wall.line;
+        data.walls.append(wall);
+    }
+
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        VTTLoader::PortalData portal;
+        stream >> portal.position >> portal.bound1 >> portal.bound2 >> portal.rotation
+               >> portal.closed >> portal.freestanding;
+        data.portals.append(portal);
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+void releaseMappedEntry(void* info)
+{
+    // Closing the file drops the mapping
+    delete static_cast<QFile*>(info);
+}
+
+} // namespace
+
+DecodedMapCache& DecodedMapCache::instance()
+{
+    static DecodedMapCache instance;
+    return instance;
+}
+
+DecodedMapCache::DecodedMapCache()
+{
+    QDir().mkpath(getCacheDirectory());
+}
+
+QString DecodedMapCache::getCacheDirectory() const
+{
+    {
+        QMutexLocker locker(&m_directoryMutex);
+        if (!m_directory.isEmpty()) {
+            return m_directory;
+        }
+    }
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return cacheDir + "/decoded-maps";
+}
+
+void DecodedMapCache::setCacheDirectory(const QString& directory)
+{
+    {
+        QMutexLocker locker(&m_directoryMutex);
+        m_directory = directory;
+    }
+    QDir().mkpath(getCacheDirectory());
+}
+
+QString DecodedMapCache::getCacheFilePath(const QFileInfo& sourceInfo) const
+{
+    QString key = sourceInfo.absoluteFilePath() + QString::number(sourceInfo.size()) +
+                  QString::number(sourceInfo.lastModified().toMSecsSinceEpoch());
+    QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5);
+    return getCacheDirectory() + "/" + hash.toHex() + ".dmc";
+}
+
+bool DecodedMapCache::lookup(const QFileInfo& sourceInfo, QImage& image, VTTLoader::VTTData& vttData)
+{
+    auto file = std::make_unique<QFile>(getCacheFilePath(sourceInfo));
+    if (!file->open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    EntryHeader header;
+    if (file->read(reinterpret_cast<char*>(&header), sizeof(header)) != qint64(sizeof(header)) ||
+        memcmp(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) != 0 ||
+        header.version != ENTRY_VERSION) {
+        return false;
+    }
+
+    // The key already covers size and mtime; the header guards against hash collisions
+    const QImage::Format format = static_cast<QImage::Format>(header.format);
+    const qint64 pixelBytes = header.bytesPerLine * header.height;
+    if (header.sourceSize != sourceInfo.size() ||
+        header.sourceModifiedMs != sourceInfo.lastModified().toMSecsSinceEpoch() ||
+        header.width <= 0 || header.height <= 0 ||
+        format <= QImage::Format_Invalid || format >= QImage::NImageFormats ||
+        header.metadataSize < 0 || header.pixelOffset < qint64(sizeof(header)) + header.metadataSize ||
+        file->size() < header.pixelOffset + pixelBytes) {
+        DebugConsole::warning(QString("DecodedMapCache: discarding invalid entry %1").arg(file->fileName()), "Loading");
+        return false;
+    }
+
+    VTTLoader::VTTData metadata;
+    if (!deserializeMetadata(file->read(header.metadataSize), metadata)) {
+        return false;
+    }
+
+    const uchar* pixels = file->map(header.pixelOffset, pixelBytes);
+    if (!pixels) {
+        return false;
+    }
+
+    // LRU stamp for evictToBudget()
+    file->setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    // Read-only image over the mapping; it owns the file from here on
+    image = MapBuffer::mapped(pixels, header.width, header.height, header.bytesPerLine, format,
+                              releaseMappedEntry, file.release());
+    vttData = metadata;
+    if (vttData.isValid) {
+        vttData.mapImage = image;
+    }
+    return true;
+}
+
+bool DecodedMapCache::contains(const QFileInfo& sourceInfo) const
+{
+    QFile file(getCacheFilePath(sourceInfo));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    EntryHeader header;
+    return file.read(reinterpret_cast<char*>(&header), sizeof(header)) == qint64(sizeof(header)) &&
+           memcmp(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) == 0 &&
+           header.version == ENTRY_VERSION &&
+           header.sourceSize == sourceInfo.size() &&
+           header.sourceModifiedMs == sourceInfo.lastModified().toMSecsSinceEpoch() &&
+           file.size() >= header.pixelOffset + header.bytesPerLine * header.height;
+}
+
+bool DecodedMapCache::fits(qint64 imageBytes) const
+{
+    const qint64 budget = qint64(m_maxSizeMB.load()) * 1024 * 1024;
+    return imageBytes <= qint64(budget * MAX_ENTRY_FRACTION);
+}
+
+bool DecodedMapCache::store(const QFileInfo& sourceInfo, const QImage& image,
+                            const VTTLoader::VTTData& vttData)
+{
+    if (image.isNull() || m_maxSizeMB.load() <= 0) {
+        return false;
+    }
+    if (!fits(image.sizeInBytes())) {
+        DebugConsole::info(QString("DecodedMapCache: %1 (%2 MB) is too large for the %3 MB budget")
+            .arg(sourceInfo.fileName())
+            .arg(image.sizeInBytes() / (1024 * 1024))
+            .arg(m_maxSizeMB.load()), "Loading");
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    QElapsedTimer timer;
+    timer.start();
+
+    QDir().mkpath(getCacheDirectory());
+    QSaveFile file(getCacheFilePath(sourceInfo));
+    if (!file.open(QIODevice::WriteOnly)) {
+        DebugConsole::warning(QString("DecodedMapCache: cannot write %1").arg(file.fileName()), "Loading");
+        return false;
+    }
+
+    const QByteArray metadata = serializeMetadata(vttData);
+
+    EntryHeader header;
+    memcpy(header.magic, ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+    header.version = ENTRY_VERSION;
+    header.sourceSize = sourceInfo.size();
+    header.sourceModifiedMs = sourceInfo.lastModified().toMSecsSinceEpoch();
+    header.width = image.width();
+    header.height = image.height();
+    header.format = image.format();
+    header.reserved = 0;
+    header.bytesPerLine = image.bytesPerLine();
+    header.metadataSize = metadata.size();
+    const qint64 headerEnd = qint64(sizeof(header)) + metadata.size();
+    header.pixelOffset = (headerEnd + PIXEL_ALIGNMENT - 1) / PIXEL_ALIGNMENT * PIXEL_ALIGNMENT;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(metadata);
+    file.write(QByteArray(header.pixelOffset - headerEnd, '\0'));
+    file.write(reinterpret_cast<const char*>(image.constBits()), image.sizeInBytes());
+
+    if (!file.commit()) {
+        DebugConsole::warning(QString("DecodedMapCache: failed to store %1").arg(sourceInfo.fileName()), "Loading");
+        return false;
+    }
+
+    DebugConsole::performance(QString("DecodedMapCache: stored %1 (%2 MB) in %3 ms")
+        .arg(sourceInfo.fileName())
+        .arg(image.sizeInBytes() / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(timer.elapsed()), "Loading");
+
+    evictToBudget(file.fileName());
+    return true;
+}
+
+void DecodedMapCache::evictToBudget(const QString& keepFilePath)
+{
+    QDir cacheDir(getCacheDirectory());
+    // Oldest first: lookups refresh the modification time of entries they hit
+    const QFileInfoList entries = cacheDir.entryInfoList(QStringList() << "*.dmc", QDir::Files,
+                                                         QDir::Time | QDir::Reversed);
+    qint64 totalBytes = 0;
+    for (const QFileInfo& entry : entries) {
+        totalBytes += entry.size();
+    }
+
+    const qint64 budget = qint64(m_maxSizeMB.load()) * 1024 * 1024;
+    const QString keep = keepFilePath.isEmpty() ? QString() : QFileInfo(keepFilePath).absoluteFilePath();
+    for (const QFileInfo& entry : entries) {
+        if (totalBytes <= budget) {
+            break;
+        }
+        // The entry just written may share its timestamp with older ones
+        if (!keep.isEmpty() && entry.absoluteFilePath() == keep) {
+            continue;
+        }
+        // Entries still mapped by an open map may refuse removal on Windows
+        if (QFile::remove(entry.absoluteFilePath())) {
+            totalBytes -= entry.size();
+            DebugConsole::info(QString("DecodedMapCache: evicted %1").arg(entry.fileName()), "Loading");
+        }
+    }
+}
+
+void DecodedMapCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    QDir cacheDir(getCacheDirectory());
+    if (cacheDir.exists()) {
+        for (const QString& file : cacheDir.entryList(QStringList() << "*.dmc", QDir::Files)) {
+            cacheDir.remove(file);
+        }
+    }
+}
+
+void DecodedMapCache::setMaxSizeMB(int sizeInMB)
+{
+    m_maxSizeMB.store(qMax(0, sizeInMB));
+
+    QMutexLocker locker(&m_mutex);
+    evictToBudget();
+}
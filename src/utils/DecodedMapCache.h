@@ -0,0 +1,72 @@
+#ifndef DECODEDMAPCACHE_H
+#define DECODEDMAPCACHE_H
+
+#include <QString>
+#include <QImage>
+#include <QMutex>
+#include <atomic>
+#include "utils/VTTLoader.h"
+
+class QFileInfo;
+
+// Disk cache of fully decoded maps under the app cache directory.
+// Entries are keyed by source path, size and modification time, and hold
+// the parsed VTTData plus the display-ready pixels as raw rows starting at
+// a page-aligned offset. A hit memory-maps the entry and wraps the mapping
+// in a read-only QImage, so a reopened map skips JSON parsing, base64 and
+// image decoding entirely and its pages are faulted in as tiles are drawn.
+// Least recently used entries are evicted once the cache exceeds its budget;
+// a map larger than MAX_ENTRY_FRACTION of the budget is never stored, since
+// it would flush every other entry to make room for itself.
+//
+// Thread-safe: lookups run on the MapLoadPipeline worker, stores in the
+// global thread pool.
+class DecodedMapCache
+{
+public:
+    static DecodedMapCache& instance();
+
+    // Fill image/vttData from the cache; false on miss or stale entry
+    bool lookup(const QFileInfo& sourceInfo, QImage& image, VTTLoader::VTTData& vttData);
+
+    // Write an entry for a decoded map, then evict older entries down to
+    // the budget. False if the map does not fit or the write failed.
+    bool store(const QFileInfo& sourceInfo, const QImage& image, const VTTLoader::VTTData& vttData);
+
+    // Whether a map of this many pixel bytes may be stored under the budget
+    bool fits(qint64 imageBytes) const;
+
+    // Header-only check for a current entry (no mapping, no LRU stamp)
+    bool contains(const QFileInfo& sourceInfo) const;
+
+    void clear();
+
+    // Keep entries somewhere else (benchmarks); empty restores the default
+    void setCacheDirectory(const QString& directory);
+
+    void setMaxSizeMB(int sizeInMB);
+    int maxSizeMB() const { return m_maxSizeMB.load(); }
+
+    static constexpr int DEFAULT_MAX_SIZE_MB = 2048;
+    static constexpr double MAX_ENTRY_FRACTION = 0.5;
+
+    // Maps that decode faster than this are not worth the disk space
+    static constexpr int MIN_DECODE_MS = 150;
+
+private:
+    DecodedMapCache();
+    ~DecodedMapCache() = default;
+    DecodedMapCache(const DecodedMapCache&) = delete;
+    DecodedMapCache& operator=(const DecodedMapCache&) = delete;
+
+    QString getCacheDirectory() const;
+    QString getCacheFilePath(const QFileInfo& sourceInfo) const;
+    void evictToBudget(const QString& keepFilePath = QString());
+
+    QMutex m_mutex;  // Serializes stores and eviction
+    mutable QMutex m_directoryMutex;
+    QString m_directory;  // Empty = under the app cache directory
+    std::atomic<int> m_maxSizeMB{DEFAULT_MAX_SIZE_MB};
+};
+
+#endif // DECODEDMAPCACHE_H
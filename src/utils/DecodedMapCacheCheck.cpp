@@ -0,0 +1,97 @@
+#include "utils/DecodedMapCacheCheck.h"
+#include "utils/DecodedMapCache.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+namespace {
+
+// Cache keys are taken from a source file, so every entry needs one
+QFileInfo makeSource(const QTemporaryDir& folder, const QString& name)
+{
+    const QString path = folder.filePath(name);
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(name.toUtf8());
+    }
+    return QFileInfo(path);
+}
+
+QImage makeImage(int side)
+{
+    QImage image(side, side, QImage::Format_RGB32);
+    image.fill(Qt::darkGreen);
+    return image;
+}
+
+} // namespace
+
+DecodedMapCacheCheck::Report DecodedMapCacheCheck::run()
+{
+    Report report;
+    QTemporaryDir folder;
+    if (!folder.isValid()) {
+        report.errorMessage = QStringLiteral("Cannot create a temporary folder");
+        return report;
+    }
+
+    DecodedMapCache& cache = DecodedMapCache::instance();
+    const int previousBudget = cache.maxSizeMB();
+    // Directory first, so the small budget never touches the real cache
+    cache.setCacheDirectory(folder.filePath(QStringLiteral("decoded-maps")));
+    cache.setMaxSizeMB(BUDGET_MB);
+
+    auto check = [&report](bool condition, const QString& name) {
+        (condition ? report.passed : report.failed) << name;
+    };
+
+    const QFileInfo first = makeSource(folder, QStringLiteral("first.png"));
+    const QFileInfo second = makeSource(folder, QStringLiteral("second.png"));
+    const QFileInfo large = makeSource(folder, QStringLiteral("large.png"));
+    const QFileInfo third = makeSource(folder, QStringLiteral("third.png"));
+    const QFileInfo fourth = makeSource(folder, QStringLiteral("fourth.png"));
+    const VTTLoader::VTTData noVtt;
+
+    check(cache.store(first, makeImage(SMALL_ENTRY_SIDE), noVtt) &&
+          cache.store(second, makeImage(SMALL_ENTRY_SIDE), noVtt),
+          QStringLiteral("small entries are stored"));
+
+    check(!cache.store(large, makeImage(LARGE_ENTRY_SIDE), noVtt),
+          QStringLiteral("an entry over the budget is refused"));
+    check(!cache.contains(large), QStringLiteral("the refused entry is not on disk"));
+    check(cache.contains(first) && cache.contains(second),
+          QStringLiteral("older entries survive the refused store"));
+
+    // Four 256 KB entries exceed 1 MB once headers are counted
+    check(cache.store(third, makeImage(SMALL_ENTRY_SIDE), noVtt) &&
+          cache.store(fourth, makeImage(SMALL_ENTRY_SIDE), noVtt),
+          QStringLiteral("stores over budget succeed"));
+    check(cache.contains(fourth), QStringLiteral("eviction keeps the entry just written"));
+    check(!cache.contains(first) || !cache.contains(second) || !cache.contains(third),
+          QStringLiteral("eviction removes an older entry"));
+
+    cache.setCacheDirectory(QString());
+    cache.setMaxSizeMB(previousBudget);
+    return report;
+}
+
+QString DecodedMapCacheCheck::Report::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+
+    out << "Decoded map cache self-test\n";
+    if (!errorMessage.isEmpty()) {
+        out << "  error: " << errorMessage << "\n";
+        return text;
+    }
+    for (const QString& name : passed) {
+        out << "  pass: " << name << "\n";
+    }
+    for (const QString& name : failed) {
+        out << "  FAIL: " << name << "\n";
+    }
+    return text;
+}
@@ -0,0 +1,34 @@
+#ifndef DECODEDMAPCACHECHECK_H
+#define DECODEDMAPCACHECHECK_H
+
+#include <QString>
+#include <QStringList>
+
+// Self-test of the DecodedMapCache budget rules, run against a scratch
+// cache directory: a map over the per-entry limit is refused without
+// evicting anything, and a store that pushes the cache over budget evicts
+// older entries but never the one it just wrote. Run with
+// --test-decoded-cache; exits non-zero on failure.
+class DecodedMapCacheCheck
+{
+public:
+    struct Report {
+        QStringList passed;
+        QStringList failed;
+        QString errorMessage;
+
+        bool ok() const { return errorMessage.isEmpty() && failed.isEmpty(); }
+        QString toText() const;
+    };
+
+    static Report run();
+
+    static constexpr int BUDGET_MB = 1;
+    static constexpr int SMALL_ENTRY_SIDE = 256;   // 256 KB at 4 bytes per pixel
+    static constexpr int LARGE_ENTRY_SIDE = 1024;  // 4 MB, over the whole budget
+
+private:
+    DecodedMapCacheCheck() = default;
+};
+
+#endif // DECODEDMAPCACHECHECK_H
@@ -0,0 +1,164 @@
+#include "utils/EffectsBenchmark.h"
+#include "graphics/FogMistEffect.h"
+#include "graphics/FrameArena.h"
+#include "graphics/PointLightSystem.h"
+#include "graphics/WeatherEffect.h"
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QTextStream>
+#include <functional>
+
+namespace {
+
+constexpr qreal FRAME_SECONDS = 1.0 / 60.0;
+
+// One driver tick per frame, then a repaint of every item, mirroring
+// SceneAnimationDriver::onTimeout followed by the scene update
+EffectsBenchmark::Scenario measure(const QString& name, QPainter& painter,
+                                   const QList<QGraphicsItem*>& items,
+                                   const std::function<void(qreal)>& advance)
+{
+    EffectsBenchmark::Scenario scenario;
+    scenario.name = name;
+
+    FrameArena& arena = FrameArena::instance();
+    const QStyleOptionGraphicsItem option;
+    QElapsedTimer timer;
+    qint64 totalNs = 0;
+    qint64 totalAllocations = 0;
+
+    for (int frame = 0; frame < EffectsBenchmark::WARMUP_FRAMES + EffectsBenchmark::MEASURED_FRAMES; ++frame) {
+        const qint64 allocationsBefore = FrameArena::threadAllocationCount();
+        timer.start();
+
+        arena.reset();
+        advance(FRAME_SECONDS);
+        for (QGraphicsItem* item : items) {
+            item->paint(&painter, &option, nullptr);
+        }
+
+        const qint64 ns = timer.nsecsElapsed();
+        const qint64 allocations = FrameArena::threadAllocationCount() - allocationsBefore;
+        if (frame < EffectsBenchmark::WARMUP_FRAMES) {
+            continue;
+        }
+        totalNs += ns;
+        if (allocationsBefore >= 0) {
+            totalAllocations += allocations;
+            scenario.maxAllocationsPerFrame = qMax(scenario.maxAllocationsPerFrame, allocations);
+        }
+    }
+
+    scenario.msPerFrame = totalNs / 1e6 / EffectsBenchmark::MEASURED_FRAMES;
+    if (FrameArena::threadAllocationCount() >= 0) {
+        scenario.allocationsPerFrame = double(totalAllocations) / EffectsBenchmark::MEASURED_FRAMES;
+    }
+    // The last frame's arena use, recorded by one more reset
+    arena.reset();
+    scenario.arenaBytesPerFrame = arena.stats().lastFrameBytes;
+    return scenario;
+}
+
+} // namespace
+
+EffectsBenchmark::Report EffectsBenchmark::run()
+{
+    Report report;
+    report.viewport = QSize(VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    report.frames = MEASURED_FRAMES;
+    report.countingAllocations = FrameArena::threadAllocationCount() >= 0;
+
+    QImage viewport(report.viewport, QImage::Format_ARGB32_Premultiplied);
+    if (viewport.isNull()) {
+        report.errorMessage = QStringLiteral("Cannot allocate the viewport image");
+        return report;
+    }
+    viewport.fill(Qt::darkGray);
+    QPainter painter(&viewport);
+    const QRectF bounds(QPointF(0, 0), QSizeF(report.viewport));
+
+    WeatherEffect rain;
+    rain.setSceneBounds(bounds);
+    rain.setWeatherType(WeatherType::Storm);
+    rain.setIntensity(1.0);
+    rain.setEnabled(true);
+    report.scenarios << measure(QStringLiteral("rain"), painter, { &rain },
+                                [&rain](qreal dt) { rain.advanceAnimation(dt); });
+    rain.setEnabled(false);
+
+    WeatherEffect snow;
+    snow.setSceneBounds(bounds);
+    snow.setWeatherType(WeatherType::Snow);
+    snow.setIntensity(1.0);
+    snow.setEnabled(true);
+    report.scenarios << measure(QStringLiteral("snow"), painter, { &snow },
+                                [&snow](qreal dt) { snow.advanceAnimation(dt); });
+
+    FogMistEffect mist;
+    mist.setSceneBounds(bounds);
+    mist.setDensity(0.7);
+    mist.setEnabled(true);
+    report.scenarios << measure(QStringLiteral("mist"), painter, { &mist },
+                                [&mist](qreal dt) { mist.advanceAnimation(dt); });
+
+    PointLightSystem lights;
+    lights.setSceneBounds(bounds);
+    lights.setAmbientDarkness(0.6);
+    lights.setEnabled(true);
+    for (int i = 0; i < LIGHT_COUNT; ++i) {
+        lights.addLightAtPosition(QPointF(bounds.width() * ((i % 6) + 0.5) / 6.0,
+                                          bounds.height() * ((i / 6) + 0.5) / 4.0),
+                                  i % 2 == 0 ? LightPreset::Torch : LightPreset::Lantern);
+    }
+    report.scenarios << measure(QStringLiteral("lights"), painter, { &lights },
+                                [&lights](qreal dt) { lights.advanceAnimation(dt); });
+
+    report.scenarios << measure(QStringLiteral("snow+mist+lights"), painter, { &lights, &mist, &snow },
+                                [&](qreal dt) {
+                                    lights.advanceAnimation(dt);
+                                    mist.advanceAnimation(dt);
+                                    snow.advanceAnimation(dt);
+                                });
+    painter.end();
+
+    const FrameArena::Stats stats = FrameArena::instance().stats();
+    report.arenaCapacity = stats.capacity;
+    report.arenaGrowths = stats.blockAllocations;
+    return report;
+}
+
+QString EffectsBenchmark::Report::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+
+    out << QString("Effects benchmark: %1x%2 viewport, %3 frames after %4 warm-up\n")
+               .arg(viewport.width()).arg(viewport.height()).arg(frames).arg(WARMUP_FRAMES);
+    if (!errorMessage.isEmpty()) {
+        out << "  error: " << errorMessage << "\n";
+        return text;
+    }
+
+    out << QString("  %1 %2 %3 %4 %5\n")
+               .arg(QStringLiteral("scenario"), -18).arg(QStringLiteral("ms/frame"), 9)
+               .arg(QStringLiteral("allocs/frame"), 13).arg(QStringLiteral("max allocs"), 11)
+               .arg(QStringLiteral("arena KB"), 9);
+    for (const Scenario& scenario : scenarios) {
+        out << QString("  %1 %2 %3 %4 %5\n")
+                   .arg(scenario.name, -18)
+                   .arg(scenario.msPerFrame, 9, 'f', 3)
+                   .arg(scenario.allocationsPerFrame < 0 ? QStringLiteral("n/a")
+                            : QString::number(scenario.allocationsPerFrame, 'f', 1), 13)
+                   .arg(scenario.maxAllocationsPerFrame < 0 ? QStringLiteral("n/a")
+                            : QString::number(scenario.maxAllocationsPerFrame), 11)
+                   .arg(scenario.arenaBytesPerFrame / 1024.0, 9, 'f', 1);
+    }
+    out << QString("  frame arena: %1 KB held, grew %2 times\n")
+               .arg(arenaCapacity / 1024).arg(arenaGrowths);
+    if (!countingAllocations) {
+        out << "  allocation counts need a build configured with -DCRITVTT_COUNT_ALLOCATIONS=ON\n";
+    }
+    return text;
+}
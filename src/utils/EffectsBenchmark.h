@@ -0,0 +1,49 @@
+#ifndef EFFECTSBENCHMARK_H
+#define EFFECTSBENCHMARK_H
+
+#include <QString>
+#include <QSize>
+#include <QList>
+
+// Runs the atmosphere overlays (rain, snow, mist, point lights) the way
+// SceneAnimationDriver does - reset the FrameArena, advance, paint - into an
+// off-screen raster viewport, and reports the time per frame and how many
+// heap allocations the GUI thread made per frame in steady state. The
+// allocation count needs a build configured with
+// -DCRITVTT_COUNT_ALLOCATIONS=ON. Run with --benchmark-effects.
+class EffectsBenchmark
+{
+public:
+    struct Scenario {
+        QString name;
+        double msPerFrame = 0.0;
+        double allocationsPerFrame = -1.0;  // Mean over the measured frames; -1 without the counter
+        qint64 maxAllocationsPerFrame = -1;
+        qint64 arenaBytesPerFrame = 0;
+    };
+
+    struct Report {
+        QSize viewport;
+        int frames = 0;
+        QList<Scenario> scenarios;
+        qint64 arenaCapacity = 0;
+        quint64 arenaGrowths = 0;
+        bool countingAllocations = false;
+        QString errorMessage;
+
+        QString toText() const;
+    };
+
+    static Report run();
+
+    static constexpr int WARMUP_FRAMES = 60;
+    static constexpr int MEASURED_FRAMES = 600;
+    static constexpr int VIEWPORT_WIDTH = 1920;
+    static constexpr int VIEWPORT_HEIGHT = 1080;
+    static constexpr int LIGHT_COUNT = 24;
+
+private:
+    EffectsBenchmark() = default;
+};
+
+#endif // EFFECTSBENCHMARK_H
@@ -1,5 +1,10 @@
 #include "utils/ImageLoader.h"
 #include "utils/VTTLoader.h"
+#include "utils/MemoryManager.h"
+#include "utils/UVTTWriter.h"
+#include "utils/DebugConsole.h"
+#include "utils/MapBuffer.h"
+#include <QDir>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -7,126 +12,188 @@
 #include <QImageReader>
 #include <QImageWriter>
 #include <QFileInfo>
-#include <QThread>
-#include <QApplication>
-#include <QEventLoop>
+#include <QStandardPaths>
+#include <QTemporaryFile>
+#include <atomic>
+#include <memory>
 
-ImageLoader::ImageLoader(QObject* parent)
-    : QObject(parent)
+#if defined(Q_OS_UNIX)
+#include <unistd.h>
+#endif
+
+namespace {
+std::atomic<int> s_pixelFormatPolicy{int(ImageLoader::PixelFormatPolicy::Auto)};
+
+void releaseScratchFile(void* info)
 {
+    // Closing the file drops the mapping
+    delete static_cast<QTemporaryFile*>(info);
+}
 }
 
-QImage ImageLoader::loadImageWithProgress(const QString& path)
+QImage ImageLoader::readImage(const QString& path, const ProgressCallback& progressCallback,
+                              QString* errorString)
 {
-    // Reentrancy guard — processEvents() below can cause reentrant load calls
-    if (m_isLoading) return QImage();
-    m_isLoading = true;
+    auto reportProgress = [&](int percentage, const QString& message) {
+        if (progressCallback) {
+            progressCallback(percentage, message);
+        }
+    };
 
-    reportProgress(0, "Starting image load...");
+    reportProgress(10, "Opening image file...");
 
-    // Get file size to determine if we need chunked loading
-    QFileInfo fileInfo(path);
-    qint64 fileSize = fileInfo.size();
-    const qint64 LARGE_FILE_THRESHOLD = 10 * 1024 * 1024; // 10MB
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+    reader.setDecideFormatFromContent(true);
+
+    // Protect against extremely large images (e.g. 50000x50000). Anything up to
+    // the cap is kept at full detail - TiledMapItem pages it in per tile.
+    QSize imageSize = reader.size();
+    if (imageSize.isValid() &&
+        (imageSize.width() > MAX_IMAGE_DIMENSION || imageSize.height() > MAX_IMAGE_DIMENSION)) {
+        imageSize = imageSize.scaled(MAX_IMAGE_DIMENSION, MAX_IMAGE_DIMENSION, Qt::KeepAspectRatio);
+        reader.setScaledSize(imageSize);
+    }
 
-    // Check if it's a VTT file first
-    if (VTTLoader::isVTTFile(path)) {
-        reportProgress(25, "Loading VTT file...");
+    // Qt's default 256 MB reader limit would reject region maps well below the cap
+    if (imageSize.isValid()) {
+        const qint64 imageMB = qint64(imageSize.width()) * imageSize.height() * 4 / (1024 * 1024);
+        reader.setAllocationLimit(int(qMax<qint64>(reader.allocationLimit(), imageMB + 1)));
+    }
 
-        // Process events frequently for large files
-        if (fileSize > LARGE_FILE_THRESHOLD) {
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    // Check if the format is supported before attempting to read
+    if (!reader.canRead()) {
+        if (errorString) {
+            *errorString = QStringLiteral("Unsupported image format");
         }
+        return QImage();
+    }
 
-        // Pass progress callback to VTTLoader for unified progress reporting
-        auto progressCallback = [this](int percentage, const QString& message) {
-            reportProgress(percentage, message);
-        };
+    reportProgress(50, "Decoding image data...");
 
-        VTTLoader::VTTData vttData = VTTLoader::loadVTT(path, progressCallback);
+    QImage image = reader.read();
+    if (image.isNull() && errorString) {
+        *errorString = reader.errorString();
+    }
 
-        reportProgress(75, "Processing VTT data...");
-        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    return image;
+}
 
-        if (!vttData.mapImage.isNull()) {
-            reportProgress(100, "VTT file loaded successfully");
-            m_isLoading = false;
-            return vttData.mapImage;
-        } else {
-            reportProgress(100, "Failed to load VTT file");
-            m_isLoading = false;
-            return QImage();
-        }
-    } else {
-        // Load regular image with better progress reporting
-        reportProgress(10, "Opening image file...");
+QImage ImageLoader::readPreview(const QString& path, int maxDimension, QSize* mapSize)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+    reader.setDecideFormatFromContent(true);
 
-        QImageReader reader(path);
-        reader.setAutoTransform(true);
+    QSize imageSize = reader.size();
+    if (!imageSize.isValid() || !reader.supportsOption(QImageIOHandler::ScaledSize)) {
+        return QImage();
+    }
 
-        // Protect against extremely large images (e.g. 50000x50000)
-        QSize imageSize = reader.size();
-        if (imageSize.isValid() && (imageSize.width() > 16384 || imageSize.height() > 16384)) {
-            reader.setScaledSize(imageSize.scaled(16384, 16384, Qt::KeepAspectRatio));
-        }
+    // Same capping as readImage(), so the preview covers the final scene rect
+    QSize fullSize = imageSize;
+    if (fullSize.width() > MAX_IMAGE_DIMENSION || fullSize.height() > MAX_IMAGE_DIMENSION) {
+        fullSize = fullSize.scaled(MAX_IMAGE_DIMENSION, MAX_IMAGE_DIMENSION, Qt::KeepAspectRatio);
+    }
+    if (reader.transformation() & QImageIOHandler::TransformationRotate90) {
+        fullSize.transpose();
+    }
+    if (qMax(fullSize.width(), fullSize.height()) <= maxDimension) {
+        return QImage();  // Small enough that the full decode is the preview
+    }
 
-        // For very large files, enable incremental reading
-        if (fileSize > LARGE_FILE_THRESHOLD) {
-            reader.setDecideFormatFromContent(true);
-        }
+    reader.setScaledSize(imageSize.scaled(maxDimension, maxDimension, Qt::KeepAspectRatio));
+    QImage preview = reader.read();
+    if (!preview.isNull() && mapSize) {
+        *mapSize = fullSize;
+    }
+    return preview;
+}
 
-        reportProgress(25, "Reading image data...");
-        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+void ImageLoader::setPixelFormatPolicy(PixelFormatPolicy policy)
+{
+    s_pixelFormatPolicy.store(int(policy));
+}
 
-        // Check if the format is supported before attempting to read
-        if (!reader.canRead()) {
-            reportProgress(100, "Unsupported image format");
-            m_isLoading = false;
-            return QImage();
-        }
+ImageLoader::PixelFormatPolicy ImageLoader::pixelFormatPolicy()
+{
+    return static_cast<PixelFormatPolicy>(s_pixelFormatPolicy.load());
+}
 
-        reportProgress(50, "Decoding image data...");
+QImage::Format ImageLoader::displayFormat(const QImage& image, PixelFormatPolicy policy)
+{
+    if (image.hasAlphaChannel()) {
+        return QImage::Format_ARGB32_Premultiplied;
+    }
 
-        // For large files, process events more frequently
-        if (fileSize > LARGE_FILE_THRESHOLD) {
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        }
+    switch (policy) {
+    case PixelFormatPolicy::Speed:
+        return QImage::Format_RGB32;
+    case PixelFormatPolicy::Memory:
+        return QImage::Format_RGB888;
+    case PixelFormatPolicy::Auto:
+        break;
+    }
 
-        QImage image = reader.read();
-
-        if (!image.isNull()) {
-            reportProgress(75, "Finalizing image...");
-            QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-
-            // Memory optimization: Only convert format if absolutely necessary
-            // RGB888 uses 25% less memory than ARGB32 for images without alpha
-            if (image.hasAlphaChannel()) {
-                // Only convert to ARGB32 if we actually have alpha
-                if (image.format() != QImage::Format_ARGB32 &&
-                    image.format() != QImage::Format_ARGB32_Premultiplied) {
-                    reportProgress(85, "Optimizing image format with alpha...");
-                    image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
-                    QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-                }
-            } else {
-                // For images without alpha, use RGB888 to save memory
-                if (image.format() != QImage::Format_RGB888 &&
-                    image.format() != QImage::Format_RGB32) {
-                    reportProgress(85, "Optimizing image format...");
-                    image = image.convertToFormat(QImage::Format_RGB888);
-                    QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-                }
-            }
-
-            reportProgress(100, "Image loaded successfully");
-        } else {
-            QString errorString = reader.errorString();
-            reportProgress(100, QString("Failed to load image: %1").arg(errorString));
-        }
+    // TiledMapItem converts per tile on first use, so a 24-bit map costs one
+    // conversion per uploaded tile rather than one per frame
+    const qint64 rgb32Bytes = qint64(image.width()) * image.height() * 4;
+    return rgb32Bytes >= MemoryManager::instance().getMaxMemoryLimit() / 2
+        ? QImage::Format_RGB888 : QImage::Format_RGB32;
+}
 
-        m_isLoading = false;
+QImage ImageLoader::convertForDisplay(const QImage& image)
+{
+    if (image.isNull()) {
         return image;
     }
+
+    // Convert once here (off the GUI thread when called from the load pipeline)
+    // instead of inside QPixmap::fromImage on the GUI thread
+    const QImage::Format format = displayFormat(image, pixelFormatPolicy());
+    if (image.format() != format) {
+        return image.convertToFormat(format);
+    }
+    return image;
+}
+
+QImage ImageLoader::toFileBacked(const QImage& image, bool* fileBacked)
+{
+    if (fileBacked) {
+        *fileBacked = false;
+    }
+    const qint64 bytes = image.sizeInBytes();
+    if (image.isNull() || bytes < FILE_BACKED_MIN_BYTES) {
+        return image;
+    }
+
+    const QString directory =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/map-pages";
+    QDir().mkpath(directory);
+    auto file = std::make_unique<QTemporaryFile>(directory + "/pages-XXXXXX");
+    const uchar* pixels = nullptr;
+    if (file->open() &&
+        file->write(reinterpret_cast<const char*>(image.constBits()), bytes) == bytes &&
+        file->flush()) {
+        pixels = file->map(0, bytes);
+    }
+    if (!pixels) {
+        DebugConsole::warning(QString("Cannot page out a %1 MB map, keeping it in memory: %2")
+            .arg(bytes / (1024 * 1024)).arg(file->errorString()), "Memory");
+        return image;
+    }
+
+#if defined(Q_OS_UNIX)
+    // The mapping keeps the pages reachable; a crash leaves nothing behind
+    ::unlink(QFile::encodeName(file->fileName()).constData());
+#endif
+
+    if (fileBacked) {
+        *fileBacked = true;
+    }
+    // Read-only image over the mapping; it owns the file from here on
+    return MapBuffer::mapped(pixels, image.width(), image.height(), image.bytesPerLine(), image.format(),
+                             releaseScratchFile, file.release());
 }
 
 QImage ImageLoader::loadImage(const QString& path)
@@ -169,24 +236,8 @@ bool ImageLoader::loadUVTT(const QString& path, QImage& outImage, QJsonObject& o
 
 bool ImageLoader::saveUVTT(const QString& path, const QImage& image, const QJsonObject& metadata)
 {
-    QJsonObject root = metadata;
-
-    // Add image data
-    QByteArray imageData = compressImage(image);
-    QString base64Data = QString::fromUtf8(imageData.toBase64());
-    root["image"] = base64Data;
-
-    // Save to file
-    QJsonDocument doc(root);
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly)) {
-        return false;
-    }
-
-    file.write(doc.toJson());
-    file.close();
-
-    return true;
+    // Streams the PNG (encoded in parallel strips) through base64 to disk
+    return UVTTWriter::write(path, image, metadata);
 }
 
 bool ImageLoader::isUVTTFile(const QString& path)
@@ -194,19 +245,6 @@ bool ImageLoader::isUVTTFile(const QString& path)
     return VTTLoader::isVTTFile(path);
 }
 
-QByteArray ImageLoader::compressImage(const QImage& image)
-{
-    QByteArray data;
-    QBuffer buffer(&data);
-    buffer.open(QIODevice::WriteOnly);
-
-    QImageWriter writer(&buffer, "PNG");
-    writer.setCompression(9);  // Max compression
-    writer.write(image);
-
-    return data;
-}
-
 QImage ImageLoader::decompressImage(const QByteArray& data)
 {
     QBuffer buffer(const_cast<QByteArray*>(&data));
@@ -215,12 +253,3 @@ QImage ImageLoader::decompressImage(const QByteArray& data)
     QImageReader reader(&buffer);
     return reader.read();
 }
-
-void ImageLoader::reportProgress(int percentage, const QString& status)
-{
-    emit progressChanged(percentage);
-    emit statusChanged(status);
-
-    // Allow UI to update
-    QApplication::processEvents();
-}
@@ -4,20 +4,53 @@
 #include <QString>
 #include <QImage>
 #include <QJsonObject>
-#include <QObject>
+#include <functional>
 
-class ImageLoader : public QObject
+// Decode and format stages for map images; every entry point is static.
+// MapLoadPipeline runs them on its worker and reports progress itself.
+class ImageLoader
 {
-    Q_OBJECT
-
 public:
-    explicit ImageLoader(QObject* parent = nullptr);
+    using ProgressCallback = std::function<void(int, const QString&)>;
+
+    // Storage format for opaque maps. Maps with alpha are always kept as
+    // ARGB32_Premultiplied, the only alpha format the raster engine blits directly.
+    enum class PixelFormatPolicy {
+        Auto = 0,    // RGB32, or RGB888 for maps that would take half the memory budget
+        Speed = 1,   // Always RGB32 - tiles upload without conversion
+        Memory = 2   // Always RGB888 - 25% smaller, converted once per tile upload
+    };
 
     // Load image from file
     static QImage loadImage(const QString& path);
 
-    // Load image with progress reporting
-    QImage loadImageWithProgress(const QString& path);
+    // Decode stage: read a regular image file, capped at MAX_IMAGE_DIMENSION.
+    // Thread-safe; errorString receives the reader error on failure.
+    static QImage readImage(const QString& path, const ProgressCallback& progressCallback = nullptr,
+                            QString* errorString = nullptr);
+
+    // Quick low-resolution read for progressive display. Only formats that
+    // decode at reduced size natively (JPEG) qualify - null otherwise.
+    // mapSize receives the size readImage() will produce. Thread-safe.
+    static QImage readPreview(const QString& path, int maxDimension, QSize* mapSize);
+
+    // Format convert stage: convert to displayFormat() under the current policy.
+    // Thread-safe.
+    static QImage convertForDisplay(const QImage& image);
+    static QImage::Format displayFormat(const QImage& image, PixelFormatPolicy policy);
+
+    // Page huge images out of the heap: copy the pixels into a scratch file
+    // under the cache directory and return a read-only image over its
+    // mapping, so resident memory follows the tiles actually drawn. Images
+    // under FILE_BACKED_MIN_BYTES, and failures, come back unchanged.
+    // Thread-safe.
+    static QImage toFileBacked(const QImage& image, bool* fileBacked = nullptr);
+
+    static void setPixelFormatPolicy(PixelFormatPolicy policy);
+    static PixelFormatPolicy pixelFormatPolicy();
+
+    static constexpr int MAX_IMAGE_DIMENSION = 32768;
+    static constexpr qint64 FILE_BACKED_MIN_BYTES = 256LL * 1024 * 1024;
 
     // Load UVTT format (JSON with image data)
     static bool loadUVTT(const QString& path, QImage& outImage, QJsonObject& outMetadata);
@@ -28,19 +61,10 @@ public:
     // Check if file is UVTT format
     static bool isUVTTFile(const QString& path);
 
-signals:
-    void progressChanged(int percentage);
-    void statusChanged(const QString& status);
-
 private:
-    static QByteArray compressImage(const QImage& image);
-    static QImage decompressImage(const QByteArray& data);
+    ImageLoader() = default;
 
-    // Helper for progress reporting
-    void reportProgress(int percentage, const QString& status);
-
-    // Reentrancy guard for loadImageWithProgress (uses processEvents)
-    bool m_isLoading = false;
+    static QImage decompressImage(const QByteArray& data);
 };
 
 #endif // IMAGELOADER_H
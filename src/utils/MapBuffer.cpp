@@ -0,0 +1,161 @@
+#include "utils/MapBuffer.h"
+#include "utils/DebugConsole.h"
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+struct MapBuffer::Data {
+    Data(const QImage& image, const QString& sourcePath);
+    ~Data();
+
+    const QImage image;
+    const QString sourcePath;
+    const bool mapped;
+};
+
+namespace {
+
+// Live buffers, for MapBuffer::audit(), and live file mappings
+struct Registry {
+    QMutex mutex;
+    QSet<const MapBuffer::Data*> buffers;
+    QSet<const uchar*> mappedPixels;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+struct Mapping {
+    const uchar* pixels;
+    QImageCleanupFunction cleanup;
+    void* cleanupInfo;
+};
+
+void releaseMapping(void* info)
+{
+    Mapping* mapping = static_cast<Mapping*>(info);
+    {
+        Registry& live = registry();
+        QMutexLocker locker(&live.mutex);
+        live.mappedPixels.remove(mapping->pixels);
+    }
+    if (mapping->cleanup) {
+        mapping->cleanup(mapping->cleanupInfo);
+    }
+    delete mapping;
+}
+
+}
+
+MapBuffer::Data::Data(const QImage& image, const QString& sourcePath)
+    : image(image)
+    , sourcePath(sourcePath)
+    , mapped(MapBuffer::isMapped(image))
+{
+    Registry& live = registry();
+    bool duplicate = false;
+    {
+        QMutexLocker locker(&live.mutex);
+        if (!sourcePath.isEmpty()) {
+            for (const Data* other : std::as_const(live.buffers)) {
+                if (other->sourcePath == sourcePath && other->image.constBits() != image.constBits()) {
+                    duplicate = true;
+                    break;
+                }
+            }
+        }
+        live.buffers.insert(this);
+    }
+
+    if (duplicate) {
+        DebugConsole::warning(QString("MapBuffer: %1 is in memory twice").arg(sourcePath), "Memory");
+    }
+}
+
+MapBuffer::Data::~Data()
+{
+    Registry& live = registry();
+    QMutexLocker locker(&live.mutex);
+    live.buffers.remove(this);
+}
+
+MapBuffer::MapBuffer(const QImage& image, const QString& sourcePath)
+{
+    if (!image.isNull()) {
+        m_data = std::make_shared<const Data>(image, sourcePath);
+    }
+}
+
+const QImage& MapBuffer::image() const
+{
+    static const QImage nullImage;
+    return m_data ? m_data->image : nullImage;
+}
+
+QString MapBuffer::sourcePath() const
+{
+    return m_data ? m_data->sourcePath : QString();
+}
+
+bool MapBuffer::isMapped() const
+{
+    return m_data && m_data->mapped;
+}
+
+QImage MapBuffer::mapped(const uchar* pixels, int width, int height, qsizetype bytesPerLine,
+                         QImage::Format format, QImageCleanupFunction cleanup, void* cleanupInfo)
+{
+    {
+        Registry& live = registry();
+        QMutexLocker locker(&live.mutex);
+        live.mappedPixels.insert(pixels);
+    }
+    return QImage(pixels, width, height, bytesPerLine, format,
+                  releaseMapping, new Mapping{pixels, cleanup, cleanupInfo});
+}
+
+bool MapBuffer::isMapped(const QImage& image)
+{
+    if (image.isNull()) {
+        return false;
+    }
+    Registry& live = registry();
+    QMutexLocker locker(&live.mutex);
+    return live.mappedPixels.contains(image.constBits());
+}
+
+MapBuffer::Audit MapBuffer::audit()
+{
+    Audit result;
+    QHash<const uchar*, QString> allocations;
+    QSet<QString> duplicated;
+
+    Registry& live = registry();
+    QMutexLocker locker(&live.mutex);
+    for (const Data* data : std::as_const(live.buffers)) {
+        ++result.buffers;
+        const uchar* pixels = data->image.constBits();
+        if (allocations.contains(pixels)) {
+            continue;
+        }
+        allocations.insert(pixels, data->sourcePath);
+        result.bytes += data->image.sizeInBytes();
+    }
+    locker.unlock();
+
+    // A source behind more than one allocation was decoded or copied twice
+    QHash<QString, int> perSource;
+    for (auto it = allocations.cbegin(); it != allocations.cend(); ++it) {
+        if (!it.value().isEmpty() && ++perSource[it.value()] == 2) {
+            duplicated.insert(it.value());
+        }
+    }
+
+    result.allocations = allocations.size();
+    result.duplicated = QStringList(duplicated.cbegin(), duplicated.cend());
+    return result;
+}
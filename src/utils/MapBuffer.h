@@ -0,0 +1,68 @@
+#ifndef MAPBUFFER_H
+#define MAPBUFFER_H
+
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <memory>
+
+// Reference-counted handle to a loaded map's pixels.
+//
+// The session that loaded a map creates one MapBuffer and every display,
+// scene and tile pyramid that shows it holds a copy of the handle. The
+// pixels are only reachable as a const QImage, so no holder can detach them
+// into a private copy. Buffers made from the same QImage share their pixels
+// too, but have separate identities.
+//
+// Every live buffer is registered for audit(): it reports how many distinct
+// pixel allocations back the live buffers, so a map that was decoded or
+// copied twice shows up as a duplicated source.
+//
+// Pixels that live in a file mapping (paged-out maps, decoded map cache
+// entries) are created through mapped(), so a buffer knows whether it holds
+// heap memory or pages the OS can drop and re-read on its own.
+class MapBuffer
+{
+public:
+    struct Audit {
+        int buffers = 0;          // Live buffers
+        int allocations = 0;      // Distinct pixel allocations behind them
+        qint64 bytes = 0;         // Size of those allocations
+        QStringList duplicated;   // Sources held in more than one allocation
+
+        bool isClean() const { return duplicated.isEmpty(); }
+    };
+
+    MapBuffer() = default;
+    explicit MapBuffer(const QImage& image, const QString& sourcePath = QString());
+
+    bool isNull() const { return !m_data; }
+    const QImage& image() const;
+    QSize size() const { return image().size(); }
+    qint64 sizeInBytes() const { return image().sizeInBytes(); }
+    QString sourcePath() const;
+
+    // File-backed pixels cost no heap and freeing them frees none
+    bool isMapped() const;
+    qint64 heapBytes() const { return isMapped() ? 0 : sizeInBytes(); }
+
+    // Holders of this buffer (displays, sessions, parked scenes)
+    long useCount() const { return m_data ? m_data.use_count() : 0; }
+
+    bool operator==(const MapBuffer& other) const { return m_data == other.m_data; }
+    bool operator!=(const MapBuffer& other) const { return m_data != other.m_data; }
+
+    static Audit audit();
+
+    // Read-only image over a file mapping; cleanup runs when the last copy goes
+    static QImage mapped(const uchar* pixels, int width, int height, qsizetype bytesPerLine,
+                         QImage::Format format, QImageCleanupFunction cleanup, void* cleanupInfo);
+    static bool isMapped(const QImage& image);
+
+    struct Data;  // Defined in MapBuffer.cpp
+
+private:
+    std::shared_ptr<const Data> m_data;
+};
+
+#endif // MAPBUFFER_H
@@ -0,0 +1,311 @@
+#include "utils/MapLoadPipeline.h"
+#include "utils/ImageLoader.h"
+#include "utils/DecodedMapCache.h"
+#include "utils/MapPrefetcher.h"
+#include "utils/DebugConsole.h"
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+MapLoadPipeline::MapLoadPipeline(QObject* parent)
+    : QObject(parent)
+    , m_threadPool(new QThreadPool(this))
+{
+    // One map decode at a time - a superseded load finishes its current stage
+    // before the next one starts, which bounds peak memory to about one map
+    m_threadPool->setMaxThreadCount(1);
+}
+
+MapLoadPipeline::~MapLoadPipeline()
+{
+    // Worker posts back to this object - it must be done before we go away
+    if (m_activeCancelFlag) {
+        m_activeCancelFlag->store(true);
+    }
+    m_threadPool->waitForDone();
+    setBusy(false);
+}
+
+void MapLoadPipeline::setBusy(bool busy)
+{
+    if (busy == m_busy) {
+        return;
+    }
+    m_busy = busy;
+    if (busy) {
+        MapPrefetcher::instance().beginForegroundLoad();
+    } else {
+        MapPrefetcher::instance().endForegroundLoad();
+    }
+}
+
+void MapLoadPipeline::load(const QString& filePath)
+{
+    abandonActiveRequest();
+
+    const quint64 requestId = m_nextRequestId++;
+    auto cancelFlag = std::make_shared<std::atomic<bool>>(false);
+    m_activeRequest = requestId;
+    m_activeFilePath = filePath;
+    m_activeCancelFlag = cancelFlag;
+    setBusy(true);
+
+    DebugConsole::info(QString("MapLoadPipeline: loading %1 in background").arg(filePath), "Loading");
+
+    m_threadPool->start([this, filePath, requestId, cancelFlag]() {
+        int lastPercentage = -1;
+        auto progressCallback = [this, requestId, cancelFlag, &lastPercentage](int percentage,
+                                                                              const QString& status) {
+            // Only forward whole-percent steps - VTT tinting reports per row band
+            if (cancelFlag->load(std::memory_order_relaxed) || percentage == lastPercentage) {
+                return;
+            }
+            lastPercentage = percentage;
+            QMetaObject::invokeMethod(this, [this, requestId, percentage, status]() {
+                if (requestId == m_activeRequest) {
+                    emit progressChanged(percentage, status);
+                }
+            }, Qt::QueuedConnection);
+        };
+
+        auto previewCallback = [this, filePath, requestId, cancelFlag](const QImage& preview,
+                                                                       const QSize& mapSize, int gridSize) {
+            if (cancelFlag->load(std::memory_order_relaxed)) {
+                return;
+            }
+            QMetaObject::invokeMethod(this, [this, filePath, requestId, preview, mapSize, gridSize]() {
+                if (requestId == m_activeRequest) {
+                    emit previewReady(filePath, preview, mapSize, gridSize);
+                }
+            }, Qt::QueuedConnection);
+        };
+
+        Result result;
+        try {
+            result = loadFile(filePath, cancelFlag.get(), progressCallback, previewCallback);
+        } catch (const std::exception& e) {
+            result = Result();
+            result.filePath = filePath;
+            result.errorMessage = QString("Error loading map: %1").arg(e.what());
+        }
+
+        QMetaObject::invokeMethod(this, [this, requestId, result]() {
+            finishRequest(requestId, result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MapLoadPipeline::cancel()
+{
+    if (m_activeRequest == 0) {
+        return;
+    }
+
+    const QString filePath = m_activeFilePath;
+    abandonActiveRequest();
+    setBusy(false);
+
+    DebugConsole::info(QString("MapLoadPipeline: cancelled %1").arg(filePath), "Loading");
+    emit loadCancelled(filePath);
+}
+
+void MapLoadPipeline::abandonActiveRequest()
+{
+    if (m_activeRequest == 0) {
+        return;
+    }
+
+    // Worker notices at its next stage boundary; finishRequest() drops the result
+    m_activeCancelFlag->store(true);
+    m_activeCancelFlag.reset();
+    m_activeRequest = 0;
+    m_activeFilePath.clear();
+}
+
+void MapLoadPipeline::finishRequest(quint64 requestId, const Result& result)
+{
+    // Replaced or cancelled - the caller already moved on
+    if (requestId != m_activeRequest) {
+        return;
+    }
+
+    m_activeRequest = 0;
+    m_activeFilePath.clear();
+    m_activeCancelFlag.reset();
+    setBusy(false);
+
+    if (result.cancelled) {
+        emit loadCancelled(result.filePath);
+    } else if (result.isValid()) {
+        emit loadFinished(result);
+    } else {
+        emit loadFailed(result.filePath, result.errorMessage);
+    }
+}
+
+MapLoadPipeline::Result MapLoadPipeline::loadFile(const QString& filePath,
+                                                  const std::atomic<bool>* cancelled,
+                                                  const ProgressCallback& progressCallback,
+                                                  const PreviewCallback& previewCallback)
+{
+    Result result;
+    result.filePath = filePath;
+
+    auto isCancelled = [cancelled]() {
+        return cancelled && cancelled->load(std::memory_order_relaxed);
+    };
+    auto reportProgress = [&](int percentage, const QString& status) {
+        if (progressCallback) {
+            progressCallback(percentage, status);
+        }
+    };
+    // Read/parse/decode report 0-100 on their own; they own 0-90 of the pipeline
+    auto stageProgress = [&](int percentage, const QString& status) {
+        reportProgress(percentage * 90 / 100, status);
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Stage 1: read
+    QFileInfo fileInfo(filePath);
+    if (!fileInfo.exists() || !fileInfo.isReadable() || fileInfo.size() == 0) {
+        result.errorMessage = QString("Cannot read map file: %1").arg(filePath);
+        return result;
+    }
+    result.lastModified = fileInfo.lastModified();
+
+    // Decoded ahead of time while the app was idle
+    if (MapPrefetcher::instance().take(fileInfo, result)) {
+        reportProgress(100, "Map loaded");
+        DebugConsole::performance(
+            QString("MapLoadPipeline: %1 taken from prefetch in %2 ms (%3x%4)")
+                .arg(fileInfo.fileName())
+                .arg(timer.elapsed())
+                .arg(result.image.width())
+                .arg(result.image.height()),
+            "Loading");
+        return result;
+    }
+
+    // Reopened map: mapped straight from the decoded cache, no parse or decode
+    if (DecodedMapCache::instance().lookup(fileInfo, result.image, result.vttData)) {
+        reportProgress(100, "Map loaded");
+        DebugConsole::performance(
+            QString("MapLoadPipeline: %1 mapped from decoded cache in %2 ms (%3x%4)")
+                .arg(fileInfo.fileName())
+                .arg(timer.elapsed())
+                .arg(result.image.width())
+                .arg(result.image.height()),
+            "Loading");
+        return result;
+    }
+
+    // Stages 2-3: parse and decode
+    const bool wantPreview = previewCallback && fileInfo.size() >= PREVIEW_MIN_FILE_SIZE;
+    QImage decoded;
+    if (VTTLoader::isVTTFile(filePath)) {
+        // Embedded PNG/WebP can't be read at reduced size; the size alone
+        // still lets the receiver lay out the scene before the decode
+        VTTLoader::MetadataCallback metadataCallback;
+        if (wantPreview) {
+            metadataCallback = [&previewCallback](const VTTLoader::VTTData& metadata) {
+                const QSize mapSize(metadata.gridSquaresX * metadata.pixelsPerGrid,
+                                    metadata.gridSquaresY * metadata.pixelsPerGrid);
+                if (!mapSize.isEmpty()) {
+                    previewCallback(QImage(), mapSize, metadata.pixelsPerGrid);
+                }
+            };
+        }
+        result.vttData = VTTLoader::loadVTT(filePath, stageProgress, metadataCallback);
+        decoded = result.vttData.mapImage;
+        if (decoded.isNull()) {
+            result.errorMessage = result.vttData.errorMessage;
+        }
+    } else {
+        if (wantPreview) {
+            QElapsedTimer previewTimer;
+            previewTimer.start();
+            QSize mapSize;
+            const QImage preview = ImageLoader::readPreview(filePath, PREVIEW_SIZE, &mapSize);
+            if (!preview.isNull()) {
+                previewCallback(preview, mapSize, 0);
+                DebugConsole::performance(QString("MapLoadPipeline: %1 preview in %2 ms")
+                    .arg(fileInfo.fileName()).arg(previewTimer.elapsed()), "Loading");
+            }
+        }
+        if (isCancelled()) {
+            result.cancelled = true;
+            return result;
+        }
+        decoded = ImageLoader::readImage(filePath, stageProgress, &result.errorMessage);
+    }
+
+    if (isCancelled()) {
+        result.cancelled = true;
+        result.vttData = VTTLoader::VTTData();
+        return result;
+    }
+    if (decoded.isNull()) {
+        if (result.errorMessage.isEmpty()) {
+            result.errorMessage = QString("Failed to decode map: %1").arg(filePath);
+        }
+        return result;
+    }
+
+    // Stage 4: format convert. Keep a single pixel buffer - VTT data must
+    // not pin the pre-conversion copy while the converted one is made.
+    reportProgress(92, "Preparing image for display...");
+    const bool vttImage = !result.vttData.mapImage.isNull();
+    result.vttData.mapImage = QImage();
+    result.image = ImageLoader::convertForDisplay(decoded);
+    decoded = QImage();
+
+    // Huge maps leave the heap, written to disk once: into their decoded
+    // cache entry, mapped back as the display image, or into a scratch
+    // mapping when the cache budget cannot take them
+    bool cached = false;
+    if (result.image.sizeInBytes() >= ImageLoader::FILE_BACKED_MIN_BYTES) {
+        DecodedMapCache& cache = DecodedMapCache::instance();
+        QImage mapped;
+        VTTLoader::VTTData cachedVttData;
+        if (cache.store(fileInfo, result.image, result.vttData) &&
+            cache.lookup(fileInfo, mapped, cachedVttData)) {
+            result.image = mapped;
+            cached = true;
+        } else {
+            result.image = ImageLoader::toFileBacked(result.image);
+        }
+    }
+    if (vttImage) {
+        result.vttData.mapImage = result.image;
+    }
+
+    if (isCancelled()) {
+        result.cancelled = true;
+        result.image = QImage();
+        result.vttData = VTTLoader::VTTData();
+        return result;
+    }
+
+    // Write the cache entry off the load path - the image is shared, not copied
+    if (!cached && timer.elapsed() >= DecodedMapCache::MIN_DECODE_MS &&
+        DecodedMapCache::instance().fits(result.image.sizeInBytes())) {
+        const QImage image = result.image;
+        const VTTLoader::VTTData vttData = result.vttData;
+        QThreadPool::globalInstance()->start([fileInfo, image, vttData]() {
+            DecodedMapCache::instance().store(fileInfo, image, vttData);
+        });
+    }
+
+    reportProgress(100, "Map loaded");
+    DebugConsole::performance(
+        QString("MapLoadPipeline: %1 decoded in %2 ms (%3x%4)")
+            .arg(fileInfo.fileName())
+            .arg(timer.elapsed())
+            .arg(result.image.width())
+            .arg(result.image.height()),
+        "Loading");
+
+    return result;
+}
@@ -0,0 +1,87 @@
+#ifndef MAPLOADPIPELINE_H
+#define MAPLOADPIPELINE_H
+
+#include <QObject>
+#include <QString>
+#include <QImage>
+#include <QDateTime>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include "utils/VTTLoader.h"
+
+class QThreadPool;
+
+// Loads map files off the GUI thread: read -> parse -> decode -> format convert.
+// Progress and results are delivered as queued signals on the owner's thread,
+// so callers never need processEvents(). Starting a new load silently replaces
+// the previous one; a replaced or cancelled load stops at the next stage
+// boundary and its result is dropped. Scene building stays on the GUI thread
+// with the receiver.
+//
+// Large files announce their final size early through previewReady(), with a
+// reduced-size read when the format supports one, so the receiver can put a
+// stand-in on screen while the full decode runs.
+class MapLoadPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    using ProgressCallback = std::function<void(int, const QString&)>;
+    // preview may be null (VTT) - mapSize and gridSize are still meaningful
+    using PreviewCallback = std::function<void(const QImage& preview, const QSize& mapSize, int gridSize)>;
+
+    struct Result {
+        QString filePath;
+        QImage image;                // Display-ready (see ImageLoader::convertForDisplay)
+        VTTLoader::VTTData vttData;  // Shares image; default for regular images
+        QDateTime lastModified;
+        QString errorMessage;
+        bool cancelled = false;
+
+        bool isValid() const { return !image.isNull(); }
+    };
+
+    explicit MapLoadPipeline(QObject* parent = nullptr);
+    ~MapLoadPipeline() override;
+
+    // Start loading filePath in the background (replaces any load in flight)
+    void load(const QString& filePath);
+
+    // Abandon the load in flight, emits loadCancelled
+    void cancel();
+
+    bool isLoading() const { return m_activeRequest != 0; }
+    QString currentFilePath() const { return m_activeFilePath; }
+
+    // Run every stage on the calling thread. Used by the worker and by
+    // callers that must stay synchronous.
+    static Result loadFile(const QString& filePath,
+                           const std::atomic<bool>* cancelled = nullptr,
+                           const ProgressCallback& progressCallback = nullptr,
+                           const PreviewCallback& previewCallback = nullptr);
+
+    static constexpr int PREVIEW_SIZE = 1024;
+    static constexpr qint64 PREVIEW_MIN_FILE_SIZE = 2 * 1024 * 1024;  // Smaller files decode fast enough
+
+signals:
+    void progressChanged(int percentage, const QString& status);
+    void previewReady(const QString& filePath, const QImage& preview, const QSize& mapSize, int gridSize);
+    void loadFinished(const MapLoadPipeline::Result& result);
+    void loadFailed(const QString& filePath, const QString& errorMessage);
+    void loadCancelled(const QString& filePath);
+
+private:
+    void abandonActiveRequest();
+    void setBusy(bool busy);
+    void finishRequest(quint64 requestId, const Result& result);
+
+    QThreadPool* m_threadPool;
+    quint64 m_nextRequestId = 1;
+    quint64 m_activeRequest = 0;  // 0 = idle
+    QString m_activeFilePath;
+    std::shared_ptr<std::atomic<bool>> m_activeCancelFlag;
+    bool m_busy = false;  // Reported to MapPrefetcher, which pauses meanwhile
+};
+
+#endif // MAPLOADPIPELINE_H
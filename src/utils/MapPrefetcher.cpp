@@ -0,0 +1,321 @@
+#include "utils/MapPrefetcher.h"
+#include "utils/DebugConsole.h"
+#include "utils/MemoryManager.h"
+#include "utils/MapBuffer.h"
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QThread>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+MapPrefetcher& MapPrefetcher::instance()
+{
+    static MapPrefetcher instance;
+    return instance;
+}
+
+MapPrefetcher::MapPrefetcher()
+    : QObject(nullptr)
+    , m_threadPool(new QThreadPool(this))
+{
+    // One map at a time: prefetching must never compete with itself for memory
+    m_threadPool->setMaxThreadCount(1);
+
+    // take() can be the first call, from a loader thread - results are
+    // always posted back to the GUI thread
+    if (QCoreApplication::instance() && thread() != QCoreApplication::instance()->thread()) {
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+
+    // Speculative maps are the first thing to go when memory runs short.
+    // Mapped maps count against the prefetch budget but not the heap.
+    MemoryManager& memory = MemoryManager::instance();
+    m_memoryConsumerId = memory.registerConsumer(QStringLiteral("Prefetched maps"),
+        [this]() { return heapBytes(); },
+        [this](qint64 bytesWanted) { return evictForMemory(bytesWanted); });
+    connect(&memory, &MemoryManager::memoryPressureRelieved, this, &MapPrefetcher::scheduleNext);
+}
+
+MapPrefetcher::~MapPrefetcher()
+{
+    MemoryManager::instance().unregisterConsumer(m_memoryConsumerId);
+    cancelInFlight();
+    m_threadPool->waitForDone();
+}
+
+void MapPrefetcher::setCandidates(const QStringList& filePaths)
+{
+    QStringList candidates;
+    for (const QString& path : filePaths) {
+        const QString absolutePath = QFileInfo(path).absoluteFilePath();
+        if (!path.isEmpty() && !candidates.contains(absolutePath)) {
+            candidates.append(absolutePath);
+        }
+        if (candidates.size() >= MAX_CANDIDATES) {
+            break;
+        }
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        if (candidates == m_candidates) {
+            return;
+        }
+        m_candidates = candidates;
+
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (!m_candidates.contains(it.key())) {
+                m_usedBytes -= it->bytes;
+                it = m_entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (auto it = m_skipped.begin(); it != m_skipped.end();) {
+            if (!m_candidates.contains(*it)) {
+                it = m_skipped.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (!m_inFlightPath.isEmpty() && !candidates.contains(m_inFlightPath)) {
+        cancelInFlight();
+    }
+    scheduleNext();
+}
+
+bool MapPrefetcher::take(const QFileInfo& fileInfo, MapLoadPipeline::Result& result)
+{
+    QMutexLocker locker(&m_mutex);
+    const QString path = fileInfo.absoluteFilePath();
+    auto it = m_entries.find(path);
+    if (it == m_entries.end()) {
+        return false;
+    }
+
+    Entry entry = *it;
+    m_usedBytes -= entry.bytes;
+    m_entries.erase(it);
+    // Opened now - the tab holds it from here on
+    m_candidates.removeAll(path);
+
+    if (entry.result.lastModified != fileInfo.lastModified()) {
+        return false;  // Changed on disk since it was prefetched
+    }
+    result.image = entry.result.image;
+    result.vttData = entry.result.vttData;
+    result.lastModified = entry.result.lastModified;
+    return true;
+}
+
+void MapPrefetcher::beginForegroundLoad()
+{
+    // The user is waiting on that load - give it the disk and the cores
+    if (m_foregroundLoads++ == 0) {
+        cancelInFlight();
+    }
+}
+
+void MapPrefetcher::endForegroundLoad()
+{
+    if (m_foregroundLoads > 0 && --m_foregroundLoads == 0) {
+        scheduleNext();
+    }
+}
+
+void MapPrefetcher::setBudgetMB(int sizeInMB)
+{
+    m_budgetMB.store(qMax(0, sizeInMB));
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_skipped.clear();
+
+        // Shrink from the least likely end
+        const qint64 budget = qint64(m_budgetMB.load()) * 1024 * 1024;
+        for (int i = m_candidates.size() - 1; i >= 0 && m_usedBytes > budget; --i) {
+            auto it = m_entries.find(m_candidates.at(i));
+            if (it != m_entries.end()) {
+                m_usedBytes -= it->bytes;
+                m_entries.erase(it);
+            }
+        }
+    }
+    scheduleNext();
+}
+
+qint64 MapPrefetcher::usedBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_usedBytes;
+}
+
+void MapPrefetcher::clear()
+{
+    cancelInFlight();
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_skipped.clear();
+    m_usedBytes = 0;
+}
+
+void MapPrefetcher::cancelInFlight()
+{
+    if (m_cancelFlag) {
+        m_cancelFlag->store(true);
+        m_cancelFlag.reset();
+    }
+    m_inFlightPath.clear();
+}
+
+qint64 MapPrefetcher::heapBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 bytes = 0;
+    for (const Entry& entry : m_entries) {
+        bytes += entry.heapBytes;
+    }
+    return bytes;
+}
+
+qint64 MapPrefetcher::evictForMemory(qint64 bytesWanted)
+{
+    // A decode in flight would only allocate more
+    cancelInFlight();
+
+    // Least likely first; evicted maps are not prefetched again while listed.
+    // Dropping a mapped map frees no heap, so those stay.
+    QMutexLocker locker(&m_mutex);
+    qint64 freed = 0;
+    for (int i = m_candidates.size() - 1; i >= 0 && freed < bytesWanted; --i) {
+        auto it = m_entries.find(m_candidates.at(i));
+        if (it != m_entries.end() && it->heapBytes > 0) {
+            freed += it->heapBytes;
+            m_usedBytes -= it->bytes;
+            m_skipped.insert(it.key());
+            m_entries.erase(it);
+        }
+    }
+    return freed;
+}
+
+qint64 MapPrefetcher::bytesAhead(int priority) const
+{
+    qint64 bytes = 0;
+    for (int i = 0; i < priority && i < m_candidates.size(); ++i) {
+        auto it = m_entries.constFind(m_candidates.at(i));
+        if (it != m_entries.constEnd()) {
+            bytes += it->bytes;
+        }
+    }
+    return bytes;
+}
+
+void MapPrefetcher::scheduleNext()
+{
+    if (m_foregroundLoads > 0 || !m_inFlightPath.isEmpty() || m_budgetMB.load() <= 0 ||
+        MemoryManager::instance().isUnderMemoryPressure()) {
+        return;
+    }
+
+    QString next;
+    {
+        QMutexLocker locker(&m_mutex);
+        const qint64 budget = qint64(m_budgetMB.load()) * 1024 * 1024;
+        for (int i = 0; i < m_candidates.size(); ++i) {
+            const QString& path = m_candidates.at(i);
+            if (m_entries.contains(path) || m_skipped.contains(path)) {
+                continue;
+            }
+            // Likelier maps already fill the budget - nothing further down would fit
+            if (bytesAhead(i) >= budget) {
+                break;
+            }
+            next = path;
+            break;
+        }
+    }
+    if (next.isEmpty()) {
+        return;
+    }
+
+    auto cancelFlag = std::make_shared<std::atomic<bool>>(false);
+    m_inFlightPath = next;
+    m_cancelFlag = cancelFlag;
+
+    m_threadPool->start([this, next, cancelFlag]() {
+        // Only runs in time the GUI and foreground loads leave over
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        MapLoadPipeline::Result result;
+        try {
+            result = MapLoadPipeline::loadFile(next, cancelFlag.get());
+        } catch (const std::exception& e) {
+            result = MapLoadPipeline::Result();
+            result.filePath = next;
+            result.errorMessage = QString("Error prefetching map: %1").arg(e.what());
+        }
+
+        if (result.isValid() && !cancelFlag->load(std::memory_order_relaxed)) {
+            DebugConsole::performance(QString("MapPrefetcher: prefetched %1 in %2 ms (%3 MB)")
+                .arg(QFileInfo(next).fileName())
+                .arg(timer.elapsed())
+                .arg(result.image.sizeInBytes() / (1024.0 * 1024.0), 0, 'f', 1), "Loading");
+        }
+
+        QMetaObject::invokeMethod(this, [this, next, cancelFlag, result]() {
+            finishPrefetch(next, cancelFlag, result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MapPrefetcher::finishPrefetch(const QString& filePath,
+                                   const std::shared_ptr<std::atomic<bool>>& cancelFlag,
+                                   const MapLoadPipeline::Result& result)
+{
+    // Cancelled or superseded - a newer prefetch may already be running
+    if (cancelFlag != m_cancelFlag) {
+        return;
+    }
+    m_cancelFlag.reset();
+    m_inFlightPath.clear();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        const int priority = m_candidates.indexOf(filePath);
+        if (priority >= 0) {
+            if (!result.isValid()) {
+                DebugConsole::warning(QString("MapPrefetcher: skipping %1 (%2)")
+                    .arg(QFileInfo(filePath).fileName(), result.errorMessage), "Loading");
+                m_skipped.insert(filePath);
+            } else {
+                const qint64 bytes = result.image.sizeInBytes();
+                const qint64 budget = qint64(m_budgetMB.load()) * 1024 * 1024;
+
+                // Make room by dropping less likely maps, never more likely ones
+                for (int i = m_candidates.size() - 1; i > priority && m_usedBytes + bytes > budget; --i) {
+                    auto it = m_entries.find(m_candidates.at(i));
+                    if (it != m_entries.end()) {
+                        m_usedBytes -= it->bytes;
+                        m_entries.erase(it);
+                    }
+                }
+
+                if (m_usedBytes + bytes > budget) {
+                    m_skipped.insert(filePath);
+                } else {
+                    const qint64 heapBytes = MapBuffer::isMapped(result.image) ? 0 : bytes;
+                    m_entries.insert(filePath, Entry{result, bytes, heapBytes});
+                    m_usedBytes += bytes;
+                }
+            }
+        }
+    }
+
+    scheduleNext();
+}
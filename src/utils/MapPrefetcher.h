@@ -0,0 +1,88 @@
+#ifndef MAPPREFETCHER_H
+#define MAPPREFETCHER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QMutex>
+#include <atomic>
+#include <memory>
+#include "utils/MapLoadPipeline.h"
+
+class QThreadPool;
+class QFileInfo;
+
+// Decodes the maps most likely to be opened next while the app is idle:
+// tabs whose images were released, the next file in the map browser folder
+// and recent files. Finished maps are held in memory, up to a byte budget
+// (lower-priority candidates are dropped first), and handed over to
+// MapLoadPipeline::loadFile() so opening one skips the whole decode.
+//
+// Runs one idle-priority worker and pauses while a foreground load is in
+// flight or MemoryManager reports pressure. Decoding also fills
+// DecodedMapCache, so a prefetched map that was evicted from memory still
+// reopens from disk.
+class MapPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MapPrefetcher& instance();
+
+    // Replace the candidate list, most likely first (GUI thread).
+    // Maps no longer listed are dropped, an unlisted one in flight is cancelled.
+    void setCandidates(const QStringList& filePaths);
+
+    // Take a prefetched map out of the store; false if absent or stale.
+    // Thread-safe - called from the MapLoadPipeline worker.
+    bool take(const QFileInfo& fileInfo, MapLoadPipeline::Result& result);
+
+    // MapLoadPipeline brackets its loads with these (GUI thread)
+    void beginForegroundLoad();
+    void endForegroundLoad();
+
+    void setBudgetMB(int sizeInMB);
+    int budgetMB() const { return m_budgetMB.load(); }
+    qint64 usedBytes() const;
+
+    void clear();
+
+    static constexpr int DEFAULT_BUDGET_MB = 1024;
+    static constexpr int MAX_CANDIDATES = 6;
+
+private:
+    MapPrefetcher();
+    ~MapPrefetcher() override;
+    MapPrefetcher(const MapPrefetcher&) = delete;
+    MapPrefetcher& operator=(const MapPrefetcher&) = delete;
+
+    void scheduleNext();
+    void cancelInFlight();
+    void finishPrefetch(const QString& filePath, const std::shared_ptr<std::atomic<bool>>& cancelFlag,
+                        const MapLoadPipeline::Result& result);
+    qint64 bytesAhead(int priority) const;  // Held by candidates ranked before priority
+    qint64 heapBytes() const;  // MemoryManager size callback
+    qint64 evictForMemory(qint64 bytesWanted);  // MemoryManager eviction callback
+
+    struct Entry {
+        MapLoadPipeline::Result result;
+        qint64 bytes = 0;
+        qint64 heapBytes = 0;  // 0 when the pixels are a file mapping
+    };
+
+    mutable QMutex m_mutex;  // Guards m_entries, m_usedBytes and m_candidates
+    QHash<QString, Entry> m_entries;
+    qint64 m_usedBytes = 0;
+    QStringList m_candidates;   // Absolute paths, most likely first
+    QSet<QString> m_skipped;    // Failed or over budget - not retried while listed
+
+    QThreadPool* m_threadPool;
+    QString m_inFlightPath;
+    std::shared_ptr<std::atomic<bool>> m_cancelFlag;
+    int m_foregroundLoads = 0;
+    std::atomic<int> m_budgetMB{DEFAULT_BUDGET_MB};
+    int m_memoryConsumerId = 0;
+};
+
+#endif // MAPPREFETCHER_H
@@ -1,19 +1,31 @@
 #include "utils/MapSession.h"
 #include "graphics/MapDisplay.h"
+#include "graphics/SceneBuilder.h"
 #include "graphics/GridOverlay.h"
+#include "graphics/FogOfWar.h"
 #include "graphics/LightingOverlay.h"
 #include "utils/VTTLoader.h"
 #include "utils/SettingsManager.h"
 #include "utils/DebugConsole.h"
 #include "utils/MemoryManager.h"
+#include "utils/DecodedMapCache.h"
 #include <QFileInfo>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QMutex>
+#include <QElapsedTimer>
 #include <QStandardPaths>
 #include <QDir>
 #include <QCryptographicHash>
-#include <QGraphicsScene>
-#include <QPainter>
 #include <QByteArray>
 
+struct MapSession::FogSwap {
+    QMutex mutex;
+    FogSnapshot pending;    // Cleared once the swap file is written
+    bool onDisk = false;
+    bool abandoned = false; // Restored or discarded - the writer must not leave a file
+};
+
 MapSession::MapSession(const QString& filePath)
     : m_filePath(filePath)
     , m_gridEnabled(true)
@@ -21,34 +33,57 @@ MapSession::MapSession(const QString& filePath)
     , m_zoomLevel(1.0)
     , m_viewCenter(0, 0)
     , m_isActive(false)
-    , m_sceneCached(false)
 {
     QFileInfo fileInfo(filePath);
     m_fileName = fileInfo.baseName();
     initializeFogPath();
+
+    // An inactive tab's image reloads from disk (usually the decoded map
+    // cache), so the budget may take it back. A mapped image is page cache,
+    // not heap: releasing it would free nothing the budget counts.
+    m_memoryConsumerId = MemoryManager::instance().registerConsumer(
+        QString("Map image: %1").arg(m_fileName),
+        [this]() { return m_mapBuffer.heapBytes(); },
+        [this](qint64) -> qint64 {
+            const qint64 bytes = m_mapBuffer.heapBytes();
+            if (m_isActive || bytes == 0) {
+                return 0;
+            }
+            releaseImageMemory();
+            return bytes;
+        });
+
+    // A parked scene is rebuilt from the image when it is gone
+    m_sceneConsumerId = MemoryManager::instance().registerConsumer(
+        QString("Retained scene: %1").arg(m_fileName),
+        [this]() { return m_retainedScene ? m_retainedScene->memoryBytes() : qint64(0); },
+        [this](qint64) -> qint64 {
+            if (!m_retainedScene) {
+                return 0;
+            }
+            const qint64 bytes = m_retainedScene->memoryBytes();
+            dropRetainedScene();
+            return bytes;
+        });
 }
 
 MapSession::~MapSession()
 {
+    MemoryManager::instance().unregisterConsumer(m_memoryConsumerId);
+    MemoryManager::instance().unregisterConsumer(m_sceneConsumerId);
+    discardFogSwap();
+
     // Report memory release if we have cached images
-    if (!m_cachedImage.isNull()) {
-        MemoryManager::instance().reportImageReleased(m_cachedImage);
+    if (!m_mapBuffer.isNull()) {
+        MemoryManager::instance().reportImageReleased(m_mapBuffer.image());
     }
 
-    // Clear cached scene reference
-    m_cachedScene.reset();
+    m_retainedScene.reset();
 }
 
 bool MapSession::loadImage()
 {
-    QFileInfo fileInfo(m_filePath);
-    if (!fileInfo.exists() || !fileInfo.isReadable() || fileInfo.size() == 0) {
-        return false;
-    }
-
-    // Check if we need to reload (file modified or no cache or memory was released)
-    QDateTime currentModified = fileInfo.lastModified();
-    if (!m_cachedImage.isNull() && m_fileLastModified == currentModified && !m_memoryReleased) {
+    if (!needsImageLoad()) {
         // Cache is valid, no need to reload
         return true;
     }
@@ -56,30 +91,44 @@ bool MapSession::loadImage()
     // Cache is invalid or doesn't exist, load from file
     DebugConsole::info(QString("Loading image from file (cache miss): %1").arg(m_filePath), "Session");
 
-    if (VTTLoader::isVTTFile(m_filePath)) {
-        // Load VTT file
-        m_cachedVTTData = VTTLoader::loadVTT(m_filePath);
-        if (m_cachedVTTData.mapImage.isNull()) {
-            DebugConsole::error(QString("Failed to load VTT file: %1").arg(m_cachedVTTData.errorMessage), "Session");
-            return false;
-        }
-        m_cachedImage = m_cachedVTTData.mapImage;
-    } else {
-        // Load regular image
-        m_cachedImage = QImage(m_filePath);
-        if (m_cachedImage.isNull()) {
-            DebugConsole::error(QString("Failed to load image: %1").arg(m_filePath), "Session");
-            return false;
-        }
-        // Reset VTT data for non-VTT files
-        m_cachedVTTData = VTTLoader::VTTData();
+    // Synchronous fallback - TabsController normally loads through MapLoadPipeline
+    return adoptLoadResult(MapLoadPipeline::loadFile(m_filePath));
+}
+
+bool MapSession::needsImageLoad() const
+{
+    if (m_mapBuffer.isNull() || m_memoryReleased) {
+        return true;
     }
 
-    m_fileLastModified = currentModified;
+    // Reload if the file was modified on disk
+    QFileInfo fileInfo(m_filePath);
+    return fileInfo.lastModified() != m_fileLastModified;
+}
+
+bool MapSession::adoptLoadResult(const MapLoadPipeline::Result& result)
+{
+    if (!result.isValid()) {
+        DebugConsole::error(QString("Failed to load map: %1 (%2)").arg(m_filePath, result.errorMessage), "Session");
+        return false;
+    }
+
+    if (!m_mapBuffer.isNull()) {
+        MemoryManager::instance().reportImageReleased(m_mapBuffer.image());
+    }
+
+    // A parked scene shows the previous pixels
+    dropRetainedScene();
+
+    // The buffer is the one holder of the pixels; VTTData keeps the rest
+    m_mapBuffer = MapBuffer(result.image, m_filePath);
+    m_cachedVTTData = result.vttData;  // Default-constructed for non-VTT files
+    m_cachedVTTData.mapImage = QImage();
+    m_fileLastModified = result.lastModified;
     m_memoryReleased = false;  // Mark that we have the image in memory
 
     // Report memory usage to the manager
-    MemoryManager::instance().reportImageLoaded(m_cachedImage);
+    MemoryManager::instance().reportImageLoaded(m_mapBuffer.image());
 
     DebugConsole::info("Image loaded and cached successfully", "Session");
     return true;
@@ -90,6 +139,9 @@ bool MapSession::loadImage()
 void MapSession::activateSession(MapDisplay* mapDisplay)
 {
     DebugConsole::info(QString("Activating session for file: %1").arg(m_filePath), "Session");
+    QElapsedTimer wakeTimer;
+    wakeTimer.start();
+    const bool waking = m_memoryReleased;
 
     if (!mapDisplay) {
         DebugConsole::error("mapDisplay is null!", "Session");
@@ -102,22 +154,35 @@ void MapSession::activateSession(MapDisplay* mapDisplay)
         return;
     }
 
-    // TODO: Scene caching disabled for stability - just use image caching for now
-    // This still provides significant performance improvement over full file reload
-
-    // Cache miss or scene cache invalid, but we have image cache - use fast loading
-    DebugConsole::performance("Loading from image cache (medium speed path)", "Session");
-    bool success = mapDisplay->loadImageFromCache(m_cachedImage, m_cachedVTTData);
-    if (!success) {
-        DebugConsole::error("Failed to load from cache!", "Session");
-        return;
+    // Fast path: the scene this tab left behind, with its live fog, effects
+    // and view position, goes straight back onto the display
+    const bool restored = m_retainedScene && mapDisplay->attachScene(m_retainedScene);
+    if (restored) {
+        DebugConsole::performance(QString("Restored retained scene of %1 in %2 ms")
+            .arg(m_fileName).arg(wakeTimer.elapsed()), "Session");
+    } else {
+        // Scene was not kept (or was given back to the budget) - rebuild from the image
+        dropRetainedScene();
+        DebugConsole::performance("Loading from image cache (medium speed path)", "Session");
+        bool success = mapDisplay->loadImageFromCache(m_mapBuffer, m_cachedVTTData);
+        if (!success) {
+            DebugConsole::error("Failed to load from cache!", "Session");
+            return;
+        }
     }
 
     m_isActive = true;
+    MemoryManager::instance().touchConsumer(m_memoryConsumerId);
+    MemoryManager::instance().touchConsumer(m_sceneConsumerId);
 
     mapDisplay->setGridEnabled(m_gridEnabled);
     mapDisplay->setFogEnabled(m_fogEnabled);
 
+    if (restored) {
+        // Calibration, view and fog are all still in place
+        return;
+    }
+
     // Load and apply per-map grid calibration if available
     if (hasGridCalibration()) {
         double tvSize, viewingDistance;
@@ -142,7 +207,10 @@ void MapSession::activateSession(MapDisplay* mapDisplay)
     loadFogState(mapDisplay);
     // Manual lights removed - only basic ambient lighting now
 
-    // TODO: Scene caching disabled for stability - image caching provides the main benefit
+    if (waking) {
+        DebugConsole::performance(QString("Woke %1 from hibernation in %2 ms")
+            .arg(m_fileName).arg(wakeTimer.elapsed()), "Memory");
+    }
 }
 
 void MapSession::deactivateSession(MapDisplay* mapDisplay)
@@ -151,10 +219,20 @@ void MapSession::deactivateSession(MapDisplay* mapDisplay)
         return;
     }
 
+    // Nothing on the display belongs to an inactive session
+    if (!m_isActive) {
+        return;
+    }
     m_isActive = false;
 
-    // Save state for restoration (scene caching disabled for stability)
-    saveFogState(mapDisplay);
+    // Park the built scene unless memory is already tight; its fog overlay
+    // then stays live and there is nothing to serialize
+    if (!MemoryManager::instance().isUnderMemoryPressure()) {
+        m_retainedScene = mapDisplay->detachScene();
+    }
+    if (!m_retainedScene) {
+        saveFogState(mapDisplay);
+    }
     // Manual lights removed - only basic ambient lighting now
 
     // Memory optimization: Release image memory for inactive tabs
@@ -167,117 +245,280 @@ void MapSession::deactivateSession(MapDisplay* mapDisplay)
     }
 }
 
-void MapSession::saveFogState(MapDisplay* mapDisplay)
+void MapSession::invalidateCache()
 {
-    if (!mapDisplay) {
+    dropRetainedScene();
+    m_mapBuffer = MapBuffer();
+    m_cachedVTTData = VTTLoader::VTTData();
+}
+
+void MapSession::dropRetainedScene()
+{
+    if (!m_retainedScene) {
         return;
     }
 
-    // Memory optimization: Compress fog state for inactive tabs
-    QByteArray uncompressed = mapDisplay->saveFogState();
-    if (!uncompressed.isEmpty()) {
-        m_savedFogState = qCompress(uncompressed, 9);  // Max compression
-        DebugConsole::performance(QString("Compressed fog state from %1 to %2 bytes")
-            .arg(uncompressed.size()).arg(m_savedFogState.size()), "Memory");
-    } else {
-        m_savedFogState.clear();
+    // The parked fog overlay holds the only copy of this tab's fog
+    if (FogOfWar* fog = m_retainedScene->contents.fogOverlay) {
+        storeFogState(fog->snapshot());
     }
+    m_retainedScene.reset();
+    DebugConsole::performance(QString("Dropped retained scene of %1").arg(m_fileName), "Memory");
 }
 
-void MapSession::loadFogState(MapDisplay* mapDisplay)
+MapSession::Tier MapSession::tier() const
 {
-    if (!mapDisplay || m_savedFogState.isEmpty()) {
+    if (!m_memoryReleased) {
+        return Tier::Hot;
+    }
+    return m_pixelsHibernated && m_pixelsHibernated->load() ? Tier::Warm : Tier::Cold;
+}
+
+void MapSession::demote(Tier target)
+{
+    if (m_isActive || target <= tier()) {
         return;
     }
 
-    // Decompress fog state if it was compressed
-    QByteArray fogData = m_savedFogState;
-    if (fogData.size() >= 4) {
-        // Check if data is compressed (Qt compression adds a 4-byte header)
-        QByteArray header = fogData.left(4);
-        if (header[0] == 'q' && header[1] == 'c' && header[2] == 'd' && header[3] == 'a') {
-            // Data is compressed, decompress it
-            fogData = qUncompress(m_savedFogState);
-            if (fogData.isEmpty()) {
-                DebugConsole::error("Failed to decompress fog state", "Memory");
-                return;
-            }
-        }
+    if (m_memoryReleased) {
+        // Warm to cold: the cache entry ages out of DecodedMapCache on its own
+        m_pixelsHibernated.reset();
+        return;
     }
+    releaseImageMemory(target == Tier::Warm);
+}
 
-    mapDisplay->loadFogState(fogData);
+void MapSession::restoreFromManifest(const SessionManifest::Tab& tab)
+{
+    m_zoomLevel = tab.zoomLevel;
+    m_viewCenter = tab.viewCenter;
+    m_gridEnabled = tab.gridEnabled;
+    m_fogEnabled = tab.fogEnabled;
+    m_fogSidecarPath = tab.fogSidecar;
+    m_memoryReleased = true;
+    m_pixelsHibernated.reset();
 }
 
-void MapSession::initializeFogPath()
+SessionManifest::Tab MapSession::manifestEntry() const
 {
-    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir().mkpath(dataDir);
+    SessionManifest::Tab tab;
+    tab.filePath = m_filePath;
+    tab.zoomLevel = m_zoomLevel;
+    tab.viewCenter = m_viewCenter;
+    tab.gridEnabled = m_gridEnabled;
+    tab.fogEnabled = m_fogEnabled;
+    const QString sidecar = m_filePath + QStringLiteral(".fog");
+    if (QFileInfo::exists(sidecar)) {
+        tab.fogSidecar = sidecar;
+    }
+    return tab;
+}
 
-    QCryptographicHash hash(QCryptographicHash::Md5);
-    hash.addData(m_filePath.toUtf8());
-    QString hashString = hash.result().toHex();
+void MapSession::releaseImageMemory(bool hibernatePixels)
+{
+    // The scene shares the pixels, so it has to go first
+    dropRetainedScene();
 
-    m_fogFilePath = dataDir + QDir::separator() + hashString + "_fog.dat";
+    if (!m_mapBuffer.isNull()) {
+        m_pixelsHibernated = hibernatePixels ? hibernateImage() : nullptr;
+        MemoryManager::instance().reportImageReleased(m_mapBuffer.image());
+    }
+    m_mapBuffer = MapBuffer();
+    // Clear VTT data except essential grid info
+    if (m_cachedVTTData.isValid) {
+        int gridSize = m_cachedVTTData.pixelsPerGrid;
+        m_cachedVTTData = VTTLoader::VTTData();
+        m_cachedVTTData.pixelsPerGrid = gridSize;  // Keep grid size for restoration
+        m_cachedVTTData.isValid = true;
+    }
+    hibernateFogState();
+    m_memoryReleased = true;
 }
 
+std::shared_ptr<std::atomic<bool>> MapSession::hibernateImage()
+{
+    // Pixels of a file that changed on disk would be cached under the new key
+    const QFileInfo fileInfo(m_filePath);
+    if (fileInfo.lastModified() != m_fileLastModified) {
+        return nullptr;
+    }
+    // The cache would refuse it; the tab goes cold instead
+    if (!DecodedMapCache::instance().fits(m_mapBuffer.sizeInBytes())) {
+        return nullptr;
+    }
 
-void MapSession::cacheCurrentScene(MapDisplay* mapDisplay)
+    // Usually already there (slow decodes are cached on load, and a mapped
+    // entry is its own backing) - otherwise write it now, whatever the
+    // decode cost was. The closure holds the pixels until the write ends.
+    const QImage image = m_mapBuffer.image();
+    const VTTLoader::VTTData vttData = m_cachedVTTData;
+    const QString fileName = m_fileName;
+    // Warm only once the entry is really there: a failed write leaves the tab cold
+    auto stored = std::make_shared<std::atomic<bool>>(false);
+    QThreadPool::globalInstance()->start([fileInfo, image, vttData, fileName, stored]() {
+        DecodedMapCache& cache = DecodedMapCache::instance();
+        if (cache.contains(fileInfo)) {
+            stored->store(true);
+        } else if (cache.store(fileInfo, image, vttData)) {
+            stored->store(true);
+            DebugConsole::performance(QString("Hibernated pixels of %1 to the decoded map cache")
+                .arg(fileName), "Memory");
+        }
+    });
+    return stored;
+}
+
+void MapSession::hibernateFogState()
 {
-    if (!mapDisplay) {
+    if (m_savedFogState.isNull()) {
         return;
     }
 
-    QGraphicsScene* scene = mapDisplay->scene();
-    if (!scene) {
-        m_sceneCached = false;
+    discardFogSwap();
+    auto swap = std::make_shared<FogSwap>();
+    swap->pending = m_savedFogState;
+    m_fogSwap = swap;
+    m_savedFogState = FogSnapshot();
+
+    const QString path = m_fogSwapPath;
+    QThreadPool::globalInstance()->start([swap, path]() {
+        FogSnapshot snapshot;
+        {
+            QMutexLocker locker(&swap->mutex);
+            if (swap->abandoned) {
+                return;
+            }
+            snapshot = swap->pending;
+        }
+        const QByteArray data = snapshot.serialize();
+
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QSaveFile file(path);
+        const bool written = file.open(QIODevice::WriteOnly) &&
+                             file.write(data) == data.size() && file.commit();
+
+        QMutexLocker locker(&swap->mutex);
+        if (swap->abandoned) {
+            QFile::remove(path);
+        } else if (written) {
+            swap->pending = FogSnapshot();
+            swap->onDisk = true;
+        }
+        // On failure the state simply stays in memory
+    });
+}
+
+void MapSession::restoreFogState()
+{
+    if (!m_fogSwap) {
         return;
     }
 
-    try {
-        // Create a shared pointer to the current scene for caching
-        // Note: We need to be careful here - we're sharing ownership of the scene
-        // The scene should not be deleted while cached
-        m_cachedScene = std::shared_ptr<QGraphicsScene>(scene, [](QGraphicsScene*) {
-            // Custom deleter that does nothing - the scene is managed elsewhere
-            // This prevents double deletion
-        });
+    {
+        QMutexLocker locker(&m_fogSwap->mutex);
+        if (!m_fogSwap->pending.isNull()) {
+            m_savedFogState = m_fogSwap->pending;
+        } else if (m_fogSwap->onDisk) {
+            QFile file(m_fogSwapPath);
+            if (file.open(QIODevice::ReadOnly)) {
+                m_savedFogState = FogSnapshot::deserialize(file.readAll());
+            } else {
+                DebugConsole::error(QString("Failed to read fog swap for %1").arg(m_fileName), "Memory");
+            }
+        }
+    }
+    discardFogSwap();
+}
+
+void MapSession::discardFogSwap()
+{
+    if (!m_fogSwap) {
+        return;
+    }
 
-        m_sceneCached = true;
-        DebugConsole::performance(QString("Scene cached successfully for %1").arg(m_fileName), "Session");
-    } catch (const std::exception& e) {
-        DebugConsole::error(QString("Failed to cache scene: %1").arg(e.what()), "Session");
-        m_sceneCached = false;
+    QMutexLocker locker(&m_fogSwap->mutex);
+    m_fogSwap->abandoned = true;
+    if (m_fogSwap->onDisk) {
+        QFile::remove(m_fogSwapPath);
     }
+    locker.unlock();
+    m_fogSwap.reset();
 }
 
-bool MapSession::restoreCachedScene(MapDisplay* mapDisplay)
+void MapSession::saveFogState(MapDisplay* mapDisplay)
 {
-    if (!mapDisplay || !m_sceneCached) {
-        return false;
+    if (!mapDisplay) {
+        return;
     }
 
-    // Check if we have a cached scene to restore
-    if (!m_cachedScene || m_cachedImage.isNull()) {
-        DebugConsole::warning("Scene cache invalid - no cached scene or image", "Session");
-        return false;
+    QElapsedTimer timer;
+    timer.start();
+    storeFogState(mapDisplay->saveFogSnapshot());
+    if (!m_savedFogState.isNull()) {
+        DebugConsole::performance(QString("Packed fog of %1 into %2 KB (%3 mixed tiles) in %4 ms")
+            .arg(m_fileName)
+            .arg(m_savedFogState.sizeInBytes() / 1024)
+            .arg(m_savedFogState.mixedTiles())
+            .arg(timer.elapsed()), "Memory");
     }
+}
 
-    try {
-        // Restore the scene directly
-        mapDisplay->setScene(m_cachedScene.get());
+void MapSession::storeFogState(const FogSnapshot& snapshot)
+{
+    // A fresh save supersedes whatever was swapped out
+    discardFogSwap();
+    m_savedFogState = snapshot;
+}
 
-        // Update the current map reference
-        mapDisplay->setCachedImage(m_cachedImage);
+void MapSession::loadFogState(MapDisplay* mapDisplay)
+{
+    restoreFogState();
 
-        DebugConsole::performance("Scene successfully restored from cache", "Session");
-        return true;
-    } catch (const std::exception& e) {
-        DebugConsole::error(QString("Failed to restore cached scene: %1").arg(e.what()), "Session");
-        m_sceneCached = false;
-        return false;
+    if (!mapDisplay) {
+        return;
     }
+
+    // A tab restored from the last launch has only its autosaved fog
+    if (m_savedFogState.isNull() && !m_fogSidecarPath.isEmpty()) {
+        QFile sidecar(m_fogSidecarPath);
+        m_fogSidecarPath.clear();
+        if (sidecar.open(QIODevice::ReadOnly)) {
+            mapDisplay->loadFogState(sidecar.readAll());
+        }
+        return;
+    }
+
+    if (m_savedFogState.isNull()) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    if (!mapDisplay->loadFogSnapshot(m_savedFogState)) {
+        DebugConsole::error(QString("Failed to restore fog of %1").arg(m_fileName), "Memory");
+        return;
+    }
+    DebugConsole::performance(QString("Restored fog of %1 in %2 ms")
+        .arg(m_fileName).arg(timer.elapsed()), "Memory");
+}
+
+void MapSession::initializeFogPath()
+{
+    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(m_filePath.toUtf8());
+    QString hashString = hash.result().toHex();
+
+    m_fogFilePath = dataDir + QDir::separator() + hashString + "_fog.dat";
+
+    // Disposable, so it lives with the other caches
+    m_fogSwapPath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+                    "/hibernation/" + hashString + ".fog";
 }
 
+
 // Grid calibration persistence methods
 void MapSession::saveGridCalibration(double tvSize, double viewingDistance, int gridSize, const QPointF& gridOffset)
 {
@@ -6,13 +6,17 @@
 #include <QPointF>
 #include <QByteArray>
 #include <QList>
-#include <QPixmap>
 #include <QDateTime>
+#include <atomic>
 #include <memory>
 #include "utils/VTTLoader.h"
+#include "utils/MapLoadPipeline.h"
+#include "utils/MapBuffer.h"
+#include "utils/SessionManifest.h"
+#include "graphics/FogSnapshot.h"
 
 class MapDisplay;
-class QGraphicsScene;
+struct RetainedScene;
 
 class MapSession
 {
@@ -22,11 +26,19 @@ public:
 
     const QString& filePath() const { return m_filePath; }
     const QString& fileName() const { return m_fileName; }
-    const QImage& image() const { return m_cachedImage; }  // Return cached image
+    const QImage& image() const { return m_mapBuffer.image(); }  // Return cached image
+    const MapBuffer& mapBuffer() const { return m_mapBuffer; }
     
     bool loadImage();
+
+    // True when activateSession() would have to read the file again
+    bool needsImageLoad() const;
+
+    // Take the image decoded by MapLoadPipeline instead of loading synchronously
+    bool adoptLoadResult(const MapLoadPipeline::Result& result);
     void activateSession(MapDisplay* mapDisplay);
     void deactivateSession(MapDisplay* mapDisplay);
+    bool isActive() const { return m_isActive; }
     
     void setGridEnabled(bool enabled) { m_gridEnabled = enabled; }
     bool isGridEnabled() const { return m_gridEnabled; }
@@ -49,29 +61,34 @@ public:
     void loadFogState(MapDisplay* mapDisplay);
 
 
-    // Image and scene caching for performance
-    bool hasImageCache() const { return !m_cachedImage.isNull(); }
-    bool hasSceneCache() const { return m_sceneCached; }
-    void invalidateCache() {
-        m_sceneCached = false;
-        m_cachedPixmap = QPixmap();
-        m_cachedImage = QImage();
-        m_cachedVTTData = VTTLoader::VTTData();
-    }
-
-    // Memory optimization: release image memory for inactive tabs
-    void releaseImageMemory() {
-        m_cachedImage = QImage();
-        m_cachedPixmap = QPixmap();
-        // Clear VTT data except essential grid info
-        if (m_cachedVTTData.isValid) {
-            int gridSize = m_cachedVTTData.pixelsPerGrid;
-            m_cachedVTTData = VTTLoader::VTTData();
-            m_cachedVTTData.pixelsPerGrid = gridSize;  // Keep grid size for restoration
-            m_cachedVTTData.isValid = true;
-        }
-        m_memoryReleased = true;
-    }
+    // Image and scene caching for performance. While inactive the session
+    // keeps its fully built scene, so switching back swaps it onto the
+    // display instead of rebuilding; the memory budget may take it back.
+    bool hasImageCache() const { return !m_mapBuffer.isNull(); }
+    bool hasSceneCache() const { return m_retainedScene != nullptr; }
+    void invalidateCache();
+
+    // Memory optimization: hibernate an inactive tab. The decoded pixels
+    // are made sure to be in DecodedMapCache, so reactivation maps them back
+    // in instead of decoding, and the saved fog state moves to a swap file.
+    // Both writes run on the global thread pool. Without hibernatePixels
+    // nothing is written to the decoded map cache.
+    void releaseImageMemory(bool hibernatePixels = true);
+    bool isHibernated() const { return m_memoryReleased; }
+
+    // Residency of an inactive tab in a large campaign. Hot keeps the
+    // pixels (and the built scene), Warm has them hibernated to the decoded
+    // map cache (once the write has succeeded; maps over the cache's entry
+    // limit never are), Cold keeps metadata only - path, view, grid and fog
+    // settings, fog swap - and decodes the source file again on activation.
+    enum class Tier { Hot, Warm, Cold };
+    Tier tier() const;
+    void demote(Tier target);
+
+    // Session restore: a tab from the last launch starts cold, with its
+    // view and fog sidecar applied when it is first activated
+    void restoreFromManifest(const SessionManifest::Tab& tab);
+    SessionManifest::Tab manifestEntry() const;
 
 private:
     QString m_filePath;
@@ -79,10 +96,14 @@ private:
     // QImage m_image;  // REMOVED - deprecated, was wasting memory
 
     // Cached data for fast tab switching
-    QImage m_cachedImage;
+    MapBuffer m_mapBuffer;
     VTTLoader::VTTData m_cachedVTTData;
     QDateTime m_fileLastModified;
     bool m_memoryReleased = false;  // Track if memory was released for inactive tab
+    // Set by the hibernation write once the released pixels are in
+    // DecodedMapCache; null when they were not handed over
+    std::shared_ptr<std::atomic<bool>> m_pixelsHibernated;
+    int m_memoryConsumerId = 0;     // MemoryManager registration for the image
 
     bool m_gridEnabled;
     bool m_fogEnabled;
@@ -91,17 +112,25 @@ private:
 
     bool m_isActive;
     QString m_fogFilePath;
-    QByteArray m_savedFogState;
-
+    FogSnapshot m_savedFogState;
+    QString m_fogSidecarPath;  // Restored tab's autosaved fog, read on first activation
+
+    // Fog state of a hibernated tab, in memory until its swap file is written
+    struct FogSwap;
+    std::shared_ptr<FogSwap> m_fogSwap;
+    QString m_fogSwapPath;
+    std::shared_ptr<std::atomic<bool>> hibernateImage();
+    void hibernateFogState();
+    void restoreFogState();
+    void discardFogSwap();
+    void storeFogState(const FogSnapshot& snapshot);
 
     // Scene caching for fast tab switching
-    bool m_sceneCached;
-    QPixmap m_cachedPixmap;
-    std::shared_ptr<QGraphicsScene> m_cachedScene;
+    std::unique_ptr<RetainedScene> m_retainedScene;
+    int m_sceneConsumerId = 0;  // MemoryManager registration for the retained scene
+    void dropRetainedScene();
 
     void initializeFogPath();
-    void cacheCurrentScene(MapDisplay* mapDisplay);
-    bool restoreCachedScene(MapDisplay* mapDisplay);
 };
 
 #endif // MAPSESSION_H
\ No newline at end of file
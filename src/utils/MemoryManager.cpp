@@ -1,5 +1,23 @@
 #include "MemoryManager.h"
 #include "DebugConsole.h"
+#include "MapBuffer.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QTimer>
+#include <QVector>
+#include <algorithm>
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#if defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#endif
 
 MemoryManager& MemoryManager::instance()
 {
@@ -9,48 +27,139 @@ MemoryManager& MemoryManager::instance()
 
 MemoryManager::MemoryManager()
     : QObject(nullptr)
+    , m_maxMemoryLimit(defaultMemoryLimit())
+{
+    // Loader threads query the budget and may be first to get here - the
+    // pressure signals still have to come from the GUI thread
+    if (QCoreApplication::instance() && thread() != QCoreApplication::instance()->thread()) {
+        moveToThread(QCoreApplication::instance()->thread());
+    }
+}
+
+int MemoryManager::registerConsumer(const QString& name, SizeFunction size, EvictFunction evict)
 {
+    QMutexLocker locker(&m_consumerMutex);
+    Consumer consumer;
+    consumer.id = m_nextConsumerId++;
+    consumer.name = name;
+    consumer.size = std::move(size);
+    consumer.evict = std::move(evict);
+    consumer.lastUsed = ++m_useCounter;
+    m_consumers.append(consumer);
+    return consumer.id;
+}
+
+void MemoryManager::unregisterConsumer(int id)
+{
+    QMutexLocker locker(&m_consumerMutex);
+    m_consumers.removeIf([id](const Consumer& consumer) { return consumer.id == id; });
+}
+
+void MemoryManager::touchConsumer(int id)
+{
+    QMutexLocker locker(&m_consumerMutex);
+    for (Consumer& consumer : m_consumers) {
+        if (consumer.id == id) {
+            consumer.lastUsed = ++m_useCounter;
+            return;
+        }
+    }
 }
 
 void MemoryManager::reportImageLoaded(const QImage& image)
 {
-    if (image.isNull()) return;
+    // File-backed pixels are page cache the OS reclaims by itself
+    if (image.isNull() || MapBuffer::isMapped(image)) return;
 
     qint64 imageMemory = calculateImageMemory(image);
-    qint64 oldUsage = m_currentMemoryUsage.fetch_add(imageMemory);
-    qint64 newUsage = oldUsage + imageMemory;
+    qint64 newUsage = m_currentMemoryUsage.fetch_add(imageMemory) + imageMemory;
 
-    DebugConsole::performance(QString("Image loaded: +%1 KB (Total: %2 MB / %3 MB)")
+    DebugConsole::performance(QString("Image loaded: +%1 KB (Maps: %2 MB, process: %3 MB / %4 MB)")
         .arg(imageMemory / 1024)
         .arg(newUsage / (1024 * 1024))
+        .arg(m_sampledUsage / (1024 * 1024))
         .arg(m_maxMemoryLimit / (1024 * 1024)), "Memory");
 
-    if (isUnderMemoryPressure() && oldUsage < (m_maxMemoryLimit * PRESSURE_THRESHOLD)) {
-        emit memoryPressureDetected();
-    }
+    scheduleEnforcement();
 }
 
 void MemoryManager::reportImageReleased(const QImage& image)
 {
-    if (image.isNull()) return;
+    if (image.isNull() || MapBuffer::isMapped(image)) return;
 
     qint64 imageMemory = calculateImageMemory(image);
-    qint64 oldUsage = m_currentMemoryUsage.fetch_sub(imageMemory);
-    qint64 newUsage = oldUsage - imageMemory;
+    qint64 newUsage = m_currentMemoryUsage.fetch_sub(imageMemory) - imageMemory;
 
-    DebugConsole::performance(QString("Image released: -%1 KB (Total: %2 MB / %3 MB)")
+    DebugConsole::performance(QString("Image released: -%1 KB (Maps: %2 MB / %3 MB)")
         .arg(imageMemory / 1024)
         .arg(newUsage / (1024 * 1024))
         .arg(m_maxMemoryLimit / (1024 * 1024)), "Memory");
+}
 
-    if (!isUnderMemoryPressure() && oldUsage >= (m_maxMemoryLimit * PRESSURE_THRESHOLD)) {
-        emit memoryPressureRelieved();
-    }
+qint64 MemoryManager::getCurrentMemoryUsage() const
+{
+    return m_sampledUsage;
 }
 
 bool MemoryManager::isUnderMemoryPressure() const
 {
-    return m_currentMemoryUsage >= (m_maxMemoryLimit * PRESSURE_THRESHOLD);
+    return m_sampledUsage >= (m_maxMemoryLimit * PRESSURE_THRESHOLD);
+}
+
+qint64 MemoryManager::accountedBytes() const
+{
+    QList<Consumer> consumers;
+    {
+        QMutexLocker locker(&m_consumerMutex);
+        consumers = m_consumers;
+    }
+
+    qint64 total = 0;
+    for (const Consumer& consumer : consumers) {
+        total += qMax<qint64>(0, consumer.size());
+    }
+    return total;
+}
+
+qint64 MemoryManager::residentBytes()
+{
+#if defined(Q_OS_LINUX)
+    // size resident shared ... in pages; shared pages are file-backed
+    // (mapped map caches, libraries) and reclaimable, so they don't count
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 3) {
+        return -1;
+    }
+    const qint64 pageSize = sysconf(_SC_PAGESIZE);
+    return (fields.at(1).toLongLong() - fields.at(2).toLongLong()) * pageSize;
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return -1;
+    }
+    return qint64(info.resident_size);
+#else
+    return -1;
+#endif
+}
+
+qint64 MemoryManager::physicalMemoryBytes()
+{
+#if defined(Q_OS_WIN)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    return GlobalMemoryStatusEx(&status) ? qint64(status.ullTotalPhys) : -1;
+#else
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    return (pages > 0 && pageSize > 0) ? qint64(pages) * pageSize : -1;
+#endif
 }
 
 bool MemoryManager::shouldCompressImage(const QImage& image) const
@@ -65,7 +174,136 @@ bool MemoryManager::shouldCompressImage(const QImage& image) const
 bool MemoryManager::shouldReleaseInactiveTabs() const
 {
     // Release inactive tabs when we're using more than 95% of limit
-    return m_currentMemoryUsage >= (m_maxMemoryLimit * RELEASE_THRESHOLD);
+    return m_sampledUsage >= (m_maxMemoryLimit * RELEASE_THRESHOLD);
+}
+
+void MemoryManager::setMaxMemoryLimit(qint64 bytes)
+{
+    m_maxMemoryLimit = bytes > 0 ? bytes : defaultMemoryLimit();
+    DebugConsole::info(QString("MemoryManager: budget %1 MB").arg(m_maxMemoryLimit / (1024 * 1024)), "Memory");
+    emit memoryLimitChanged(m_maxMemoryLimit);
+    scheduleEnforcement();
+}
+
+qint64 MemoryManager::defaultMemoryLimit()
+{
+    const qint64 physical = physicalMemoryBytes();
+    return physical > 0 ? qint64(physical * DEFAULT_LIMIT_FRACTION) : FALLBACK_LIMIT;
+}
+
+void MemoryManager::startBudgetMonitor(int intervalMs)
+{
+    if (!m_monitorTimer) {
+        m_monitorTimer = new QTimer(this);
+        connect(m_monitorTimer, &QTimer::timeout, this, &MemoryManager::enforceBudget);
+    }
+    m_monitorTimer->start(intervalMs);
+    enforceBudget();
+}
+
+void MemoryManager::scheduleEnforcement()
+{
+    // Callable from loader threads; eviction itself runs on the GUI thread
+    if (!m_enforcementQueued.exchange(true)) {
+        QMetaObject::invokeMethod(this, &MemoryManager::enforceBudget, Qt::QueuedConnection);
+    }
+}
+
+qint64 MemoryManager::sampleUsage()
+{
+    const qint64 resident = residentBytes();
+    const qint64 usage = resident >= 0 ? resident : accountedBytes();
+    m_sampledUsage = usage;
+    return usage;
+}
+
+void MemoryManager::updatePressure(qint64 usage)
+{
+    const bool underPressure = usage >= (m_maxMemoryLimit * PRESSURE_THRESHOLD);
+    if (m_underPressure.exchange(underPressure) == underPressure) {
+        return;
+    }
+    if (underPressure) {
+        emit memoryPressureDetected();
+    } else {
+        emit memoryPressureRelieved();
+    }
+}
+
+void MemoryManager::enforceBudget()
+{
+    m_enforcementQueued = false;
+
+    const qint64 limit = m_maxMemoryLimit;
+    const qint64 usage = sampleUsage();
+    if (usage < limit * PRESSURE_THRESHOLD) {
+        updatePressure(usage);
+        return;
+    }
+
+    struct Candidate {
+        int id;
+        QString name;
+        qint64 lastUsed;
+        qint64 bytes;
+    };
+    QVector<Candidate> candidates;
+    QList<Consumer> consumers;
+    {
+        QMutexLocker locker(&m_consumerMutex);
+        consumers = m_consumers;
+    }
+    for (const Consumer& consumer : consumers) {
+        const qint64 bytes = consumer.size();
+        if (bytes > 0) {
+            candidates.append({ consumer.id, consumer.name, consumer.lastUsed, bytes });
+        }
+    }
+
+    // Stalest first; among equally stale consumers the largest goes first
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        return a.lastUsed != b.lastUsed ? a.lastUsed < b.lastUsed : a.bytes > b.bytes;
+    });
+
+    qint64 toFree = usage - qint64(limit * TARGET_THRESHOLD);
+    qint64 totalFreed = 0;
+    for (const Candidate& candidate : candidates) {
+        if (toFree <= 0) {
+            break;
+        }
+
+        // An earlier eviction may have destroyed this consumer
+        EvictFunction evict;
+        {
+            QMutexLocker locker(&m_consumerMutex);
+            for (const Consumer& consumer : m_consumers) {
+                if (consumer.id == candidate.id) {
+                    evict = consumer.evict;
+                    break;
+                }
+            }
+        }
+        if (!evict) {
+            continue;
+        }
+
+        const qint64 freed = evict(qMin(toFree, candidate.bytes));
+        if (freed > 0) {
+            toFree -= freed;
+            totalFreed += freed;
+            DebugConsole::performance(QString("MemoryManager: evicted %1 MB from %2")
+                .arg(freed / (1024.0 * 1024.0), 0, 'f', 1)
+                .arg(candidate.name), "Memory");
+        }
+    }
+
+    const qint64 after = sampleUsage();
+    DebugConsole::performance(QString("MemoryManager: over budget at %1 MB, freed %2 MB (now %3 MB / %4 MB)")
+        .arg(usage / (1024 * 1024))
+        .arg(totalFreed / (1024 * 1024))
+        .arg(after / (1024 * 1024))
+        .arg(limit / (1024 * 1024)), "Memory");
+    updatePressure(after);
 }
 
 qint64 MemoryManager::calculateImageMemory(const QImage& image)
@@ -101,4 +339,4 @@ qint64 MemoryManager::calculateImageMemory(const QImage& image)
     // Include overhead for QImage structure and potential alignment
     qint64 overhead = 1024;  // Approximate overhead
     return (image.width() * image.height() * bytesPerPixel) + overhead;
-}
\ No newline at end of file
+}
@@ -3,8 +3,27 @@
 
 #include <QObject>
 #include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QString>
 #include <atomic>
+#include <functional>
 
+class QTimer;
+
+// Process-wide memory budget.
+//
+// Subsystems that hold recreatable memory (map images of inactive tabs,
+// prefetched maps, render caches, fog history, tile pixmaps) register as
+// consumers with a size callback and an eviction callback. The monitor
+// samples the process footprint - anonymous resident memory from
+// /proc/self/statm where available, the sum of registered consumers
+// otherwise - and when it crosses the pressure threshold, asks consumers
+// to free memory, least recently used first and largest first among
+// equally stale ones, until usage is back under the target.
+//
+// Consumers are registered, touched and evicted on the GUI thread; the
+// counters and the budget can be read from any thread.
 class MemoryManager : public QObject
 {
     Q_OBJECT
@@ -12,37 +31,86 @@ class MemoryManager : public QObject
 public:
     static MemoryManager& instance();
 
+    // Bytes currently held by a consumer
+    using SizeFunction = std::function<qint64()>;
+    // Free up to the requested bytes; returns what was actually freed
+    using EvictFunction = std::function<qint64(qint64 bytesWanted)>;
+
+    int registerConsumer(const QString& name, SizeFunction size, EvictFunction evict);
+    void unregisterConsumer(int id);
+    void touchConsumer(int id);  // Marks the consumer as recently used
+
     // Memory tracking
     void reportImageLoaded(const QImage& image);
     void reportImageReleased(const QImage& image);
-    qint64 getCurrentMemoryUsage() const { return m_currentMemoryUsage; }
+    qint64 getCurrentMemoryUsage() const;   // Last sampled process footprint
+    qint64 getMapImageUsage() const { return m_currentMemoryUsage; }
     qint64 getMaxMemoryLimit() const { return m_maxMemoryLimit; }
     bool isUnderMemoryPressure() const;
 
+    // Sum of the registered consumers' sizes
+    qint64 accountedBytes() const;
+
+    // Anonymous resident memory of this process; -1 where unsupported
+    static qint64 residentBytes();
+    static qint64 physicalMemoryBytes();
+
     // Memory optimization hints
     bool shouldCompressImage(const QImage& image) const;
     bool shouldReleaseInactiveTabs() const;
 
-    // Settings
-    void setMaxMemoryLimit(qint64 bytes) { m_maxMemoryLimit = bytes; }
+    // Settings; 0 picks the default share of physical memory
+    void setMaxMemoryLimit(qint64 bytes);
+    static qint64 defaultMemoryLimit();
+
+    // Periodic sampling and enforcement (GUI thread)
+    void startBudgetMonitor(int intervalMs = MONITOR_INTERVAL_MS);
+    void enforceBudget();
+
+    static constexpr int MONITOR_INTERVAL_MS = 2000;
 
 signals:
     void memoryPressureDetected();
     void memoryPressureRelieved();
+    void memoryLimitChanged(qint64 bytes);
 
 private:
     MemoryManager();
     ~MemoryManager() = default;
 
+    struct Consumer {
+        int id = 0;
+        QString name;
+        SizeFunction size;
+        EvictFunction evict;
+        qint64 lastUsed = 0;
+    };
+
     static qint64 calculateImageMemory(const QImage& image);
+    qint64 sampleUsage();
+    void updatePressure(qint64 usage);
+    void scheduleEnforcement();
+
+    mutable QMutex m_consumerMutex;
+    QList<Consumer> m_consumers;
+    int m_nextConsumerId = 1;
+    qint64 m_useCounter = 0;   // Monotonic LRU stamp
+
+    QTimer* m_monitorTimer = nullptr;
+    std::atomic<bool> m_enforcementQueued{false};
+    std::atomic<bool> m_underPressure{false};
 
-    std::atomic<qint64> m_currentMemoryUsage{0};
-    std::atomic<qint64> m_maxMemoryLimit{150 * 1024 * 1024};  // 150MB default limit
+    std::atomic<qint64> m_currentMemoryUsage{0};  // Reported map images
+    std::atomic<qint64> m_sampledUsage{0};
+    std::atomic<qint64> m_maxMemoryLimit{0};
 
     // Thresholds
     static constexpr double PRESSURE_THRESHOLD = 0.90;  // 90% of limit
     static constexpr double RELEASE_THRESHOLD = 0.95;   // 95% of limit
+    static constexpr double TARGET_THRESHOLD = 0.80;    // Evict down to 80%
+    static constexpr double DEFAULT_LIMIT_FRACTION = 0.5;  // Of physical memory
+    static constexpr qint64 FALLBACK_LIMIT = qint64(2) * 1024 * 1024 * 1024;
     static constexpr qint64 MIN_IMAGE_SIZE_TO_COMPRESS = 5 * 1024 * 1024;  // 5MB
 };
 
-#endif // MEMORYMANAGER_H
\ No newline at end of file
+#endif // MEMORYMANAGER_H
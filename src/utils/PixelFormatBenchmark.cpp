@@ -0,0 +1,165 @@
+#include "utils/PixelFormatBenchmark.h"
+#include "utils/ImageLoader.h"
+#include "utils/VTTLoader.h"
+#include "graphics/TiledMapItem.h"
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QPixmap>
+#include <QFileInfo>
+#include <QTextStream>
+
+namespace {
+
+QString formatName(QImage::Format format)
+{
+    switch (format) {
+    case QImage::Format_RGB32: return QStringLiteral("RGB32");
+    case QImage::Format_ARGB32: return QStringLiteral("ARGB32");
+    case QImage::Format_ARGB32_Premultiplied: return QStringLiteral("ARGB32_Premultiplied");
+    case QImage::Format_RGB888: return QStringLiteral("RGB888");
+    case QImage::Format_RGBX8888: return QStringLiteral("RGBX8888");
+    case QImage::Format_RGB16: return QStringLiteral("RGB16");
+    case QImage::Format_Indexed8: return QStringLiteral("Indexed8");
+    default: return QString("Format %1").arg(int(format));
+    }
+}
+
+double elapsedMs(const QElapsedTimer& timer)
+{
+    return timer.nsecsElapsed() / 1e6;
+}
+
+// Same view-into-the-rows upload TiledMapItem::tilePixmap() does
+double measureTileUpload(const QImage& image)
+{
+    const int tile = TiledMapItem::TILE_SIZE;
+    const int columns = qMax(1, image.width() / tile);
+    const int rows = qMax(1, image.height() / tile);
+    const int bytesPerPixel = image.depth() / 8;
+
+    int uploaded = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < PixelFormatBenchmark::SAMPLE_TILES; ++i) {
+        // Spread samples over the map so the numbers include cold rows
+        const int index = int(qint64(i) * columns * rows / PixelFormatBenchmark::SAMPLE_TILES);
+        const QRect rect = QRect((index % columns) * tile, (index / columns) * tile, tile, tile) & image.rect();
+        if (rect.isEmpty()) {
+            continue;
+        }
+        const QImage view(image.constScanLine(rect.y()) + rect.x() * bytesPerPixel,
+                          rect.width(), rect.height(), image.bytesPerLine(), image.format());
+        const QPixmap pixmap = QPixmap::fromImage(view);
+        Q_UNUSED(pixmap);
+        ++uploaded;
+    }
+    return uploaded > 0 ? elapsedMs(timer) / uploaded : 0.0;
+}
+
+// Raster viewport like the one QGraphicsView paints into
+double measureBlit(const QImage& image, qreal scale)
+{
+    QImage viewport(PixelFormatBenchmark::VIEWPORT_WIDTH, PixelFormatBenchmark::VIEWPORT_HEIGHT,
+                    QImage::Format_ARGB32_Premultiplied);
+    viewport.fill(Qt::black);
+    const QRectF source(0, 0, qMin<qreal>(image.width(), viewport.width() / scale),
+                        qMin<qreal>(image.height(), viewport.height() / scale));
+    const QRectF target(0, 0, source.width() * scale, source.height() * scale);
+
+    QPainter painter(&viewport);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, scale != 1.0);
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < PixelFormatBenchmark::SAMPLE_FRAMES; ++frame) {
+        painter.drawImage(target, image, source);
+    }
+    painter.end();
+    return elapsedMs(timer) / PixelFormatBenchmark::SAMPLE_FRAMES;
+}
+
+} // namespace
+
+PixelFormatBenchmark::Report PixelFormatBenchmark::run(const QString& mapPath)
+{
+    Report report;
+    report.filePath = mapPath;
+
+    QElapsedTimer timer;
+    timer.start();
+    QImage decoded;
+    if (VTTLoader::isVTTFile(mapPath)) {
+        VTTLoader::VTTData data = VTTLoader::loadVTT(mapPath);
+        decoded = data.mapImage;
+        report.errorMessage = data.errorMessage;
+    } else {
+        decoded = ImageLoader::readImage(mapPath, nullptr, &report.errorMessage);
+    }
+    report.loadMs = elapsedMs(timer);
+
+    if (decoded.isNull()) {
+        if (report.errorMessage.isEmpty()) {
+            report.errorMessage = QString("Failed to decode %1").arg(mapPath);
+        }
+        return report;
+    }
+    report.errorMessage.clear();
+    report.mapSize = decoded.size();
+    report.decodedFormat = decoded.format();
+    report.policyFormat = ImageLoader::displayFormat(decoded, ImageLoader::pixelFormatPolicy());
+
+    QList<QImage::Format> candidates = { QImage::Format_RGB32, QImage::Format_RGB888,
+                                         QImage::Format_ARGB32_Premultiplied };
+    if (decoded.hasAlphaChannel()) {
+        candidates = { QImage::Format_ARGB32_Premultiplied, QImage::Format_ARGB32 };
+    }
+
+    for (QImage::Format format : candidates) {
+        FormatResult result;
+        result.format = format;
+
+        timer.restart();
+        QImage converted = decoded.convertToFormat(format);
+        result.convertMs = elapsedMs(timer);
+        result.sizeMB = converted.sizeInBytes() / (1024.0 * 1024.0);
+
+        result.tileUploadMs = measureTileUpload(converted);
+        result.blitFullMs = measureBlit(converted, 1.0);
+        result.blitScaledMs = measureBlit(converted, 0.25);
+        report.formats.append(result);
+    }
+
+    return report;
+}
+
+QString PixelFormatBenchmark::Report::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+
+    out << "Pixel format benchmark: " << QFileInfo(filePath).fileName() << "\n";
+    if (!errorMessage.isEmpty()) {
+        out << "  error: " << errorMessage << "\n";
+        return text;
+    }
+
+    out << QString("  %1x%2, decoded as %3 in %4 ms\n")
+               .arg(mapSize.width()).arg(mapSize.height())
+               .arg(formatName(decodedFormat))
+               .arg(loadMs, 0, 'f', 1);
+    out << QString("  %1 %2 %3 %4 %5 %6\n")
+               .arg(QStringLiteral("format"), -22).arg(QStringLiteral("convert ms"), 11)
+               .arg(QStringLiteral("size MB"), 9).arg(QStringLiteral("tile ms"), 9)
+               .arg(QStringLiteral("blit 1:1"), 9).arg(QStringLiteral("blit 1:4"), 9);
+    for (const FormatResult& result : formats) {
+        out << QString("  %1 %2 %3 %4 %5 %6\n")
+                   .arg(formatName(result.format), -22)
+                   .arg(result.convertMs, 11, 'f', 1)
+                   .arg(result.sizeMB, 9, 'f', 1)
+                   .arg(result.tileUploadMs, 9, 'f', 3)
+                   .arg(result.blitFullMs, 9, 'f', 2)
+                   .arg(result.blitScaledMs, 9, 'f', 2);
+    }
+
+    out << QString("  current policy stores this map as %1\n").arg(formatName(policyFormat));
+    return text;
+}
@@ -0,0 +1,48 @@
+#ifndef PIXELFORMATBENCHMARK_H
+#define PIXELFORMATBENCHMARK_H
+
+#include <QString>
+#include <QImage>
+#include <QList>
+
+// Measures what each candidate map storage format costs, for choosing
+// ImageLoader::PixelFormatPolicy from data: decode, conversion from the
+// decoded format, resident size, tile upload (QPixmap::fromImage of
+// TiledMapItem-sized tiles) and blitting into a raster viewport at 1:1
+// and zoomed out. Needs a QGuiApplication; run with --benchmark-formats.
+class PixelFormatBenchmark
+{
+public:
+    struct FormatResult {
+        QImage::Format format = QImage::Format_Invalid;
+        double convertMs = 0.0;
+        double sizeMB = 0.0;
+        double tileUploadMs = 0.0;   // Per tile
+        double blitFullMs = 0.0;     // Per viewport frame at 1:1
+        double blitScaledMs = 0.0;   // Per viewport frame at 1:4
+    };
+
+    struct Report {
+        QString filePath;
+        QSize mapSize;
+        QImage::Format decodedFormat = QImage::Format_Invalid;
+        QImage::Format policyFormat = QImage::Format_Invalid;  // What convertForDisplay() picks
+        double loadMs = 0.0;
+        QList<FormatResult> formats;
+        QString errorMessage;
+
+        QString toText() const;
+    };
+
+    static Report run(const QString& mapPath);
+
+    static constexpr int VIEWPORT_WIDTH = 1920;
+    static constexpr int VIEWPORT_HEIGHT = 1080;
+    static constexpr int SAMPLE_TILES = 64;
+    static constexpr int SAMPLE_FRAMES = 20;
+
+private:
+    PixelFormatBenchmark() = default;
+};
+
+#endif // PIXELFORMATBENCHMARK_H
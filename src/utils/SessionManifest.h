@@ -0,0 +1,28 @@
+#ifndef SESSIONMANIFEST_H
+#define SESSIONMANIFEST_H
+
+#include <QList>
+#include <QPointF>
+#include <QString>
+
+// The open tabs at quit, for restoring them on the next launch
+// (SettingsManager::saveSessionManifest). Tabs are listed in tab bar order.
+// Lights come from the map file itself and have no sidecar of their own.
+struct SessionManifest
+{
+    struct Tab {
+        QString filePath;
+        qreal zoomLevel = 1.0;
+        QPointF viewCenter;
+        bool gridEnabled = true;
+        bool fogEnabled = false;
+        QString fogSidecar;  // Autosaved fog (<map>.fog), empty if there is none
+    };
+
+    QList<Tab> tabs;
+    int activeIndex = -1;
+
+    bool isEmpty() const { return tabs.isEmpty(); }
+};
+
+#endif // SESSIONMANIFEST_H
@@ -0,0 +1,251 @@
+#include "utils/SessionStressBenchmark.h"
+#include "controllers/TabsController.h"
+#include "graphics/MapDisplay.h"
+#include "utils/DecodedMapCache.h"
+#include "utils/MapSession.h"
+#include "utils/MemoryManager.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QImage>
+#include <QPainter>
+#include <QRandomGenerator>
+#include <QTabBar>
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+double elapsedMs(const QElapsedTimer& timer)
+{
+    return timer.nsecsElapsed() / 1e6;
+}
+
+QString megabytes(qint64 bytes)
+{
+    return bytes < 0 ? QStringLiteral("n/a") : QString("%1 MB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+// Every map gets different content, so no layer along the way can share pixels
+QImage generateMap(int index)
+{
+    QImage image(SessionStressBenchmark::MAP_WIDTH, SessionStressBenchmark::MAP_HEIGHT, QImage::Format_RGB32);
+    QRandomGenerator random(quint32(index) + 1);
+    image.fill(QColor::fromHsv(random.bounded(360), 60, 90));
+
+    QPainter painter(&image);
+    for (int i = 0; i < 400; ++i) {
+        painter.fillRect(random.bounded(image.width()), random.bounded(image.height()),
+                         random.bounded(16, 400), random.bounded(16, 400),
+                         QColor::fromHsv(random.bounded(360), 120, random.bounded(60, 220)));
+    }
+    painter.setPen(Qt::white);
+    painter.drawText(image.rect(), Qt::AlignCenter, QString("Map %1").arg(index));
+    return image;
+}
+
+// Runs until the tab showing filePath is active; hot switches complete
+// inside trigger(), the others when the background load lands
+bool activate(TabsController& tabs, const QString& filePath, const std::function<void()>& trigger)
+{
+    auto isCurrent = [&tabs, &filePath]() {
+        MapSession* session = tabs.getCurrentSession();
+        return session && session->filePath() == filePath;
+    };
+
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+    // Emitted first thing when a load finishes, fails or is cancelled
+    QObject::connect(&tabs, &TabsController::requestHideProgress, &loop, &QEventLoop::quit,
+                     Qt::QueuedConnection);
+
+    trigger();
+    if (!isCurrent()) {
+        timeout.start(SessionStressBenchmark::LOAD_TIMEOUT_MS);
+        loop.exec();
+    }
+    return isCurrent();
+}
+
+// Points DecodedMapCache at the temporary folder for the run, so the
+// generated maps neither land in nor evict the user's cache
+class ScratchDecodedCache
+{
+public:
+    explicit ScratchDecodedCache(const QString& directory)
+    {
+        DecodedMapCache::instance().setCacheDirectory(directory);
+    }
+
+    ~ScratchDecodedCache()
+    {
+        // Hibernation writes resolve the directory when they run
+        QThreadPool::globalInstance()->waitForDone();
+        DecodedMapCache::instance().setCacheDirectory(QString());
+    }
+};
+
+} // namespace
+
+SessionStressBenchmark::Latency SessionStressBenchmark::Latency::from(QList<double> samples)
+{
+    Latency latency;
+    latency.count = samples.size();
+    if (samples.isEmpty()) {
+        return latency;
+    }
+    std::sort(samples.begin(), samples.end());
+    latency.medianMs = samples.at(samples.size() / 2);
+    latency.p95Ms = samples.at(qMin(samples.size() - 1, int(samples.size() * 0.95)));
+    latency.maxMs = samples.last();
+    return latency;
+}
+
+SessionStressBenchmark::Report SessionStressBenchmark::run(int sessionCount)
+{
+    Report report;
+    report.sessions = sessionCount;
+    report.mapSize = QSize(MAP_WIDTH, MAP_HEIGHT);
+
+    QTemporaryDir folder;
+    if (!folder.isValid()) {
+        report.errorMessage = QStringLiteral("Cannot create a temporary folder for the maps");
+        return report;
+    }
+
+    ScratchDecodedCache scratchCache(folder.filePath(QStringLiteral("decoded-maps")));
+
+    QStringList paths;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < sessionCount; ++i) {
+        const QString path = folder.filePath(QString("map_%1.jpg").arg(i, 3, 10, QLatin1Char('0')));
+        if (!generateMap(i).save(path, "JPG", 85)) {
+            report.errorMessage = QString("Cannot write %1").arg(path);
+            return report;
+        }
+        paths << path;
+    }
+    report.generateMs = elapsedMs(timer);
+
+    // Same widgets MainWindow wires up, painted off screen
+    QTabBar tabBar;
+    MapDisplay display;
+    display.setAttribute(Qt::WA_DontShowOnScreen);
+    display.resize(VIEWPORT_WIDTH, VIEWPORT_HEIGHT);
+    display.show();
+    TabsController tabs;
+    tabs.attach(&tabBar, &display, sessionCount);
+    MemoryManager::instance().startBudgetMonitor();
+
+    auto sampleRss = [&report]() {
+        const qint64 rss = MemoryManager::residentBytes();
+        report.peakRss = qMax(report.peakRss, rss);
+        return rss;
+    };
+    report.baselineRss = sampleRss();
+
+    timer.restart();
+    for (const QString& path : paths) {
+        if (!activate(tabs, path, [&tabs, &path]() { tabs.loadMapFile(path); })) {
+            report.errorMessage = QString("Opening %1 did not complete").arg(path);
+            return report;
+        }
+        sampleRss();
+    }
+    report.openMs = elapsedMs(timer);
+    report.openedRss = sampleRss();
+
+    // Alternate going back to the previous tab (the common case at the
+    // table) with jumps to any tab of the campaign
+    QList<double> hot, warm, cold;
+    QRandomGenerator random(42);
+    int previous = tabs.sessionCount() - 2;
+    for (int i = 0; i < SWITCH_SAMPLES && tabs.sessionCount() > 1; ++i) {
+        const int current = tabBar.currentIndex();
+        int index = (i % 2 == 0) ? previous : random.bounded(tabs.sessionCount());
+        if (index == current) {
+            index = (index + 1) % tabs.sessionCount();
+        }
+        MapSession* target = tabs.sessionAt(index);
+        // Bucket by what the reload will do, not by tier(): a cold tab whose
+        // decode is still in DecodedMapCache (slow decodes are cached on
+        // load, hibernated ones age out lazily) reloads like a warm one
+        MapSession::Tier tier = target->tier();
+        if (tier == MapSession::Tier::Cold &&
+            DecodedMapCache::instance().contains(QFileInfo(target->filePath()))) {
+            tier = MapSession::Tier::Warm;
+        }
+
+        timer.restart();
+        if (!activate(tabs, target->filePath(), [&tabBar, index]() { tabBar.setCurrentIndex(index); })) {
+            report.errorMessage = QString("Switching to %1 did not complete").arg(target->filePath());
+            return report;
+        }
+        display.viewport()->repaint();
+        const double ms = elapsedMs(timer);
+
+        (tier == MapSession::Tier::Hot ? hot : tier == MapSession::Tier::Warm ? warm : cold) << ms;
+        previous = current;
+        sampleRss();
+        QCoreApplication::processEvents();
+    }
+    report.finalRss = sampleRss();
+    report.hotSwitch = Latency::from(hot);
+    report.warmSwitch = Latency::from(warm);
+    report.coldSwitch = Latency::from(cold);
+
+    for (int i = 0; i < tabs.sessionCount(); ++i) {
+        switch (tabs.sessionAt(i)->tier()) {
+        case MapSession::Tier::Hot: ++report.hot; break;
+        case MapSession::Tier::Warm: ++report.warm; break;
+        case MapSession::Tier::Cold: ++report.cold; break;
+        }
+    }
+    return report;
+}
+
+QString SessionStressBenchmark::Report::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+
+    out << QString("Session stress benchmark: %1 maps of %2x%3\n")
+               .arg(sessions).arg(mapSize.width()).arg(mapSize.height());
+    if (!errorMessage.isEmpty()) {
+        out << "  error: " << errorMessage << "\n";
+        return text;
+    }
+
+    out << QString("  generated in %1 s, opened in %2 s (%3 ms per tab)\n")
+               .arg(generateMs / 1000.0, 0, 'f', 1)
+               .arg(openMs / 1000.0, 0, 'f', 1)
+               .arg(sessions > 0 ? openMs / sessions : 0.0, 0, 'f', 1);
+    out << QString("  RSS: baseline %1, all open %2, peak %3, after switching %4\n")
+               .arg(megabytes(baselineRss), megabytes(openedRss), megabytes(peakRss), megabytes(finalRss));
+    out << QString("  tiers: %1 hot, %2 warm, %3 cold\n").arg(hot).arg(warm).arg(cold);
+    out << QString("  %1 %2 %3 %4 %5\n")
+               .arg(QStringLiteral("switch to"), -10).arg(QStringLiteral("count"), 6)
+               .arg(QStringLiteral("median ms"), 10).arg(QStringLiteral("p95 ms"), 10)
+               .arg(QStringLiteral("max ms"), 10);
+    const QList<QPair<QString, Latency>> rows = {
+        { QStringLiteral("hot"), hotSwitch },
+        { QStringLiteral("warm"), warmSwitch },
+        { QStringLiteral("cold"), coldSwitch },
+    };
+    for (const auto& row : rows) {
+        out << QString("  %1 %2 %3 %4 %5\n")
+                   .arg(row.first, -10).arg(row.second.count, 6)
+                   .arg(row.second.medianMs, 10, 'f', 1)
+                   .arg(row.second.p95Ms, 10, 'f', 1)
+                   .arg(row.second.maxMs, 10, 'f', 1);
+    }
+    return text;
+}
@@ -0,0 +1,61 @@
+#ifndef SESSIONSTRESSBENCHMARK_H
+#define SESSIONSTRESSBENCHMARK_H
+
+#include <QString>
+#include <QSize>
+#include <QList>
+
+// Opens a campaign-sized number of maps as tabs through TabsController and
+// reports what that costs: resident memory while the tabs are opened and
+// switched between, and how long a switch takes to the first painted frame
+// by the residency tier of the tab switched to (see
+// TabsController::rebalanceSessions). Switches are bucketed by what the
+// reload did: a released tab that hits DecodedMapCache counts as warm. The
+// maps, and the decoded cache for the run, live in a temporary folder. Needs a QApplication; run with --benchmark-sessions.
+class SessionStressBenchmark
+{
+public:
+    struct Latency {
+        int count = 0;
+        double medianMs = 0.0;
+        double p95Ms = 0.0;
+        double maxMs = 0.0;
+
+        static Latency from(QList<double> samples);
+    };
+
+    struct Report {
+        int sessions = 0;
+        QSize mapSize;
+        double generateMs = 0.0;
+        double openMs = 0.0;         // All tabs
+        qint64 baselineRss = -1;     // Before the first tab
+        qint64 openedRss = -1;       // After the last tab
+        qint64 peakRss = -1;
+        qint64 finalRss = -1;        // After the switches
+        int hot = 0;
+        int warm = 0;
+        int cold = 0;
+        Latency hotSwitch;
+        Latency warmSwitch;
+        Latency coldSwitch;
+        QString errorMessage;
+
+        QString toText() const;
+    };
+
+    static Report run(int sessionCount = DEFAULT_SESSIONS);
+
+    static constexpr int DEFAULT_SESSIONS = 200;
+    static constexpr int MAP_WIDTH = 3072;
+    static constexpr int MAP_HEIGHT = 2048;
+    static constexpr int SWITCH_SAMPLES = 120;
+    static constexpr int LOAD_TIMEOUT_MS = 30000;
+    static constexpr int VIEWPORT_WIDTH = 1920;
+    static constexpr int VIEWPORT_HEIGHT = 1080;
+
+private:
+    SessionStressBenchmark() = default;
+};
+
+#endif // SESSIONSTRESSBENCHMARK_H
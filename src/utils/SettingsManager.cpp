@@ -1,5 +1,8 @@
 #include "utils/SettingsManager.h"
 #include "utils/DebugConsole.h"
+#include "utils/DecodedMapCache.h"
+#include "utils/MapPrefetcher.h"
+#include "utils/ImageLoader.h"
 #include <QStandardPaths>
 #include <QCryptographicHash>
 #include <QGlobalStatic>
@@ -239,6 +242,64 @@ int SettingsManager::loadUpdateFrequency()
     return m_settings->value("performance/updateFrequency", 60).toInt();
 }
 
+void SettingsManager::saveAtmosphereCompositing(bool enabled)
+{
+    m_settings->setValue("performance/atmosphereCompositing", enabled);
+    m_settings->sync();
+}
+
+bool SettingsManager::loadAtmosphereCompositing()
+{
+    return m_settings->value("performance/atmosphereCompositing", false).toBool();
+}
+
+void SettingsManager::saveDecodedMapCacheSize(int sizeInMB)
+{
+    m_settings->setValue("performance/decodedMapCacheMB", sizeInMB);
+    m_settings->sync();
+}
+
+int SettingsManager::loadDecodedMapCacheSize()
+{
+    return m_settings->value("performance/decodedMapCacheMB",
+                             DecodedMapCache::DEFAULT_MAX_SIZE_MB).toInt();
+}
+
+void SettingsManager::savePrefetchBudget(int sizeInMB)
+{
+    m_settings->setValue("performance/prefetchBudgetMB", sizeInMB);
+    m_settings->sync();
+}
+
+int SettingsManager::loadPrefetchBudget()
+{
+    return m_settings->value("performance/prefetchBudgetMB",
+                             MapPrefetcher::DEFAULT_BUDGET_MB).toInt();
+}
+
+void SettingsManager::savePixelFormatPolicy(int policy)
+{
+    m_settings->setValue("performance/pixelFormatPolicy", policy);
+    m_settings->sync();
+}
+
+int SettingsManager::loadPixelFormatPolicy()
+{
+    return m_settings->value("performance/pixelFormatPolicy",
+                             int(ImageLoader::PixelFormatPolicy::Auto)).toInt();
+}
+
+void SettingsManager::saveMemoryBudget(int sizeInMB)
+{
+    m_settings->setValue("performance/memoryBudgetMB", sizeInMB);
+    m_settings->sync();
+}
+
+int SettingsManager::loadMemoryBudget()
+{
+    return m_settings->value("performance/memoryBudgetMB", 0).toInt();
+}
+
 // Display settings
 void SettingsManager::saveGridOpacity(int opacity)
 {
@@ -298,6 +359,62 @@ bool SettingsManager::loadWheelZoomEnabled()
     return m_settings->value("interaction/wheelZoomEnabled", false).toBool();
 }
 
+void SettingsManager::saveSessionManifest(const SessionManifest& manifest)
+{
+    m_settings->remove("session");
+    m_settings->beginGroup("session");
+    m_settings->setValue("activeIndex", manifest.activeIndex);
+    m_settings->beginWriteArray("tabs", manifest.tabs.size());
+    for (int i = 0; i < manifest.tabs.size(); ++i) {
+        const SessionManifest::Tab& tab = manifest.tabs.at(i);
+        m_settings->setArrayIndex(i);
+        m_settings->setValue("filePath", tab.filePath);
+        m_settings->setValue("zoomLevel", tab.zoomLevel);
+        m_settings->setValue("viewCenter", tab.viewCenter);
+        m_settings->setValue("gridEnabled", tab.gridEnabled);
+        m_settings->setValue("fogEnabled", tab.fogEnabled);
+        m_settings->setValue("fogSidecar", tab.fogSidecar);
+    }
+    m_settings->endArray();
+    m_settings->endGroup();
+    m_settings->sync();
+}
+
+SessionManifest SettingsManager::loadSessionManifest()
+{
+    SessionManifest manifest;
+    m_settings->beginGroup("session");
+    const int savedActiveIndex = m_settings->value("activeIndex", 0).toInt();
+    int activeIndex = -1;
+    const int count = m_settings->beginReadArray("tabs");
+    for (int i = 0; i < count; ++i) {
+        m_settings->setArrayIndex(i);
+        SessionManifest::Tab tab;
+        tab.filePath = m_settings->value("filePath").toString();
+        tab.zoomLevel = m_settings->value("zoomLevel", 1.0).toDouble();
+        tab.viewCenter = m_settings->value("viewCenter").toPointF();
+        tab.gridEnabled = m_settings->value("gridEnabled", true).toBool();
+        tab.fogEnabled = m_settings->value("fogEnabled", false).toBool();
+        tab.fogSidecar = m_settings->value("fogSidecar").toString();
+        if (tab.filePath.isEmpty()) {
+            continue;
+        }
+        // Dropped entries shift the saved index; a dropped active tab hands
+        // over to the next kept one
+        if (savedActiveIndex >= 0 && i >= savedActiveIndex && activeIndex < 0) {
+            activeIndex = manifest.tabs.size();
+        }
+        manifest.tabs.append(tab);
+    }
+    m_settings->endArray();
+    if (savedActiveIndex >= 0 && activeIndex < 0) {
+        activeIndex = manifest.tabs.size() - 1;  // It was the last tab, or past the end
+    }
+    manifest.activeIndex = activeIndex;
+    m_settings->endGroup();
+    return manifest;
+}
+
 // Per-map grid calibration storage
 QString SettingsManager::generateMapKey(const QString& mapPath)
 {
@@ -7,6 +7,8 @@
 #include <QColor>
 #include <QGlobalStatic>
 
+#include "utils/SessionManifest.h"
+
 class SettingsManager
 {
 public:
@@ -79,6 +81,23 @@ public:
     void saveUpdateFrequency(int frequency);
     int loadUpdateFrequency();
 
+    void saveAtmosphereCompositing(bool enabled);
+    bool loadAtmosphereCompositing();
+
+    void saveDecodedMapCacheSize(int sizeInMB);
+    int loadDecodedMapCacheSize();
+
+    void savePrefetchBudget(int sizeInMB);
+    int loadPrefetchBudget();
+
+    // ImageLoader::PixelFormatPolicy as int
+    void savePixelFormatPolicy(int policy);
+    int loadPixelFormatPolicy();
+
+    // Process memory budget; 0 = share of physical memory
+    void saveMemoryBudget(int sizeInMB);
+    int loadMemoryBudget();
+
     // Display settings
     void saveGridOpacity(int opacity);
     int loadGridOpacity();
@@ -94,6 +113,10 @@ public:
     void saveWheelZoomEnabled(bool enabled);
     bool loadWheelZoomEnabled();
 
+    // Tabs open at quit, restored on the next launch
+    void saveSessionManifest(const SessionManifest& manifest);
+    SessionManifest loadSessionManifest();
+
     void clearAllSettings();
 
     // Force immediate sync to disk
@@ -0,0 +1,99 @@
+#include "utils/StartupProfiler.h"
+#include "utils/DebugConsole.h"
+#include <QElapsedTimer>
+#include <QTextStream>
+
+namespace {
+
+QElapsedTimer s_timer;
+double s_lastMarkMs = 0.0;
+double s_interactiveMs = -1.0;
+QList<StartupProfiler::Phase> s_phases;
+
+} // namespace
+
+void StartupProfiler::start()
+{
+    s_timer.start();
+    s_lastMarkMs = 0.0;
+    s_interactiveMs = -1.0;
+    s_phases.clear();
+}
+
+double StartupProfiler::elapsedMs()
+{
+    return s_timer.isValid() ? s_timer.nsecsElapsed() / 1e6 : 0.0;
+}
+
+void StartupProfiler::mark(const QString& phase)
+{
+    if (!s_timer.isValid()) {
+        return;
+    }
+
+    Phase entry;
+    entry.name = phase;
+    entry.endMs = elapsedMs();
+    entry.ms = entry.endMs - s_lastMarkMs;
+    s_lastMarkMs = entry.endMs;
+    s_phases.append(entry);
+
+    DebugConsole::performance(QString("%1: %2 ms (at %3 ms)")
+        .arg(phase)
+        .arg(entry.ms, 0, 'f', 1)
+        .arg(entry.endMs, 0, 'f', 1), "Startup");
+}
+
+void StartupProfiler::markInteractive()
+{
+    if (!s_timer.isValid() || s_interactiveMs >= 0.0) {
+        return;
+    }
+
+    mark(QStringLiteral("first frame"));
+    s_interactiveMs = s_lastMarkMs;
+
+    const QString message = QString("Interactive after %1 ms (target %2 ms)")
+        .arg(s_interactiveMs, 0, 'f', 1)
+        .arg(INTERACTIVE_TARGET_MS, 0, 'f', 0);
+    if (s_interactiveMs > INTERACTIVE_TARGET_MS) {
+        DebugConsole::warning(message, "Startup");
+    } else {
+        DebugConsole::performance(message, "Startup");
+    }
+}
+
+double StartupProfiler::interactiveMs()
+{
+    return s_interactiveMs;
+}
+
+QList<StartupProfiler::Phase> StartupProfiler::phases()
+{
+    return s_phases;
+}
+
+QString StartupProfiler::toText()
+{
+    QString text;
+    QTextStream out(&text);
+
+    out << "Startup profile\n";
+    out << QString("  %1 %2 %3\n")
+               .arg(QStringLiteral("phase"), -28)
+               .arg(QStringLiteral("ms"), 8)
+               .arg(QStringLiteral("at ms"), 8);
+    for (const Phase& phase : s_phases) {
+        out << QString("  %1 %2 %3\n")
+                   .arg(phase.name, -28)
+                   .arg(phase.ms, 8, 'f', 1)
+                   .arg(phase.endMs, 8, 'f', 1);
+    }
+    if (s_interactiveMs >= 0.0) {
+        out << QString("  interactive after %1 ms (target %2 ms)%3\n")
+                   .arg(s_interactiveMs, 0, 'f', 1)
+                   .arg(INTERACTIVE_TARGET_MS, 0, 'f', 0)
+                   .arg(s_interactiveMs > INTERACTIVE_TARGET_MS ? QStringLiteral(" - over target") : QString());
+    }
+    return text;
+}
@@ -0,0 +1,37 @@
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QString>
+#include <QList>
+
+// Wall-clock phases from the top of main() to an interactive window and on
+// through the idle-time construction that follows it. Each mark() closes
+// the phase that started at the previous mark and logs it under the
+// "Startup" category. GUI thread only.
+class StartupProfiler
+{
+public:
+    struct Phase {
+        QString name;
+        double ms = 0.0;     // Duration of this phase
+        double endMs = 0.0;  // Since start()
+    };
+
+    static void start();
+    static void mark(const QString& phase);
+
+    // First frame of the main window is on screen and accepts input
+    static void markInteractive();
+    static double interactiveMs();  // -1 until markInteractive()
+
+    static double elapsedMs();
+    static QList<Phase> phases();
+    static QString toText();
+
+    static constexpr double INTERACTIVE_TARGET_MS = 300.0;
+
+private:
+    StartupProfiler() = default;
+};
+
+#endif // STARTUPPROFILER_H
@@ -0,0 +1,263 @@
+#include "utils/ThemeBenchmark.h"
+#include "ui/AtmosphereToolboxWidget.h"
+#include "ui/widgets/MapBrowserWidget.h"
+#include "ui/DarkTheme.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QStyle>
+#include <QStyleFactory>
+#include <QTextStream>
+#include <QVector>
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+namespace {
+
+// The stylesheets this tree used before the theme moved into
+// DarkTheme::Style, kept verbatim in resources/theme-benchmark/ (see
+// theme-benchmark.qrc): the application sheet main.cpp assembled from the
+// DarkTheme::get*StyleSheet() factories and the tooltip rule, then the
+// panel-level sheets the two docks set on themselves
+QString formerStyleSheet(const QString& name)
+{
+    QFile file(QStringLiteral(":/theme-benchmark/%1.qss").arg(name));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+QString applicationStyleSheet()
+{
+    return formerStyleSheet(QStringLiteral("application"));
+}
+
+// AtmosphereToolboxWidget::applyDarkTheme()
+QString atmospherePanelStyleSheet()
+{
+    return formerStyleSheet(QStringLiteral("atmosphere-panel"))
+        .arg(DarkTheme::BgPrimary.name())      // %1
+        .arg(DarkTheme::TextPrimary.name())    // %2
+        .arg(DarkTheme::BgSecondary.name())    // %3
+        .arg(DarkTheme::BgTertiary.name())     // %4
+        .arg(DarkTheme::BorderColor.name())    // %5
+        .arg(DarkTheme::AccentPrimary.name())  // %6
+        .arg("#3A3A3A")                         // %7 hover
+        .arg(DarkTheme::TextDisabled.name());  // %8
+}
+
+double elapsedMs(const QElapsedTimer& timer)
+{
+    return timer.nsecsElapsed() / 1e6;
+}
+
+struct PanelFactory {
+    QString name;
+    std::function<QWidget*()> create;
+    std::function<void(QWidget*)> restyle;  // Re-applies the panel's former own sheets
+};
+
+// Builds and shows the panel off screen, then repaints it synchronously
+void measure(const PanelFactory& factory, bool styleSheets, double& buildMs, double& repaintMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    std::unique_ptr<QWidget> panel(factory.create());
+    if (styleSheets) {
+        factory.restyle(panel.get());
+    }
+    panel->setAttribute(Qt::WA_DontShowOnScreen);
+    panel->resize(ThemeBenchmark::PANEL_WIDTH, ThemeBenchmark::PANEL_HEIGHT);
+    panel->show();
+    QCoreApplication::processEvents();
+    buildMs = elapsedMs(timer);
+
+    for (int i = 0; i < ThemeBenchmark::WARMUP_REPAINTS; ++i) {
+        panel->repaint();
+    }
+    timer.restart();
+    for (int i = 0; i < ThemeBenchmark::MEASURED_REPAINTS; ++i) {
+        panel->repaint();
+    }
+    repaintMs = elapsedMs(timer) / ThemeBenchmark::MEASURED_REPAINTS;
+}
+
+// The former setup: no proxy style, Fusion under the stylesheets
+void applyFormerTheme(QApplication& app)
+{
+    QStyle* fusion = QStyleFactory::create(QStringLiteral("Fusion"));
+    app.setStyle(fusion);
+    app.setPalette(fusion->standardPalette());
+    app.setStyleSheet(applicationStyleSheet());
+}
+
+void applyCurrentTheme(QApplication& app)
+{
+    app.setStyleSheet(QString());
+    DarkTheme::apply(app);
+}
+
+ThemeBenchmark::Timing summarize(QVector<double> samples)
+{
+    ThemeBenchmark::Timing timing;
+    if (samples.isEmpty()) {
+        return timing;
+    }
+    std::sort(samples.begin(), samples.end());
+    const int middle = samples.size() / 2;
+    timing.minMs = samples.first();
+    timing.maxMs = samples.last();
+    timing.medianMs = samples.size() % 2 ? samples.at(middle)
+                                         : (samples.at(middle - 1) + samples.at(middle)) / 2.0;
+    return timing;
+}
+
+} // namespace
+
+ThemeBenchmark::Report ThemeBenchmark::run()
+{
+    Report report;
+    report.rounds = ROUNDS;
+    report.repaints = MEASURED_REPAINTS;
+
+    auto* app = qobject_cast<QApplication*>(QCoreApplication::instance());
+    if (!app) {
+        report.errorMessage = QStringLiteral("Needs a QApplication");
+        return report;
+    }
+    if (!app->styleSheet().isEmpty()) {
+        report.errorMessage = QStringLiteral("An application stylesheet is already set");
+        return report;
+    }
+
+    // Per-label colour sheets are not replayed, so the qss columns are
+    // still a lower bound on the former cost
+    const QString listStyleSheet = formerStyleSheet(QStringLiteral("map-browser-list"));
+    const QString lineEditStyleSheet = formerStyleSheet(QStringLiteral("map-browser-line-edit"));
+    if (applicationStyleSheet().isEmpty() || listStyleSheet.isEmpty() || lineEditStyleSheet.isEmpty()) {
+        report.errorMessage = QStringLiteral("The former stylesheets are missing from the resources");
+        return report;
+    }
+
+    const QList<PanelFactory> factories = {
+        { QStringLiteral("atmosphere panel"),
+          []() -> QWidget* { return new AtmosphereToolboxWidget(); },
+          [](QWidget* panel) { panel->setStyleSheet(atmospherePanelStyleSheet()); } },
+        { QStringLiteral("map browser"),
+          []() -> QWidget* { return new MapBrowserWidget(); },
+          [listStyleSheet, lineEditStyleSheet](QWidget* panel) {
+              for (QListWidget* list : panel->findChildren<QListWidget*>()) {
+                  list->setStyleSheet(listStyleSheet);
+              }
+              for (QLineEdit* edit : panel->findChildren<QLineEdit*>()) {
+                  edit->setStyleSheet(lineEditStyleSheet);
+              }
+          } },
+    };
+
+    // Per panel and setup (0 theme, 1 stylesheets): build and repaint samples
+    const int panelCount = factories.size();
+    QVector<QVector<double>> buildSamples(panelCount * 2);
+    QVector<QVector<double>> repaintSamples(panelCount * 2);
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        // Alternate which setup runs first, so caches warmed by one do not
+        // always favour the other
+        for (int pass = 0; pass < 2; ++pass) {
+            const bool styleSheets = (round + pass) % 2 == 1;
+            if (styleSheets) {
+                applyFormerTheme(*app);
+            } else {
+                applyCurrentTheme(*app);
+            }
+            for (int i = 0; i < panelCount; ++i) {
+                double buildMs = 0.0;
+                double repaintMs = 0.0;
+                measure(factories.at(i), styleSheets, buildMs, repaintMs);
+                buildSamples[i * 2 + int(styleSheets)] << buildMs;
+                repaintSamples[i * 2 + int(styleSheets)] << repaintMs;
+            }
+        }
+    }
+    applyCurrentTheme(*app);
+
+    for (int i = 0; i < panelCount; ++i) {
+        Panel panel;
+        panel.name = factories.at(i).name;
+        panel.build = summarize(buildSamples.at(i * 2));
+        panel.repaint = summarize(repaintSamples.at(i * 2));
+        panel.styleSheetBuild = summarize(buildSamples.at(i * 2 + 1));
+        panel.styleSheetRepaint = summarize(repaintSamples.at(i * 2 + 1));
+        report.panels << panel;
+    }
+    return report;
+}
+
+double ThemeBenchmark::Panel::buildSpeedup() const
+{
+    return build.medianMs > 0.0 ? styleSheetBuild.medianMs / build.medianMs : 0.0;
+}
+
+double ThemeBenchmark::Panel::repaintSpeedup() const
+{
+    return repaint.medianMs > 0.0 ? styleSheetRepaint.medianMs / repaint.medianMs : 0.0;
+}
+
+bool ThemeBenchmark::Report::themeIsFaster() const
+{
+    if (!errorMessage.isEmpty() || panels.isEmpty()) {
+        return false;
+    }
+    for (const Panel& panel : panels) {
+        if (panel.repaintSpeedup() <= 1.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString ThemeBenchmark::Report::toText() const
+{
+    QString text;
+    QTextStream out(&text);
+
+    out << QString("Theme benchmark: %1 rounds of %2 repaints per panel at %3x%4, off screen\n")
+               .arg(rounds).arg(repaints).arg(PANEL_WIDTH).arg(PANEL_HEIGHT);
+    if (!errorMessage.isEmpty()) {
+        out << "  error: " << errorMessage << "\n";
+        return text;
+    }
+
+    // Median, then the spread over the rounds
+    auto format = [](const Timing& timing, int precision) {
+        return QString("%1 (%2-%3)")
+            .arg(timing.medianMs, 0, 'f', precision)
+            .arg(timing.minMs, 0, 'f', precision)
+            .arg(timing.maxMs, 0, 'f', precision);
+    };
+
+    out << QString("  %1 %2 %3 %4\n")
+               .arg(QStringLiteral("panel"), -18).arg(QStringLiteral("setup"), -7)
+               .arg(QStringLiteral("build ms"), -20).arg(QStringLiteral("repaint ms"));
+    for (const Panel& panel : panels) {
+        out << QString("  %1 %2 %3 %4\n")
+                   .arg(panel.name, -18).arg(QStringLiteral("theme"), -7)
+                   .arg(format(panel.build, 1), -20).arg(format(panel.repaint, 2));
+        out << QString("  %1 %2 %3 %4\n")
+                   .arg(QString(), -18).arg(QStringLiteral("qss"), -7)
+                   .arg(format(panel.styleSheetBuild, 1), -20).arg(format(panel.styleSheetRepaint, 2));
+        out << QString("  %1 %2 %3 %4\n")
+                   .arg(QString(), -18).arg(QStringLiteral("gain"), -7)
+                   .arg(QString("%1x").arg(panel.buildSpeedup(), 0, 'f', 2), -20)
+                   .arg(QString("%1x").arg(panel.repaintSpeedup(), 0, 'f', 2));
+    }
+    out << "  theme: DarkTheme::Style; qss: Fusion under the former application and panel stylesheets\n";
+    out << "  gain: qss median over theme median\n";
+    out << (themeIsFaster() ? "  result: the theme repaints every panel faster\n"
+                            : "  result: the theme is NOT faster on every panel\n");
+    return text;
+}
@@ -0,0 +1,59 @@
+#ifndef THEMEBENCHMARK_H
+#define THEMEBENCHMARK_H
+
+#include <QString>
+#include <QList>
+
+// Builds the side docks (atmosphere panel, map browser) off screen and times
+// construction and full repaints under DarkTheme::Style, and under plain
+// Fusion with the stylesheets the theme used to be (application sheet plus
+// the panels' own), which puts every widget under QStyleSheetStyle. The two
+// setups alternate over several rounds so neither always runs warm; each
+// figure is the median with the min-max spread. Startup phases before and
+// after come from --benchmark-startup. Run with --benchmark-theme.
+class ThemeBenchmark
+{
+public:
+    struct Timing {
+        double minMs = 0.0;
+        double medianMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct Panel {
+        QString name;
+        Timing build;
+        Timing repaint;            // Mean full repaint per round
+        Timing styleSheetBuild;
+        Timing styleSheetRepaint;  // Same, Fusion with the former stylesheets
+
+        // Former cost over current, from the medians; above 1 means the theme is faster
+        double buildSpeedup() const;
+        double repaintSpeedup() const;
+    };
+
+    struct Report {
+        int rounds = 0;
+        int repaints = 0;
+        QList<Panel> panels;
+        QString errorMessage;
+
+        // Every panel repaints faster under the theme than under the stylesheets
+        bool themeIsFaster() const;
+        QString toText() const;
+    };
+
+    // Leaves DarkTheme applied
+    static Report run();
+
+    static constexpr int ROUNDS = 6;  // Even, so each setup goes first half the time
+    static constexpr int WARMUP_REPAINTS = 20;
+    static constexpr int MEASURED_REPAINTS = 200;
+    static constexpr int PANEL_WIDTH = 320;
+    static constexpr int PANEL_HEIGHT = 900;
+
+private:
+    ThemeBenchmark() = default;
+};
+
+#endif // THEMEBENCHMARK_H
@@ -0,0 +1,328 @@
+#include "utils/UVTTWriter.h"
+#include "utils/DebugConsole.h"
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QBuffer>
+#include <QImageWriter>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef CRITVTT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+// Base64-encodes a byte stream in pieces; only whole 3-byte groups are
+// encoded before finish(), so the pieces join into one valid string
+class Base64Stream
+{
+public:
+    explicit Base64Stream(QIODevice* device) : m_device(device) {}
+
+    bool write(QByteArrayView bytes)
+    {
+        m_pending.append(bytes.data(), bytes.size());
+        if (m_pending.size() < FLUSH_SIZE) {
+            return true;
+        }
+        const qsizetype whole = m_pending.size() / 3 * 3;
+        const bool ok = m_device->write(m_pending.left(whole).toBase64()) >= 0;
+        m_pending.remove(0, whole);
+        return ok;
+    }
+
+    bool finish()
+    {
+        const bool ok = m_pending.isEmpty() || m_device->write(m_pending.toBase64()) >= 0;
+        m_pending.clear();
+        return ok;
+    }
+
+private:
+    static constexpr qsizetype FLUSH_SIZE = 3 * 256 * 1024;
+
+    QIODevice* m_device;
+    QByteArray m_pending;
+};
+
+#ifdef CRITVTT_HAVE_ZLIB
+
+void appendBigEndian(QByteArray& bytes, quint32 value)
+{
+    const char be[4] = { char(value >> 24), char(value >> 16), char(value >> 8), char(value) };
+    bytes.append(be, 4);
+}
+
+QByteArray pngChunk(const char type[4], QByteArrayView data)
+{
+    QByteArray chunk;
+    chunk.reserve(data.size() + 12);
+    appendBigEndian(chunk, quint32(data.size()));
+    chunk.append(type, 4);
+    chunk.append(data.data(), data.size());
+
+    uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(type), 4);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(data.data()), uInt(data.size()));
+    appendBigEndian(chunk, quint32(crc));
+    return chunk;
+}
+
+inline uchar paeth(int a, int b, int c)
+{
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return uchar(a);
+    }
+    return uchar(pb <= pc ? b : c);
+}
+
+// Filter one row with the usual minimum-sum-of-absolute-differences pick
+// among None/Sub/Up/Paeth. out holds the filter byte plus rowBytes.
+void filterRow(const uchar* row, const uchar* previous, int rowBytes, int bpp,
+               uchar* out, QByteArray& scratch)
+{
+    scratch.resize(qsizetype(rowBytes) * 3);
+    uchar* sub = reinterpret_cast<uchar*>(scratch.data());
+    uchar* up = sub + rowBytes;
+    uchar* pth = up + rowBytes;
+
+    quint64 sumNone = 0, sumSub = 0, sumUp = 0, sumPaeth = 0;
+    for (int i = 0; i < rowBytes; ++i) {
+        const int left = i >= bpp ? row[i - bpp] : 0;
+        const int above = previous ? previous[i] : 0;
+        const int upperLeft = (previous && i >= bpp) ? previous[i - bpp] : 0;
+
+        sub[i] = uchar(row[i] - left);
+        up[i] = uchar(row[i] - above);
+        pth[i] = uchar(row[i] - paeth(left, above, upperLeft));
+
+        sumNone += qint8(row[i]) < 0 ? -qint8(row[i]) : qint8(row[i]);
+        sumSub += qint8(sub[i]) < 0 ? -qint8(sub[i]) : qint8(sub[i]);
+        sumUp += qint8(up[i]) < 0 ? -qint8(up[i]) : qint8(up[i]);
+        sumPaeth += qint8(pth[i]) < 0 ? -qint8(pth[i]) : qint8(pth[i]);
+    }
+
+    const uchar* best = row;
+    uchar type = 0;
+    quint64 bestSum = sumNone;
+    if (sumSub < bestSum) { best = sub; type = 1; bestSum = sumSub; }
+    if (sumUp < bestSum) { best = up; type = 2; bestSum = sumUp; }
+    if (sumPaeth < bestSum) { best = pth; type = 4; }
+
+    out[0] = type;
+    memcpy(out + 1, best, size_t(rowBytes));
+}
+
+struct Strip {
+    int firstRow = 0;
+    int rowCount = 0;
+    QByteArray deflated;
+    uLong adler = 1;
+    qsizetype rawBytes = 0;
+    bool ok = false;
+};
+
+// Filter and deflate rows [firstRow, firstRow + rowCount) as raw deflate
+// ending on a sync flush (or a final block for the last strip)
+void encodeStrip(const QImage& image, QImage::Format pngFormat, int bpp, bool last, Strip& strip)
+{
+    const int width = image.width();
+    const int rowBytes = width * bpp;
+
+    // Rows in PNG byte order, plus the row above for Up/Paeth
+    const int top = qMax(0, strip.firstRow - 1);
+    const int rows = strip.firstRow + strip.rowCount - top;
+    QImage source(image.constScanLine(top), width, rows, image.bytesPerLine(), image.format());
+    const QImage converted = source.format() == pngFormat ? source : source.convertToFormat(pngFormat);
+
+    QByteArray filtered(qsizetype(rowBytes + 1) * strip.rowCount, Qt::Uninitialized);
+    QByteArray scratch;
+    for (int y = 0; y < strip.rowCount; ++y) {
+        const int local = strip.firstRow + y - top;
+        const uchar* previous = (strip.firstRow + y) > 0 ? converted.constScanLine(local - 1) : nullptr;
+        filterRow(converted.constScanLine(local), previous, rowBytes, bpp,
+                  reinterpret_cast<uchar*>(filtered.data()) + qsizetype(rowBytes + 1) * y, scratch);
+    }
+
+    strip.rawBytes = filtered.size();
+    strip.adler = adler32(1L, reinterpret_cast<const Bytef*>(filtered.constData()), uInt(filtered.size()));
+
+    z_stream stream{};
+    if (deflateInit2(&stream, UVTTWriter::COMPRESSION_LEVEL, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return;
+    }
+    // Bound covers a finished stream; a sync flush adds at most a few bytes more
+    strip.deflated.resize(qsizetype(deflateBound(&stream, uLong(filtered.size()))) + 64);
+    stream.next_in = reinterpret_cast<Bytef*>(filtered.data());
+    stream.avail_in = uInt(filtered.size());
+    stream.next_out = reinterpret_cast<Bytef*>(strip.deflated.data());
+    stream.avail_out = uInt(strip.deflated.size());
+
+    const int result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool complete = last ? result == Z_STREAM_END : (result == Z_OK && stream.avail_in == 0);
+    strip.deflated.truncate(qsizetype(stream.total_out));
+    deflateEnd(&stream);
+    strip.ok = complete;
+}
+
+#endif // CRITVTT_HAVE_ZLIB
+
+} // namespace
+
+bool UVTTWriter::encodePNG(const QImage& image, const WriteFunction& sink, int maxThreads)
+{
+    if (image.isNull()) {
+        return false;
+    }
+
+#ifdef CRITVTT_HAVE_ZLIB
+    const bool hasAlpha = image.hasAlphaChannel();
+    const QImage::Format pngFormat = hasAlpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888;
+
+    // Strips view the source rows directly; paletted and sub-byte formats
+    // can't be viewed that way and are converted up front
+    const QImage source = (image.depth() >= 8 && image.colorCount() == 0)
+        ? image : image.convertToFormat(pngFormat);
+    const int bpp = hasAlpha ? 4 : 3;
+    const int width = image.width();
+    const int height = image.height();
+
+    // Signature and IHDR: 8-bit RGB or RGBA, no interlace
+    static const char signature[8] = { char(0x89), 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    QByteArray header;
+    appendBigEndian(header, quint32(width));
+    appendBigEndian(header, quint32(height));
+    header.append(char(8));
+    header.append(char(hasAlpha ? 6 : 2));
+    header.append(3, '\0');
+    if (!sink(QByteArrayView(signature, 8)) || !sink(pngChunk("IHDR", header))) {
+        return false;
+    }
+
+    const int rowsPerStrip = int(qBound<qsizetype>(1, STRIP_BYTES / (qsizetype(width) * bpp + 1), height));
+    const int stripCount = (height + rowsPerStrip - 1) / rowsPerStrip;
+
+    if (maxThreads <= 0) {
+        maxThreads = QThread::idealThreadCount();
+    }
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, maxThreads));
+    const int batchSize = qMax(1, maxThreads) * 2;
+
+    uLong adler = 1;
+    for (int first = 0; first < stripCount; first += batchSize) {
+        const int count = qMin(batchSize, stripCount - first);
+        QVector<Strip> strips(count);
+        for (int i = 0; i < count; ++i) {
+            Strip& strip = strips[i];
+            strip.firstRow = (first + i) * rowsPerStrip;
+            strip.rowCount = qMin(rowsPerStrip, height - strip.firstRow);
+            const bool last = first + i == stripCount - 1;
+            pool.start([&source, pngFormat, bpp, last, &strip]() {
+                encodeStrip(source, pngFormat, bpp, last, strip);
+            });
+        }
+        pool.waitForDone();
+
+        // Written in order: zlib header before the first strip, combined
+        // adler32 after the last
+        for (int i = 0; i < count; ++i) {
+            const Strip& strip = strips.at(i);
+            if (!strip.ok) {
+                return false;
+            }
+            adler = adler32_combine(adler, strip.adler, strip.rawBytes);
+
+            QByteArray data;
+            if (first + i == 0) {
+                data.append(char(0x78));
+                data.append(char(0x9C));
+            }
+            data.append(strip.deflated);
+            if (first + i == stripCount - 1) {
+                appendBigEndian(data, quint32(adler));
+            }
+            if (!sink(pngChunk("IDAT", data))) {
+                return false;
+            }
+        }
+    }
+
+    return sink(pngChunk("IEND", QByteArrayView()));
+#else
+    Q_UNUSED(maxThreads);
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    QImageWriter writer(&buffer, "PNG");
+    writer.setCompression(COMPRESSION_LEVEL);
+    if (!writer.write(image)) {
+        return false;
+    }
+    return sink(data);
+#endif
+}
+
+bool UVTTWriter::write(const QString& path, const QImage& image, const QJsonObject& metadata,
+                       QString* errorString, int maxThreads)
+{
+    auto fail = [&](const QString& message) {
+        if (errorString) {
+            *errorString = message;
+        }
+        DebugConsole::error(QString("UVTTWriter: %1").arg(message), "VTT");
+        return false;
+    };
+
+    if (image.isNull()) {
+        return fail("no image to export");
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return fail(QString("cannot write %1: %2").arg(path, file.errorString()));
+    }
+
+    // Metadata first, then the image field left open for the stream
+    QJsonObject root = metadata;
+    root.remove("image");
+    QByteArray head = QJsonDocument(root).toJson(QJsonDocument::Compact);
+    head.chop(1);  // Closing brace
+    head.append(root.isEmpty() ? "\"image\":\"" : ",\"image\":\"");
+    if (file.write(head) < 0) {
+        return fail(file.errorString());
+    }
+
+    Base64Stream base64(&file);
+    const bool encoded = encodePNG(image, [&base64](QByteArrayView bytes) {
+        return base64.write(bytes);
+    }, maxThreads);
+    if (!encoded || !base64.finish() || file.write("\"}\n") < 0) {
+        file.cancelWriting();
+        return fail(QString("failed to encode %1").arg(QFileInfo(path).fileName()));
+    }
+
+    if (!file.commit()) {
+        return fail(QString("cannot save %1: %2").arg(path, file.errorString()));
+    }
+
+    DebugConsole::performance(QString("UVTTWriter: exported %1 (%2x%3, %4 MB) in %5 ms")
+        .arg(QFileInfo(path).fileName())
+        .arg(image.width())
+        .arg(image.height())
+        .arg(QFileInfo(path).size() / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(timer.elapsed()), "VTT");
+    return true;
+}
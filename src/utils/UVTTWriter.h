@@ -0,0 +1,42 @@
+#ifndef UVTTWRITER_H
+#define UVTTWRITER_H
+
+#include <QString>
+#include <QImage>
+#include <QJsonObject>
+#include <QByteArrayView>
+#include <functional>
+
+// Streaming UVTT export: metadata JSON, then the map as a base64 PNG in the
+// "image" field, written straight to disk.
+//
+// The PNG is encoded in horizontal strips on a local thread pool. Every
+// strip is filtered and deflated independently and ends on a byte-aligned
+// sync flush, so the compressed strips concatenate into one valid zlib
+// stream (adler32 values are combined, not recomputed). Strips are
+// processed a batch at a time and base64-encoded as they are written, so
+// peak memory is the image plus one batch of strips - no PNG, base64 or
+// JSON copy of the whole map is ever built.
+//
+// Without zlib (CRITVTT_HAVE_ZLIB unset) the PNG comes from QImageWriter
+// on the calling thread; base64 and JSON still stream.
+class UVTTWriter
+{
+public:
+    using WriteFunction = std::function<bool(QByteArrayView)>;
+
+    // Thread-safe. maxThreads <= 0 uses QThread::idealThreadCount().
+    static bool write(const QString& path, const QImage& image, const QJsonObject& metadata,
+                      QString* errorString = nullptr, int maxThreads = 0);
+
+    // Encode image as PNG into sink, in order; false if the sink fails
+    static bool encodePNG(const QImage& image, const WriteFunction& sink, int maxThreads = 0);
+
+    static constexpr int COMPRESSION_LEVEL = 6;                 // zlib level; 9 costs ~3x for a few %
+    static constexpr qsizetype STRIP_BYTES = 2 * 1024 * 1024;   // Filtered bytes per strip
+
+private:
+    UVTTWriter() = default;
+};
+
+#endif // UVTTWRITER_H
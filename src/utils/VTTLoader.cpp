@@ -1,5 +1,6 @@
 #include "utils/VTTLoader.h"
 #include "utils/DebugConsole.h"
+#include "utils/Base64Decoder.h"
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -10,9 +11,175 @@
 #include <QImageReader>
 #include <QApplication>
 #include <QThread>
-#include <QRegularExpression>
+#include <QByteArrayView>
+#include <QElapsedTimer>
+#include <QHash>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+// Field names that may carry the embedded map image, in order of preference
+const char* const IMAGE_KEYS[] = { "image", "image_data", "map", "mapImage" };
+
+// Result of the top-level scan: every field except the image strings, copied
+// into a small JSON object for QJsonDocument, plus the raw image byte ranges
+// (quotes excluded, pointing into the mapped file)
+struct TopLevelScan {
+    QByteArray metadata;
+    QHash<QByteArray, QByteArrayView> imageFields;
+    qint64 errorOffset = 0;
+    QString errorString;
+};
+
+inline bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+const char* skipSpace(const char* p, const char* end)
+{
+    while (p < end && isJsonSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+// p points at the opening quote; returns one past the closing quote or nullptr
+const char* skipString(const char* p, const char* end)
+{
+    for (++p; p < end; ++p) {
+        if (*p == '\\') {
+            ++p;
+        } else if (*p == '"') {
+            return p + 1;
+        }
+    }
+    return nullptr;
+}
+
+// Skip one JSON value without interpreting it; nested containers are only
+// balanced here, QJsonDocument validates them later
+const char* skipValue(const char* p, const char* end)
+{
+    if (p >= end) {
+        return nullptr;
+    }
+    if (*p == '"') {
+        return skipString(p, end);
+    }
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            const char c = *p;
+            if (c == '"') {
+                p = skipString(p, end);
+                if (!p) {
+                    return nullptr;
+                }
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    return p + 1;
+                }
+            }
+            ++p;
+        }
+        return nullptr;
+    }
+    // Number, true, false, null
+    const char* start = p;
+    while (p < end && !isJsonSpace(*p) && *p != ',' && *p != '}' && *p != ']') {
+        ++p;
+    }
+    return p > start ? p : nullptr;
+}
+
+bool scanTopLevel(const char* begin, const char* end, TopLevelScan& scan)
+{
+    auto fail = [&](const char* at, const QString& message) {
+        scan.errorOffset = at - begin;
+        scan.errorString = message;
+        return false;
+    };
+
+    const char* p = skipSpace(begin, end);
+    // Tolerate a UTF-8 byte order mark
+    if (end - p >= 3 && p[0] == '\xEF' && p[1] == '\xBB' && p[2] == '\xBF') {
+        p = skipSpace(p + 3, end);
+    }
+    if (p >= end || *p != '{') {
+        return fail(p, "expected top-level object");
+    }
+    p = skipSpace(p + 1, end);
+
+    scan.metadata.append('{');
+    bool firstField = true;
+
+    while (p < end && *p != '}') {
+        if (*p != '"') {
+            return fail(p, "expected field name");
+        }
+        const char* keyStart = p;
+        const char* keyEnd = skipString(p, end);
+        if (!keyEnd) {
+            return fail(p, "unterminated field name");
+        }
 
-VTTLoader::VTTData VTTLoader::loadVTT(const QString& filepath, ProgressCallback progressCallback)
+        p = skipSpace(keyEnd, end);
+        if (p >= end || *p != ':') {
+            return fail(p, "expected ':' after field name");
+        }
+        p = skipSpace(p + 1, end);
+
+        const char* valueStart = p;
+        const char* valueEnd = skipValue(p, end);
+        if (!valueEnd) {
+            return fail(valueStart, "malformed or unterminated value");
+        }
+
+        const QByteArray key(keyStart + 1, keyEnd - keyStart - 2);
+        const bool isImageField = *valueStart == '"' &&
+            std::find_if(std::begin(IMAGE_KEYS), std::end(IMAGE_KEYS),
+                         [&key](const char* name) { return key == name; }) != std::end(IMAGE_KEYS);
+
+        if (isImageField) {
+            if (!scan.imageFields.contains(key)) {
+                scan.imageFields.insert(key, QByteArrayView(valueStart + 1, valueEnd - valueStart - 2));
+            }
+        } else {
+            if (!firstField) {
+                scan.metadata.append(',');
+            }
+            scan.metadata.append(keyStart, keyEnd - keyStart);
+            scan.metadata.append(':');
+            scan.metadata.append(valueStart, valueEnd - valueStart);
+            firstField = false;
+        }
+
+        p = skipSpace(valueEnd, end);
+        if (p < end && *p == ',') {
+            p = skipSpace(p + 1, end);
+        } else if (p >= end || *p != '}') {
+            return fail(p, "expected ',' or '}'");
+        }
+    }
+
+    if (p >= end) {
+        return fail(p, "unterminated object");
+    }
+
+    scan.metadata.append('}');
+    return true;
+}
+
+} // namespace
+
+VTTLoader::VTTData VTTLoader::loadVTT(const QString& filepath, ProgressCallback progressCallback,
+                                      MetadataCallback metadataCallback)
 {
     VTTData data;
 
@@ -46,16 +213,35 @@ VTTLoader::VTTData VTTLoader::loadVTT(const QString& filepath, ProgressCallback
         return data;
     }
 
-    reportProgress(10, "Reading file data...");
-    QByteArray fileData = file.readAll();
-    file.close();
+    // Map the file instead of copying it - only the metadata is copied out,
+    // the embedded image is decoded straight from the mapped bytes
+    reportProgress(10, "Mapping file data...");
+    QByteArray fileData;
+    const char* fileBegin = reinterpret_cast<const char*>(file.map(0, fileSize));
+    if (!fileBegin) {
+        DebugConsole::vtt("Memory mapping unavailable, reading file into memory", "VTT");
+        fileData = file.readAll();
+        fileBegin = fileData.constData();
+        fileSize = fileData.size();
+    }
+
+    reportProgress(15, "Scanning VTT structure...");
+    TopLevelScan scan;
+    if (!scanTopLevel(fileBegin, fileBegin + fileSize, scan)) {
+        data.errorMessage = QString("JSON parse error at offset %1: %2")
+            .arg(scan.errorOffset)
+            .arg(scan.errorString);
+        DebugConsole::error(data.errorMessage, "VTT");
+        reportProgress(100, "JSON parse failed");
+        return data;
+    }
 
     QJsonParseError parseError;
-    QJsonDocument doc = QJsonDocument::fromJson(fileData, &parseError);
+    QJsonDocument doc = QJsonDocument::fromJson(scan.metadata, &parseError);
+    scan.metadata = QByteArray();
 
     if (parseError.error != QJsonParseError::NoError) {
-        data.errorMessage = QString("JSON parse error at offset %1: %2")
-            .arg(parseError.offset)
+        data.errorMessage = QString("JSON parse error in metadata: %1")
             .arg(parseError.errorString());
         DebugConsole::error(data.errorMessage, "VTT");
         reportProgress(100, "JSON parse failed");
@@ -503,20 +689,20 @@ VTTLoader::VTTData VTTLoader::loadVTT(const QString& filepath, ProgressCallback
         DebugConsole::vtt(QString("Successfully loaded %1 lights, %2 skipped").arg(lightCount).arg(skippedCount), "VTT");
     }
 
-    // Extract and decode the base64 image (support common field variants)
-    QString base64Image;
-    if (root.contains("image") && root["image"].isString()) {
-        base64Image = root["image"].toString();
-    } else if (root.contains("image_data") && root["image_data"].isString()) {
-        base64Image = root["image_data"].toString();
-    } else if (root.contains("map") && root["map"].isString()) {
-        base64Image = root["map"].toString();
-    } else if (root.contains("mapImage") && root["mapImage"].isString()) {
-        base64Image = root["mapImage"].toString();
+    // Decode the base64 image straight from its byte range (first common field variant wins)
+    QByteArrayView base64Image;
+    for (const char* key : IMAGE_KEYS) {
+        if (scan.imageFields.contains(key)) {
+            base64Image = scan.imageFields.value(key);
+            break;
+        }
     }
 
     if (!base64Image.isEmpty()) {
-        DebugConsole::vtt(QString("Found image data, length: %1 characters").arg(base64Image.length()), "VTT");
+        if (metadataCallback) {
+            metadataCallback(data);
+        }
+        DebugConsole::vtt(QString("Found image data, length: %1 bytes").arg(base64Image.size()), "VTT");
         reportProgress(60, "Decoding embedded image...");
         data.mapImage = decodeBase64Image(base64Image, progressCallback);
 
@@ -589,9 +775,8 @@ VTTLoader::VTTData VTTLoader::loadVTT(const QString& filepath, ProgressCallback
                     int tintProgress = 87 + (8 * y / totalRows); // Progress from 87% to 95%
                     reportProgress(tintProgress, QString("Applying ambient lighting... %1%").arg((100 * y) / totalRows));
 
-                    // The progress callback now handles processEvents safely
-                    // We don't call processEvents here to avoid potential hangs
-                    // when DD2VTT files are loaded as the first file
+                    // Runs on the MapLoadPipeline worker; progress is
+                    // forwarded to the GUI thread as a queued signal
                 }
             }
 
@@ -616,7 +801,7 @@ bool VTTLoader::isVTTFile(const QString& filepath)
            filepath.endsWith(".df2vtt", Qt::CaseInsensitive);
 }
 
-QImage VTTLoader::decodeBase64Image(const QString& base64Data, ProgressCallback progressCallback)
+QImage VTTLoader::decodeBase64Image(QByteArrayView base64Data, ProgressCallback progressCallback)
 {
     // Helper to report progress safely
     auto reportProgress = [&](int percentage, const QString& message) {
@@ -627,50 +812,44 @@ QImage VTTLoader::decodeBase64Image(const QString& base64Data, ProgressCallback
 
     reportProgress(62, "Preparing base64 data...");
 
-    DebugConsole::vtt(QString("Raw base64 input length: %1").arg(base64Data.length()), "VTT");
-    DebugConsole::vtt(QString("First 50 chars of raw input: %1").arg(base64Data.left(50)), "VTT");
+    DebugConsole::vtt(QString("Raw base64 input length: %1").arg(base64Data.size()), "VTT");
+    DebugConsole::vtt(QString("First 50 chars of raw input: %1")
+        .arg(QString::fromLatin1(base64Data.first(qMin<qsizetype>(50, base64Data.size())))), "VTT");
 
     // VTT files might have data URL prefix, remove it if present
-    QString cleanBase64 = base64Data;
+    QByteArrayView cleanBase64 = base64Data;
     if (cleanBase64.startsWith("data:image/")) {
-        int commaIndex = cleanBase64.indexOf(',');
+        const qsizetype commaIndex = cleanBase64.indexOf(',');
         if (commaIndex != -1) {
             DebugConsole::vtt(QString("Removed data URL prefix, comma at position %1").arg(commaIndex), "VTT");
-            cleanBase64 = cleanBase64.mid(commaIndex + 1);
+            cleanBase64 = cleanBase64.sliced(commaIndex + 1);
         }
     }
 
-    DebugConsole::vtt(QString("Clean base64 length: %1").arg(cleanBase64.length()), "VTT");
-    DebugConsole::vtt(QString("First 50 chars of clean input: %1").arg(cleanBase64.left(50)), "VTT");
+    DebugConsole::vtt(QString("Clean base64 length: %1").arg(cleanBase64.size()), "VTT");
 
     reportProgress(65, "Decoding base64 data...");
 
-    // Check for invalid base64 characters before decoding
-    QString base64Pattern = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/=";
-    bool hasInvalidChars = false;
-    for (int i = 0; i < cleanBase64.length(); ++i) {
-        if (!base64Pattern.contains(cleanBase64[i]) && !cleanBase64[i].isSpace()) {
-            hasInvalidChars = true;
-            DebugConsole::warning(QString("Invalid base64 character '%1' at position %2").arg(cleanBase64[i]).arg(i), "VTT");
-            if (i > 5) break; // Don't spam too many warnings
-        }
-    }
-
-    if (hasInvalidChars) {
-        DebugConsole::warning("Base64 data contains invalid characters, attempting to clean", "VTT");
-        // Remove whitespace and newlines which are common in VTT files
-        cleanBase64 = cleanBase64.replace(QRegularExpression("\\s"), "");
-        DebugConsole::vtt(QString("Cleaned base64 length after removing whitespace: %1").arg(cleanBase64.length()), "VTT");
+    // One table-driven pass validates, skips whitespace/JSON escapes and decodes;
+    // big payloads are split across cores
+    QElapsedTimer decodeTimer;
+    decodeTimer.start();
+    const Base64Decoder::Result decoded = Base64Decoder::decode(cleanBase64);
+    if (!decoded.isValid()) {
+        const qsizetype inputOffset = (cleanBase64.data() - base64Data.data()) + decoded.errorOffset;
+        DebugConsole::error(QString("Base64 decoding failed at position %1: %2")
+            .arg(inputOffset).arg(decoded.errorString), "VTT");
+        reportProgress(100, "Base64 decoding failed");
+        return QImage();
     }
-
-    // Use Qt's AbortOnBase64DecodingErrors to ensure strict decoding
-    QByteArray imageData = QByteArray::fromBase64(cleanBase64.toUtf8(),
-                                                   QByteArray::Base64Encoding | QByteArray::AbortOnBase64DecodingErrors);
+    const QByteArray& imageData = decoded.data;
+    DebugConsole::performance(QString("VTTLoader: decoded %1 MB of base64 in %2 ms")
+        .arg(cleanBase64.size() / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(decodeTimer.elapsed()), "VTT");
 
     if (imageData.isEmpty()) {
         DebugConsole::error("Base64 decoding resulted in empty data", "VTT");
-        DebugConsole::error(QString("Input base64 length: %1").arg(cleanBase64.length()), "VTT");
-        DebugConsole::vtt(QString("First 100 chars of base64: %1").arg(cleanBase64.left(100)), "VTT");
+        DebugConsole::error(QString("Input base64 length: %1").arg(base64Data.size()), "VTT");
         reportProgress(100, "Base64 decoding failed");
         return QImage();
     }
@@ -4,6 +4,7 @@
 #include <QImage>
 #include <QColor>
 #include <QString>
+#include <QByteArrayView>
 #include <QList>
 #include <QPointF>
 #include <QLineF>
@@ -70,12 +71,15 @@ public:
     };
 
     using ProgressCallback = std::function<void(int, const QString&)>;
+    // Called once the grid/lighting metadata is parsed, before the image decode
+    using MetadataCallback = std::function<void(const VTTData&)>;
 
-    static VTTData loadVTT(const QString& filepath, ProgressCallback progressCallback = nullptr);
+    static VTTData loadVTT(const QString& filepath, ProgressCallback progressCallback = nullptr,
+                           MetadataCallback metadataCallback = nullptr);
     static bool isVTTFile(const QString& filepath);
 
 private:
-    static QImage decodeBase64Image(const QString& base64Data, ProgressCallback progressCallback = nullptr);
+    static QImage decodeBase64Image(QByteArrayView base64Data, ProgressCallback progressCallback = nullptr);
     static QColor parseHexColor(const QString& hexColor);
 };
 